@@ -14,6 +14,12 @@ target_include_directories(vkr PUBLIC
 target_include_directories(vkr PUBLIC ${Vulkan_INCLUDE_DIRS})
 target_link_libraries(vkr PUBLIC Vulkan::Vulkan Vulkan::shaderc_combined)
 
+# identifies the shaderc build in shader cache keys
+if(Vulkan_VERSION)
+  target_compile_definitions(vkr PRIVATE
+    VKR_SHADERC_VERSION="${Vulkan_VERSION}")
+endif()
+
 if(HAS_SLANG)
   target_include_directories(vkr PRIVATE ${SLANG_INCLUDE_DIR})
   target_link_libraries(vkr PUBLIC ${SLANG_LIBRARY})
@@ -34,6 +40,10 @@ elseif(UNIX)
 
 endif()
 
+# worker threads for parallel command recording
+find_package(Threads REQUIRED)
+target_link_libraries(vkr PUBLIC Threads::Threads)
+
 # 3rdparty libs to link statically
 target_link_libraries(vkr PUBLIC glfw)
 target_link_libraries(vkr PUBLIC glm::glm-header-only)
@@ -12,6 +12,7 @@ function(add_vk_app TARGET_NAME)
   set(options)
   set(one_value_args
     ASSET_DIR
+    BENCHMARK_FRAMES
     OUTPUT_DIR
     OUTPUT_NAME
     WORKING_DIRECTORY
@@ -134,5 +135,19 @@ function(add_vk_app TARGET_NAME)
     )
   endif()
 
+  # headless fixed-frame run registered with ctest as a throughput benchmark
+  if(VK_APP_BENCHMARK_FRAMES)
+    add_test(NAME ${TARGET_NAME}.benchmark
+      COMMAND ${TARGET_NAME}
+        --headless
+        --frames=${VK_APP_BENCHMARK_FRAMES}
+        --capture=${TARGET_NAME}.benchmark.png
+      WORKING_DIRECTORY "${app_working_dir}"
+    )
+    set_tests_properties(${TARGET_NAME}.benchmark PROPERTIES
+      LABELS benchmark
+    )
+  endif()
+
   _vk_app_print("  -- Adding VK app: ${TARGET_NAME} -> ${app_output_dir}\n")
 endfunction()
@@ -0,0 +1,21 @@
+#version 450
+
+layout(binding = 0) uniform CameraBuffer {
+  mat4 view;
+  mat4 proj;
+} camera;
+
+layout(push_constant) uniform DrawData {
+  vec4 offset;
+} draw;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+  vec3 position = inPosition + draw.offset.xyz;
+  gl_Position = camera.proj * camera.view * vec4(position, 1.0);
+  fragColor = inColor;
+}
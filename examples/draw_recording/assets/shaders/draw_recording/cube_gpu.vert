@@ -0,0 +1,30 @@
+#version 450
+
+layout(binding = 0) uniform CameraBuffer {
+  mat4 view;
+  mat4 proj;
+} camera;
+
+struct Object {
+  mat4 model;
+  uint batch;
+  uint pad0;
+  uint pad1;
+  uint pad2;
+};
+
+// the cull pass starts every draw at its object's index
+layout(std430, binding = 1) readonly buffer Objects {
+  Object objects[];
+};
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+  vec4 position = objects[gl_InstanceIndex].model * vec4(inPosition, 1.0);
+  gl_Position = camera.proj * camera.view * position;
+  fragColor = inColor * (0.5 + 0.5 * fract(position.xzx * 0.05));
+}
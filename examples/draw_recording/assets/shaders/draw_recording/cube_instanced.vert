@@ -0,0 +1,18 @@
+#version 450
+
+layout(binding = 0) uniform CameraBuffer {
+  mat4 view;
+  mat4 proj;
+} camera;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 4) in mat4 inModel;
+layout(location = 8) in vec4 inInstanceColor;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+  gl_Position = camera.proj * camera.view * inModel * vec4(inPosition, 1.0);
+  fragColor = inColor * inInstanceColor.rgb;
+}
@@ -0,0 +1,430 @@
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <vkr.hh>
+#include <vulkan/vulkan.h>
+
+namespace {
+
+// one mesh and one draw per cube, so recording cost grows with the grid
+constexpr uint32_t DEFAULT_GRID_SIZE = 64;
+constexpr float CUBE_SPACING = 1.5f;
+constexpr float CUBE_EXTENT = 0.5f;
+
+enum class CullMode {
+  None,
+  // RasterPass tests every mesh's bounds while recording
+  Cpu,
+  // one shared cube placed per object; a compute pass culls and compacts the
+  // draws and the raster pass records one indirect count draw
+  Gpu,
+  // Gpu plus a wall in front of the grid and a Hi-Z test against the
+  // previous frame's depth
+  GpuOcclusion,
+};
+
+struct CameraBufferObject {
+  alignas(16) glm::mat4 view;
+  alignas(16) glm::mat4 proj;
+};
+
+// per-cube offset, changed every frame without touching descriptors
+struct DrawData {
+  alignas(16) glm::vec4 offset;
+};
+
+auto cubeName(uint32_t x, uint32_t z) -> std::string {
+  return "cube_" + std::to_string(x) + "_" + std::to_string(z);
+}
+
+} // namespace
+
+class DrawRecordingApp : public vkr::exec::RenderApplication {
+public:
+  DrawRecordingApp(vkr::exec::DrawDataMode drawDataMode, uint32_t gridSize,
+                   CullMode culling, bool occlusionTest, bool instanced)
+      : draw_data_mode_(drawDataMode), grid_size_(gridSize),
+        culling_(culling), occlusion_test_(occlusionTest),
+        instanced_(instanced) {}
+
+private:
+  vkr::exec::DrawDataMode draw_data_mode_;
+  uint32_t grid_size_;
+  CullMode culling_;
+  // GpuOcclusion without the test keeps the wall and the pyramid, which
+  // makes the raster pass's GPU time comparable
+  bool occlusion_test_;
+  // one shared cube and a per-frame instance buffer drawn as a single
+  // indirect batch, so recording cost does not grow with the grid
+  bool instanced_;
+
+  [[nodiscard]] auto gpuCulling() const noexcept -> bool {
+    return culling_ == CullMode::Gpu || culling_ == CullMode::GpuOcclusion;
+  }
+  vkr::scene::UniformBufferHandle camera_buffer_{};
+  std::shared_ptr<vkr::scene::DrawDataStream> draw_data_{};
+  vkr::scene::InstanceBufferHandle instance_buffer_{};
+  std::vector<vkr::scene::InstanceTransform3D> instances_{};
+
+  void createResources() override {
+    constexpr std::array<uint16_t, 36> indices = {
+        0, 1, 2, 2, 3, 0, 4, 6, 5, 6, 4, 7, 0, 4, 5, 5, 1, 0,
+        3, 2, 6, 6, 7, 3, 0, 3, 7, 7, 4, 0, 1, 5, 6, 6, 2, 1};
+    const std::vector<uint16_t> indexList(indices.begin(), indices.end());
+    const float origin = -0.5f * CUBE_SPACING * (grid_size_ - 1);
+
+    camera_buffer_ =
+        scene->createUniformBuffer<CameraBufferObject>("camera", {});
+
+    if (instanced_) {
+      createInstancedResources(indexList, origin);
+      return;
+    }
+
+    if (gpuCulling()) {
+      createGpuCulledResources(indexList, origin);
+      return;
+    }
+
+    for (uint32_t x = 0; x < grid_size_; ++x) {
+      for (uint32_t z = 0; z < grid_size_; ++z) {
+        const glm::vec3 center{origin + CUBE_SPACING * x, 0.0f,
+                               origin + CUBE_SPACING * z};
+        const glm::vec3 color{static_cast<float>(x) / grid_size_, 0.4f,
+                              static_cast<float>(z) / grid_size_};
+
+        std::vector<vkr::scene::Vertex3D> vertices{};
+        vertices.reserve(8);
+        for (uint32_t corner = 0; corner < 8; ++corner) {
+          const glm::vec3 offset{(corner & 1U) != 0 ? CUBE_EXTENT
+                                                    : -CUBE_EXTENT,
+                                 (corner & 2U) != 0 ? CUBE_EXTENT
+                                                    : -CUBE_EXTENT,
+                                 corner >= 4 ? CUBE_EXTENT : -CUBE_EXTENT};
+          vertices.emplace_back(center + offset,
+                                (corner & 2U) != 0 ? color : color * 0.6f);
+        }
+
+        vkr::scene::Mesh<vkr::scene::Vertex3D> cube(*device, *commandPool);
+        cube.load(vertices, indexList);
+        scene->createMesh(cubeName(x, z), cube);
+      }
+    }
+
+    scene->createDrawDataStream<DrawData>("cubes", grid_size_ * grid_size_);
+    draw_data_ = scene->getDrawDataStream("cubes");
+  }
+
+  // centered at the origin, placed by an object or instance transform
+  void createSharedCube(const std::vector<uint16_t> &indexList) {
+    std::vector<vkr::scene::Vertex3D> vertices{};
+    vertices.reserve(8);
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+      const glm::vec3 offset{(corner & 1U) != 0 ? CUBE_EXTENT : -CUBE_EXTENT,
+                             (corner & 2U) != 0 ? CUBE_EXTENT : -CUBE_EXTENT,
+                             corner >= 4 ? CUBE_EXTENT : -CUBE_EXTENT};
+      vertices.emplace_back(offset, (corner & 2U) != 0 ? glm::vec3(1.0f)
+                                                       : glm::vec3(0.6f));
+    }
+
+    vkr::scene::Mesh<vkr::scene::Vertex3D> cube(*device, *commandPool);
+    cube.load(vertices, indexList);
+    scene->createMesh("cube", cube);
+  }
+
+  // onDraw rewrites only the current frame's slot of the instance buffer
+  void createInstancedResources(const std::vector<uint16_t> &indexList,
+                                float origin) {
+    createSharedCube(indexList);
+
+    instances_.reserve(grid_size_ * grid_size_);
+    for (uint32_t x = 0; x < grid_size_; ++x) {
+      for (uint32_t z = 0; z < grid_size_; ++z) {
+        const glm::vec3 center{origin + CUBE_SPACING * x, 0.0f,
+                               origin + CUBE_SPACING * z};
+        const glm::vec4 color{static_cast<float>(x) / grid_size_, 0.4f,
+                              static_cast<float>(z) / grid_size_, 1.0f};
+        instances_.emplace_back(glm::translate(glm::mat4(1.0f), center),
+                                color);
+      }
+    }
+
+    instance_buffer_ = scene->createInstanceBuffer("cubes", instances_);
+  }
+
+  // the cubes stay where they are placed, the objects buffer is shared by
+  // every frame in flight
+  void createGpuCulledResources(const std::vector<uint16_t> &indexList,
+                                float origin) {
+    createSharedCube(indexList);
+
+    std::vector<vkr::exec::GpuCullObject> objects{};
+    objects.reserve(grid_size_ * grid_size_);
+    for (uint32_t x = 0; x < grid_size_; ++x) {
+      for (uint32_t z = 0; z < grid_size_; ++z) {
+        const glm::vec3 center{origin + CUBE_SPACING * x, 0.0f,
+                               origin + CUBE_SPACING * z};
+        objects.push_back(vkr::exec::GpuCullObject{
+            .model = glm::translate(glm::mat4(1.0f), center)});
+      }
+    }
+
+    // as wide as the grid and tall enough to hide a large part of it from
+    // the default camera
+    if (culling_ == CullMode::GpuOcclusion) {
+      const float width = CUBE_SPACING * grid_size_;
+      objects.push_back(vkr::exec::GpuCullObject{
+          .model = glm::scale(
+              glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 12.0f, 25.0f)),
+              glm::vec3(width, 24.0f, 1.0f)),
+          .batch = 1});
+    }
+    scene->createStorageBuffer("objects", objects);
+  }
+
+  // the cull pass is updated once the passes it depends on exist
+  auto addGpuCullPass(vkr::exec::RasterPassDesc &desc)
+      -> vkr::exec::GpuCullPass & {
+    auto &cullPass = graph->addPass<vkr::exec::GpuCullPass>(*executor, *device,
+                                                            *scene);
+    cullPass.setName("cull").write("cull.commands");
+
+    if (culling_ == CullMode::GpuOcclusion) {
+      desc.sampledDepth();
+    }
+    desc.storage(1, "objects")
+        .gpuCulled(cullPass)
+        .vertexShader(vkr::resource::ShaderModuleDesc::vertexGlslFile(
+            assetSystem->resolve("shaders/draw_recording/cube_gpu.vert")
+                .string()));
+    return cullPass;
+  }
+
+  void updateGpuCullPass(vkr::exec::GpuCullPass &cullPass,
+                         vkr::exec::RasterPass &rasterPass) {
+    auto cullDesc = vkr::exec::GpuCullPassDesc{}
+                        .objectBuffer("objects")
+                        .frustum(*camera)
+                        .batch("cube", grid_size_ * grid_size_);
+    rasterPass.read("cull.commands");
+
+    if (culling_ == CullMode::GpuOcclusion) {
+      rasterPass.write("scene.depth");
+      auto &hizPass = graph->addPass<vkr::exec::HiZPass>(
+          *executor, *device, vkr::exec::RenderPassSource{rasterPass},
+          *camera);
+      hizPass.setName("hiz").read("scene.depth").write("hiz.pyramid");
+      cullDesc.batch("cube", 1).occlusion(hizPass);
+    }
+
+    cullPass.update(cullDesc);
+    cullPass.occlusion(occlusion_test_);
+  }
+
+  void buildGraph() override {
+    std::vector<std::string> meshNames{};
+    if (!gpuCulling() && !instanced_) {
+      meshNames.reserve(grid_size_ * grid_size_);
+      for (uint32_t x = 0; x < grid_size_; ++x) {
+        for (uint32_t z = 0; z < grid_size_; ++z) {
+          meshNames.push_back(cubeName(x, z));
+        }
+      }
+    }
+
+    auto vertexInput = vkr::scene::Vertex3D::vertexInputDesc();
+    if (instanced_) {
+      vertexInput.append(vkr::scene::InstanceTransform3D::vertexInputDesc());
+    }
+
+    auto desc = vkr::exec::RasterPassDesc::offscreen(
+        swapchain->width(), swapchain->height(), VK_FORMAT_R8G8B8A8_UNORM,
+        VK_FORMAT_D32_SFLOAT, "draw-recording", std::move(vertexInput));
+    desc.target.color.addUsage(VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+    const bool pushConstants =
+        draw_data_mode_ == vkr::exec::DrawDataMode::PushConstants;
+    const std::string vertexShader = pushConstants
+                                         ? "shaders/draw_recording/cube.vert"
+                                         : "shaders/draw_recording/"
+                                           "cube_uniform.vert";
+    desc.uniform(0, "camera", VK_SHADER_STAGE_VERTEX_BIT)
+        .fragmentShader(vkr::resource::ShaderModuleDesc::fragmentGlslFile(
+            assetSystem->resolve("shaders/draw_recording/cube.frag").string()))
+        .noCull()
+        .clearColor(0.05f, 0.05f, 0.08f, 1.0f)
+        .clearDepth();
+    vkr::exec::GpuCullPass *cullPass = nullptr;
+    if (instanced_) {
+      desc.instanced("cube", "cubes")
+          .vertexShader(vkr::resource::ShaderModuleDesc::vertexGlslFile(
+              assetSystem->resolve("shaders/draw_recording/cube_instanced.vert")
+                  .string()));
+    } else if (gpuCulling()) {
+      cullPass = &addGpuCullPass(desc);
+    } else {
+      desc.meshes(std::move(meshNames))
+          .perDrawData("cubes", draw_data_mode_, VK_SHADER_STAGE_VERTEX_BIT, 1)
+          .vertexShader(vkr::resource::ShaderModuleDesc::vertexGlslFile(
+              assetSystem->resolve(vertexShader).string()));
+    }
+    if (culling_ == CullMode::Cpu) {
+      // the shader moves cubes up to 0.5 along y
+      desc.frustumCulling(*camera, 0.5f);
+    }
+
+    auto &rasterPass = graph->addPass<vkr::exec::RasterPass>(
+        *executor, *device, *commandPool, *scene);
+    rasterPass.setName("cubes").write("scene.color");
+    rasterPass.update(desc);
+    if (cullPass != nullptr) {
+      updateGpuCullPass(*cullPass, rasterPass);
+    }
+
+    if (ctx.headless.enabled) {
+      auto &blitPass = graph->addPass<vkr::exec::BlitPass>(
+          *executor, *swapchain, vkr::exec::RenderPassSource{rasterPass});
+      blitPass.setName("blit").read("scene.color").write("swapchain");
+    } else {
+      auto &uiPass = graph->addPass<vkr::exec::UiPass>(
+          *executor, *window, *instance, *surface, *device, *commandPool,
+          *commandBuffers, *swapchain, *scene, *assetSystem, ctx.camera,
+          vkr::exec::RenderPassSource{rasterPass}, *graph, *timer, ctx.ui);
+      uiPass.setName("ui").read("scene.color").write("swapchain");
+    }
+
+    auto &presentPass = graph->addPass<vkr::exec::PresentPass>(*executor);
+    presentPass.setName("present");
+  }
+
+  void onDraw() override {
+    CameraBufferObject cbo{};
+    cbo.view = camera->getView();
+    cbo.proj = camera->getProjection();
+
+    scene->uniformBuffer(camera_buffer_)
+        ->updateRaw(executor->frameIndex(), &cbo, sizeof(cbo));
+
+    // the instanced cubes move like the per-mesh ones, the GPU culled cubes
+    // do not move
+    if (instanced_) {
+      const float time = timer->elapsedTime();
+      for (uint32_t instance = 0; instance < instances_.size(); ++instance) {
+        const float phase = 0.2f * static_cast<float>(instance / grid_size_ +
+                                                      instance % grid_size_);
+        instances_[instance].model[3].y = 0.5f * std::sin(time + phase);
+      }
+      scene->instanceBuffer(instance_buffer_)
+          ->updateRaw(executor->frameIndex(), instances_.data(),
+                      instances_.size());
+    }
+
+    if (draw_data_) {
+      const float time = timer->elapsedTime();
+      for (uint32_t draw = 0; draw < draw_data_->drawCount(); ++draw) {
+        const float phase =
+            0.2f * static_cast<float>(draw / grid_size_ + draw % grid_size_);
+        draw_data_->set(
+            draw, DrawData{glm::vec4(0.0f, 0.5f * std::sin(time + phase), 0.0f,
+                                     0.0f)});
+      }
+    }
+
+    if (ctx.ui.viewport.height > 0 &&
+        ctx.ui.layoutMode == vkr::ui::LayoutMode::Standard) {
+      ctx.camera.aspectRatio =
+          ctx.ui.viewport.width / static_cast<float>(ctx.ui.viewport.height);
+    } else {
+      ctx.camera.aspectRatio = ctx.window.ratio();
+    }
+  }
+
+  void configure() override {
+    ctx.window = {
+        .title = "Draw Recording",
+        .width = 1200,
+        .height = 900,
+    };
+
+    ctx.instance = {
+        .name = "draw_recording",
+        .version = VK_MAKE_VERSION(1, 0, 0),
+        .surfaceIntegration = vkr::core::SurfaceIntegration::GLFW,
+    };
+    ctx.commandBuffers.size = 2;
+    ctx.recording.minDrawsPerChunk = 128;
+    // used when present, GpuCullPass draws fall back to the full command range
+    ctx.device.drawIndirectCount = true;
+
+    ctx.camera = {
+        .movementSpeed = 20.0f,
+        .mouseSensitivity = 0.5f,
+        .aspectRatio = ctx.window.ratio(),
+        .pos = glm::vec3(0.0f, 30.0f, 60.0f),
+        .front = glm::normalize(glm::vec3(0.0f, -0.5f, -1.0f)),
+        .pitch = -26.5f,
+    };
+  }
+};
+
+// --draw-data=push|uniform picks how the per-cube offsets reach the shader,
+// --grid=N the cubes per side, --cull enables frustum culling on the CPU,
+// --gpu-cull on the GPU and --occlusion adds Hi-Z occlusion culling to it,
+// --occlusion=off the same scene without the test, --instanced draws the
+// grid as one instanced indirect batch; everything else goes to
+// RenderApplication
+auto main(int argc, char *argv[]) -> int {
+  auto drawDataMode = vkr::exec::DrawDataMode::PushConstants;
+  uint32_t gridSize = DEFAULT_GRID_SIZE;
+  auto culling = CullMode::None;
+  bool occlusionTest = true;
+  bool instanced = false;
+  std::vector<char *> arguments{};
+  for (int i = 0; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg == "--draw-data=uniform") {
+      drawDataMode = vkr::exec::DrawDataMode::DynamicUniform;
+    } else if (arg.rfind("--grid=", 0) == 0) {
+      const auto value = arg.substr(7);
+      const auto [end, error] =
+          std::from_chars(value.data(), value.data() + value.size(), gridSize);
+      if (error != std::errc{} || end != value.data() + value.size() ||
+          gridSize == 0) {
+        std::cerr << "invalid --grid value '" << value
+                  << "', expected a positive integer" << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (arg == "--cull") {
+      culling = CullMode::Cpu;
+    } else if (arg == "--gpu-cull") {
+      if (culling != CullMode::GpuOcclusion) {
+        culling = CullMode::Gpu;
+      }
+    } else if (arg == "--occlusion" || arg == "--occlusion=off") {
+      culling = CullMode::GpuOcclusion;
+      occlusionTest = arg == "--occlusion";
+    } else if (arg == "--instanced") {
+      instanced = true;
+    } else if (arg != "--draw-data=push") {
+      arguments.push_back(argv[i]);
+    }
+  }
+
+  DrawRecordingApp app(drawDataMode, gridSize, culling, occlusionTest,
+                       instanced);
+
+  try {
+    app.run(static_cast<int>(arguments.size()), arguments.data());
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+};
@@ -205,6 +205,7 @@ private:
       desc.input(channelInput(channel));
     }
 
+    desc.addColorUsage(VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
     desc.pipelineDesc(shadertoyPipeline("shadertoy.image", "image.frag"));
     return desc;
   }
@@ -327,11 +328,17 @@ private:
         .write("scene.color");
     imagePass.update(imageDesc({0, 1, 2, 3}));
 
-    auto &uiPass = graph->addPass<vkr::exec::UiPass>(
-        *executor, *window, *instance, *surface, *device, *commandPool,
-        *commandBuffers, *swapchain, *scene, *assetSystem, ctx.camera,
-        vkr::exec::RenderPassSource{imagePass}, *graph, *timer, ctx.ui);
-    uiPass.setName("ui").read("scene.color").write("swapchain");
+    if (ctx.headless.enabled) {
+      auto &blitPass = graph->addPass<vkr::exec::BlitPass>(
+          *executor, *swapchain, vkr::exec::RenderPassSource{imagePass});
+      blitPass.setName("blit").read("scene.color").write("swapchain");
+    } else {
+      auto &uiPass = graph->addPass<vkr::exec::UiPass>(
+          *executor, *window, *instance, *surface, *device, *commandPool,
+          *commandBuffers, *swapchain, *scene, *assetSystem, ctx.camera,
+          vkr::exec::RenderPassSource{imagePass}, *graph, *timer, ctx.ui);
+      uiPass.setName("ui").read("scene.color").write("swapchain");
+    }
 
     auto &presentPass = graph->addPass<vkr::exec::PresentPass>(*executor);
     presentPass.setName("present");
@@ -351,8 +358,9 @@ private:
       shadertoy_time_offset_ = timer->elapsedTime();
     }
 
-    std::time_t t = std::time(nullptr);
-    std::tm *now = std::localtime(&t);
+    // headless benchmarks pin the date so every run renders the same frames
+    std::time_t t = ctx.headless.enabled ? 0 : std::time(nullptr);
+    std::tm *now = ctx.headless.enabled ? std::gmtime(&t) : std::localtime(&t);
     const uint64_t frameCount = timer->frameCount();
     const uint64_t shadertoyFrame = frameCount >= shadertoy_frame_offset_
                                         ? frameCount - shadertoy_frame_offset_
@@ -418,7 +426,7 @@ auto main(int argc, char *argv[]) -> int {
   ShaderToyApp app;
 
   try {
-    app.run();
+    app.run(argc, argv);
   } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
     return EXIT_FAILURE;
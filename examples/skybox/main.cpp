@@ -94,7 +94,7 @@ private:
     auto compositeDesc = vkr::exec::FullscreenPassDesc::postProcess(
         swapchain->width(), swapchain->height(), VK_FORMAT_R8G8B8A8_UNORM,
         "skybox-cornell-composite");
-    compositeDesc
+    compositeDesc.addColorUsage(VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
         .vertexShader(vkr::resource::ShaderModuleDesc::vertexGlslFile(
             assetSystem->resolveApp("shaders/composite/composite.vert")
                 .string()))
@@ -113,11 +113,17 @@ private:
         .write("scene.color");
     compositePass.update(compositeDesc);
 
-    auto &uiPass = graph->addPass<vkr::exec::UiPass>(
-        *executor, *window, *instance, *surface, *device, *commandPool,
-        *commandBuffers, *swapchain, *scene, *assetSystem, ctx.camera,
-        vkr::exec::RenderPassSource{compositePass}, *graph, *timer, ctx.ui);
-    uiPass.setName("ui").read("scene.color").write("swapchain");
+    if (ctx.headless.enabled) {
+      auto &blitPass = graph->addPass<vkr::exec::BlitPass>(
+          *executor, *swapchain, vkr::exec::RenderPassSource{compositePass});
+      blitPass.setName("blit").read("scene.color").write("swapchain");
+    } else {
+      auto &uiPass = graph->addPass<vkr::exec::UiPass>(
+          *executor, *window, *instance, *surface, *device, *commandPool,
+          *commandBuffers, *swapchain, *scene, *assetSystem, ctx.camera,
+          vkr::exec::RenderPassSource{compositePass}, *graph, *timer, ctx.ui);
+      uiPass.setName("ui").read("scene.color").write("swapchain");
+    }
 
     auto &presentPass = graph->addPass<vkr::exec::PresentPass>(*executor);
     presentPass.setName("present");
@@ -180,11 +186,11 @@ private:
   }
 };
 
-auto main() -> int {
+auto main(int argc, char *argv[]) -> int {
   SkyboxApp app;
 
   try {
-    app.run();
+    app.run(argc, argv);
   } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
     return EXIT_FAILURE;
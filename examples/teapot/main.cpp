@@ -1,6 +1,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
+#include <string_view>
 #include <vector>
 #include <vkr.hh>
 #include <vulkan/vulkan.h>
@@ -13,10 +14,26 @@ struct UniformBuffer3DObject {
   alignas(16) glm::mat4 proj;
 };
 
+// bindless slot of the albedo texture, pushed with the draw
+struct MaterialPushConstants {
+  uint32_t albedo;
+};
+
 } // namespace
 
 class TeapotApp : public vkr::exec::RenderApplication {
+public:
+  explicit TeapotApp(bool bindless) : bindless_(bindless) {}
+
 private:
+  // samples the texture through the scene's bindless table instead of a
+  // per-pass descriptor
+  bool bindless_;
+
+  [[nodiscard]] auto bindlessTable() const -> bool {
+    return bindless_ && scene->bindless() != nullptr;
+  }
+
   void createResources() override {
     vkr::scene::Mesh<vkr::scene::VertexNormalTexture3D> teapot(*device,
                                                                *commandPool);
@@ -28,6 +45,13 @@ private:
         assetSystem->resolve("objects/teapot/default.png").string());
 
     scene->createUniformBuffer<UniformBuffer3DObject>("default", {});
+
+    // the device logs why when it falls back to per-pass descriptors
+    if (bindlessTable()) {
+      scene->createDrawDataStream<MaterialPushConstants>("material", 1);
+      scene->getDrawDataStream("material")->set(
+          0, MaterialPushConstants{scene->textureIndex("teapot_texture")});
+    }
   }
 
   void buildGraph() override {
@@ -36,12 +60,21 @@ private:
         VK_FORMAT_D32_SFLOAT, "teapot-local",
         vkr::scene::VertexNormalTexture3D::vertexInputDesc());
     desc.uniform(0, "default", VK_SHADER_STAGE_VERTEX_BIT)
-        .texture(1, "teapot_texture", VK_SHADER_STAGE_FRAGMENT_BIT)
         .vertexShader(vkr::resource::ShaderModuleDesc::vertexGlslFile(
-            assetSystem->resolve("shaders/teapot/teapot.vert").string()))
-        .fragmentShader(vkr::resource::ShaderModuleDesc::fragmentGlslFile(
-            assetSystem->resolve("shaders/teapot/teapot.frag").string()))
-        .noCull()
+            assetSystem->resolve("shaders/teapot/teapot.vert").string()));
+    if (bindlessTable()) {
+      desc.bindlessResources()
+          .perDrawData("material", vkr::exec::DrawDataMode::PushConstants,
+                       VK_SHADER_STAGE_FRAGMENT_BIT)
+          .fragmentShader(vkr::resource::ShaderModuleDesc::fragmentGlslFile(
+              assetSystem->resolve("shaders/teapot/teapot_bindless.frag")
+                  .string()));
+    } else {
+      desc.texture(1, "teapot_texture", VK_SHADER_STAGE_FRAGMENT_BIT)
+          .fragmentShader(vkr::resource::ShaderModuleDesc::fragmentGlslFile(
+              assetSystem->resolve("shaders/teapot/teapot.frag").string()));
+    }
+    desc.noCull()
         .clearColor(0.0f, 0.0f, 0.0f, 1.0f)
         .clearDepth();
 
@@ -53,7 +86,7 @@ private:
     auto postDesc = vkr::exec::FullscreenPassDesc::postProcess(
         swapchain->width(), swapchain->height(), VK_FORMAT_R8G8B8A8_UNORM,
         "postprocess");
-    postDesc
+    postDesc.addColorUsage(VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
         .vertexShader(vkr::resource::ShaderModuleDesc::vertexGlslFile(
             assetSystem->resolve("shaders/postprocess/postprocess.vert")
                 .string()))
@@ -69,11 +102,17 @@ private:
         .write("scene.color");
     postProcessPass.update(postDesc);
 
-    auto &uiPass = graph->addPass<vkr::exec::UiPass>(
-        *executor, *window, *instance, *surface, *device, *commandPool,
-        *commandBuffers, *swapchain, *scene, *assetSystem, ctx.camera,
-        vkr::exec::RenderPassSource{postProcessPass}, *graph, *timer, ctx.ui);
-    uiPass.setName("ui").read("scene.color").write("swapchain");
+    if (ctx.headless.enabled) {
+      auto &blitPass = graph->addPass<vkr::exec::BlitPass>(
+          *executor, *swapchain, vkr::exec::RenderPassSource{postProcessPass});
+      blitPass.setName("blit").read("scene.color").write("swapchain");
+    } else {
+      auto &uiPass = graph->addPass<vkr::exec::UiPass>(
+          *executor, *window, *instance, *surface, *device, *commandPool,
+          *commandBuffers, *swapchain, *scene, *assetSystem, ctx.camera,
+          vkr::exec::RenderPassSource{postProcessPass}, *graph, *timer, ctx.ui);
+      uiPass.setName("ui").read("scene.color").write("swapchain");
+    }
 
     auto &presentPass = graph->addPass<vkr::exec::PresentPass>(*executor);
     presentPass.setName("present");
@@ -113,6 +152,7 @@ private:
         .surfaceIntegration = vkr::core::SurfaceIntegration::GLFW,
     };
     ctx.commandBuffers.size = 2;
+    ctx.device.descriptorIndexing = bindless_;
 
     ctx.camera = {
         .movementSpeed = 5.0f,
@@ -122,11 +162,23 @@ private:
   }
 };
 
-auto main() -> int {
-  TeapotApp app;
+// --bindless samples the texture by its bindless index; everything else goes
+// to RenderApplication
+auto main(int argc, char *argv[]) -> int {
+  bool bindless = false;
+  std::vector<char *> arguments{};
+  for (int i = 0; i < argc; ++i) {
+    if (std::string_view{argv[i]} == "--bindless") {
+      bindless = true;
+    } else {
+      arguments.push_back(argv[i]);
+    }
+  }
+
+  TeapotApp app(bindless);
 
   try {
-    app.run();
+    app.run(static_cast<int>(arguments.size()), arguments.data());
   } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
     return EXIT_FAILURE;
@@ -6,29 +6,40 @@
 
 #include "vkr/core/sync/fence.hh"
 #include "vkr/core/sync/semaphore.hh"
+#include "vkr/core/sync/timeline.hh"
 #include "vkr/exec/compute/app.hh"
 #include "vkr/exec/compute/executor.hh"
 #include "vkr/exec/compute/graph.hh"
 #include "vkr/exec/compute/passes/compute.hh"
 #include "vkr/exec/profiler.hh"
 #include "vkr/exec/render/app.hh"
+#include "vkr/exec/render/draw_list.hh"
+#include "vkr/exec/render/passes/blit.hh"
 #include "vkr/exec/render/passes/composite.hh"
 #include "vkr/exec/render/passes/feedback_fullscreen.hh"
 #include "vkr/exec/render/passes/fullscreen.hh"
+#include "vkr/exec/render/passes/gpu_cull.hh"
+#include "vkr/exec/render/passes/hiz.hh"
 #include "vkr/exec/render/passes/input.hh"
 #include "vkr/exec/render/passes/post_process.hh"
 #include "vkr/exec/render/passes/present.hh"
 #include "vkr/exec/render/passes/raster.hh"
 #include "vkr/exec/render/passes/source.hh"
 #include "vkr/exec/render/passes/ui.hh"
+#include "vkr/exec/render/readback.hh"
 #include "vkr/exec/render/targets/frame_history.hh"
 #include "vkr/pipeline/compute_pipeline.hh"
 #include "vkr/resource/buffer/buffer.hh"
 #include "vkr/resource/buffer/storage_buffer.hh"
 #include "vkr/resource/buffer/uniform_buffer.hh"
 #include "vkr/resource/image/storage_image.hh"
+#include "vkr/scene/culling.hh"
 #include "vkr/scene/frame_uniform_buffer_set.hh"
+#include "vkr/scene/frustum.hh"
+#include "vkr/scene/geometry/bounds.hh"
+#include "vkr/scene/geometry/draw_data.hh"
 #include "vkr/scene/geometry/index_buffer.hh"
+#include "vkr/scene/geometry/instance_buffer.hh"
 #include "vkr/scene/geometry/mesh.hh"
 #include "vkr/scene/geometry/vbos.hh"
 #include "vkr/scene/geometry/vertex_buffer.hh"
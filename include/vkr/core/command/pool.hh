@@ -1,6 +1,8 @@
 #pragma once
 
+#include "vkr/core/command/upload.hh"
 #include "vkr/core/device.hh"
+#include <memory>
 
 namespace vkr::core {
 
@@ -14,13 +16,14 @@ struct CommandPoolDesc {
   CommandQueueRole queueRole{CommandQueueRole::Graphics};
   VkCommandPoolCreateFlags flags{
       VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT};
+  UploadContextDesc upload{};
 
   [[nodiscard]] auto isValid() const noexcept -> bool {
     switch (queueRole) {
     case CommandQueueRole::Graphics:
     case CommandQueueRole::Compute:
     case CommandQueueRole::Transfer:
-      return true;
+      return upload.isValid();
     }
 
     return false;
@@ -29,6 +32,7 @@ struct CommandPoolDesc {
   template <typename Archive> auto serialize(Archive &ar) -> void {
     ar("queueRole", queueRole);
     ar("flags", flags);
+    ar("upload", upload);
   }
 };
 
@@ -50,6 +54,9 @@ public:
     return queue_family_;
   }
   [[nodiscard]] auto queue() const noexcept -> VkQueue { return queue_; }
+  [[nodiscard]] auto uploader() const noexcept -> UploadContext & {
+    return *uploader_;
+  }
 
 private:
   // dependencies
@@ -60,6 +67,7 @@ private:
   VkCommandPool vk_command_pool_{VK_NULL_HANDLE};
   uint32_t queue_family_{VK_QUEUE_FAMILY_IGNORED};
   VkQueue queue_{VK_NULL_HANDLE};
+  std::unique_ptr<UploadContext> uploader_{};
 
   void resolveQueue();
 };
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "vkr/core/device.hh"
+#include "vkr/core/sync/timeline.hh"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace vkr::core {
+
+struct UploadContextDesc {
+  VkDeviceSize stagingSize{32ULL * 1024ULL * 1024ULL};
+  uint32_t maxBatchesInFlight{4};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return stagingSize > 0 && maxBatchesInFlight > 0;
+  }
+
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("stagingSize", stagingSize);
+    ar("maxBatchesInFlight", maxBatchesInFlight);
+  }
+};
+
+struct StagingRange {
+  VkBuffer buffer{VK_NULL_HANDLE};
+  VkDeviceSize offset{0};
+  void *mapped{nullptr};
+};
+
+struct UploadStats {
+  uint64_t uploads{0};
+  uint64_t uploadedBytes{0};
+  uint64_t submits{0};
+  uint64_t stalls{0};
+  uint64_t overflowBuffers{0};
+};
+
+class UploadContext {
+public:
+  UploadContext(const Device &device, uint32_t queueFamily, VkQueue queue,
+                const UploadContextDesc &desc);
+  ~UploadContext();
+
+  UploadContext(const UploadContext &) = delete;
+  auto operator=(const UploadContext &) -> UploadContext & = delete;
+
+  [[nodiscard]] auto stage(const void *data, VkDeviceSize size,
+                           VkDeviceSize alignment = 16) -> StagingRange;
+  [[nodiscard]] auto commandBuffer() -> VkCommandBuffer;
+  void copyBuffer(const void *data, VkDeviceSize size, VkBuffer dst,
+                  VkDeviceSize dstOffset = 0);
+
+  auto flush() -> uint64_t;
+  [[nodiscard]] auto isComplete(uint64_t batch) -> bool;
+  void wait(uint64_t batch);
+  void waitIdle();
+
+  // the queue timeline value a flushed batch signals, for submissions on
+  // other queues to wait on; invalid with fences or once the batch retired
+  [[nodiscard]] auto submission(uint64_t batch) const -> TimelinePoint;
+
+  [[nodiscard]] auto pendingBatch() const noexcept -> uint64_t {
+    return recording_ != NO_BATCH ? batches_[recording_].value : 0;
+  }
+  [[nodiscard]] auto completedBatch() const noexcept -> uint64_t {
+    return completed_value_;
+  }
+  [[nodiscard]] auto busy() const noexcept -> bool {
+    return recording_ != NO_BATCH || !in_flight_.empty();
+  }
+  [[nodiscard]] auto stats() const noexcept -> const UploadStats & {
+    return stats_;
+  }
+  void logStats() const;
+
+private:
+  struct OverflowBuffer {
+    VkBuffer buffer{VK_NULL_HANDLE};
+    MemoryAllocation allocation{};
+  };
+
+  struct Batch {
+    VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
+    VkFence fence{VK_NULL_HANDLE};
+    uint64_t timelineValue{0};
+    uint64_t value{0};
+    uint64_t ringEnd{0};
+    std::vector<OverflowBuffer> overflow{};
+  };
+
+  static constexpr uint32_t NO_BATCH = UINT32_MAX;
+
+  // dependencies
+  const Device &device_;
+
+  // components
+  UploadContextDesc desc_{};
+  VkQueue queue_{VK_NULL_HANDLE};
+  VkCommandPool vk_command_pool_{VK_NULL_HANDLE};
+  VkBuffer vk_staging_buffer_{VK_NULL_HANDLE};
+  MemoryAllocation staging_allocation_{};
+  std::vector<Batch> batches_{};
+  TimelineSemaphore *timeline_{nullptr};
+
+  // states
+  std::vector<uint32_t> free_batches_{};
+  std::deque<uint32_t> in_flight_{};
+  uint32_t recording_{NO_BATCH};
+  uint64_t next_value_{1};
+  uint64_t completed_value_{0};
+  uint64_t ring_head_{0};
+  uint64_t ring_tail_{0};
+  UploadStats stats_{};
+
+  // helpers
+  void beginBatch();
+  void retireOldest();
+  void retireCompleted();
+  [[nodiscard]] auto batchSignaled(const Batch &batch) const -> bool;
+  void waitBatch(const Batch &batch) const;
+  void releaseOverflow(Batch &batch) noexcept;
+  [[nodiscard]] auto createBuffer(VkDeviceSize size,
+                                  MemoryAllocation &allocation) -> VkBuffer;
+  void destroy() noexcept;
+};
+
+} // namespace vkr::core
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace vkr::core {
+
+struct DeletionQueueStats {
+  uint64_t deferred{0};
+  uint64_t destroyed{0};
+  uint64_t flushes{0};
+  size_t peakPending{0};
+};
+
+// holds GPU objects released while work that may still reference them is in
+// flight. Releases are tagged with the open epoch; each executor closes one
+// epoch per submission and reports the last epoch its retired work covers.
+// An epoch is destroyed once every busy submitter has reported it, so render
+// and compute queues retiring at different rates never free an object the
+// other still uses, while an idle executor holds nothing back.
+class DeletionQueue {
+public:
+  DeletionQueue() = default;
+  ~DeletionQueue();
+
+  DeletionQueue(const DeletionQueue &) = delete;
+  auto operator=(const DeletionQueue &) -> DeletionQueue & = delete;
+
+  void push(std::function<void()> deleter);
+
+  // an executor whose submissions may reference released objects; it starts
+  // out idle
+  auto addSubmitter() -> uint32_t;
+  void removeSubmitter(uint32_t submitter);
+
+  // closes the open epoch and returns it, right after the submission that
+  // may still reference releases tagged with it
+  auto advance() -> uint64_t;
+  // marks submitter busy with its work up to retiredEpoch retired and
+  // destroys every epoch all busy submitters have retired
+  void collect(uint32_t submitter, uint64_t retiredEpoch);
+  // submitter has nothing recording or in flight; its next collect makes it
+  // busy again
+  void idle(uint32_t submitter);
+  // destroys everything; the caller guarantees the device is idle
+  void flush();
+
+  [[nodiscard]] auto epoch() const -> uint64_t;
+  [[nodiscard]] auto pending() const -> size_t;
+  [[nodiscard]] auto stats() const -> DeletionQueueStats;
+  void logStats() const;
+
+private:
+  struct Entry {
+    uint64_t epoch{0};
+    std::function<void()> deleter{};
+  };
+
+  struct Submitter {
+    uint64_t retired{0};
+    bool active{false};
+    bool idle{true};
+  };
+
+  // states
+  mutable std::mutex mutex_{};
+  std::deque<Entry> entries_{};
+  std::vector<Submitter> submitters_{};
+  uint64_t epoch_{1};
+  DeletionQueueStats stats_{};
+
+  // helpers
+  auto registered(uint32_t index) -> Submitter &;
+  void collectRetired(std::deque<Entry> &retired);
+  void run(std::deque<Entry> &entries) noexcept;
+};
+
+} // namespace vkr::core
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "vkr/core/deletion_queue.hh"
 #include "vkr/core/instance.hh"
+#include "vkr/core/memory/allocator.hh"
+#include "vkr/core/pipeline_cache.hh"
 #include "vkr/core/surface.hh"
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -13,13 +17,34 @@
 
 namespace vkr::core {
 
+class TimelineSemaphore;
+
 struct DeviceDesc {
   std::vector<std::string> requiredExtensions{};
   std::vector<std::string> optionalExtensions{};
+  MemoryAllocatorDesc memory{};
+  PipelineCacheDesc pipelineCache{};
+  // enables VK_KHR_timeline_semaphore when the device supports it and gives
+  // every queue a timeline; falls back to fences otherwise
+  bool timelineSemaphore{false};
+  // enables VK_EXT_descriptor_indexing with partially bound, update-after-bind
+  // sampled image and storage buffer arrays; skipped when unsupported
+  bool descriptorIndexing{false};
+  // enables VK_KHR_draw_indirect_count so GPU-written draw counts can drive
+  // indirect draws; without it those draws run their full command range
+  bool drawIndirectCount{false};
 
-  [[nodiscard]] auto isValid() const noexcept -> bool { return true; }
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return memory.isValid() && pipelineCache.isValid();
+  }
 
-  template <typename Archive> auto serialize(Archive &ar) -> void {}
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("memory", memory);
+    ar("pipelineCache", pipelineCache);
+    ar("timelineSemaphore", timelineSemaphore);
+    ar("descriptorIndexing", descriptorIndexing);
+    ar("drawIndirectCount", drawIndirectCount);
+  }
 };
 
 class Device {
@@ -32,6 +57,7 @@ public:
   Device(const Device &) = delete;
   auto operator=(const Device &) -> Device & = delete;
 
+  // also destroys everything waiting in the deletion queue
   void waitIdle() const;
 
   [[nodiscard]] auto device() const noexcept -> VkDevice {
@@ -48,6 +74,10 @@ public:
       -> const std::vector<std::string> & {
     return enabled_extensions_;
   }
+  [[nodiscard]] auto enabledFeatures() const noexcept
+      -> const VkPhysicalDeviceFeatures & {
+    return enabled_features_;
+  }
   [[nodiscard]] auto queueFamilies() const noexcept
       -> const std::vector<VkQueueFamilyProperties> & {
     return queue_families_;
@@ -88,9 +118,46 @@ public:
   [[nodiscard]] auto transferQueue() const noexcept -> VkQueue {
     return vk_transfer_queue_;
   }
+  [[nodiscard]] auto allocator() const noexcept -> MemoryAllocator & {
+    return *allocator_;
+  }
+  [[nodiscard]] auto pipelineCache() const noexcept -> PipelineCache & {
+    return *pipeline_cache_;
+  }
+  [[nodiscard]] auto deletionQueue() const noexcept -> DeletionQueue & {
+    return *deletion_queue_;
+  }
   [[nodiscard]] auto hasExtension(const std::string &extension) const noexcept
       -> bool;
 
+  [[nodiscard]] auto timelineSemaphores() const noexcept -> bool {
+    return timeline_semaphores_;
+  }
+  [[nodiscard]] auto descriptorIndexing() const noexcept -> bool {
+    return descriptor_indexing_;
+  }
+  // update-after-bind descriptor limits, valid when descriptorIndexing()
+  [[nodiscard]] auto descriptorIndexingProperties() const noexcept
+      -> const VkPhysicalDeviceDescriptorIndexingPropertiesEXT & {
+    return descriptor_indexing_properties_;
+  }
+  [[nodiscard]] auto drawIndirectCount() const noexcept -> bool {
+    return draw_indirect_count_;
+  }
+  // the timeline every submission to queue signals; queues that share a
+  // VkQueue share one timeline
+  [[nodiscard]] auto timeline(VkQueue queue) const -> TimelineSemaphore &;
+  [[nodiscard]] auto waitSemaphore(VkSemaphore semaphore, uint64_t value,
+                                   uint64_t timeout) const -> VkResult;
+  [[nodiscard]] auto semaphoreCounterValue(VkSemaphore semaphore) const
+      -> uint64_t;
+  void cmdDrawIndexedIndirectCount(VkCommandBuffer commandBuffer,
+                                   VkBuffer buffer, VkDeviceSize offset,
+                                   VkBuffer countBuffer,
+                                   VkDeviceSize countOffset,
+                                   uint32_t maxDrawCount,
+                                   uint32_t stride) const;
+
 private:
   // dependencies
   const Instance &instance_;
@@ -103,6 +170,7 @@ private:
 
   std::vector<VkExtensionProperties> available_extensions_{};
   std::vector<std::string> enabled_extensions_{};
+  VkPhysicalDeviceFeatures enabled_features_{};
   std::vector<VkQueueFamilyProperties> queue_families_{};
   uint32_t graphics_family_{VK_QUEUE_FAMILY_IGNORED};
   uint32_t present_family_{VK_QUEUE_FAMILY_IGNORED};
@@ -114,11 +182,31 @@ private:
   VkQueue vk_compute_queue_{VK_NULL_HANDLE};
   VkQueue vk_transfer_queue_{VK_NULL_HANDLE};
 
+  std::unique_ptr<MemoryAllocator> allocator_{};
+  std::unique_ptr<PipelineCache> pipeline_cache_{};
+  std::unique_ptr<DeletionQueue> deletion_queue_{};
+
+  bool timeline_semaphores_{false};
+  bool descriptor_indexing_{false};
+  VkPhysicalDeviceDescriptorIndexingPropertiesEXT
+      descriptor_indexing_properties_{};
+  bool draw_indirect_count_{false};
+  PFN_vkCmdDrawIndexedIndirectCountKHR vk_cmd_draw_indexed_indirect_count_{
+      nullptr};
+  PFN_vkWaitSemaphoresKHR vk_wait_semaphores_{nullptr};
+  PFN_vkGetSemaphoreCounterValueKHR vk_get_semaphore_counter_value_{nullptr};
+  std::vector<VkQueue> timeline_queues_{};
+  std::vector<std::unique_ptr<TimelineSemaphore>> queue_timelines_{};
+
   // helpers
   void pickPhysicalDevice();
   void createLogicalDevice();
   void queryDeviceSupport(VkPhysicalDevice device);
   [[nodiscard]] auto resolveExtensions() -> bool;
   void resolveQueueFamilies(VkPhysicalDevice device);
+  void resolveTimelineSemaphore(VkPhysicalDevice device);
+  void resolveDescriptorIndexing(VkPhysicalDevice device);
+  void resolveDrawIndirectCount();
+  void createQueueTimelines();
 };
 } // namespace vkr::core
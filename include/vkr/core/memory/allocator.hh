@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace vkr::core {
+
+class Device;
+
+enum class MemoryResourceKind {
+  Linear,
+  Optimal,
+};
+
+struct MemoryAllocatorDesc {
+  VkDeviceSize blockSize{64ULL * 1024ULL * 1024ULL};
+  VkDeviceSize dedicatedThreshold{0};
+  bool subAllocate{true};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool { return blockSize > 0; }
+
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("blockSize", blockSize);
+    ar("dedicatedThreshold", dedicatedThreshold);
+    ar("subAllocate", subAllocate);
+  }
+};
+
+struct MemoryAllocation {
+  static constexpr uint32_t DEDICATED_BLOCK = UINT32_MAX;
+
+  VkDeviceMemory memory{VK_NULL_HANDLE};
+  VkDeviceSize offset{0};
+  VkDeviceSize size{0};
+  void *mapped{nullptr};
+  uint32_t memoryType{0};
+  uint32_t pool{0};
+  uint32_t block{DEDICATED_BLOCK};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return memory != VK_NULL_HANDLE;
+  }
+  [[nodiscard]] auto dedicated() const noexcept -> bool {
+    return block == DEDICATED_BLOCK;
+  }
+};
+
+struct MemoryStats {
+  uint64_t deviceMemoryCount{0};
+  uint64_t peakDeviceMemoryCount{0};
+  VkDeviceSize deviceMemoryBytes{0};
+  VkDeviceSize peakDeviceMemoryBytes{0};
+
+  uint64_t allocationCount{0};
+  uint64_t peakAllocationCount{0};
+  VkDeviceSize allocatedBytes{0};
+  VkDeviceSize peakAllocatedBytes{0};
+
+  uint64_t totalAllocations{0};
+  uint64_t dedicatedAllocations{0};
+  double vkAllocateMilliseconds{0.0};
+};
+
+class MemoryAllocator {
+public:
+  MemoryAllocator(const Device &device, const MemoryAllocatorDesc &desc);
+  ~MemoryAllocator();
+
+  MemoryAllocator(const MemoryAllocator &) = delete;
+  auto operator=(const MemoryAllocator &) -> MemoryAllocator & = delete;
+
+  [[nodiscard]] auto allocate(const VkMemoryRequirements &requirements,
+                              VkMemoryPropertyFlags properties,
+                              MemoryResourceKind kind) -> MemoryAllocation;
+  void free(MemoryAllocation &allocation) noexcept;
+
+  [[nodiscard]] auto stats() const -> MemoryStats;
+  void logStats() const;
+
+  [[nodiscard]] auto desc() const noexcept -> const MemoryAllocatorDesc & {
+    return desc_;
+  }
+  [[nodiscard]] auto memoryTypeIndex(uint32_t typeFilter,
+                                     VkMemoryPropertyFlags properties) const
+      -> uint32_t;
+
+private:
+  struct Block {
+    VkDeviceMemory memory{VK_NULL_HANDLE};
+    VkDeviceSize size{0};
+    void *mapped{nullptr};
+    uint32_t allocationCount{0};
+
+    // free ranges, indexed both by offset (coalescing) and by size (best fit)
+    std::map<VkDeviceSize, VkDeviceSize> freeByOffset{};
+    std::multimap<VkDeviceSize, VkDeviceSize> freeBySize{};
+  };
+
+  struct Pool {
+    std::vector<std::unique_ptr<Block>> blocks{};
+  };
+
+  static constexpr uint32_t KIND_COUNT = 2;
+
+  // dependencies
+  const Device &device_;
+
+  // components
+  MemoryAllocatorDesc desc_{};
+  VkPhysicalDeviceMemoryProperties memory_properties_{};
+  VkDeviceSize buffer_image_granularity_{1};
+  uint32_t max_allocation_count_{0};
+  std::array<Pool, VK_MAX_MEMORY_TYPES * KIND_COUNT> pools_{};
+
+  // states
+  mutable std::mutex mutex_{};
+  MemoryStats stats_{};
+
+  // helpers
+  [[nodiscard]] auto poolIndex(uint32_t memoryType,
+                               MemoryResourceKind kind) const noexcept
+      -> uint32_t;
+  [[nodiscard]] auto preferredBlockSize(uint32_t memoryType) const noexcept
+      -> VkDeviceSize;
+  [[nodiscard]] auto allocateDeviceMemory(uint32_t memoryType,
+                                          VkDeviceSize size, void **mapped)
+      -> VkDeviceMemory;
+  void freeDeviceMemory(VkDeviceMemory memory, VkDeviceSize size,
+                        bool mapped) noexcept;
+  [[nodiscard]] static auto takeRange(Block &block, VkDeviceSize size,
+                                      VkDeviceSize alignment,
+                                      VkDeviceSize &offset) -> bool;
+  static void releaseRange(Block &block, VkDeviceSize offset,
+                           VkDeviceSize size);
+  static void eraseBySize(Block &block, VkDeviceSize size,
+                          VkDeviceSize offset);
+  void trackAllocated(VkDeviceSize size) noexcept;
+};
+
+} // namespace vkr::core
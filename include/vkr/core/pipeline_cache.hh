@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace vkr::core {
+
+class Device;
+
+struct PipelineCacheDesc {
+  bool enabled{true};
+  std::string path{"pipeline_cache.bin"};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return !enabled || !path.empty();
+  }
+
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("enabled", enabled);
+    ar("path", path);
+  }
+};
+
+struct PipelineCacheStats {
+  bool warm{false};
+  size_t loadedBytes{0};
+  uint32_t pipelineCount{0};
+  double creationMilliseconds{0.0};
+};
+
+class PipelineCache {
+public:
+  PipelineCache(const Device &device, const PipelineCacheDesc &desc);
+  ~PipelineCache();
+
+  PipelineCache(const PipelineCache &) = delete;
+  auto operator=(const PipelineCache &) -> PipelineCache & = delete;
+
+  [[nodiscard]] auto cache() const noexcept -> VkPipelineCache {
+    return vk_pipeline_cache_;
+  }
+
+  void merge(const std::vector<VkPipelineCache> &sources);
+  void save() noexcept;
+
+  void recordCreation(double milliseconds) noexcept;
+  [[nodiscard]] auto stats() const -> PipelineCacheStats;
+  void logStats() const;
+
+private:
+  // dependencies
+  const Device &device_;
+
+  // components
+  PipelineCacheDesc desc_{};
+  VkPipelineCache vk_pipeline_cache_{VK_NULL_HANDLE};
+
+  // states
+  mutable std::mutex mutex_{};
+  PipelineCacheStats stats_{};
+
+  // helpers
+  [[nodiscard]] auto loadInitialData() const -> std::vector<uint8_t>;
+  [[nodiscard]] auto headerMatches(const std::vector<uint8_t> &data) const
+      -> bool;
+};
+
+} // namespace vkr::core
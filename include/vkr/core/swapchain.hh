@@ -18,7 +18,18 @@ struct SwapchainDesc {
   uint32_t height{};
   uint32_t imageCount{0};
 
-  [[nodiscard]] auto isValid() const noexcept -> bool { return true; }
+  // headless mode renders into a ring of offscreen images instead of a
+  // presentable swapchain; no window or surface is required
+  bool headless{false};
+  VkExtent2D headlessExtent{1280, 720};
+  uint32_t headlessImageCount{3};
+  VkFormat headlessFormat{VK_FORMAT_R8G8B8A8_UNORM};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return !headless ||
+           (headlessExtent.width > 0 && headlessExtent.height > 0 &&
+            headlessImageCount > 0 && headlessFormat != VK_FORMAT_UNDEFINED);
+  }
 
   template <typename Archive> auto serialize(Archive &ar) -> void {
     ar("present", presentMode);
@@ -44,6 +55,7 @@ class Swapchain {
 public:
   explicit Swapchain(const Window &window, const Surface &surface,
                      const Device &device, SwapchainDesc &desc);
+  explicit Swapchain(const Device &device, SwapchainDesc &desc);
   ~Swapchain();
 
   Swapchain(const Swapchain &) = delete;
@@ -75,19 +87,41 @@ public:
     return desc_.presentMode;
   }
 
+  [[nodiscard]] auto headless() const noexcept -> bool {
+    return desc_.headless;
+  }
+
+  [[nodiscard]] auto images() const noexcept -> const std::vector<VkImage> & {
+    return vk_images_;
+  }
+
+  [[nodiscard]] auto usage() const noexcept -> VkImageUsageFlags {
+    return usage_;
+  }
+
+  // layout the last pass must leave the image in before presentation
+  [[nodiscard]] auto finalLayout() const noexcept -> VkImageLayout {
+    return desc_.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                          : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+  }
+
   void recreate();
 
 private:
   // dependencies
-  const Window &window_;
-  const Surface &surface_;
+  const Window *window_{nullptr};
+  const Surface *surface_{nullptr};
   const Device &device_;
 
   // components
   SwapchainDesc &desc_;
   VkSwapchainKHR vk_swapchain_{VK_NULL_HANDLE};
+  std::vector<VkImage> vk_images_{};
+  std::vector<MemoryAllocation> headless_allocations_{};
+  VkImageUsageFlags usage_{0};
 
   void create();
+  void createHeadless();
   void destroy();
 };
 
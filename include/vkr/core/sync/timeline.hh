@@ -0,0 +1,89 @@
+#pragma once
+
+#include "vkr/core/device.hh"
+#include <cstdint>
+#include <vector>
+
+namespace vkr::core {
+
+// a value on a timeline semaphore; the work it stands for is done once the
+// semaphore counter reaches it
+struct TimelinePoint {
+  VkSemaphore semaphore{VK_NULL_HANDLE};
+  uint64_t value{0};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return semaphore != VK_NULL_HANDLE && value > 0;
+  }
+};
+
+class TimelineSemaphore {
+public:
+  explicit TimelineSemaphore(const Device &device, uint64_t initialValue = 0);
+  ~TimelineSemaphore();
+
+  TimelineSemaphore(const TimelineSemaphore &) = delete;
+  auto operator=(const TimelineSemaphore &) -> TimelineSemaphore & = delete;
+
+  TimelineSemaphore(TimelineSemaphore &&other) noexcept;
+  auto operator=(TimelineSemaphore &&other) -> TimelineSemaphore & = delete;
+
+  [[nodiscard]] auto semaphore() const noexcept -> VkSemaphore {
+    return vk_semaphore_;
+  }
+
+  // hands out the value the next submission signalling this timeline uses;
+  // submissions must reach the queue in the order their values were taken
+  [[nodiscard]] auto next() noexcept -> uint64_t { return ++pending_value_; }
+
+  [[nodiscard]] auto pendingValue() const noexcept -> uint64_t {
+    return pending_value_;
+  }
+
+  [[nodiscard]] auto point(uint64_t value) const noexcept -> TimelinePoint {
+    return {vk_semaphore_, value};
+  }
+
+  [[nodiscard]] auto completedValue() const -> uint64_t;
+  [[nodiscard]] auto reached(uint64_t value) const -> bool;
+  void wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
+
+private:
+  // dependencies
+  const Device &device_;
+
+  // components
+  VkSemaphore vk_semaphore_{VK_NULL_HANDLE};
+
+  // state
+  uint64_t pending_value_{0};
+  mutable uint64_t completed_value_{0};
+
+  void destroy() noexcept;
+};
+
+// semaphores of one vkQueueSubmit; binary semaphores take value 0 and the
+// timeline values are chained in only when a timeline semaphore is present
+class SubmitSemaphores {
+public:
+  void wait(VkSemaphore semaphore, VkPipelineStageFlags stageMask,
+            uint64_t value = 0);
+  void wait(const TimelinePoint &point, VkPipelineStageFlags stageMask);
+  void signal(VkSemaphore semaphore, uint64_t value = 0);
+  void signal(const TimelinePoint &point);
+
+  // fills the semaphore fields of submitInfo, which then points into this
+  // object until the submit returns
+  void apply(VkSubmitInfo &submitInfo);
+
+private:
+  std::vector<VkSemaphore> wait_semaphores_{};
+  std::vector<VkPipelineStageFlags> wait_stages_{};
+  std::vector<uint64_t> wait_values_{};
+  std::vector<VkSemaphore> signal_semaphores_{};
+  std::vector<uint64_t> signal_values_{};
+  VkTimelineSemaphoreSubmitInfoKHR timeline_info_{};
+  bool timeline_{false};
+};
+
+} // namespace vkr::core
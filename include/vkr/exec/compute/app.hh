@@ -8,28 +8,35 @@
 #include "vkr/exec/profiler.hh"
 #include "vkr/logger.hh"
 #include "vkr/util/asset.hh"
+#include "vkr/util/shader_cache.hh"
 #include "vkr/util/timer.hh"
 #include <memory>
+#include <vector>
 
 namespace vkr::exec {
 
 struct ComputeAppDesc {
   util::AssetDesc asset{};
+  util::ShaderCacheDesc shaderCache{};
   core::InstanceDesc instance{};
   core::DeviceDesc device{};
   core::CommandPoolDesc commandPool{core::CommandQueueRole::Compute};
+  ComputeExecutorDesc executor{};
   ProfilerDesc profiler{};
 
   [[nodiscard]] auto isValid() const noexcept -> bool {
-    return asset.isValid() && instance.isValid() && device.isValid() &&
-           commandPool.isValid() && profiler.isValid();
+    return asset.isValid() && shaderCache.isValid() && instance.isValid() &&
+           device.isValid() && commandPool.isValid() && executor.isValid() &&
+           profiler.isValid();
   }
 
   template <typename Archive> auto serialize(Archive &ar) -> void {
     ar("asset", asset);
+    ar("shaderCache", shaderCache);
     ar("instance", instance);
     ar("device", device);
     ar("commandPool", commandPool);
+    ar("executor", executor);
     ar("profiler", profiler);
   }
 };
@@ -65,6 +72,9 @@ protected:
 private:
   void initCompute();
   void execute();
+
+  [[nodiscard]] auto captureBlocking() -> std::vector<ProfileReport>;
+  [[nodiscard]] auto capturePipelined() -> std::vector<ProfileReport>;
 };
 
 } // namespace vkr::exec
@@ -3,16 +3,59 @@
 #include "vkr/core/command/pool.hh"
 #include "vkr/core/device.hh"
 #include "vkr/core/sync/fence.hh"
+#include "vkr/core/sync/timeline.hh"
+#include <cstdint>
+#include <memory>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace vkr::exec {
 
 class Profiler;
 
+struct ComputeBarrier {
+  VkPipelineStageFlags srcStageMask{0};
+  VkPipelineStageFlags dstStageMask{0};
+  VkAccessFlags srcAccessMask{0};
+  VkAccessFlags dstAccessMask{0};
+
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    return srcStageMask == 0 || dstStageMask == 0;
+  }
+
+  void merge(const ComputeBarrier &other) noexcept {
+    srcStageMask |= other.srcStageMask;
+    dstStageMask |= other.dstStageMask;
+    srcAccessMask |= other.srcAccessMask;
+    dstAccessMask |= other.dstAccessMask;
+  }
+};
+
+struct ComputeExecutorDesc {
+  uint32_t framesInFlight{3};
+  bool pipelined{false};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return framesInFlight > 0;
+  }
+
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("framesInFlight", framesInFlight);
+    ar("pipelined", pipelined);
+  }
+};
+
+struct ComputeExecutorStats {
+  uint64_t submits{0};
+  uint64_t stalls{0};
+};
+
 class ComputeExecutor {
 public:
   explicit ComputeExecutor(const core::Device &device,
-                           const core::CommandPool &commandPool);
+                           const core::CommandPool &commandPool,
+                           const ComputeExecutorDesc &desc);
   ~ComputeExecutor();
 
   ComputeExecutor(const ComputeExecutor &) = delete;
@@ -23,12 +66,38 @@ public:
   void end();
   void setProfiler(Profiler *profiler) noexcept;
 
+  auto submit() -> uint64_t;
+  [[nodiscard]] auto isComplete(uint64_t ticket) -> bool;
+  void wait(uint64_t ticket);
+  void waitIdle();
+
+  // makes the next submission wait for point at stageMask, e.g. for the
+  // graphics frame that produced its input
+  void waitOn(const core::TimelinePoint &point, VkPipelineStageFlags stageMask);
+  // the compute timeline value a submitted ticket signals, invalid when
+  // submissions are tracked with fences or the ticket already retired
+  [[nodiscard]] auto submission(uint64_t ticket) const -> core::TimelinePoint;
+
+  [[nodiscard]] auto desc() const noexcept -> const ComputeExecutorDesc & {
+    return desc_;
+  }
+  [[nodiscard]] auto lastTicket() const noexcept -> uint64_t {
+    return next_ticket_ - 1;
+  }
+  [[nodiscard]] auto completedTicket() const noexcept -> uint64_t {
+    return completed_ticket_;
+  }
+  [[nodiscard]] auto stats() const noexcept -> const ComputeExecutorStats & {
+    return stats_;
+  }
+
   [[nodiscard]] auto commandBuffer() const -> VkCommandBuffer;
 
   void bindComputePipeline(VkPipeline pipeline, VkPipelineLayout pipelineLayout,
                            const std::vector<VkDescriptorSet> &descriptorSets);
   void dispatch(uint32_t groupCountX, uint32_t groupCountY,
                 uint32_t groupCountZ);
+  void barrier(const ComputeBarrier &barrier);
   void beginProfileScope(std::string_view name);
   void endProfileScope();
 
@@ -38,15 +107,38 @@ private:
   const core::CommandPool &command_pool_;
   Profiler *profiler_{nullptr};
 
+  struct Frame {
+    VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
+    std::unique_ptr<core::Fence> fence{};
+    uint64_t timelineValue{0};
+    uint64_t ticket{0};
+    // deletion queue epoch closed by the submission
+    uint64_t epoch{0};
+  };
+
   // components
+  ComputeExecutorDesc desc_{};
+  std::vector<Frame> frames_{};
   VkCommandBuffer command_buffer_{VK_NULL_HANDLE};
+  core::TimelineSemaphore *timeline_{nullptr};
 
   // state
   bool active_{false};
   bool submitted_{false};
+  uint32_t current_frame_{0};
+  uint64_t next_ticket_{1};
+  uint64_t completed_ticket_{0};
+  uint32_t deletion_submitter_{0};
+  ComputeExecutorStats stats_{};
+  std::vector<std::pair<core::TimelinePoint, VkPipelineStageFlags>>
+      pending_waits_{};
 
-  void allocateCommandBuffer();
-  void freeCommandBuffer() noexcept;
+  void allocateCommandBuffers();
+  void freeCommandBuffers() noexcept;
+  auto submitCurrent() -> uint64_t;
+  void retire(Frame &frame) noexcept;
+  [[nodiscard]] auto frameSignaled(const Frame &frame) const -> bool;
+  void waitFrame(const Frame &frame) const;
   void ensureActive(const char *op) const;
   void ensureInactive(const char *op) const;
 };
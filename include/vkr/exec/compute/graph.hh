@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vkr/exec/compute/passes/compute.hh"
+#include "vkr/exec/pass_creation.hh"
 #include <functional>
 #include <memory>
 #include <optional>
@@ -26,6 +27,7 @@ public:
   void addDependency(std::string producer, std::string consumer);
 
   void compile();
+  // see RenderGraph::create
   void create();
   void destroy();
   void record();
@@ -40,6 +42,17 @@ public:
   [[nodiscard]] auto getPass(std::string_view name) const
       -> std::optional<std::reference_wrapper<const ComputePass>>;
 
+  void parallelCreate(bool enabled) noexcept { parallel_create_ = enabled; }
+
+  [[nodiscard]] auto createStats() const noexcept -> const GraphCreateStats & {
+    return create_stats_;
+  }
+
+  [[nodiscard]] auto levelCount() const noexcept -> size_t {
+    return level_barriers_.size();
+  }
+  [[nodiscard]] auto barrierCount() const noexcept -> size_t;
+
 private:
   // components
   std::vector<std::unique_ptr<ComputePass>> passes_{};
@@ -48,10 +61,15 @@ private:
       manual_dependencies_{};
   std::vector<std::vector<size_t>> compiled_dependencies_{};
   std::vector<size_t> ordered_passes_{};
+  std::vector<size_t> pass_levels_{};
+  std::vector<ComputeBarrier> level_barriers_{};
+  ComputeBarrier entry_barrier_{};
 
   // states
   bool dirty_{true};
   bool created_{false};
+  bool parallel_create_{true};
+  GraphCreateStats create_stats_{};
 
   // helpers
   void rebuildNameTable();
@@ -59,6 +77,10 @@ private:
   void validateDependencies() const;
   void addCompiledDependency(size_t producer, size_t consumer);
   void buildResourceDependencies();
+  void buildBarrierPlan();
+
+  [[nodiscard]] auto hazardBarrier(size_t producer, size_t consumer) const
+      -> ComputeBarrier;
 
   [[nodiscard]] auto passIndex(std::string_view name) const -> size_t;
   [[nodiscard]] static auto contains(const std::vector<std::string> &values,
@@ -111,6 +111,17 @@ public:
   void destroy() override;
   void update(const ComputePassDesc &desc);
   void record() override;
+  auto awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> override;
+
+  [[nodiscard]] auto executor() const noexcept -> ComputeExecutor & {
+    return executor_;
+  }
+
+  // rebuilds queued through updateAsync() are swapped in by record()
+  [[nodiscard]] auto computePipeline() const noexcept
+      -> pipeline::ComputePipeline * {
+    return pipeline_.get();
+  }
 
 private:
   // dependencies
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+namespace vkr::exec {
+
+inline constexpr VkAccessFlags kWriteAccessMask =
+    VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT |
+    VK_ACCESS_MEMORY_WRITE_BIT;
+
+[[nodiscard]] inline auto depthAspectMask(VkFormat format) noexcept
+    -> VkImageAspectFlags {
+  switch (format) {
+  case VK_FORMAT_D16_UNORM_S8_UINT:
+  case VK_FORMAT_D24_UNORM_S8_UINT:
+  case VK_FORMAT_D32_SFLOAT_S8_UINT:
+    return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+  default:
+    return VK_IMAGE_ASPECT_DEPTH_BIT;
+  }
+}
+
+struct ImageState {
+  VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+  VkPipelineStageFlags stageMask{0};
+  VkAccessFlags accessMask{0};
+};
+
+// how a pass touches one image while it records; the render graph turns the
+// difference to the image's tracked state into barriers
+struct ImageAccess {
+  VkImage image{VK_NULL_HANDLE};
+  VkImageAspectFlags aspectMask{VK_IMAGE_ASPECT_COLOR_BIT};
+  ImageState state{};
+
+  // previous contents are overwritten (cleared attachment, full blit)
+  bool discard{false};
+
+  [[nodiscard]] auto writes() const noexcept -> bool {
+    return (state.accessMask & kWriteAccessMask) != 0;
+  }
+
+  [[nodiscard]] static auto
+  sampled(VkImage image, VkImageLayout layout,
+          VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT)
+      -> ImageAccess {
+    return {.image = image,
+            .aspectMask = aspectMask,
+            .state = {.layout = layout,
+                      .stageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                      .accessMask = VK_ACCESS_SHADER_READ_BIT}};
+  }
+
+  [[nodiscard]] static auto colorAttachment(VkImage image, bool discard = true)
+      -> ImageAccess {
+    return {.image = image,
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .state = {.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                      .stageMask =
+                          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                      .accessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT},
+            .discard = discard};
+  }
+
+  [[nodiscard]] static auto depthAttachment(VkImage image, VkFormat format,
+                                            bool discard = true)
+      -> ImageAccess {
+    return {
+        .image = image,
+        .aspectMask = depthAspectMask(format),
+        .state = {.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                  .stageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                               VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                  .accessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT},
+        .discard = discard};
+  }
+
+  [[nodiscard]] static auto transferSource(VkImage image) -> ImageAccess {
+    return {.image = image,
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .state = {.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                      .stageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                      .accessMask = VK_ACCESS_TRANSFER_READ_BIT}};
+  }
+
+  [[nodiscard]] static auto transferDestination(VkImage image,
+                                                bool discard = true)
+      -> ImageAccess {
+    return {.image = image,
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .state = {.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                      .stageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                      .accessMask = VK_ACCESS_TRANSFER_WRITE_BIT},
+            .discard = discard};
+  }
+
+  // the acquire semaphore waits at color output, so recording that stage
+  // chains the next frame's transition of this image onto the acquire;
+  // headless images are read back by a transfer instead
+  [[nodiscard]] static auto present(VkImage image, VkImageLayout layout)
+      -> ImageAccess {
+    if (layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+      return transferSource(image);
+    }
+
+    return {.image = image,
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .state = {.layout = layout,
+                      .stageMask =
+                          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                      .accessMask = 0}};
+  }
+};
+
+} // namespace vkr::exec
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "vkr/exec/image_access.hh"
 #include "vkr/pipeline/graphics_pipeline.hh"
+#include "vkr/resource/image/image.hh"
 #include <functional>
 #include <optional>
 #include <string>
@@ -57,13 +59,67 @@ public:
     return *this;
   }
 
+  // memory the graph assigned to transientAttachments(), same order; an
+  // invalid entry means the attachment allocates its own
+  void setTransientMemory(std::vector<core::MemoryAllocation> memory) {
+    transient_memory_ = std::move(memory);
+  }
+
+  [[nodiscard]] auto transientMemory() const noexcept
+      -> const std::vector<core::MemoryAllocation> & {
+    return transient_memory_;
+  }
+
   virtual void create() = 0;
   virtual void destroy() = 0;
   virtual void record() = 0;
 
+  // create() leaves pipeline builds running on worker threads; the graph
+  // collects them here before the first frame, one status per pipeline
+  virtual auto awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> {
+    return {};
+  }
+
   virtual void present() {}
   virtual void afterFrame() {}
 
+  // swapchain resize without rebuilding the graph: rescale() moves every
+  // extent sized from the previous swapchain to the new one before transient
+  // memory is planned again, then resize() rebuilds only what depends on it.
+  // Passes that do not know better are rebuilt from scratch.
+  virtual void rescale(VkExtent2D previous, VkExtent2D extent) {
+    (void)previous;
+    (void)extent;
+  }
+
+  virtual void resize() {
+    destroy();
+    create();
+  }
+
+  // attachments the graph may alias with those of other passes when their
+  // lifetimes within a frame do not overlap; queried before create()
+  [[nodiscard]] virtual auto transientAttachments() const
+      -> std::vector<resource::ImageDesc> {
+    return {};
+  }
+
+  // images created for transientAttachments(), same order
+  [[nodiscard]] virtual auto transientImages() const -> std::vector<VkImage> {
+    return {};
+  }
+
+  // passes whose attachments this pass samples while recording
+  [[nodiscard]] virtual auto sampledPasses() const
+      -> std::vector<const Pass *> {
+    return {};
+  }
+
+  // images touched by the next record(), queried right before it
+  [[nodiscard]] virtual auto imageAccesses() const -> std::vector<ImageAccess> {
+    return {};
+  }
+
   [[nodiscard]] virtual auto presentsToSwapchain() const noexcept -> bool {
     return false;
   }
@@ -83,6 +139,7 @@ private:
   std::string name_{};
   std::vector<std::string> reads_{};
   std::vector<std::string> writes_{};
+  std::vector<core::MemoryAllocation> transient_memory_{};
 };
 
 } // namespace vkr::exec
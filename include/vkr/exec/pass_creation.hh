@@ -0,0 +1,42 @@
+#pragma once
+
+#include "vkr/exec/pass.hh"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vkr::exec {
+
+// where one pass spent graph creation; pipeline builds run on worker threads
+// and overlap with other passes, so they are reported apart from create()
+struct PassCreateTiming {
+  std::string pass{};
+  double createMilliseconds{0.0};
+  double pipelineMilliseconds{0.0};
+  uint32_t pipelines{0};
+};
+
+struct GraphCreateStats {
+  bool parallel{true};
+  double milliseconds{0.0};
+  std::vector<PassCreateTiming> passes{};
+
+  // what the pipeline builds cost back to back
+  [[nodiscard]] auto pipelineMilliseconds() const noexcept -> double {
+    double total = 0.0;
+    for (const auto &pass : passes) {
+      total += pass.pipelineMilliseconds;
+    }
+    return total;
+  }
+};
+
+// creates passes in order. In parallel mode every pass's pipeline builds keep
+// running while later passes are created and are collected at the end; in
+// serial mode each pass waits for its own before the next one starts.
+auto createPasses(const std::vector<Pass *> &passes, bool parallel)
+    -> GraphCreateStats;
+void logCreateStats(std::string_view graph, const GraphCreateStats &stats);
+
+} // namespace vkr::exec
@@ -13,17 +13,19 @@ namespace vkr::exec {
 struct ProfilerDesc {
   bool enableGpuTimestamps{false};
   uint32_t maxScopes{64};
+  uint32_t frameSlots{4};
   uint32_t warmupFrames{0};
   uint32_t captureFrames{1};
   bool logReport{true};
 
   [[nodiscard]] auto isValid() const noexcept -> bool {
-    return maxScopes > 0 && captureFrames > 0;
+    return maxScopes > 0 && frameSlots > 0 && captureFrames > 0;
   }
 
   template <typename Archive> auto serialize(Archive &ar) -> void {
     ar("enableGpuTimestamps", enableGpuTimestamps);
     ar("maxScopes", maxScopes);
+    ar("frameSlots", frameSlots);
     ar("warmupFrames", warmupFrames);
     ar("captureFrames", captureFrames);
     ar("logReport", logReport);
@@ -41,6 +43,7 @@ struct ProfileSample {
 
 struct ProfileReport {
   bool gpuTimestampsEnabled{false};
+  uint64_t frame{0};
   std::vector<ProfileSample> gpuSamples{};
   std::vector<ProfileSample> cpuSamples{};
 
@@ -49,6 +52,14 @@ struct ProfileReport {
   }
 };
 
+// folds timings captured over many frames into min/mean/median/max samples
+[[nodiscard]] auto summarizeTimings(std::string name,
+                                    std::vector<double> milliseconds)
+    -> ProfileSample;
+[[nodiscard]] auto summarizeReports(const std::vector<ProfileReport> &reports)
+    -> ProfileReport;
+void logProfileSummary(const ProfileReport &report);
+
 class Profiler {
 public:
   Profiler(const core::Device &device, const core::CommandPool &commandPool,
@@ -68,7 +79,14 @@ public:
       VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
 
   [[nodiscard]] auto collect() -> ProfileReport;
+  [[nodiscard]] auto collectAll() -> std::vector<ProfileReport>;
   [[nodiscard]] auto enabled() const noexcept -> bool { return enabled_; }
+  [[nodiscard]] auto frameCount() const noexcept -> uint64_t {
+    return frame_count_;
+  }
+  [[nodiscard]] auto droppedFrames() const noexcept -> uint64_t {
+    return dropped_frames_;
+  }
   [[nodiscard]] auto desc() const noexcept -> const ProfilerDesc & {
     return desc_;
   }
@@ -80,18 +98,28 @@ private:
     uint32_t endQuery{0};
   };
 
+  struct FrameSlot {
+    VkQueryPool queryPool{VK_NULL_HANDLE};
+    std::vector<Scope> scopes{};
+    uint32_t usedQueries{0};
+    uint64_t frame{0};
+    bool pending{false};
+  };
+
   // dependencies
   const core::Device &device_;
   const core::CommandPool &command_pool_;
 
   // components
   ProfilerDesc desc_{};
-  VkQueryPool query_pool_{VK_NULL_HANDLE};
-  std::vector<Scope> scopes_{};
+  std::vector<FrameSlot> slots_{};
+  std::vector<ProfileReport> resolved_{};
 
   // states
   std::vector<size_t> scope_stack_{};
-  uint32_t next_query_{0};
+  uint32_t current_slot_{0};
+  uint64_t frame_count_{0};
+  uint64_t dropped_frames_{0};
   uint32_t timestamp_valid_bits_{0};
   float timestamp_period_{0.0F};
   bool enabled_{false};
@@ -100,6 +128,7 @@ private:
   // helpers
   void create();
   void destroy() noexcept;
+  [[nodiscard]] auto resolve(FrameSlot &slot, ProfileReport &report) -> bool;
   [[nodiscard]] auto queryCount() const noexcept -> uint32_t;
   [[nodiscard]] auto timestampDelta(uint64_t begin, uint64_t end) const
       -> uint64_t;
@@ -10,20 +10,56 @@
 #include "vkr/exec/profiler.hh"
 #include "vkr/exec/render/executor.hh"
 #include "vkr/exec/render/graph.hh"
+#include "vkr/exec/render/parallel_recorder.hh"
 #include "vkr/exec/render/sync.hh"
 #include "vkr/scene/camera.hh"
 #include "vkr/scene/scene.hh"
 #include "vkr/ui/ui.hh"
 #include "vkr/util/asset.hh"
 #include "vkr/util/input_tracer.hh"
+#include "vkr/util/shader_cache.hh"
 #include "vkr/util/timer.hh"
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace vkr::exec {
 
+// fixed-frame offscreen benchmark: no window or surface, the swapchain is a
+// ring of offscreen images and the last frame can be written out as a PNG
+struct RenderHeadlessDesc {
+  bool enabled{false};
+  uint32_t width{1280};
+  uint32_t height{720};
+  uint32_t imageCount{3};
+  VkFormat format{VK_FORMAT_R8G8B8A8_UNORM};
+  uint32_t warmupFrames{10};
+  uint32_t frames{300};
+  float fixedStep{1.0f / 60.0f};
+  std::string capturePath{};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return !enabled || (width > 0 && height > 0 && imageCount > 0 &&
+                        frames > 0 && fixedStep >= 0.0f);
+  }
+
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("enabled", enabled);
+    ar("width", width);
+    ar("height", height);
+    ar("imageCount", imageCount);
+    ar("format", format);
+    ar("warmupFrames", warmupFrames);
+    ar("frames", frames);
+    ar("fixedStep", fixedStep);
+    ar("capturePath", capturePath);
+  }
+};
+
 struct RenderAppDesc {
   util::AssetDesc asset{};
+  util::ShaderCacheDesc shaderCache{};
   core::WindowDesc window{};
   core::InstanceDesc instance{};
   core::DeviceDesc device{};
@@ -31,18 +67,22 @@ struct RenderAppDesc {
   core::CommandPoolDesc commandPool{};
   core::CommandBuffersDesc commandBuffers{};
   ProfilerDesc profiler{};
+  ParallelRecorderDesc recording{};
   vkr::scene::CameraDesc camera{};
   ui::UiDesc ui{};
+  RenderHeadlessDesc headless{};
 
   [[nodiscard]] auto isValid() const noexcept -> bool {
-    return asset.isValid() && window.isValid() && instance.isValid() &&
-           device.isValid() && swapchain.isValid() && commandPool.isValid() &&
-           commandBuffers.isValid() && profiler.isValid() && camera.isValid() &&
-           ui.isValid();
+    return asset.isValid() && shaderCache.isValid() && window.isValid() &&
+           instance.isValid() && device.isValid() && swapchain.isValid() &&
+           commandPool.isValid() && commandBuffers.isValid() &&
+           profiler.isValid() && recording.isValid() && camera.isValid() &&
+           ui.isValid() && headless.isValid();
   }
 
   template <typename Archive> auto serialize(Archive &ar) -> void {
     ar("asset", asset);
+    ar("shaderCache", shaderCache);
     ar("window", window);
     ar("instance", instance);
     ar("device", device);
@@ -50,8 +90,10 @@ struct RenderAppDesc {
     ar("commandPool", commandPool);
     ar("commandBuffers", commandBuffers);
     ar("profiler", profiler);
+    ar("recording", recording);
     ar("camera", camera);
     ar("ui", ui);
+    ar("headless", headless);
   }
 };
 
@@ -64,6 +106,10 @@ public:
   auto operator=(const RenderApplication &) -> RenderApplication & = delete;
 
   void run();
+  // accepts --headless, --frames=N, --warmup=N, --capture=PATH,
+  // --record-threads=N, --sync=timeline|fence, --resize=incremental|full and
+  // --pipelines=parallel|serial
+  void run(int argc, char **argv);
 
   RenderAppDesc ctx;
 
@@ -87,6 +133,7 @@ public:
 
   // executor
   std::unique_ptr<Executor> executor;
+  std::unique_ptr<ParallelRecorder> recorder;
   std::unique_ptr<RenderGraph> graph;
   std::unique_ptr<Profiler> profiler;
   ProfileReport profileReport;
@@ -107,9 +154,17 @@ protected:
   }
 
 private:
+  std::vector<std::string> arguments_{};
+  double record_milliseconds_{0.0};
+  bool incremental_resize_{true};
+  bool parallel_pipelines_{true};
+
   void initVulkan();
+  void applyArguments();
 
   void mainLoop();
+  void runHeadless();
+  void captureFrame(const std::filesystem::path &path);
   void drawFrame();
   void updateUiState();
   void recreateSwapchain();
@@ -5,6 +5,7 @@
 #include "vkr/resource/image/image.hh"
 #include "vkr/resource/image/image_view.hh"
 #include "vkr/resource/image/sampler.hh"
+#include <optional>
 #include <utility>
 
 namespace vkr::exec {
@@ -19,6 +20,9 @@ struct ColorAttachmentDesc {
   bool createSampler{false};
   resource::SamplerDesc sampler{resource::SamplerDesc::linearClampToEdge()};
 
+  // graph-owned memory shared with attachments of disjoint lifetime
+  std::optional<core::MemoryAllocation> memory{};
+
   auto extent(uint32_t attachmentWidth, uint32_t attachmentHeight) noexcept
       -> ColorAttachmentDesc & {
     width = attachmentWidth;
@@ -87,6 +91,13 @@ struct ColorAttachmentDesc {
     return width != 0 && height != 0 && format != VK_FORMAT_UNDEFINED;
   }
 
+  [[nodiscard]] auto imageDesc() const -> resource::ImageDesc {
+    auto desc = resource::ImageDesc::colorAttachment(width, height, format);
+    desc.usage = usage;
+    desc.memory = memory;
+    return desc;
+  }
+
   [[nodiscard]] static auto attachment(uint32_t width, uint32_t height,
                                        VkFormat format) -> ColorAttachmentDesc {
     ColorAttachmentDesc desc{};
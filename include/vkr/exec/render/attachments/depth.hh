@@ -5,6 +5,7 @@
 #include "vkr/resource/image/image.hh"
 #include "vkr/resource/image/image_view.hh"
 #include "vkr/resource/image/sampler.hh"
+#include <optional>
 #include <utility>
 
 namespace vkr::exec {
@@ -18,6 +19,9 @@ struct DepthAttachmentDesc {
   bool createSampler{false};
   resource::SamplerDesc sampler{resource::SamplerDesc::nearestClampToEdge()};
 
+  // graph-owned memory shared with attachments of disjoint lifetime
+  std::optional<core::MemoryAllocation> memory{};
+
   auto extent(uint32_t attachmentWidth, uint32_t attachmentHeight) noexcept
       -> DepthAttachmentDesc & {
     width = attachmentWidth;
@@ -76,6 +80,13 @@ struct DepthAttachmentDesc {
     return width != 0 && height != 0 && format != VK_FORMAT_UNDEFINED;
   }
 
+  [[nodiscard]] auto imageDesc() const -> resource::ImageDesc {
+    auto desc = resource::ImageDesc::depthAttachment(width, height, format);
+    desc.usage = usage;
+    desc.memory = memory;
+    return desc;
+  }
+
   [[nodiscard]] static auto attachment(uint32_t width, uint32_t height,
                                        VkFormat format) -> DepthAttachmentDesc {
     DepthAttachmentDesc desc{};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "vkr/core/device.hh"
+#include "vkr/resource/buffer/buffer.hh"
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace vkr::exec {
+
+// per-frame VkDrawIndexedIndirectCommand arrays; each frame slot is rewritten
+// only after the executor has waited for that slot's fence
+class DrawCommandBuffer {
+public:
+  explicit DrawCommandBuffer(const core::Device &device, uint32_t frameCount);
+  ~DrawCommandBuffer() = default;
+
+  DrawCommandBuffer(const DrawCommandBuffer &) = delete;
+  auto operator=(const DrawCommandBuffer &) -> DrawCommandBuffer & = delete;
+
+  void update(uint32_t frameIndex,
+              const std::vector<VkDrawIndexedIndirectCommand> &commands);
+
+  [[nodiscard]] auto buffer(uint32_t frameIndex) const -> VkBuffer;
+  [[nodiscard]] auto commandCount(uint32_t frameIndex) const -> uint32_t;
+  [[nodiscard]] auto frameCount() const noexcept -> uint32_t {
+    return static_cast<uint32_t>(buffers_.size());
+  }
+
+  [[nodiscard]] static constexpr auto stride() noexcept -> uint32_t {
+    return sizeof(VkDrawIndexedIndirectCommand);
+  }
+
+private:
+  // dependencies
+  const core::Device &device_;
+
+  // components
+  std::vector<std::unique_ptr<resource::Buffer>> buffers_{};
+  std::vector<uint32_t> counts_{};
+
+  // helpers
+  void ensureFrame(uint32_t frameIndex) const;
+};
+
+} // namespace vkr::exec
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkr::exec {
+
+// fields of a 64-bit draw sort key, most significant first, so sorted draws
+// change pipeline least often, then descriptor set, then mesh, and draws
+// sharing all three go front to back
+struct DrawSortKey {
+  static constexpr uint32_t kPipelineBits = 12;
+  static constexpr uint32_t kDescriptorSetBits = 12;
+  static constexpr uint32_t kMeshBits = 20;
+  static constexpr uint32_t kDepthBits = 20;
+
+  // small ids chosen by the caller; ids wider than their field wrap, which
+  // only weakens grouping
+  uint32_t pipeline{0};
+  uint32_t descriptorSet{0};
+  uint32_t mesh{0};
+  // view depth normalized to [0, 1], clamped when encoded
+  float depth{0.0f};
+
+  [[nodiscard]] auto encode() const noexcept -> uint64_t;
+};
+
+struct DrawListEntry {
+  uint64_t key{0};
+  uint32_t draw{0};
+};
+
+// one key per draw; after sort() callers record in entry order and use the
+// entry's draw index to reach their own per-draw data
+class DrawList {
+public:
+  void clear() noexcept { entries_.clear(); }
+  void reserve(size_t count) { entries_.reserve(count); }
+  void add(const DrawSortKey &key, uint32_t draw);
+  void sort();
+
+  [[nodiscard]] auto entries() const noexcept
+      -> const std::vector<DrawListEntry> & {
+    return entries_;
+  }
+
+  [[nodiscard]] auto draw(size_t position) const noexcept -> uint32_t {
+    return entries_[position].draw;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_t {
+    return entries_.size();
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    return entries_.empty();
+  }
+
+private:
+  // states
+  std::vector<DrawListEntry> entries_{};
+};
+
+} // namespace vkr::exec
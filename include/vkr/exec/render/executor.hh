@@ -5,11 +5,18 @@
 #include "vkr/core/device.hh"
 #include "vkr/exec/profiler.hh"
 #include "vkr/exec/render/frame_buffer_set.hh"
+#include "vkr/exec/render/parallel_recorder.hh"
 #include "vkr/exec/render/sync.hh"
 #include "vkr/pipeline/render_pass.hh"
+#include "vkr/scene/culling.hh"
 #include "vkr/scene/scene.hh"
 #include "vkr/ui/ui.hh"
+#include <array>
+#include <functional>
+#include <initializer_list>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace vkr::exec {
 
@@ -20,13 +27,72 @@ struct RenderPassBeginDesc {
   VkSubpassContents contents{VK_SUBPASS_CONTENTS_INLINE};
 };
 
+// per-instance vertex data, bound at vertex binding 1 next to the mesh
+struct InstanceBinding {
+  VkBuffer buffer{VK_NULL_HANDLE};
+  VkDeviceSize offset{0};
+};
+
+struct ExecutorDrawStats {
+  uint32_t drawCalls{0};
+  uint32_t indirectDrawCalls{0};
+  uint32_t indirectCommands{0};
+  uint64_t instances{0};
+  uint32_t secondaryCommandBuffers{0};
+  // pipeline, descriptor set, vertex and index buffer binds recorded, and
+  // the ones dropped because the same object was already bound
+  uint32_t bindsIssued{0};
+  uint32_t bindsSkipped{0};
+  // objects tested by the frame's culling stages, the ones kept, the ones a
+  // Hi-Z test hid, the ones dropped for lack of command slots, and the time
+  // spent testing them on the CPU
+  uint32_t cullObjects{0};
+  uint32_t cullVisible{0};
+  uint32_t cullOccluded{0};
+  uint32_t cullOverflowed{0};
+  double cullMilliseconds{0.0};
+};
+
+// what a command buffer has bound since its last reset; binds that match it
+// are skipped. Sets bound with another layout are forgotten instead of
+// tracked through layout compatibility
+struct ExecutorBindState {
+  static constexpr uint32_t kMaxSets = 4;
+
+  struct DescriptorSet {
+    VkPipelineLayout layout{VK_NULL_HANDLE};
+    VkDescriptorSet set{VK_NULL_HANDLE};
+    uint32_t dynamicOffsetCount{0};
+    uint32_t dynamicOffset{0};
+  };
+
+  VkPipeline pipeline{VK_NULL_HANDLE};
+  std::array<DescriptorSet, kMaxSets> sets{};
+  VkBuffer vertexBuffer{VK_NULL_HANDLE};
+  VkBuffer instanceBuffer{VK_NULL_HANDLE};
+  VkDeviceSize instanceOffset{0};
+  VkBuffer indexBuffer{VK_NULL_HANDLE};
+  VkIndexType indexType{VK_INDEX_TYPE_MAX_ENUM};
+};
+
+// image barriers between two passes, recorded as one vkCmdPipelineBarrier
+struct ImageBarrierBatch {
+  VkPipelineStageFlags srcStageMask{0};
+  VkPipelineStageFlags dstStageMask{0};
+  std::vector<VkImageMemoryBarrier> images{};
+
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    return srcStageMask == 0 || dstStageMask == 0;
+  }
+};
+
 class Executor {
 public:
   explicit Executor(const core::Device &device,
                     const core::Swapchain &swapchain,
                     const core::CommandPool &commandPool, FrameSync &frameSync,
                     scene::Scene &scene, core::CommandBuffers &commandBuffers);
-  ~Executor() = default;
+  ~Executor();
 
   Executor(const Executor &) = delete;
   auto operator=(const Executor &) -> Executor & = delete;
@@ -36,6 +102,24 @@ public:
   void presentFrame();
   void endFrame();
   void setProfiler(Profiler *profiler) noexcept;
+  void setParallelRecorder(ParallelRecorder *recorder) noexcept;
+  // makes the next frame submission wait for point at stageMask, e.g. for a
+  // compute or transfer submission on another queue
+  void waitOn(const core::TimelinePoint &point, VkPipelineStageFlags stageMask);
+
+  // the graphics timeline value of the last submitted frame, invalid when
+  // frames are tracked with fences
+  [[nodiscard]] auto lastSubmission() const noexcept -> core::TimelinePoint {
+    return last_submission_;
+  }
+
+  [[nodiscard]] auto device() const noexcept -> const core::Device & {
+    return device_;
+  }
+
+  [[nodiscard]] auto swapchain() const noexcept -> const core::Swapchain & {
+    return swapchain_;
+  }
 
   [[nodiscard]] auto swapchainOutOfDate() const noexcept -> bool {
     return swapchain_out_of_date_;
@@ -60,23 +144,84 @@ public:
     return image_index_;
   }
 
+  // image index handed to the last present, used for headless readback
+  [[nodiscard]] auto lastPresentedImage() const noexcept -> uint32_t {
+    return last_presented_image_;
+  }
+
   [[nodiscard]] auto currentFrameIndex() const noexcept -> uint32_t {
     return current_frame_;
   }
 
   [[nodiscard]] auto framesInFlight() const noexcept -> uint32_t;
 
+  [[nodiscard]] auto drawStats() const noexcept -> const ExecutorDrawStats & {
+    return draw_stats_;
+  }
+
   void beginPass(const FramebufferSet &framebufferSet,
                  const pipeline::RenderPass &renderPass,
                  const RenderPassBeginDesc &desc);
   void endPass();
+  void barrier(const ImageBarrierBatch &batch);
+  // buffer hazards between passes that are not tracked by the render graph,
+  // e.g. a compute pass writing draw commands for a later raster pass
+  void memoryBarrier(VkPipelineStageFlags srcStageMask,
+                     VkAccessFlags srcAccessMask,
+                     VkPipelineStageFlags dstStageMask,
+                     VkAccessFlags dstAccessMask);
+  void fillBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                  uint32_t data);
+  // compute work recorded between render passes of the frame
+  void bindComputePipeline(VkPipeline pipeline, VkPipelineLayout layout,
+                           VkDescriptorSet descriptorSet);
+  void dispatch(uint32_t groupCountX, uint32_t groupCountY = 1,
+                uint32_t groupCountZ = 1);
+
+  // chunks a draw list should be recorded in, 0 to record it inline; a pass
+  // that gets chunks begins with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+  [[nodiscard]] auto parallelChunks(uint32_t drawCount) const noexcept
+      -> uint32_t;
+  // runs record(chunk) on the worker threads, each chunk into its own
+  // secondary buffer, and executes them in chunk order in the current pass;
+  // the draw helpers below target the chunk's buffer while it records
+  void recordParallel(uint32_t chunkCount,
+                      const std::function<void(uint32_t)> &record);
 
   void bindPipeline(VkPipeline pipeline, VkPipelineLayout pipelineLayout,
                     const std::vector<VkDescriptorSet> &descriptorSets);
+  // binds one set at setIndex, e.g. the scene's bindless table or a set
+  // with dynamic uniform slices
+  void bindDescriptorSet(VkPipelineLayout pipelineLayout, uint32_t setIndex,
+                         VkDescriptorSet descriptorSet,
+                         std::initializer_list<uint32_t> dynamicOffsets = {});
+  // adds a pass's culling results to this frame's draw stats
+  void recordCulling(const scene::CullStats &stats);
+  void pushConstants(VkPipelineLayout pipelineLayout,
+                     VkShaderStageFlags stageFlags, uint32_t offset,
+                     uint32_t size, const void *data);
   void setViewportAndScissor(VkExtent2D extent);
 
   void drawIndexed(const scene::IVertexBuffer &vertexBuffer,
                    const scene::IndexBuffer &indexBuffer);
+  void drawIndexedInstanced(const scene::IVertexBuffer &vertexBuffer,
+                            const scene::IndexBuffer &indexBuffer,
+                            const InstanceBinding &instances,
+                            uint32_t instanceCount, uint32_t firstInstance = 0);
+  void drawIndexedIndirect(const scene::IVertexBuffer &vertexBuffer,
+                           const scene::IndexBuffer &indexBuffer,
+                           const InstanceBinding &instances,
+                           VkBuffer drawBuffer, VkDeviceSize drawOffset,
+                           uint32_t drawCount);
+  // the draw count is read from countBuffer on the GPU; devices without
+  // VK_KHR_draw_indirect_count run all maxDrawCount commands, so the unused
+  // tail has to hold empty commands
+  void drawIndexedIndirectCount(const scene::IVertexBuffer &vertexBuffer,
+                                const scene::IndexBuffer &indexBuffer,
+                                const InstanceBinding &instances,
+                                VkBuffer drawBuffer, VkDeviceSize drawOffset,
+                                VkBuffer countBuffer, VkDeviceSize countOffset,
+                                uint32_t maxDrawCount);
   void drawGeometry();
   void drawFullscreenTriangle();
   void drawUI(ui::UI &ui);
@@ -92,20 +237,40 @@ private:
   scene::Scene &scene_;
   core::CommandBuffers &command_buffers_;
   Profiler *profiler_{nullptr};
+  ParallelRecorder *recorder_{nullptr};
 
   // state
   uint32_t current_frame_{0};
   uint32_t image_index_{0};
   uint32_t frame_index_{0};
+  uint32_t headless_image_cursor_{0};
+  uint32_t last_presented_image_{0};
   VkCommandBuffer command_buffer_{VK_NULL_HANDLE};
   bool frame_active_{false};
   bool frame_submitted_{false};
   bool frame_presented_{false};
   bool swapchain_out_of_date_{false};
+  ExecutorDrawStats draw_stats_{};
+  ExecutorBindState bind_state_{};
+  VkRenderPass active_render_pass_{VK_NULL_HANDLE};
+  VkFramebuffer active_framebuffer_{VK_NULL_HANDLE};
+  VkSubpassContents active_contents_{VK_SUBPASS_CONTENTS_INLINE};
+  std::vector<std::pair<core::TimelinePoint, VkPipelineStageFlags>>
+      pending_waits_{};
+  core::TimelinePoint last_submission_{};
+  std::vector<uint64_t> frame_epochs_{};
+  uint32_t deletion_submitter_{0};
 
   // helpers
   void ensureFrameActive(const char *op) const;
   void ensureFrameInactive(const char *op) const;
+  void ensurePrimary(const char *op) const;
+  [[nodiscard]] auto activeCommandBuffer() const -> VkCommandBuffer;
+  [[nodiscard]] auto activeDrawStats() -> ExecutorDrawStats &;
+  [[nodiscard]] auto activeBindState() -> ExecutorBindState &;
+  void bindGeometry(const scene::IVertexBuffer &vertexBuffer,
+                    const scene::IndexBuffer &indexBuffer,
+                    const InstanceBinding *instances);
 
   auto acquireNextImage(uint32_t &imageIndex) -> bool;
   void submitCommandBuffer();
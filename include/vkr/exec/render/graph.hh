@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vkr/exec/pass.hh"
+#include "vkr/exec/pass_creation.hh"
 #include <functional>
 #include <memory>
 #include <optional>
@@ -15,11 +16,28 @@
 
 namespace vkr::exec {
 
+class Executor;
 class UiPass;
 
+// barriers the graph recorded for the last fully recorded frame
+struct RenderGraphBarrierStats {
+  uint32_t pipelineBarriers{0};
+  uint32_t imageBarriers{0};
+  uint32_t layoutTransitions{0};
+  uint32_t skippedAccesses{0};
+};
+
+// transient attachments before and after packing into shared memory
+struct RenderGraphAttachmentStats {
+  uint32_t attachments{0};
+  uint32_t slots{0};
+  VkDeviceSize unaliasedBytes{0};
+  VkDeviceSize aliasedBytes{0};
+};
+
 class RenderGraph {
 public:
-  RenderGraph() = default;
+  explicit RenderGraph(Executor &executor) : executor_(executor) {}
   ~RenderGraph() { destroy(); }
 
   RenderGraph(const RenderGraph &) = delete;
@@ -40,12 +58,33 @@ public:
   void addDependency(std::string producer, std::string consumer);
 
   void compile();
+  // pipelines of all passes build concurrently unless parallel creation is
+  // turned off; create() returns once every one of them is ready
   void create();
   void destroy();
+  // follows a swapchain extent change; pipelines, render passes and
+  // descriptor layouts survive, attachments and framebuffers are rebuilt
+  void resize(VkExtent2D previous, VkExtent2D extent);
   void record();
   void present();
   void afterFrame();
 
+  void parallelCreate(bool enabled) noexcept { parallel_create_ = enabled; }
+
+  [[nodiscard]] auto createStats() const noexcept -> const GraphCreateStats & {
+    return create_stats_;
+  }
+
+  [[nodiscard]] auto barrierStats() const noexcept
+      -> const RenderGraphBarrierStats & {
+    return barrier_stats_;
+  }
+
+  [[nodiscard]] auto attachmentStats() const noexcept
+      -> const RenderGraphAttachmentStats & {
+    return attachment_stats_;
+  }
+
   [[nodiscard]] auto passes() -> std::vector<std::reference_wrapper<Pass>>;
   [[nodiscard]] auto passes() const
       -> std::vector<std::reference_wrapper<const Pass>>;
@@ -78,6 +117,9 @@ public:
   }
 
 private:
+  // dependencies
+  Executor &executor_;
+
   // components
   std::vector<std::unique_ptr<Pass>> passes_{};
   std::unordered_map<std::string, size_t> pass_indices_{};
@@ -88,9 +130,20 @@ private:
   std::vector<std::vector<size_t>> compiled_dependencies_{};
   std::vector<size_t> ordered_passes_{};
 
+  std::vector<core::MemoryAllocation> transient_slots_{};
+  std::vector<std::vector<size_t>> pass_transient_slots_{};
+
   // states
   bool dirty_{true};
   bool created_{false};
+  bool parallel_create_{true};
+  GraphCreateStats create_stats_{};
+  std::unordered_map<VkImage, ImageState> image_states_{};
+  std::unordered_map<VkImage, size_t> image_slots_{};
+  std::vector<VkImage> slot_owners_{};
+  RenderGraphAttachmentStats attachment_stats_{};
+  RenderGraphBarrierStats barrier_stats_{};
+  RenderGraphBarrierStats pending_barrier_stats_{};
 
   // helpers
   auto rebuildNameTable() -> void;
@@ -101,6 +154,13 @@ private:
   auto addCompiledDependency(size_t producer, size_t consumer) -> void;
   auto buildResourceDependencies() -> void;
 
+  auto planTransientAttachments() -> void;
+  auto bindTransientImages() -> void;
+  auto releaseTransientAttachments() -> void;
+  auto retireTransientSlots(std::vector<core::MemoryAllocation> slots) -> void;
+  auto resetImageStates() -> void;
+  auto recordBarriers(const Pass &pass) -> void;
+
   [[nodiscard]] auto passIndex(std::string_view name) const -> size_t;
 
   [[nodiscard]] static auto contains(const std::vector<std::string> &values,
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "vkr/core/command/pool.hh"
+#include "vkr/core/device.hh"
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vkr::exec {
+
+struct ParallelRecorderDesc {
+  // worker threads recording secondary command buffers; 0 records every pass
+  // serially into the primary command buffer
+  uint32_t threads{0};
+  // draw lists shorter than this stay on the primary buffer, longer ones are
+  // split into chunks of at least this many draws
+  uint32_t minDrawsPerChunk{256};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return minDrawsPerChunk > 0;
+  }
+
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("threads", threads);
+    ar("minDrawsPerChunk", minDrawsPerChunk);
+  }
+};
+
+using ParallelRecordTask = std::function<void(VkCommandBuffer, uint32_t)>;
+
+class ParallelRecorder {
+public:
+  ParallelRecorder(const core::Device &device,
+                   const core::CommandPool &commandPool,
+                   uint32_t framesInFlight, const ParallelRecorderDesc &desc);
+  ~ParallelRecorder();
+
+  ParallelRecorder(const ParallelRecorder &) = delete;
+  auto operator=(const ParallelRecorder &) -> ParallelRecorder & = delete;
+
+  // recycles the secondary buffers of a frame whose fence has signalled
+  void beginFrame(uint32_t frameIndex);
+
+  // records taskCount secondary buffers inside the inherited render pass and
+  // returns them in task order once every worker is done
+  [[nodiscard]] auto record(const VkCommandBufferInheritanceInfo &inheritance,
+                            uint32_t taskCount, const ParallelRecordTask &task)
+      -> std::vector<VkCommandBuffer>;
+
+  // chunks a draw list of drawCount draws should be split into, 0 when it
+  // should stay on the primary buffer
+  [[nodiscard]] auto chunkCount(uint32_t drawCount) const noexcept
+      -> uint32_t;
+
+  [[nodiscard]] auto threadCount() const noexcept -> uint32_t {
+    return static_cast<uint32_t>(workers_.size());
+  }
+
+  [[nodiscard]] auto desc() const noexcept -> const ParallelRecorderDesc & {
+    return desc_;
+  }
+
+private:
+  struct ThreadPool {
+    VkCommandPool pool{VK_NULL_HANDLE};
+    std::vector<VkCommandBuffer> buffers{};
+    uint32_t used{0};
+  };
+
+  // dependencies
+  const core::Device &device_;
+
+  // components
+  ParallelRecorderDesc desc_{};
+  std::vector<std::vector<ThreadPool>> pools_{};
+  std::vector<std::thread> workers_{};
+
+  // state
+  std::mutex mutex_{};
+  std::condition_variable work_ready_{};
+  std::condition_variable work_done_{};
+  const ParallelRecordTask *task_{nullptr};
+  const VkCommandBufferInheritanceInfo *inheritance_{nullptr};
+  std::vector<VkCommandBuffer> results_{};
+  std::exception_ptr error_{};
+  uint64_t generation_{0};
+  uint32_t task_count_{0};
+  uint32_t next_task_{0};
+  uint32_t finished_tasks_{0};
+  uint32_t frame_index_{0};
+  bool stopping_{false};
+
+  // helpers
+  void workerLoop(uint32_t thread);
+  void recordTask(uint32_t thread, uint32_t task);
+  auto acquireBuffer(uint32_t thread) -> VkCommandBuffer;
+};
+
+} // namespace vkr::exec
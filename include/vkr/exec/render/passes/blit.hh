@@ -0,0 +1,40 @@
+#pragma once
+
+#include "vkr/core/swapchain.hh"
+#include "vkr/exec/pass.hh"
+#include "vkr/exec/render/executor.hh"
+#include "vkr/exec/render/passes/source.hh"
+
+namespace vkr::exec {
+
+// copies a source color target into the current swapchain image without a
+// render pass; stands in for the ui pass when rendering headless
+class BlitPass final : public Pass {
+public:
+  BlitPass(Executor &executor, const core::Swapchain &swapchain,
+           RenderPassSource source, VkFilter filter = VK_FILTER_LINEAR);
+  ~BlitPass() override = default;
+
+  BlitPass(const BlitPass &) = delete;
+  auto operator=(const BlitPass &) -> BlitPass & = delete;
+
+  void create() override {}
+  void destroy() override {}
+  void record() override;
+
+  [[nodiscard]] auto imageAccesses() const
+      -> std::vector<ImageAccess> override;
+  [[nodiscard]] auto sampledPasses() const
+      -> std::vector<const Pass *> override;
+
+private:
+  // dependencies
+  Executor &executor_;
+  const core::Swapchain &swapchain_;
+
+  // components
+  RenderPassSource source_;
+  VkFilter filter_{VK_FILTER_LINEAR};
+};
+
+} // namespace vkr::exec
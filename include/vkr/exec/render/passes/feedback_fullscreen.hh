@@ -313,6 +313,14 @@ public:
   void destroy() override;
   void update(const FeedbackFullscreenPassDesc &desc);
   void record() override;
+  auto awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> override;
+  void rescale(VkExtent2D previous, VkExtent2D extent) override;
+  void resize() override;
+
+  [[nodiscard]] auto imageAccesses() const
+      -> std::vector<ImageAccess> override;
+  [[nodiscard]] auto sampledPasses() const
+      -> std::vector<const Pass *> override;
 
   auto addSource(RenderPassSource source) -> FeedbackFullscreenPass &;
   auto setSources(std::vector<RenderPassSource> sources)
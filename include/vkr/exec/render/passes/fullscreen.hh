@@ -50,6 +50,11 @@ struct FullscreenPassDesc {
     return *this;
   }
 
+  auto addColorUsage(VkImageUsageFlags usage) -> FullscreenPassDesc & {
+    target.color.addUsage(usage);
+    return *this;
+  }
+
   auto sampledColor(bool enabled = true) -> FullscreenPassDesc & {
     target.sampledColor(enabled);
     return *this;
@@ -296,6 +301,17 @@ public:
   void destroy() override;
   void update(const FullscreenPassDesc &desc);
   void record() override;
+  auto awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> override;
+  void rescale(VkExtent2D previous, VkExtent2D extent) override;
+  void resize() override;
+
+  [[nodiscard]] auto imageAccesses() const
+      -> std::vector<ImageAccess> override;
+  [[nodiscard]] auto transientAttachments() const
+      -> std::vector<resource::ImageDesc> override;
+  [[nodiscard]] auto transientImages() const -> std::vector<VkImage> override;
+  [[nodiscard]] auto sampledPasses() const
+      -> std::vector<const Pass *> override;
 
   auto addSource(RenderPassSource source) -> FullscreenPass &;
   auto setSources(std::vector<RenderPassSource> sources) -> FullscreenPass &;
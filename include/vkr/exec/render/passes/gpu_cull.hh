@@ -0,0 +1,205 @@
+#pragma once
+
+#include "vkr/core/device.hh"
+#include "vkr/exec/pass.hh"
+#include "vkr/exec/render/executor.hh"
+#include "vkr/exec/render/passes/hiz.hh"
+#include "vkr/pipeline/compute_pipeline.hh"
+#include "vkr/pipeline/descriptors/layout.hh"
+#include "vkr/pipeline/descriptors/pool.hh"
+#include "vkr/pipeline/descriptors/set.hh"
+#include "vkr/resource/buffer/buffer.hh"
+#include "vkr/scene/camera.hh"
+#include "vkr/scene/culling.hh"
+#include "vkr/scene/scene.hh"
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vkr::exec {
+
+// one element of the objects storage buffer; the batch's mesh bounds are
+// placed with model, which the vertex shader reads back through
+// gl_InstanceIndex since every emitted command starts at its object
+struct GpuCullObject {
+  glm::mat4 model{1.0f};
+  uint32_t batch{0};
+  uint32_t padding[3]{};
+};
+
+// a mesh and how many of its objects may survive culling in one frame
+struct GpuCullBatchDesc {
+  std::string meshName{};
+  uint32_t maxObjects{0};
+};
+
+struct GpuCullPassDesc {
+  // scene storage buffer of GpuCullObject
+  std::string objects{};
+  const scene::Camera *camera{nullptr};
+  // added to every scaled bounding radius, see RasterCullingDesc::margin
+  float margin{0.0f};
+  std::vector<GpuCullBatchDesc> batches{};
+  // objects that pass the frustum are also tested against this pyramid of
+  // the previous frame's depth; objects it hides are skipped
+  const HiZPass *hiz{nullptr};
+
+  auto objectBuffer(std::string name) -> GpuCullPassDesc & {
+    objects = std::move(name);
+    return *this;
+  }
+
+  auto frustum(const scene::Camera &view, float boundsMargin = 0.0f)
+      -> GpuCullPassDesc & {
+    camera = &view;
+    margin = boundsMargin;
+    return *this;
+  }
+
+  auto batch(std::string meshName, uint32_t maxObjects) -> GpuCullPassDesc & {
+    batches.push_back(
+        {.meshName = std::move(meshName), .maxObjects = maxObjects});
+    return *this;
+  }
+
+  auto occlusion(const HiZPass &pyramid) noexcept -> GpuCullPassDesc & {
+    hiz = &pyramid;
+    return *this;
+  }
+};
+
+// tests every object against the camera frustum in a compute shader and
+// appends a VkDrawIndexedIndirectCommand per visible object to its batch's
+// range, counting them per batch; a RasterPass set to gpuCulled() draws each
+// batch with one indirect count call, so recording cost does not depend on
+// the number of objects
+class GpuCullPass final : public Pass {
+public:
+  GpuCullPass(Executor &executor, const core::Device &device,
+              scene::Scene &scene);
+  ~GpuCullPass() override;
+
+  GpuCullPass(const GpuCullPass &) = delete;
+  auto operator=(const GpuCullPass &) -> GpuCullPass & = delete;
+
+  void create() override;
+  void destroy() override;
+  void update(const GpuCullPassDesc &desc);
+  void record() override;
+  auto awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> override;
+
+  [[nodiscard]] auto desc() const noexcept -> const GpuCullPassDesc & {
+    return desc_;
+  }
+
+  [[nodiscard]] auto objectCount() const noexcept -> uint32_t {
+    return object_count_;
+  }
+
+  [[nodiscard]] auto batchCount() const noexcept -> uint32_t {
+    return static_cast<uint32_t>(desc_.batches.size());
+  }
+
+  // switches the Hi-Z test of a pass created with one on and off between
+  // frames, e.g. to compare GPU times
+  void occlusion(bool enabled) noexcept { occlusion_ = enabled; }
+  [[nodiscard]] auto occlusionEnabled() const noexcept -> bool {
+    return desc_.hiz != nullptr && occlusion_;
+  }
+
+  // counted by the shader and read back once the frame slot comes around
+  // again, so it trails recording by the frames in flight
+  [[nodiscard]] auto stats() const noexcept -> const scene::CullStats & {
+    return stats_;
+  }
+
+  // valid from this frame's record() until the next one
+  [[nodiscard]] auto batchMesh(uint32_t batch) const -> scene::IMesh &;
+  [[nodiscard]] auto commandBuffer(uint32_t frameIndex) const -> VkBuffer;
+  [[nodiscard]] auto commandOffset(uint32_t batch) const -> VkDeviceSize;
+  [[nodiscard]] auto countBuffer(uint32_t frameIndex) const -> VkBuffer;
+  [[nodiscard]] auto countOffset(uint32_t batch) const -> VkDeviceSize;
+
+private:
+  // mirrors the shader's Batch struct
+  struct BatchData {
+    glm::vec4 sphere{0.0f, 0.0f, 0.0f, -1.0f};
+    uint32_t indexCount{0};
+    uint32_t firstIndex{0};
+    int32_t vertexOffset{0};
+    uint32_t firstCommand{0};
+    uint32_t maxCommands{0};
+    uint32_t padding[3]{};
+  };
+
+  struct PushConstants {
+    glm::vec4 planes[6]{};
+    uint32_t objectCount{0};
+    uint32_t batchCount{0};
+    float margin{0.0f};
+  };
+
+  // mirrors the shader's Occlusion block; a zero level count skips the test
+  struct OcclusionData {
+    glm::mat4 viewProjection{1.0f};
+    uint32_t levelCount{0};
+    uint32_t padding[3]{};
+    glm::uvec4 levels[HiZPass::kMaxLevels]{};
+  };
+
+  struct StatsData {
+    uint32_t visible{0};
+    uint32_t frustumCulled{0};
+    uint32_t occluded{0};
+    uint32_t overflowed{0};
+  };
+
+  struct FrameBuffers {
+    std::unique_ptr<resource::Buffer> batches{};
+    std::unique_ptr<resource::Buffer> commands{};
+    std::unique_ptr<resource::Buffer> counts{};
+    std::unique_ptr<resource::Buffer> occlusion{};
+    std::unique_ptr<resource::Buffer> stats{};
+    uint64_t batchVersion{UINT64_MAX};
+    uint64_t batchRevision{UINT64_MAX};
+    VkBuffer pyramid{VK_NULL_HANDLE};
+    bool recorded{false};
+  };
+
+  // dependencies
+  Executor &executor_;
+  const core::Device &device_;
+  scene::Scene &scene_;
+
+  // components
+  GpuCullPassDesc desc_{};
+  std::shared_ptr<resource::Buffer> objects_{};
+  std::vector<FrameBuffers> frames_{};
+  std::unique_ptr<pipeline::DescriptorPool> descriptor_pool_{};
+  std::unique_ptr<pipeline::DescriptorSetLayout> descriptor_layout_{};
+  std::unique_ptr<pipeline::DescriptorSets> descriptor_sets_{};
+  std::unique_ptr<pipeline::ComputePipeline> pipeline_{};
+
+  // states
+  uint32_t object_count_{0};
+  uint32_t command_count_{0};
+  std::vector<uint32_t> first_commands_{};
+  std::vector<scene::MeshHandle> mesh_handles_{};
+  std::vector<scene::IMesh *> meshes_{};
+  std::vector<BatchData> batch_data_{};
+  bool occlusion_{true};
+  scene::CullStats stats_{};
+
+  // helpers
+  void createBuffers();
+  void createDescriptors();
+  void createPipeline();
+  void resolveMeshes();
+  void writeBatches(FrameBuffers &frame);
+  void writeOcclusion(uint32_t frameIndex);
+  void readStats(FrameBuffers &frame);
+};
+
+} // namespace vkr::exec
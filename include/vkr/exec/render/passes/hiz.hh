@@ -0,0 +1,100 @@
+#pragma once
+
+#include "vkr/core/device.hh"
+#include "vkr/exec/pass.hh"
+#include "vkr/exec/render/executor.hh"
+#include "vkr/exec/render/passes/source.hh"
+#include "vkr/pipeline/compute_pipeline.hh"
+#include "vkr/pipeline/descriptors/layout.hh"
+#include "vkr/pipeline/descriptors/pool.hh"
+#include "vkr/pipeline/descriptors/set.hh"
+#include "vkr/resource/buffer/buffer.hh"
+#include "vkr/scene/camera.hh"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace vkr::exec {
+
+// one mip of the pyramid, stored row-major at offset floats into the buffer
+struct HiZLevel {
+  uint32_t width{0};
+  uint32_t height{0};
+  uint32_t offset{0};
+};
+
+// reduces the source's depth attachment into a pyramid of farthest depths,
+// each level half the size of the one above, starting at half the depth
+// resolution. The pyramid lives in a storage buffer rather than a mipped
+// image, so levels need only memory barriers and no per-level views. It is
+// read during the next frame together with the view-projection it was
+// rendered with; the source target needs a sampled depth attachment.
+class HiZPass final : public Pass {
+public:
+  static constexpr uint32_t kMaxLevels = 16;
+
+  HiZPass(Executor &executor, const core::Device &device,
+          RenderPassSource source, const scene::Camera &camera);
+  ~HiZPass() override;
+
+  HiZPass(const HiZPass &) = delete;
+  auto operator=(const HiZPass &) -> HiZPass & = delete;
+
+  void create() override;
+  void destroy() override;
+  void record() override;
+  auto awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> override;
+
+  [[nodiscard]] auto imageAccesses() const
+      -> std::vector<ImageAccess> override;
+  [[nodiscard]] auto sampledPasses() const
+      -> std::vector<const Pass *> override;
+
+  // false until the first pyramid since create() has been recorded
+  [[nodiscard]] auto ready() const noexcept -> bool { return ready_; }
+
+  [[nodiscard]] auto pyramid() const -> VkBuffer;
+  [[nodiscard]] auto levels() const noexcept -> const std::vector<HiZLevel> & {
+    return levels_;
+  }
+
+  [[nodiscard]] auto viewProjection() const noexcept -> const glm::mat4 & {
+    return view_projection_;
+  }
+
+private:
+  struct PushConstants {
+    uint32_t srcWidth{0};
+    uint32_t srcHeight{0};
+    uint32_t srcOffset{0};
+    uint32_t dstWidth{0};
+    uint32_t dstHeight{0};
+    uint32_t dstOffset{0};
+    uint32_t fromDepth{0};
+  };
+
+  // dependencies
+  Executor &executor_;
+  const core::Device &device_;
+  RenderPassSource source_;
+  const scene::Camera &camera_;
+
+  // components
+  std::unique_ptr<resource::Buffer> pyramid_{};
+  std::unique_ptr<pipeline::DescriptorPool> descriptor_pool_{};
+  std::unique_ptr<pipeline::DescriptorSetLayout> descriptor_layout_{};
+  std::unique_ptr<pipeline::DescriptorSets> descriptor_sets_{};
+  std::unique_ptr<pipeline::ComputePipeline> pipeline_{};
+
+  // states
+  std::vector<HiZLevel> levels_{};
+  glm::mat4 view_projection_{1.0f};
+  bool ready_{false};
+
+  // helpers
+  void createLevels();
+  void createDescriptors();
+  void createPipeline();
+};
+
+} // namespace vkr::exec
@@ -14,6 +14,9 @@ public:
   void record() override;
   void present() override;
 
+  [[nodiscard]] auto imageAccesses() const
+      -> std::vector<ImageAccess> override;
+
   [[nodiscard]] auto presentsToSwapchain() const noexcept -> bool override {
     return true;
   }
@@ -3,8 +3,11 @@
 #include "vkr/core/command/pool.hh"
 #include "vkr/core/device.hh"
 #include "vkr/exec/pass.hh"
+#include "vkr/exec/render/draw_commands.hh"
+#include "vkr/exec/render/draw_list.hh"
 #include "vkr/exec/render/executor.hh"
 #include "vkr/exec/render/frame_buffer_set.hh"
+#include "vkr/exec/render/passes/gpu_cull.hh"
 #include "vkr/exec/render/passes/input.hh"
 #include "vkr/exec/render/passes/source.hh"
 #include "vkr/exec/render/targets/offscreen.hh"
@@ -13,6 +16,9 @@
 #include "vkr/pipeline/descriptors/set.hh"
 #include "vkr/pipeline/graphics_pipeline.hh"
 #include "vkr/pipeline/render_pass.hh"
+#include "vkr/resource/buffer/buffer.hh"
+#include "vkr/scene/camera.hh"
+#include "vkr/scene/culling.hh"
 #include "vkr/scene/scene.hh"
 #include <memory>
 #include <string>
@@ -21,6 +27,46 @@
 
 namespace vkr::exec {
 
+struct RasterInstanceBatchDesc {
+  std::string meshName{};
+  std::string instanceBufferName{};
+  uint32_t firstInstance{0};
+  // 0 draws every instance currently written for the frame
+  uint32_t instanceCount{0};
+};
+
+enum class DrawDataMode {
+  PushConstants,
+  // one aligned slice per draw in a per-frame buffer, selected by rebinding
+  // set 0 with a dynamic offset
+  DynamicUniform,
+};
+
+// feeds element i of a scene DrawDataStream to draw i of the mesh list
+struct RasterDrawDataDesc {
+  std::string stream{};
+  DrawDataMode mode{DrawDataMode::PushConstants};
+  VkShaderStageFlags stageFlags{VK_SHADER_STAGE_VERTEX_BIT};
+  // set 0 binding of the DynamicUniform slice
+  uint32_t binding{0};
+
+  [[nodiscard]] auto enabled() const noexcept -> bool {
+    return !stream.empty();
+  }
+};
+
+// tests each mesh's bounds against the camera frustum before recording and
+// orders the kept draws front to back; margin covers vertex offsets applied
+// in the shader that the bounds do not include
+struct RasterCullingDesc {
+  const scene::Camera *camera{nullptr};
+  float margin{0.0f};
+
+  [[nodiscard]] auto enabled() const noexcept -> bool {
+    return camera != nullptr;
+  }
+};
+
 struct RasterPassDesc {
   OffscreenTargetDesc target{};
   std::vector<pipeline::DescriptorBinding> descriptorBindings{};
@@ -28,6 +74,14 @@ struct RasterPassDesc {
   std::vector<VkClearValue> clearValues{};
   pipeline::GraphicsPipelineDesc graphicsPipeline{};
   std::vector<std::string> meshNames{};
+  std::vector<RasterInstanceBatchDesc> instanceBatches{};
+  bool indirect{true};
+  bool bindless{false};
+  RasterDrawDataDesc drawData{};
+  RasterCullingDesc culling{};
+  // draws the batches a GpuCullPass compacted this frame, one indirect count
+  // call each; instance index i reads object i of its objects buffer
+  const GpuCullPass *gpuCull{nullptr};
   std::vector<RenderPassInputDesc> inputs{};
 
   auto targetDesc(OffscreenTargetDesc desc) -> RasterPassDesc & {
@@ -100,6 +154,12 @@ struct RasterPassDesc {
     return *this;
   }
 
+  // binds the scene's bindless table at BindlessTable::kSet
+  auto bindlessResources(bool enabled = true) -> RasterPassDesc & {
+    bindless = enabled;
+    return *this;
+  }
+
   auto descriptorPoolDesc(pipeline::DescriptorPoolDesc desc)
       -> RasterPassDesc & {
     descriptorPool = std::move(desc);
@@ -130,6 +190,15 @@ struct RasterPassDesc {
                                   descriptorCount, stageFlags}});
   }
 
+  // a scene storage buffer, the same one for every frame in flight
+  auto storage(uint32_t binding, std::string name,
+               VkShaderStageFlags stageFlags = VK_SHADER_STAGE_VERTEX_BIT)
+      -> RasterPassDesc & {
+    return descriptor({.name = std::move(name),
+                       .layout = {binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                  1, stageFlags}});
+  }
+
   auto texture(uint32_t binding, std::string name,
                VkShaderStageFlags stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
                uint32_t descriptorCount = 1) -> RasterPassDesc & {
@@ -189,6 +258,49 @@ struct RasterPassDesc {
     return *this;
   }
 
+  auto instanced(std::string meshName, std::string instanceBufferName,
+                 uint32_t firstInstance = 0, uint32_t instanceCount = 0)
+      -> RasterPassDesc & {
+    instanceBatches.push_back({.meshName = std::move(meshName),
+                               .instanceBufferName =
+                                   std::move(instanceBufferName),
+                               .firstInstance = firstInstance,
+                               .instanceCount = instanceCount});
+    return *this;
+  }
+
+  auto clearInstanced() noexcept -> RasterPassDesc & {
+    instanceBatches.clear();
+    return *this;
+  }
+
+  auto perDrawData(std::string stream,
+                   DrawDataMode mode = DrawDataMode::PushConstants,
+                   VkShaderStageFlags stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+                   uint32_t binding = 0) -> RasterPassDesc & {
+    drawData = {.stream = std::move(stream),
+                .mode = mode,
+                .stageFlags = stageFlags,
+                .binding = binding};
+    return *this;
+  }
+
+  auto frustumCulling(const scene::Camera &camera, float margin = 0.0f)
+      -> RasterPassDesc & {
+    culling = {.camera = &camera, .margin = margin};
+    return *this;
+  }
+
+  auto gpuCulled(const GpuCullPass &pass) noexcept -> RasterPassDesc & {
+    gpuCull = &pass;
+    return *this;
+  }
+
+  auto indirectDraws(bool enabled = true) noexcept -> RasterPassDesc & {
+    indirect = enabled;
+    return *this;
+  }
+
   auto clearColor(float r, float g, float b, float a) -> RasterPassDesc & {
     clearValues.push_back(VkClearValue{.color = {{r, g, b, a}}});
     return *this;
@@ -360,11 +472,26 @@ public:
   void destroy() override;
   void update(const RasterPassDesc &desc);
   void record() override;
+  auto awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> override;
+  void rescale(VkExtent2D previous, VkExtent2D extent) override;
+  void resize() override;
+
+  [[nodiscard]] auto imageAccesses() const
+      -> std::vector<ImageAccess> override;
+  [[nodiscard]] auto transientAttachments() const
+      -> std::vector<resource::ImageDesc> override;
+  [[nodiscard]] auto transientImages() const -> std::vector<VkImage> override;
+  [[nodiscard]] auto sampledPasses() const
+      -> std::vector<const Pass *> override;
   auto addSource(RenderPassSource source) -> RasterPass &;
   auto setSources(std::vector<RenderPassSource> sources) -> RasterPass &;
 
   [[nodiscard]] auto target() -> OffscreenTarget &;
   [[nodiscard]] auto target() const -> const OffscreenTarget &;
+  // mesh list culling of the last recorded frame, empty without culling
+  [[nodiscard]] auto cullStats() const noexcept -> const scene::CullStats & {
+    return culler_.stats();
+  }
   [[nodiscard]] auto target(uint32_t) -> OffscreenTarget & { return target(); }
   [[nodiscard]] auto target(uint32_t) const -> const OffscreenTarget & {
     return target();
@@ -389,6 +516,14 @@ public:
   }
 
 private:
+  struct InstanceBatch {
+    scene::IMesh *mesh{nullptr};
+    scene::IInstanceBuffer *instances{nullptr};
+    InstanceBinding binding{};
+    uint32_t firstCommand{0};
+    uint32_t commandCount{0};
+  };
+
   // dependencies
   Executor &executor_;
   const core::Device &device_;
@@ -403,22 +538,60 @@ private:
   std::unique_ptr<pipeline::DescriptorPool> descriptor_pool_{};
   std::unique_ptr<pipeline::DescriptorSetLayout> descriptor_layout_{};
   std::unique_ptr<pipeline::DescriptorSets> descriptor_sets_{};
+  std::unique_ptr<pipeline::DescriptorSetLayout> empty_layout_{};
   std::unique_ptr<pipeline::GraphicsPipeline> pipeline_{};
   std::unique_ptr<pipeline::GraphicsPipeline> mesh_grid_pipeline_{};
   std::unique_ptr<scene::IndexBuffer> mesh_grid_index_buffer_{};
-  std::string mesh_grid_name_{};
+  std::unique_ptr<DrawCommandBuffer> draw_commands_{};
+  std::shared_ptr<scene::DrawDataStream> draw_data_{};
+  std::unique_ptr<resource::Buffer> draw_data_buffer_{};
+  VkDeviceSize draw_data_slice_{0};
   std::vector<RenderPassSource> sources_{};
 
+  // states
+  // scene handles resolved at create(); recording never looks up names
+  std::vector<scene::MeshHandle> mesh_handles_{};
+  std::vector<scene::MeshHandle> batch_meshes_{};
+  std::vector<scene::InstanceBufferHandle> batch_instances_{};
+  scene::MeshHandle mesh_grid_mesh_{};
+  size_t mesh_grid_draw_{0};
+  // mesh draws in sort-key order, rebuilt when the scene version changes or,
+  // with culling, every frame from the visible meshes
+  DrawList draw_list_{};
+  uint64_t draw_list_version_{UINT64_MAX};
+  // sum of the listed meshes' revisions; in-place edits move the culled
+  // bounds without changing the scene version
+  uint64_t bounds_revision_{UINT64_MAX};
+  scene::FrustumCuller culler_{};
+  std::vector<uint32_t> visible_draws_{};
+  // reused across frames so recording does not allocate
+  std::vector<InstanceBatch> batches_{};
+  std::vector<VkDrawIndexedIndirectCommand> batch_commands_{};
+
   // helpers
   void createTarget();
   void createRenderPass();
   void createFramebuffers();
   void createDescriptors();
   void createPipeline();
+  void createDrawData();
+  void resolveSceneHandles();
 
+  [[nodiscard]] auto bindlessSetLayouts() -> std::vector<VkDescriptorSetLayout>;
+  void bindBindlessTable(VkPipelineLayout layout);
   [[nodiscard]] auto createDescriptorWrites() const
       -> std::vector<pipeline::DescriptorSetWriteDesc>;
   [[nodiscard]] auto descriptorPoolDesc() const -> pipeline::DescriptorPoolDesc;
+  [[nodiscard]] auto dynamicDrawData() const noexcept -> bool;
+  [[nodiscard]] auto drawDataBinding() const -> pipeline::DescriptorBinding;
+  void bindDrawData(VkPipelineLayout layout, size_t drawIndex);
+  [[nodiscard]] auto resolveMesh(size_t index) -> scene::IMesh &;
+  void sortDraws();
+  [[nodiscard]] auto boundsRevision() const -> uint64_t;
+  void cullDraws();
+  void recordMeshes(size_t begin, size_t end);
+  void recordInstanceBatches();
+  void recordGpuCulledBatches();
   void syncSelectedMeshGrid();
   void recordSelectedMeshGrid(const std::vector<VkDescriptorSet> &sets);
 };
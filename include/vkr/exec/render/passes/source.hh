@@ -1,5 +1,6 @@
 #pragma once
 
+#include "vkr/exec/pass.hh"
 #include "vkr/exec/render/targets/offscreen.hh"
 #include <functional>
 #include <variant>
@@ -19,6 +20,7 @@ struct RenderPassSource {
   explicit RenderPassSource(FullscreenPass &source);
   explicit RenderPassSource(FeedbackFullscreenPass &source);
 
+  [[nodiscard]] auto pass() const -> const Pass &;
   [[nodiscard]] auto target() -> OffscreenTarget &;
   [[nodiscard]] auto target() const -> const OffscreenTarget &;
   [[nodiscard]] auto target(uint32_t frameIndex) -> OffscreenTarget &;
@@ -42,6 +42,12 @@ public:
   void create() override;
   void destroy() override;
   void record() override;
+  void resize() override;
+
+  [[nodiscard]] auto imageAccesses() const
+      -> std::vector<ImageAccess> override;
+  [[nodiscard]] auto sampledPasses() const
+      -> std::vector<const Pass *> override;
 
   [[nodiscard]] auto shouldClose() const noexcept -> bool {
     return ui_ && ui_->shouldClose();
@@ -93,6 +99,9 @@ private:
   std::unique_ptr<FramebufferSet> framebuffers_{};
   std::unique_ptr<pipeline::DescriptorPool> descriptor_pool_{};
   std::unique_ptr<ui::UI> ui_{};
+
+  // helpers
+  void createFramebuffers();
 };
 
 } // namespace vkr::exec
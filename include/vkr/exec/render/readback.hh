@@ -0,0 +1,36 @@
+#pragma once
+
+#include "vkr/core/command/pool.hh"
+#include "vkr/core/device.hh"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace vkr::exec {
+
+struct ImageReadback {
+  uint32_t width{0};
+  uint32_t height{0};
+  VkFormat format{VK_FORMAT_UNDEFINED};
+  // tightly packed RGBA8 rows, swizzled from BGRA when needed
+  std::vector<uint8_t> pixels{};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return width != 0 && height != 0 &&
+           pixels.size() == static_cast<size_t>(width) * height * 4;
+  }
+};
+
+// copies a 4-byte color image back to the host and blocks until it lands;
+// the image must have TRANSFER_SRC usage and be idle on the GPU
+[[nodiscard]] auto readbackImage(const core::Device &device,
+                                 const core::CommandPool &commandPool,
+                                 VkImage image, VkImageLayout layout,
+                                 VkFormat format, VkExtent2D extent)
+    -> ImageReadback;
+
+auto writePng(const std::filesystem::path &path, const ImageReadback &image)
+    -> bool;
+
+} // namespace vkr::exec
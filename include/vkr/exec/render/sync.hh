@@ -3,6 +3,7 @@
 #include "vkr/core/command/buffers.hh"
 #include "vkr/core/device.hh"
 #include "vkr/core/swapchain.hh"
+#include "vkr/core/sync/timeline.hh"
 #include <cstdint>
 
 namespace vkr::exec {
@@ -36,11 +37,21 @@ public:
       -> VkSemaphore;
   [[nodiscard]] auto renderFinishedSemaphore(uint32_t imageIndex) const
       -> VkSemaphore;
+  // VK_NULL_HANDLE when frames are tracked on the graphics queue timeline
   [[nodiscard]] auto inFlightFence(uint32_t frameIndex) const -> VkFence;
   [[nodiscard]] auto framesInFlight() const noexcept -> uint32_t {
     return command_buffers_.size();
   }
 
+  [[nodiscard]] auto timelineEnabled() const noexcept -> bool {
+    return timeline_ != nullptr;
+  }
+  [[nodiscard]] auto timeline() const -> core::TimelineSemaphore &;
+
+  // takes the graphics timeline value the frame's submission signals
+  [[nodiscard]] auto signalFrame(uint32_t frameIndex) -> core::TimelinePoint;
+  [[nodiscard]] auto isFrameComplete(uint32_t frameIndex) const -> bool;
+
   void waitForFrame(uint32_t frameIndex) const;
   void resetFrame(uint32_t frameIndex) const;
   void recreate();
@@ -55,6 +66,10 @@ private:
   std::vector<VkSemaphore> vk_image_available_semaphores_{};
   std::vector<VkSemaphore> vk_render_finished_semaphores_{};
   std::vector<VkFence> vk_in_flight_fences_{};
+  core::TimelineSemaphore *timeline_{nullptr};
+
+  // state
+  std::vector<uint64_t> frame_values_{};
 
   void create();
   void destroy();
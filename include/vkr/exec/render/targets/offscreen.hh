@@ -2,10 +2,13 @@
 
 #include "vkr/core/command/pool.hh"
 #include "vkr/core/device.hh"
+#include "vkr/exec/image_access.hh"
 #include "vkr/exec/render/attachments/color.hh"
 #include "vkr/exec/render/attachments/depth.hh"
+#include "vkr/exec/render/passes/input.hh"
 #include <optional>
 #include <utility>
+#include <vector>
 
 namespace vkr::exec {
 
@@ -71,6 +74,44 @@ struct OffscreenTargetDesc {
     return *this;
   }
 
+  // binds the attachments to graph-owned memory, in imageDescs() order;
+  // invalid entries keep their own allocation
+  auto aliasMemory(const std::vector<core::MemoryAllocation> &memory)
+      -> OffscreenTargetDesc & {
+    size_t index = 0;
+    if (colorEnabled && index < memory.size()) {
+      if (memory[index].isValid()) {
+        color.memory = memory[index];
+      }
+      ++index;
+    }
+
+    if (depth && index < memory.size() && memory[index].isValid()) {
+      depth->memory = memory[index];
+    }
+
+    return *this;
+  }
+
+  // attachments sized from the previous swapchain extent follow it to the new
+  // one; fixed-size attachments such as shadow maps keep their size
+  auto rescale(VkExtent2D previous, VkExtent2D extent) noexcept
+      -> OffscreenTargetDesc & {
+    const auto follow = [&](uint32_t &width, uint32_t &height) {
+      if (width == previous.width && height == previous.height) {
+        width = extent.width;
+        height = extent.height;
+      }
+    };
+
+    follow(color.width, color.height);
+    if (depth) {
+      follow(depth->width, depth->height);
+    }
+
+    return *this;
+  }
+
   [[nodiscard]] auto hasColor() const noexcept -> bool { return colorEnabled; }
 
   [[nodiscard]] auto hasDepth() const noexcept -> bool {
@@ -85,6 +126,20 @@ struct OffscreenTargetDesc {
     return colorEnabled ? color.height : (depth ? depth->height : 0U);
   }
 
+  // images backing the enabled attachments, color first
+  [[nodiscard]] auto imageDescs() const -> std::vector<resource::ImageDesc> {
+    std::vector<resource::ImageDesc> descs{};
+    if (colorEnabled) {
+      descs.push_back(color.imageDesc());
+    }
+
+    if (depth) {
+      descs.push_back(depth->imageDesc());
+    }
+
+    return descs;
+  }
+
   [[nodiscard]] static auto colorOnly(uint32_t width, uint32_t height,
                                       VkFormat format) -> OffscreenTargetDesc {
     OffscreenTargetDesc desc{};
@@ -183,6 +238,16 @@ public:
 
   [[nodiscard]] auto attachmentViews() const -> std::vector<VkImageView>;
 
+  // images in OffscreenTargetDesc::imageDescs() order
+  [[nodiscard]] auto images() const -> std::vector<VkImage>;
+
+  // accesses of a render pass that clears and draws into this target
+  [[nodiscard]] auto attachmentAccesses() const -> std::vector<ImageAccess>;
+
+  // access of a pass sampling this target, in the layout it is bound with
+  [[nodiscard]] auto sampledAccess(RenderPassInputKind kind) const
+      -> ImageAccess;
+
 private:
   // dependencies
   const core::Device &device_;
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace vkr::pipeline {
+
+// outcome of the most recent pipeline rebuild; request ids come from
+// update()/updateAsync() and grow monotonically per pipeline
+struct PipelineBuildStatus {
+  uint64_t request{0};
+  bool ok{true};
+  std::string error{};
+  double milliseconds{0.0};
+
+  [[nodiscard]] auto covers(uint64_t id) const noexcept -> bool {
+    return request >= id;
+  }
+};
+
+} // namespace vkr::pipeline
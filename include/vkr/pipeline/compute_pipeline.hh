@@ -1,9 +1,12 @@
 #pragma once
 
 #include "vkr/core/device.hh"
+#include "vkr/pipeline/build_status.hh"
 #include "vkr/resource/shader/module.hh"
 #include <cstdint>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -36,6 +39,19 @@ public:
   void destroy();
   auto update(const ComputePipelineDesc &desc) -> bool;
 
+  // see GraphicsPipeline::updateAsync
+  auto updateAsync(const ComputePipelineDesc &desc) -> uint64_t;
+  auto commitPending() -> bool;
+  auto waitPending() -> bool;
+
+  [[nodiscard]] auto building() const noexcept -> bool {
+    return pending_build_.valid() || queued_build_.has_value();
+  }
+
+  [[nodiscard]] auto lastBuild() const noexcept -> const PipelineBuildStatus & {
+    return last_build_;
+  }
+
   [[nodiscard]] auto desc() const noexcept -> const ComputePipelineDesc & {
     return desc_;
   }
@@ -64,19 +80,39 @@ public:
   [[nodiscard]] auto revision() const noexcept -> uint64_t { return revision_; }
 
 private:
-  struct RetiredPipeline {
-    VkPipeline pipeline{VK_NULL_HANDLE};
-    VkPipelineLayout layout{VK_NULL_HANDLE};
-  };
-
   const core::Device &device_;
 
   ComputePipelineDesc desc_{};
   std::unique_ptr<resource::ShaderModule> shader_module_{};
   VkPipelineLayout vk_pipeline_layout_{VK_NULL_HANDLE};
   VkPipeline vk_compute_pipeline_{VK_NULL_HANDLE};
-  std::vector<RetiredPipeline> retired_pipelines_{};
   uint64_t revision_{0};
+
+  struct Build {
+    uint64_t request{0};
+    ComputePipelineDesc desc{};
+    std::unique_ptr<resource::ShaderModule> shaderModule{};
+    VkPipelineLayout layout{VK_NULL_HANDLE};
+    VkPipeline pipeline{VK_NULL_HANDLE};
+    double milliseconds{0.0};
+    std::string error{};
+  };
+
+  struct QueuedBuild {
+    uint64_t request{0};
+    ComputePipelineDesc desc{};
+  };
+
+  std::future<Build> pending_build_{};
+  std::optional<QueuedBuild> queued_build_{};
+  uint64_t next_request_{0};
+  PipelineBuildStatus last_build_{};
+
+  [[nodiscard]] auto build(const ComputePipelineDesc &desc) const -> Build;
+  void launch(QueuedBuild request);
+  void commit(Build &&next);
+  void discard(Build &next) const;
+  void retire(VkPipeline pipeline, VkPipelineLayout layout) const;
 };
 
 } // namespace vkr::pipeline
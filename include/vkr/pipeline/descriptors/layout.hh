@@ -7,6 +7,10 @@ namespace vkr::pipeline {
 
 struct DescriptorSetLayoutDesc {
   std::vector<DescriptorBinding> bindings{};
+  VkDescriptorSetLayoutCreateFlags flags{0};
+  // per-binding descriptor indexing flags, same order as bindings; empty
+  // leaves every binding at the default
+  std::vector<VkDescriptorBindingFlagsEXT> bindingFlags{};
 };
 
 class DescriptorSetLayout {
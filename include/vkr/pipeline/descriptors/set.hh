@@ -131,6 +131,12 @@ public:
   void create();
   void destroy();
   void update(const DescriptorSetsDesc &desc);
+  // writes new descriptors into the allocated sets; none of them may be in
+  // use by the GPU
+  void rewrite(std::vector<DescriptorSetWriteDesc> writes);
+  // applies writes on top of the current contents without keeping them in
+  // desc(); for update-after-bind sets that change a few slots at a time
+  void write(const std::vector<DescriptorSetWriteDesc> &writes);
 
   [[nodiscard]] auto desc() const noexcept -> const DescriptorSetsDesc & {
     return desc_;
@@ -164,6 +170,7 @@ private:
 
   void allocateSets();
   void updateDescriptors();
+  void updateDescriptors(const std::vector<DescriptorSetWriteDesc> &writes);
 };
 
 } // namespace vkr::pipeline
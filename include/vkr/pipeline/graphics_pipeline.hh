@@ -1,11 +1,14 @@
 #pragma once
 
 #include "vkr/core/device.hh"
+#include "vkr/pipeline/build_status.hh"
 #include "vkr/resource/shader/module.hh"
 #include "vkr/scene/geometry/vbos.hh"
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <future>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1494,6 +1497,24 @@ public:
   void destroy();
   auto update(const GraphicsPipelineDesc &desc) -> bool;
 
+  // compiles and creates the next revision on a worker thread; the current
+  // revision keeps rendering until commitPending() swaps the result in. A
+  // request made while another is building replaces any queued one.
+  auto updateAsync(const GraphicsPipelineDesc &desc) -> uint64_t;
+  // called at a frame boundary; true when a new revision was swapped in
+  auto commitPending() -> bool;
+  // blocks until the pending build and any request queued behind it have
+  // landed; same result as commitPending()
+  auto waitPending() -> bool;
+
+  [[nodiscard]] auto building() const noexcept -> bool {
+    return pending_build_.valid() || queued_build_.has_value();
+  }
+
+  [[nodiscard]] auto lastBuild() const noexcept -> const PipelineBuildStatus & {
+    return last_build_;
+  }
+
   [[nodiscard]] auto desc() const noexcept -> const GraphicsPipelineDesc & {
     return desc_;
   }
@@ -1523,11 +1544,6 @@ public:
   [[nodiscard]] auto revision() const noexcept -> uint64_t { return revision_; }
 
 private:
-  struct RetiredPipeline {
-    VkPipeline pipeline{VK_NULL_HANDLE};
-    VkPipelineLayout layout{VK_NULL_HANDLE};
-  };
-
   // dependencies
   const core::Device &device_;
   const RenderPass &render_pass_;
@@ -1537,8 +1553,35 @@ private:
   std::vector<std::unique_ptr<resource::ShaderModule>> shader_modules_{};
   VkPipelineLayout vk_pipeline_layout_{VK_NULL_HANDLE};
   VkPipeline vk_graphics_pipeline_{VK_NULL_HANDLE};
-  std::vector<RetiredPipeline> retired_pipelines_{};
   uint64_t revision_{0};
+
+  struct Build {
+    uint64_t request{0};
+    GraphicsPipelineDesc desc{};
+    std::vector<std::unique_ptr<resource::ShaderModule>> shaderModules{};
+    VkPipelineLayout layout{VK_NULL_HANDLE};
+    VkPipeline pipeline{VK_NULL_HANDLE};
+    double milliseconds{0.0};
+    std::string error{};
+  };
+
+  struct QueuedBuild {
+    uint64_t request{0};
+    GraphicsPipelineDesc desc{};
+  };
+
+  // states
+  std::future<Build> pending_build_{};
+  std::optional<QueuedBuild> queued_build_{};
+  uint64_t next_request_{0};
+  PipelineBuildStatus last_build_{};
+
+  // helpers
+  [[nodiscard]] auto build(const GraphicsPipelineDesc &desc) const -> Build;
+  void launch(QueuedBuild request);
+  void commit(Build &&next);
+  void discard(Build &next) const;
+  void retire(VkPipeline pipeline, VkPipelineLayout layout) const;
 };
 
 } // namespace vkr::pipeline
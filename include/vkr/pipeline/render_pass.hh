@@ -230,6 +230,20 @@ struct RenderPassDesc {
     return *this;
   }
 
+  // attachments stay in their subpass layout for the whole pass; transitions
+  // and external dependencies are recorded by the render graph instead
+  auto externalLayouts() noexcept -> RenderPassDesc & {
+    for (auto &color : colors) {
+      color.initialLayout = color.subpassLayout;
+      color.finalLayout = color.subpassLayout;
+    }
+
+    depth.initialLayout = depth.subpassLayout;
+    depth.finalLayout = depth.subpassLayout;
+    dependencies.clear();
+    return *this;
+  }
+
   [[nodiscard]] auto hasColor() const noexcept -> bool {
     return !colors.empty();
   }
@@ -26,7 +26,10 @@ public:
     return vk_buffer_;
   }
   [[nodiscard]] auto memory() const noexcept -> const VkDeviceMemory & {
-    return vk_memory_;
+    return allocation_.memory;
+  }
+  [[nodiscard]] auto memoryOffset() const noexcept -> VkDeviceSize {
+    return allocation_.offset;
   }
   [[nodiscard]] auto mapped() const noexcept -> void * { return mapped_; }
   [[nodiscard]] auto size() const noexcept -> VkDeviceSize { return size_; }
@@ -38,7 +41,7 @@ public:
     return memory_properties_;
   }
   [[nodiscard]] auto isValid() const noexcept -> bool {
-    return vk_buffer_ != VK_NULL_HANDLE && vk_memory_ != VK_NULL_HANDLE;
+    return vk_buffer_ != VK_NULL_HANDLE && allocation_.isValid();
   }
   [[nodiscard]] auto isMapped() const noexcept -> bool {
     return mapped_ != nullptr;
@@ -62,7 +65,7 @@ private:
 
   // components
   VkBuffer vk_buffer_{VK_NULL_HANDLE};
-  VkDeviceMemory vk_memory_{VK_NULL_HANDLE};
+  core::MemoryAllocation allocation_{};
   VkDeviceSize size_{0};
   VkBufferUsageFlags usage_{0};
   VkMemoryPropertyFlags memory_properties_{0};
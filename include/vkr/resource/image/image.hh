@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vkr/core/device.hh"
+#include <optional>
 #include <vulkan/vulkan.h>
 
 namespace vkr::resource {
@@ -25,6 +26,10 @@ struct ImageDesc {
   VkImageAspectFlags aspectMask{VK_IMAGE_ASPECT_COLOR_BIT};
   VkImageViewType defaultViewType{VK_IMAGE_VIEW_TYPE_2D};
 
+  // externally owned memory to bind instead of allocating; other images may
+  // alias the same range
+  std::optional<core::MemoryAllocation> memory{};
+
   [[nodiscard]] auto isValid() const noexcept -> bool {
     return width != 0 && height != 0 && depth != 0 && mipLevels != 0 &&
            arrayLayers != 0 && format != VK_FORMAT_UNDEFINED && usage != 0;
@@ -90,6 +95,11 @@ public:
   void destroy();
   void update(const ImageDesc &desc);
 
+  // requirements of an image created from desc, without keeping the image
+  [[nodiscard]] static auto memoryRequirements(const core::Device &device,
+                                               const ImageDesc &desc)
+      -> VkMemoryRequirements;
+
   [[nodiscard]] auto desc() const noexcept -> const ImageDesc & {
     return desc_;
   }
@@ -105,10 +115,16 @@ public:
 
   [[nodiscard]] auto image() const noexcept -> VkImage { return vk_image_; }
   [[nodiscard]] auto memory() const noexcept -> VkDeviceMemory {
-    return vk_memory_;
+    return allocation_.memory;
+  }
+  [[nodiscard]] auto memoryOffset() const noexcept -> VkDeviceSize {
+    return allocation_.offset;
   }
   [[nodiscard]] auto isValid() const noexcept -> bool {
-    return vk_image_ != VK_NULL_HANDLE && vk_memory_ != VK_NULL_HANDLE;
+    return vk_image_ != VK_NULL_HANDLE && allocation_.isValid();
+  }
+  [[nodiscard]] auto aliased() const noexcept -> bool {
+    return desc_.memory.has_value();
   }
 
 private:
@@ -119,7 +135,7 @@ private:
   ImageDesc desc_{};
   VkImageLayout layout_{VK_IMAGE_LAYOUT_UNDEFINED};
   VkImage vk_image_{VK_NULL_HANDLE};
-  VkDeviceMemory vk_memory_{VK_NULL_HANDLE};
+  core::MemoryAllocation allocation_{};
 
   // helpers
   void create();
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "vkr/core/device.hh"
+#include "vkr/pipeline/descriptors/layout.hh"
+#include "vkr/pipeline/descriptors/pool.hh"
+#include "vkr/pipeline/descriptors/set.hh"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vkr::scene {
+
+struct BindlessDesc {
+  uint32_t textureCapacity{1024};
+  uint32_t bufferCapacity{256};
+  VkShaderStageFlags stageFlags{VK_SHADER_STAGE_VERTEX_BIT |
+                                VK_SHADER_STAGE_FRAGMENT_BIT};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return textureCapacity > 0 && bufferCapacity > 0 && stageFlags != 0;
+  }
+};
+
+// one update-after-bind descriptor set shared by every pass: a sampler2D
+// array at binding 0 and a storage buffer array at binding 1. Slots are
+// handed out when a resource is registered and stay fixed for its lifetime,
+// so draws select resources by index instead of switching sets.
+class BindlessTable {
+public:
+  static constexpr uint32_t kSet = 1;
+  static constexpr uint32_t kTextureBinding = 0;
+  static constexpr uint32_t kBufferBinding = 1;
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  BindlessTable(const core::Device &device, const BindlessDesc &desc);
+  ~BindlessTable() = default;
+
+  BindlessTable(const BindlessTable &) = delete;
+  auto operator=(const BindlessTable &) -> BindlessTable & = delete;
+
+  [[nodiscard]] auto addTexture(VkDescriptorImageInfo image) -> uint32_t;
+  [[nodiscard]] auto addBuffer(VkDescriptorBufferInfo buffer) -> uint32_t;
+  // the slot is reused once the frames that may still sample it retire
+  void releaseTexture(uint32_t index);
+  void releaseBuffer(uint32_t index);
+
+  [[nodiscard]] auto desc() const noexcept -> const BindlessDesc & {
+    return desc_;
+  }
+
+  [[nodiscard]] auto layout() const noexcept -> VkDescriptorSetLayout {
+    return layout_->layout();
+  }
+
+  [[nodiscard]] auto set() const -> VkDescriptorSet { return sets_->set(0); }
+
+private:
+  // slots freed by the deletion queue, which may run after the table is gone
+  struct FreeSlots {
+    std::mutex mutex{};
+    std::vector<uint32_t> textures{};
+    std::vector<uint32_t> buffers{};
+  };
+
+  // dependencies
+  const core::Device &device_;
+
+  // components
+  BindlessDesc desc_{};
+  std::unique_ptr<pipeline::DescriptorPool> pool_{};
+  std::unique_ptr<pipeline::DescriptorSetLayout> layout_{};
+  std::unique_ptr<pipeline::DescriptorSets> sets_{};
+
+  // states
+  uint32_t next_texture_{0};
+  uint32_t next_buffer_{0};
+  std::shared_ptr<FreeSlots> free_slots_{std::make_shared<FreeSlots>()};
+
+  // helpers
+  [[nodiscard]] auto allocate(std::vector<uint32_t> FreeSlots::*list,
+                              uint32_t &next, uint32_t capacity,
+                              const char *kind) -> uint32_t;
+  void release(std::vector<uint32_t> FreeSlots::*list, uint32_t index);
+};
+
+} // namespace vkr::scene
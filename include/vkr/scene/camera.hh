@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vkr/core/window.hh"
+#include "vkr/scene/frustum.hh"
 #include "vkr/util/input_tracer.hh"
 #include "vkr/util/timer.hh"
 #include <glm/common.hpp>
@@ -83,6 +84,10 @@ public:
     return proj;
   }
 
+  [[nodiscard]] auto frustum() const -> Frustum {
+    return Frustum::fromViewProjection(getProjection() * getView());
+  }
+
   void mouseMove(float xOffset, float yOffset) {
     desc_.yaw += xOffset * desc_.mouseSensitivity;
     desc_.pitch += yOffset * desc_.mouseSensitivity;
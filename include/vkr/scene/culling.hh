@@ -0,0 +1,66 @@
+#pragma once
+
+#include "vkr/scene/frustum.hh"
+#include "vkr/scene/geometry/bounds.hh"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkr::scene {
+
+struct CullStats {
+  uint32_t objects{0};
+  uint32_t visible{0};
+  // objects a Hi-Z test hid, only counted by GPU culling
+  uint32_t occluded{0};
+  // objects that passed but found their batch's commands full, likewise GPU
+  // only; they are not drawn and not counted as visible
+  uint32_t overflowed{0};
+  double milliseconds{0.0};
+};
+
+// bounds kept as structure-of-arrays so each plane test runs as one
+// branch-free loop over all objects that the compiler can vectorize. An
+// object is kept when both its sphere and its box reach the inner side of
+// every plane; objects without valid bounds are always kept.
+class FrustumCuller {
+public:
+  FrustumCuller() = default;
+  ~FrustumCuller() = default;
+
+  FrustumCuller(const FrustumCuller &) = delete;
+  auto operator=(const FrustumCuller &) -> FrustumCuller & = delete;
+
+  void clear() noexcept;
+  void reserve(size_t count);
+  // margin grows the bounds, e.g. for vertex animation the bounds miss
+  auto add(const MeshBounds &bounds, float margin = 0.0f) -> uint32_t;
+  // writes the indices of kept objects in ascending order
+  void cull(const Frustum &frustum, std::vector<uint32_t> &visible);
+
+  [[nodiscard]] auto size() const noexcept -> size_t { return radius_.size(); }
+
+  [[nodiscard]] auto center(uint32_t index) const noexcept -> glm::vec3 {
+    return {center_x_[index], center_y_[index], center_z_[index]};
+  }
+
+  [[nodiscard]] auto stats() const noexcept -> const CullStats & {
+    return stats_;
+  }
+
+private:
+  // components
+  std::vector<float> center_x_{};
+  std::vector<float> center_y_{};
+  std::vector<float> center_z_{};
+  std::vector<float> radius_{};
+  std::vector<float> extent_x_{};
+  std::vector<float> extent_y_{};
+  std::vector<float> extent_z_{};
+
+  // states
+  std::vector<uint8_t> inside_{};
+  CullStats stats_{};
+};
+
+} // namespace vkr::scene
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+namespace vkr::scene {
+
+// six world-space planes, xyz the inward normal and w the offset, so a point
+// p is inside when dot(xyz, p) + w >= 0 for every plane
+struct Frustum {
+  std::array<glm::vec4, 6> planes{};
+
+  // extracted from the rows of the view-projection matrix; the near plane
+  // uses the -w <= z bound, which also holds for [0, 1] depth projections
+  // and only keeps a little more than needed there
+  [[nodiscard]] static auto fromViewProjection(const glm::mat4 &viewProjection)
+      -> Frustum {
+    const glm::vec4 row0{viewProjection[0][0], viewProjection[1][0],
+                         viewProjection[2][0], viewProjection[3][0]};
+    const glm::vec4 row1{viewProjection[0][1], viewProjection[1][1],
+                         viewProjection[2][1], viewProjection[3][1]};
+    const glm::vec4 row2{viewProjection[0][2], viewProjection[1][2],
+                         viewProjection[2][2], viewProjection[3][2]};
+    const glm::vec4 row3{viewProjection[0][3], viewProjection[1][3],
+                         viewProjection[2][3], viewProjection[3][3]};
+
+    Frustum frustum{};
+    frustum.planes = {row3 + row0, row3 - row0, row3 + row1,
+                      row3 - row1, row3 + row2, row3 - row2};
+    for (auto &plane : frustum.planes) {
+      plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+  }
+};
+
+} // namespace vkr::scene
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace vkr::scene {
+
+// object-space box and a sphere sharing its center; a mesh without vertex
+// positions keeps the default, which is never culled
+struct MeshBounds {
+  glm::vec3 min{0.0f};
+  glm::vec3 max{0.0f};
+  glm::vec3 center{0.0f};
+  float radius{-1.0f};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return radius >= 0.0f;
+  }
+
+  [[nodiscard]] auto extent() const noexcept -> glm::vec3 {
+    return 0.5f * (max - min);
+  }
+};
+
+// the sphere is centered on the box and reaches the farthest vertex, which
+// is tighter than the box's half diagonal for most meshes
+template <typename VertexType, typename PositionFn>
+auto computeBounds(const std::vector<VertexType> &vertices,
+                   PositionFn position) -> MeshBounds {
+  MeshBounds bounds{};
+  if (vertices.empty()) {
+    return bounds;
+  }
+
+  bounds.min = bounds.max = position(vertices.front());
+  for (const auto &vertex : vertices) {
+    const glm::vec3 point = position(vertex);
+    bounds.min = glm::min(bounds.min, point);
+    bounds.max = glm::max(bounds.max, point);
+  }
+
+  bounds.center = 0.5f * (bounds.min + bounds.max);
+  float radiusSquared = 0.0f;
+  for (const auto &vertex : vertices) {
+    const glm::vec3 offset = position(vertex) - bounds.center;
+    radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+  }
+  bounds.radius = std::sqrt(radiusSquared);
+  return bounds;
+}
+
+} // namespace vkr::scene
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vkr/logger.hh"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace vkr::scene {
+
+// small per-draw values (model matrix, material index, ...) kept on the host;
+// a raster pass hands element i to draw i of its mesh list through push
+// constants or a dynamic uniform slice, so they change without descriptor
+// writes
+class DrawDataStream {
+public:
+  DrawDataStream(uint32_t stride, uint32_t drawCount)
+      : stride_(stride), draw_count_(drawCount) {
+    if (stride_ == 0 || stride_ % 4 != 0) {
+      VKR_RES_ERROR("Draw data stride {} must be a non-zero multiple of 4",
+                    stride_);
+    }
+
+    data_.resize(static_cast<size_t>(stride_) * draw_count_);
+  }
+
+  template <typename ElementType>
+  void set(uint32_t drawIndex, const ElementType &element) {
+    static_assert(std::is_trivially_copyable_v<ElementType>,
+                  "draw data must be trivially copyable");
+    setRaw(drawIndex, &element, sizeof(ElementType));
+  }
+
+  void setRaw(uint32_t drawIndex, const void *data, size_t size) {
+    if (drawIndex >= draw_count_) {
+      VKR_RES_ERROR("Draw data index {} out of range, count {}", drawIndex,
+                    draw_count_);
+    }
+
+    if (size != stride_) {
+      VKR_RES_ERROR("Draw data element size {} does not match stride {}",
+                    size, stride_);
+    }
+
+    std::memcpy(data_.data() + static_cast<size_t>(drawIndex) * stride_, data,
+                size);
+  }
+
+  [[nodiscard]] auto element(uint32_t drawIndex) const -> const void * {
+    return data_.data() + static_cast<size_t>(drawIndex) * stride_;
+  }
+
+  [[nodiscard]] auto stride() const noexcept -> uint32_t { return stride_; }
+
+  [[nodiscard]] auto drawCount() const noexcept -> uint32_t {
+    return draw_count_;
+  }
+
+private:
+  // states
+  uint32_t stride_{0};
+  uint32_t draw_count_{0};
+  std::vector<std::byte> data_{};
+};
+
+} // namespace vkr::scene
@@ -3,11 +3,44 @@
 #include "vkr/core/command/pool.hh"
 #include "vkr/core/device.hh"
 #include "vkr/resource/buffer/buffer.hh"
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 namespace vkr::scene {
 
+class IndexSpan {
+public:
+  IndexSpan() = default;
+  IndexSpan(const void *data, size_t count, VkIndexType type) noexcept
+      : data_(data), count_(count), type_(type) {}
+
+  [[nodiscard]] auto data() const noexcept -> const void * { return data_; }
+  [[nodiscard]] auto size() const noexcept -> size_t { return count_; }
+  [[nodiscard]] auto empty() const noexcept -> bool { return count_ == 0; }
+  [[nodiscard]] auto type() const noexcept -> VkIndexType { return type_; }
+
+  [[nodiscard]] auto operator[](size_t i) const noexcept -> uint32_t {
+    if (type_ == VK_INDEX_TYPE_UINT32) {
+      return static_cast<const uint32_t *>(data_)[i];
+    }
+    return static_cast<const uint16_t *>(data_)[i];
+  }
+
+  [[nodiscard]] auto toVector() const -> std::vector<uint32_t> {
+    std::vector<uint32_t> result(count_);
+    for (size_t i = 0; i < count_; ++i) {
+      result[i] = (*this)[i];
+    }
+    return result;
+  }
+
+private:
+  const void *data_{nullptr};
+  size_t count_{0};
+  VkIndexType type_{VK_INDEX_TYPE_UINT16};
+};
+
 class IndexBuffer {
 public:
   explicit IndexBuffer(const core::Device &device,
@@ -23,9 +56,25 @@ public:
   void create();
   void destroy();
   void update(const std::vector<uint16_t> &indices);
+  void update(const std::vector<uint32_t> &indices);
 
-  [[nodiscard]] auto indices() const noexcept -> std::vector<uint16_t> {
-    return indices_;
+  [[nodiscard]] auto indices() const noexcept -> IndexSpan {
+    return index_type_ == VK_INDEX_TYPE_UINT32
+               ? IndexSpan{indices32_.data(), indices32_.size(), index_type_}
+               : IndexSpan{indices16_.data(), indices16_.size(), index_type_};
+  }
+  [[nodiscard]] auto indexCount() const noexcept -> uint32_t {
+    return static_cast<uint32_t>(indices().size());
+  }
+  [[nodiscard]] auto indexType() const noexcept -> VkIndexType {
+    return index_type_;
+  }
+  [[nodiscard]] auto indexSize() const noexcept -> VkDeviceSize {
+    return index_type_ == VK_INDEX_TYPE_UINT32 ? sizeof(uint32_t)
+                                               : sizeof(uint16_t);
+  }
+  [[nodiscard]] auto bufferSize() const noexcept -> VkDeviceSize {
+    return indexSize() * indices().size();
   }
   [[nodiscard]] auto buffer() const noexcept -> VkBuffer {
     return target_->buffer();
@@ -40,7 +89,9 @@ private:
   const core::CommandPool &command_pool_;
 
   // dependencies
-  std::vector<uint16_t> indices_{};
+  VkIndexType index_type_{VK_INDEX_TYPE_UINT16};
+  std::vector<uint16_t> indices16_{};
+  std::vector<uint32_t> indices32_{};
   std::unique_ptr<resource::Buffer> target_{};
 };
 } // namespace vkr::scene
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "vkr/core/device.hh"
+#include "vkr/logger.hh"
+#include "vkr/resource/buffer/buffer.hh"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace vkr::scene {
+
+class IInstanceBuffer {
+public:
+  virtual ~IInstanceBuffer() = default;
+
+  [[nodiscard]] virtual auto buffer(uint32_t frameIndex) const -> VkBuffer = 0;
+  [[nodiscard]] virtual auto instanceCount(uint32_t frameIndex) const
+      -> uint32_t = 0;
+  [[nodiscard]] virtual auto frameCount() const noexcept -> size_t = 0;
+  [[nodiscard]] virtual auto stride() const noexcept -> VkDeviceSize = 0;
+
+  virtual void updateRaw(uint32_t frameIndex, const void *data,
+                         size_t count) = 0;
+};
+
+// per-instance vertex data, one host-visible copy per frame in flight so the
+// CPU can rewrite frame N while the GPU still reads frame N-1
+template <typename InstanceType>
+class InstanceBuffer final : public IInstanceBuffer {
+public:
+  explicit InstanceBuffer(const core::Device &device, uint32_t frameCount)
+      : device_(device) {
+    if (frameCount == 0) {
+      VKR_RES_ERROR("InstanceBuffer frame count must be greater than zero");
+    }
+
+    buffers_.reserve(frameCount);
+    for (uint32_t i = 0; i < frameCount; ++i) {
+      buffers_.push_back(std::make_unique<resource::Buffer>(device_));
+    }
+    counts_.resize(frameCount, 0);
+  }
+
+  ~InstanceBuffer() override = default;
+
+  InstanceBuffer(const InstanceBuffer &) = delete;
+  auto operator=(const InstanceBuffer &) -> InstanceBuffer & = delete;
+
+  void update(uint32_t frameIndex, const std::vector<InstanceType> &instances) {
+    if (frameIndex >= buffers_.size()) {
+      VKR_RES_ERROR("Instance buffer frame {} is unavailable", frameIndex);
+    }
+
+    counts_[frameIndex] = static_cast<uint32_t>(instances.size());
+    if (instances.empty()) {
+      return;
+    }
+
+    const auto byteSize =
+        static_cast<VkDeviceSize>(sizeof(InstanceType) * instances.size());
+    auto &target = *buffers_[frameIndex];
+
+    // grow only; shrinking keeps the larger allocation for the next spike
+    if (!target.isValid() || target.size() < byteSize) {
+      target.update(byteSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+      (void)target.map();
+    }
+
+    target.write(instances.data(), byteSize);
+  }
+
+  void updateRaw(uint32_t frameIndex, const void *data,
+                 size_t count) override {
+    if (data == nullptr && count != 0) {
+      VKR_RES_ERROR("Cannot update instance buffer with invalid raw data!");
+    }
+
+    const auto *rawInstances = static_cast<const InstanceType *>(data);
+    std::vector<InstanceType> instances(rawInstances, rawInstances + count);
+    update(frameIndex, instances);
+  }
+
+  [[nodiscard]] auto buffer(uint32_t frameIndex) const -> VkBuffer override {
+    if (frameIndex >= buffers_.size()) {
+      VKR_RES_ERROR("Instance buffer frame {} is unavailable", frameIndex);
+    }
+    return buffers_[frameIndex]->buffer();
+  }
+
+  [[nodiscard]] auto instanceCount(uint32_t frameIndex) const
+      -> uint32_t override {
+    if (frameIndex >= counts_.size()) {
+      VKR_RES_ERROR("Instance buffer frame {} is unavailable", frameIndex);
+    }
+    return counts_[frameIndex];
+  }
+
+  [[nodiscard]] auto frameCount() const noexcept -> size_t override {
+    return buffers_.size();
+  }
+
+  [[nodiscard]] auto stride() const noexcept -> VkDeviceSize override {
+    return sizeof(InstanceType);
+  }
+
+private:
+  // dependencies
+  const core::Device &device_;
+
+  // components
+  std::vector<std::unique_ptr<resource::Buffer>> buffers_{};
+  std::vector<uint32_t> counts_{};
+};
+
+} // namespace vkr::scene
@@ -3,9 +3,11 @@
 #include "vkr/core/command/pool.hh"
 #include "vkr/core/device.hh"
 #include "vkr/logger.hh"
+#include "vkr/scene/geometry/bounds.hh"
 #include "vkr/scene/geometry/index_buffer.hh"
 #include "vkr/scene/geometry/vertex_buffer.hh"
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -21,6 +23,10 @@ namespace detail {
 
 template <typename...> struct AlwaysFalse : std::false_type {};
 
+template <typename IndexType>
+constexpr bool IsIndexType =
+    std::is_same_v<IndexType, uint16_t> || std::is_same_v<IndexType, uint32_t>;
+
 template <typename VertexType, typename = void>
 struct HasPosition : std::false_type {};
 
@@ -76,6 +82,17 @@ void assignPosition(VertexType &vertex, glm::vec3 pos) {
   }
 }
 
+template <typename VertexType>
+auto positionOf(const VertexType &vertex) -> glm::vec3 {
+  using PositionType = std::decay_t<decltype(vertex.pos)>;
+
+  if constexpr (std::is_same_v<PositionType, glm::vec3>) {
+    return vertex.pos;
+  } else {
+    return {vertex.pos, 0.0f};
+  }
+}
+
 template <typename VertexType>
 void assignColor(VertexType &vertex, glm::vec3 color) {
   if constexpr (HasColor<VertexType>::value) {
@@ -128,44 +145,48 @@ template <typename VertexType, bool UseHash = UseHashDedup<VertexType>>
 class VertexDeduplicator {
 public:
   auto indexFor(const VertexType &vertex, std::vector<VertexType> &vertices)
-      -> uint16_t {
+      -> uint32_t {
     auto it = std::find(vertices.begin(), vertices.end(), vertex);
     if (it != vertices.end()) {
-      return static_cast<uint16_t>(std::distance(vertices.begin(), it));
+      return static_cast<uint32_t>(std::distance(vertices.begin(), it));
     }
 
-    if (vertices.size() > std::numeric_limits<uint16_t>::max()) {
+    if (vertices.size() >= std::numeric_limits<uint32_t>::max()) {
       VKR_RES_ERROR("Mesh has more than {} unique vertices",
-                    std::numeric_limits<uint16_t>::max());
+                    std::numeric_limits<uint32_t>::max());
     }
 
     vertices.push_back(vertex);
-    return static_cast<uint16_t>(vertices.size() - 1);
+    return static_cast<uint32_t>(vertices.size() - 1);
   }
+
+  void reserve(size_t) {}
 };
 
 template <typename VertexType> class VertexDeduplicator<VertexType, true> {
 public:
   auto indexFor(const VertexType &vertex, std::vector<VertexType> &vertices)
-      -> uint16_t {
+      -> uint32_t {
     auto it = unique_vertices_.find(vertex);
     if (it != unique_vertices_.end()) {
       return it->second;
     }
 
-    if (vertices.size() > std::numeric_limits<uint16_t>::max()) {
+    if (vertices.size() >= std::numeric_limits<uint32_t>::max()) {
       VKR_RES_ERROR("Mesh has more than {} unique vertices",
-                    std::numeric_limits<uint16_t>::max());
+                    std::numeric_limits<uint32_t>::max());
     }
 
-    const auto index = static_cast<uint16_t>(vertices.size());
+    const auto index = static_cast<uint32_t>(vertices.size());
     vertices.push_back(vertex);
     unique_vertices_.emplace(vertex, index);
     return index;
   }
 
+  void reserve(size_t count) { unique_vertices_.reserve(count); }
+
 private:
-  std::unordered_map<VertexType, uint16_t> unique_vertices_{};
+  std::unordered_map<VertexType, uint32_t> unique_vertices_{};
 };
 
 } // namespace detail
@@ -179,6 +200,13 @@ public:
   [[nodiscard]] virtual auto indexBuffer() const
       -> std::optional<std::reference_wrapper<const IndexBuffer>> = 0;
 
+  // object-space bounds of the loaded vertices, recomputed on every vertex
+  // update
+  [[nodiscard]] virtual auto bounds() const noexcept -> const MeshBounds & = 0;
+  // bumped by every load and update, which keep the mesh's scene handle;
+  // passes caching bounds or index counts compare it
+  [[nodiscard]] virtual auto revision() const noexcept -> uint64_t = 0;
+
   [[nodiscard]] auto isValid() const -> bool {
     return vertexBufferBase().has_value() && indexBuffer().has_value();
   }
@@ -195,14 +223,19 @@ public:
   auto operator=(const Mesh &) -> Mesh & = delete;
 
 public:
+  template <typename IndexType>
   void load(const std::vector<VBOType> &vertices,
-            const std::vector<uint16_t> &indices) {
+            const std::vector<IndexType> &indices) {
+    static_assert(detail::IsIndexType<IndexType>,
+                  "Mesh indices must be uint16_t or uint32_t");
+
     if (!vertex_buffer_ || !index_buffer_) {
       vertex_buffer_ =
           std::make_unique<VertexBuffer<VBOType>>(device_, command_pool_);
       index_buffer_ = std::make_unique<IndexBuffer>(device_, command_pool_);
       vertex_buffer_->update(vertices);
       index_buffer_->update(indices);
+      updateBounds(vertices);
     } else {
       update(vertices, indices);
     }
@@ -236,9 +269,16 @@ public:
       VKR_RES_ERROR("Failed to load OBJ file: {}", meshFilePath);
     }
 
+    size_t indexCount = 0;
+    for (const auto &shape : shapes) {
+      indexCount += shape.mesh.indices.size();
+    }
+
     std::vector<VBOType> vertices;
-    std::vector<uint16_t> indices;
+    std::vector<uint32_t> indices;
     detail::VertexDeduplicator<VBOType> uniqueVertices;
+    indices.reserve(indexCount);
+    uniqueVertices.reserve(indexCount);
 
     for (const auto &shape : shapes) {
       for (const auto &index : shape.mesh.indices) {
@@ -292,23 +332,35 @@ public:
 
     load(vertices, indices);
 
-    VKR_RES_INFO("Loaded mesh: {} vertices, {} indices", vertices.size(),
-                 indices.size());
+    VKR_RES_INFO("Loaded mesh: {} vertices, {} indices ({}, {} bytes)",
+                 vertices.size(), indices.size(),
+                 index_buffer_->indexType() == VK_INDEX_TYPE_UINT32 ? "uint32"
+                                                                    : "uint16",
+                 index_buffer_->bufferSize());
   }
 
+  template <typename IndexType>
   void update(const std::vector<VBOType> &vertices,
-              const std::vector<uint16_t> &indices) {
+              const std::vector<IndexType> &indices) {
+    static_assert(detail::IsIndexType<IndexType>,
+                  "Mesh indices must be uint16_t or uint32_t");
     checkDataLoaded();
     vertex_buffer_->update(vertices);
     index_buffer_->update(indices);
+    updateBounds(vertices);
   }
   void update(const std::vector<VBOType> &vertices) {
     checkDataLoaded();
     vertex_buffer_->update(vertices);
+    updateBounds(vertices);
   }
-  void update(const std::vector<uint16_t> &indices) {
+  template <typename IndexType>
+  void update(const std::vector<IndexType> &indices) {
+    static_assert(detail::IsIndexType<IndexType>,
+                  "Mesh indices must be uint16_t or uint32_t");
     checkDataLoaded();
     index_buffer_->update(indices);
+    ++revision_;
   }
 
   [[nodiscard]] auto vertexBuffer() const
@@ -338,6 +390,14 @@ public:
     return *index_buffer_;
   }
 
+  [[nodiscard]] auto bounds() const noexcept -> const MeshBounds & override {
+    return bounds_;
+  }
+
+  [[nodiscard]] auto revision() const noexcept -> uint64_t override {
+    return revision_;
+  }
+
 private:
   // dependencies
   const core::Device &device_;
@@ -347,10 +407,23 @@ private:
   std::unique_ptr<VertexBuffer<VBOType>> vertex_buffer_;
   std::unique_ptr<IndexBuffer> index_buffer_;
 
+  // states
+  MeshBounds bounds_{};
+  uint64_t revision_{0};
+
   void checkDataLoaded() {
     if (!vertex_buffer_ || !index_buffer_) {
       VKR_RES_ERROR("Vertex or index buffer is not initialized!");
     }
   }
+
+  void updateBounds(const std::vector<VBOType> &vertices) {
+    ++revision_;
+    if constexpr (detail::HasPosition<VBOType>::value) {
+      bounds_ = computeBounds(vertices, [](const VBOType &vertex) {
+        return detail::positionOf(vertex);
+      });
+    }
+  }
 };
 } // namespace vkr::scene
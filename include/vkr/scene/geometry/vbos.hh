@@ -19,6 +19,14 @@ struct VertexInputDesc {
     return bindings.empty() && attributes.empty();
   }
 
+  auto append(const VertexInputDesc &other) -> VertexInputDesc & {
+    bindings.insert(bindings.end(), other.bindings.begin(),
+                    other.bindings.end());
+    attributes.insert(attributes.end(), other.attributes.begin(),
+                      other.attributes.end());
+    return *this;
+  }
+
   [[nodiscard]] auto createInfo() const noexcept
       -> VkPipelineVertexInputStateCreateInfo {
     VkPipelineVertexInputStateCreateInfo info{};
@@ -421,6 +429,61 @@ struct VertexSkybox3D {
   }
 };
 
+struct InstanceTransform3D {
+  glm::mat4 model{1.0f};
+  glm::vec4 color{1.0f};
+
+  InstanceTransform3D() = default;
+  explicit InstanceTransform3D(const glm::mat4 &model,
+                               glm::vec4 color = glm::vec4{1.0f})
+      : model(model), color(color) {}
+
+  [[nodiscard]] static auto getBindingDescription(uint32_t binding = 1)
+      -> VkVertexInputBindingDescription {
+    VkVertexInputBindingDescription desc{};
+    desc.binding = binding;
+    desc.stride = sizeof(InstanceTransform3D);
+    desc.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    return desc;
+  }
+
+  // a mat4 attribute occupies four consecutive vec4 locations
+  [[nodiscard]] static auto
+  getAttributeDescriptions(uint32_t binding = 1, uint32_t firstLocation = 4)
+      -> std::vector<VkVertexInputAttributeDescription> {
+    std::vector<VkVertexInputAttributeDescription> attributes{};
+    attributes.reserve(5);
+
+    for (uint32_t column = 0; column < 4; ++column) {
+      VkVertexInputAttributeDescription modelDesc{};
+      modelDesc.binding = binding;
+      modelDesc.location = firstLocation + column;
+      modelDesc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+      modelDesc.offset = static_cast<uint32_t>(
+          offsetof(InstanceTransform3D, model) + sizeof(glm::vec4) * column);
+      attributes.push_back(modelDesc);
+    }
+
+    VkVertexInputAttributeDescription colorDesc{};
+    colorDesc.binding = binding;
+    colorDesc.location = firstLocation + 4;
+    colorDesc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    colorDesc.offset = offsetof(InstanceTransform3D, color);
+    attributes.push_back(colorDesc);
+
+    return attributes;
+  }
+
+  [[nodiscard]] static auto vertexInputDesc(uint32_t binding = 1,
+                                            uint32_t firstLocation = 4)
+      -> VertexInputDesc {
+    VertexInputDesc desc{};
+    desc.bindings.push_back(getBindingDescription(binding));
+    desc.attributes = getAttributeDescriptions(binding, firstLocation);
+    return desc;
+  }
+};
+
 [[nodiscard]] inline auto skyboxCubeVertices() -> std::vector<VertexSkybox3D> {
   return {
       VertexSkybox3D{{-1.0f, -1.0f, -1.0f}},
@@ -107,6 +107,8 @@ protected:
     upload(vertices_.data(), bufferSize);
   }
 
+  // pending uploads into the buffer finish before the deletion queue lets
+  // it go, so there is nothing to wait for here
   void destroy() { target_->destroy(); }
 
   void upload(const VertexType *vertices, VkDeviceSize bufferSize) {
@@ -114,60 +116,8 @@ protected:
       VKR_RES_ERROR("Cannot upload empty vertex buffer data!");
     }
 
-    resource::Buffer staging{device_, bufferSize,
-                             VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-    staging.write(vertices, bufferSize);
-
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = command_pool_.commandPool();
-    allocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
-    if (vkAllocateCommandBuffers(device_.device(), &allocInfo,
-                                 &commandBuffer) != VK_SUCCESS) {
-      VKR_RES_ERROR("Failed to allocate vertex upload command buffer");
-    }
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
-      vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                           &commandBuffer);
-      VKR_RES_ERROR("Failed to begin vertex upload command buffer");
-    }
-
-    VkBufferCopy copyRegion{};
-    copyRegion.size = bufferSize;
-    vkCmdCopyBuffer(commandBuffer, staging.buffer(), target_->buffer(), 1,
-                    &copyRegion);
-
-    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-      vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                           &commandBuffer);
-      VKR_RES_ERROR("Failed to end vertex upload command buffer");
-    }
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-
-    if (vkQueueSubmit(command_pool_.queue(), 1, &submitInfo, VK_NULL_HANDLE) !=
-        VK_SUCCESS) {
-      vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                           &commandBuffer);
-      VKR_RES_ERROR("Failed to submit vertex upload command buffer");
-    }
-
-    vkQueueWaitIdle(command_pool_.queue());
-    vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                         &commandBuffer);
+    command_pool_.uploader().copyBuffer(vertices, bufferSize,
+                                        target_->buffer());
   }
 
 protected:
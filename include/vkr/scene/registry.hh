@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vkr::scene {
+
+// index into a ResourceRegistry slot plus the generation it was issued for;
+// a handle to an erased resource stays invalid even after its slot is reused
+template <typename Tag>
+struct ResourceHandle {
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  uint32_t index{kInvalidIndex};
+  uint32_t generation{0};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return index != kInvalidIndex;
+  }
+
+  [[nodiscard]] auto operator==(const ResourceHandle &other) const noexcept
+      -> bool {
+    return index == other.index && generation == other.generation;
+  }
+
+  [[nodiscard]] auto operator!=(const ResourceHandle &other) const noexcept
+      -> bool {
+    return !(*this == other);
+  }
+};
+
+using MeshHandle = ResourceHandle<struct MeshTag>;
+using TextureHandle = ResourceHandle<struct TextureTag>;
+using CubemapHandle = ResourceHandle<struct CubemapTag>;
+using UniformBufferHandle = ResourceHandle<struct UniformBufferTag>;
+using InstanceBufferHandle = ResourceHandle<struct InstanceBufferTag>;
+
+// generational slot map: resources and names live in dense arrays for
+// iteration, handles resolve through a slot table without hashing, and the
+// name map is only consulted when a handle is looked up or a resource is
+// created or destroyed
+template <typename ResourceType, typename HandleType>
+class ResourceRegistry {
+public:
+  // replacing a named resource keeps its handle, so holders pick up the new
+  // resource without resolving again
+  auto insert(const std::string &name, std::shared_ptr<ResourceType> resource)
+      -> HandleType {
+    auto it = handles_.find(name);
+    if (it != handles_.end()) {
+      resources_[slots_[it->second.index].dense] = std::move(resource);
+      ++version_;
+      return it->second;
+    }
+
+    uint32_t slot = 0;
+    if (!free_slots_.empty()) {
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    } else {
+      slot = static_cast<uint32_t>(slots_.size());
+      slots_.push_back({});
+    }
+
+    slots_[slot].dense = static_cast<uint32_t>(resources_.size());
+    resources_.push_back(std::move(resource));
+    names_.push_back(name);
+    dense_slots_.push_back(slot);
+
+    const HandleType handle{slot, slots_[slot].generation};
+    handles_.emplace(name, handle);
+    ++version_;
+    return handle;
+  }
+
+  void erase(const std::string &name) {
+    auto it = handles_.find(name);
+    if (it == handles_.end()) {
+      return;
+    }
+
+    const uint32_t slot = it->second.index;
+    const uint32_t dense = slots_[slot].dense;
+    const uint32_t last = static_cast<uint32_t>(resources_.size() - 1);
+
+    if (dense != last) {
+      resources_[dense] = std::move(resources_[last]);
+      names_[dense] = std::move(names_[last]);
+      dense_slots_[dense] = dense_slots_[last];
+      slots_[dense_slots_[dense]].dense = dense;
+    }
+
+    resources_.pop_back();
+    names_.pop_back();
+    dense_slots_.pop_back();
+
+    slots_[slot].dense = kFreeDense;
+    ++slots_[slot].generation;
+    free_slots_.push_back(slot);
+    handles_.erase(it);
+    ++version_;
+  }
+
+  [[nodiscard]] auto find(const std::string &name) const -> HandleType {
+    auto it = handles_.find(name);
+    return it == handles_.end() ? HandleType{} : it->second;
+  }
+
+  [[nodiscard]] auto contains(HandleType handle) const noexcept -> bool {
+    return handle.index < slots_.size() &&
+           slots_[handle.index].generation == handle.generation &&
+           slots_[handle.index].dense != kFreeDense;
+  }
+
+  [[nodiscard]] auto get(HandleType handle) const noexcept -> ResourceType * {
+    return contains(handle) ? resources_[slots_[handle.index].dense].get()
+                            : nullptr;
+  }
+
+  [[nodiscard]] auto get(const std::string &name) const
+      -> std::shared_ptr<ResourceType> {
+    auto it = handles_.find(name);
+    return it == handles_.end() ? nullptr
+                                : resources_[slots_[it->second.index].dense];
+  }
+
+  [[nodiscard]] auto name(HandleType handle) const -> const std::string & {
+    static const std::string empty{};
+    return contains(handle) ? names_[slots_[handle.index].dense] : empty;
+  }
+
+  [[nodiscard]] auto resources() const noexcept
+      -> const std::vector<std::shared_ptr<ResourceType>> & {
+    return resources_;
+  }
+
+  [[nodiscard]] auto names() const noexcept
+      -> const std::vector<std::string> & {
+    return names_;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_t {
+    return resources_.size();
+  }
+
+  // bumped by every insert and erase so views can cache derived lists
+  [[nodiscard]] auto version() const noexcept -> uint64_t { return version_; }
+
+private:
+  static constexpr uint32_t kFreeDense = UINT32_MAX;
+
+  struct Slot {
+    uint32_t dense{kFreeDense};
+    uint32_t generation{0};
+  };
+
+  // components
+  std::vector<std::shared_ptr<ResourceType>> resources_{};
+  std::vector<std::string> names_{};
+  std::vector<uint32_t> dense_slots_{};
+  std::vector<Slot> slots_{};
+  std::vector<uint32_t> free_slots_{};
+  std::unordered_map<std::string, HandleType> handles_{};
+
+  // states
+  uint64_t version_{0};
+};
+
+} // namespace vkr::scene
@@ -4,10 +4,15 @@
 #include "vkr/core/command/pool.hh"
 #include "vkr/core/device.hh"
 #include "vkr/logger.hh"
+#include "vkr/resource/buffer/buffer.hh"
+#include "vkr/scene/bindless.hh"
 #include "vkr/scene/frame_uniform_buffer_set.hh"
+#include "vkr/scene/geometry/draw_data.hh"
+#include "vkr/scene/geometry/instance_buffer.hh"
 #include "vkr/scene/geometry/mesh.hh"
 #include "vkr/scene/material/cubemap.hh"
 #include "vkr/scene/material/texture.hh"
+#include "vkr/scene/registry.hh"
 #include <array>
 #include <cstdint>
 #include <memory>
@@ -34,26 +39,120 @@ public:
 
   // Uniform buffer management
   template <typename UBOType>
-  void createUniformBuffer(const std::string &name, const UBOType &ubo) {
+  auto createUniformBuffer(const std::string &name, const UBOType &ubo)
+      -> UniformBufferHandle {
     auto buffer = std::make_shared<FrameUniformBufferSet<UBOType>>(
         device_, command_buffers_.size());
     buffer->update(0, ubo);
-    uniform_buffers_[name] = std::move(buffer);
+    return uniform_buffers_.insert(name, std::move(buffer));
   }
 
   [[nodiscard]] auto getUniformBuffer(const std::string &name) const
       -> std::shared_ptr<IFrameUniformBufferSet> {
-    auto it = uniform_buffers_.find(name);
-    return it == uniform_buffers_.end() ? nullptr : it->second;
+    return uniform_buffers_.get(name);
+  }
+
+  [[nodiscard]] auto uniformBufferHandle(const std::string &name) const
+      -> UniformBufferHandle {
+    return uniform_buffers_.find(name);
+  }
+
+  [[nodiscard]] auto uniformBuffer(UniformBufferHandle handle) const noexcept
+      -> IFrameUniformBufferSet * {
+    return uniform_buffers_.get(handle);
   }
 
   void destroyUniformBuffer(const std::string &name) {
     uniform_buffers_.erase(name);
   }
 
+  // Instance buffer management
+  template <typename InstanceType>
+  auto createInstanceBuffer(const std::string &name,
+                            const std::vector<InstanceType> &instances)
+      -> InstanceBufferHandle {
+    auto buffer = std::make_shared<InstanceBuffer<InstanceType>>(
+        device_, command_buffers_.size());
+    // nothing reads a new buffer yet, so every frame slot starts filled;
+    // later writes go through update(frameIndex, ...)
+    for (uint32_t frameIndex = 0; frameIndex < buffer->frameCount();
+         ++frameIndex) {
+      buffer->update(frameIndex, instances);
+    }
+    return instance_buffers_.insert(name, std::move(buffer));
+  }
+
+  [[nodiscard]] auto getInstanceBuffer(const std::string &name) const
+      -> std::shared_ptr<IInstanceBuffer> {
+    return instance_buffers_.get(name);
+  }
+
+  [[nodiscard]] auto instanceBufferHandle(const std::string &name) const
+      -> InstanceBufferHandle {
+    return instance_buffers_.find(name);
+  }
+
+  [[nodiscard]] auto instanceBuffer(InstanceBufferHandle handle) const noexcept
+      -> IInstanceBuffer * {
+    return instance_buffers_.get(handle);
+  }
+
+  void destroyInstanceBuffer(const std::string &name) {
+    instance_buffers_.erase(name);
+  }
+
+  // Per-draw data management
+  template <typename ElementType>
+  void createDrawDataStream(const std::string &name, uint32_t drawCount) {
+    draw_data_[name] = std::make_shared<DrawDataStream>(
+        static_cast<uint32_t>(sizeof(ElementType)), drawCount);
+  }
+
+  [[nodiscard]] auto getDrawDataStream(const std::string &name) const
+      -> std::shared_ptr<DrawDataStream> {
+    auto it = draw_data_.find(name);
+    return it == draw_data_.end() ? nullptr : it->second;
+  }
+
+  void destroyDrawDataStream(const std::string &name) {
+    draw_data_.erase(name);
+  }
+
+  // Storage buffer management
+  template <typename ElementType>
+  void createStorageBuffer(const std::string &name,
+                           const std::vector<ElementType> &elements) {
+    if (elements.empty()) {
+      VKR_RES_ERROR("Cannot create empty storage buffer '{}'", name);
+    }
+
+    const auto byteSize =
+        static_cast<VkDeviceSize>(sizeof(ElementType) * elements.size());
+    auto buffer = std::make_shared<resource::Buffer>(device_);
+    buffer->update(byteSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    (void)buffer->map();
+    buffer->write(elements.data(), byteSize);
+    storage_buffers_[name] = std::move(buffer);
+    registerStorageBuffer(name);
+  }
+
+  [[nodiscard]] auto getStorageBuffer(const std::string &name) const
+      -> std::shared_ptr<resource::Buffer> {
+    auto it = storage_buffers_.find(name);
+    return it == storage_buffers_.end() ? nullptr : it->second;
+  }
+
+  void destroyStorageBuffer(const std::string &name) {
+    releaseIndex(buffer_indices_, name, &BindlessTable::releaseBuffer);
+    storage_buffers_.erase(name);
+  }
+
   // Mesh management
   template <typename VBOType>
-  void createMesh(const std::string &name, const Mesh<VBOType> &mesh) {
+  auto createMesh(const std::string &name, const Mesh<VBOType> &mesh)
+      -> MeshHandle {
     const auto vertexBuffer = mesh.vertexBuffer();
     const auto indexBuffer = mesh.indexBuffer();
 
@@ -62,27 +161,46 @@ public:
     }
 
     auto stored = std::make_shared<Mesh<VBOType>>(device_, command_pool_);
-    stored->load(vertexBuffer->get().vertices(), indexBuffer->get().indices());
-    meshes_[name] = std::move(stored);
+    stored->load(vertexBuffer->get().vertices(),
+                 indexBuffer->get().indices().toVector());
+    return meshes_.insert(name, std::move(stored));
   }
 
   void destroyMesh(const std::string &name) {
     if (selected_mesh_name_ == name) {
-      selected_mesh_name_.clear();
+      clearSelectedMesh();
     }
 
     meshes_.erase(name);
   }
 
   [[nodiscard]] auto hasMesh(const std::string &name) const -> bool {
-    auto it = meshes_.find(name);
-    return it != meshes_.end() && it->second && it->second->isValid();
+    const auto *mesh = meshes_.get(meshes_.find(name));
+    return mesh != nullptr && mesh->isValid();
   }
 
   [[nodiscard]] auto getMesh(const std::string &name) const
       -> std::shared_ptr<IMesh> {
-    auto it = meshes_.find(name);
-    return it == meshes_.end() ? nullptr : it->second;
+    return meshes_.get(name);
+  }
+
+  [[nodiscard]] auto meshHandle(const std::string &name) const -> MeshHandle {
+    return meshes_.find(name);
+  }
+
+  [[nodiscard]] auto mesh(MeshHandle handle) const noexcept -> IMesh * {
+    return meshes_.get(handle);
+  }
+
+  // dense views for per-frame iteration; no lookup or allocation
+  [[nodiscard]] auto meshes() const noexcept
+      -> const std::vector<std::shared_ptr<IMesh>> & {
+    return meshes_.resources();
+  }
+
+  [[nodiscard]] auto meshNames() const noexcept
+      -> const std::vector<std::string> & {
+    return meshes_.names();
   }
 
   [[nodiscard]] auto meshCount() const noexcept -> size_t {
@@ -93,68 +211,161 @@ public:
     return selected_mesh_name_;
   }
 
+  [[nodiscard]] auto selectedMesh() const noexcept -> MeshHandle {
+    return selected_mesh_;
+  }
+
   void selectMesh(std::string name) {
-    selected_mesh_name_ = hasMesh(name) ? std::move(name) : std::string{};
+    if (!hasMesh(name)) {
+      clearSelectedMesh();
+      return;
+    }
+
+    selected_mesh_ = meshes_.find(name);
+    selected_mesh_name_ = std::move(name);
   }
 
-  void clearSelectedMesh() { selected_mesh_name_.clear(); }
+  void clearSelectedMesh() {
+    selected_mesh_ = {};
+    selected_mesh_name_.clear();
+  }
 
   // Texture management
-  void createTexture(const std::string &name, const TextureDesc &desc) {
+  auto createTexture(const std::string &name, const TextureDesc &desc)
+      -> TextureHandle {
     auto texture = std::make_shared<Texture>(device_, command_pool_);
     texture->update(desc);
-    textures_[name] = std::move(texture);
+    const auto handle = textures_.insert(name, std::move(texture));
+    registerTexture(name);
+    return handle;
   }
 
-  void createTexture(const std::string &name, TextureDesc &&desc) {
+  auto createTexture(const std::string &name, TextureDesc &&desc)
+      -> TextureHandle {
     auto texture = std::make_shared<Texture>(device_, command_pool_);
     texture->update(desc);
-    textures_[name] = std::move(texture);
+    const auto handle = textures_.insert(name, std::move(texture));
+    registerTexture(name);
+    return handle;
   }
 
-  void createTexture(const std::string &name, const std::string &filePath) {
-    createTexture(name, TextureDesc::textureFile(filePath));
+  auto createTexture(const std::string &name, const std::string &filePath)
+      -> TextureHandle {
+    return createTexture(name, TextureDesc::textureFile(filePath));
   }
 
-  void createCubemap(const std::string &name,
+  auto createCubemap(const std::string &name,
                      const std::array<std::string, 6> &facePaths,
-                     VkFormat format = VK_FORMAT_R8G8B8A8_SRGB) {
-    createCubemap(name, CubemapDesc::files(facePaths, format));
+                     VkFormat format = VK_FORMAT_R8G8B8A8_SRGB)
+      -> CubemapHandle {
+    return createCubemap(name, CubemapDesc::files(facePaths, format));
   }
 
-  void createCubemap(const std::string &name, const CubemapDesc &desc) {
+  auto createCubemap(const std::string &name, const CubemapDesc &desc)
+      -> CubemapHandle {
     auto cubemap = std::make_shared<Cubemap>(device_, command_pool_);
     cubemap->update(desc);
-    cubemaps_[name] = std::move(cubemap);
+    return cubemaps_.insert(name, std::move(cubemap));
   }
 
-  void createCubemap(const std::string &name, CubemapDesc &&desc) {
+  auto createCubemap(const std::string &name, CubemapDesc &&desc)
+      -> CubemapHandle {
     auto cubemap = std::make_shared<Cubemap>(device_, command_pool_);
     cubemap->update(desc);
-    cubemaps_[name] = std::move(cubemap);
+    return cubemaps_.insert(name, std::move(cubemap));
   }
 
   [[nodiscard]] auto getCubemap(const std::string &name) const
       -> std::shared_ptr<Cubemap> {
-    auto it = cubemaps_.find(name);
-    return it == cubemaps_.end() ? nullptr : it->second;
+    return cubemaps_.get(name);
   }
 
   [[nodiscard]] auto getTexture(const std::string &name) const
       -> std::shared_ptr<Texture> {
-    auto it = textures_.find(name);
-    return it == textures_.end() ? nullptr : it->second;
+    return textures_.get(name);
+  }
+
+  [[nodiscard]] auto textureHandle(const std::string &name) const
+      -> TextureHandle {
+    return textures_.find(name);
   }
 
-  void destroyTexture(const std::string &name) { textures_.erase(name); }
+  [[nodiscard]] auto texture(TextureHandle handle) const noexcept
+      -> Texture * {
+    return textures_.get(handle);
+  }
+
+  [[nodiscard]] auto cubemapHandle(const std::string &name) const
+      -> CubemapHandle {
+    return cubemaps_.find(name);
+  }
+
+  [[nodiscard]] auto cubemap(CubemapHandle handle) const noexcept
+      -> Cubemap * {
+    return cubemaps_.get(handle);
+  }
+
+  void destroyTexture(const std::string &name) {
+    releaseIndex(texture_indices_, name, &BindlessTable::releaseTexture);
+    textures_.erase(name);
+  }
 
   void destroyCubemap(const std::string &name) { cubemaps_.erase(name); }
 
+  // Bindless resources: every texture and storage buffer gets a fixed slot in
+  // one descriptor set that passes bind at BindlessTable::kSet
+  void enableBindless(const BindlessDesc &desc = {}) {
+    if (bindless_) {
+      return;
+    }
+
+    if (!device_.descriptorIndexing()) {
+      VKR_RES_WARN("Bindless resources need DeviceDesc::descriptorIndexing; "
+                   "keeping per-pass descriptor sets");
+      return;
+    }
+
+    bindless_ = std::make_unique<BindlessTable>(device_, desc);
+    for (const auto &name : textures_.names()) {
+      registerTexture(name);
+    }
+    for (const auto &[name, _] : storage_buffers_) {
+      registerStorageBuffer(name);
+    }
+  }
+
+  [[nodiscard]] auto bindless() const noexcept -> const BindlessTable * {
+    return bindless_.get();
+  }
+
+  [[nodiscard]] auto textureIndex(const std::string &name) const -> uint32_t {
+    return findIndex(texture_indices_, name);
+  }
+
+  [[nodiscard]] auto storageBufferIndex(const std::string &name) const
+      -> uint32_t {
+    return findIndex(buffer_indices_, name);
+  }
+
+  // changes whenever a mesh, texture, cubemap or buffer is added or removed
+  [[nodiscard]] auto version() const noexcept -> uint64_t {
+    return uniform_buffers_.version() + instance_buffers_.version() +
+           textures_.version() + cubemaps_.version() + meshes_.version();
+  }
+
   // Counts
   [[nodiscard]] auto uniformBufferCount() const noexcept -> size_t {
     return uniform_buffers_.size();
   }
 
+  [[nodiscard]] auto instanceBufferCount() const noexcept -> size_t {
+    return instance_buffers_.size();
+  }
+
+  [[nodiscard]] auto storageBufferCount() const noexcept -> size_t {
+    return storage_buffers_.size();
+  }
+
   [[nodiscard]] auto textureCount() const noexcept -> size_t {
     return textures_.size();
   }
@@ -170,11 +381,21 @@ public:
   // Names
   [[nodiscard]] auto listUniformBufferNames() const
       -> std::vector<std::string> {
-    return listResourceNames(uniform_buffers_);
+    return uniform_buffers_.names();
+  }
+
+  [[nodiscard]] auto listInstanceBufferNames() const
+      -> std::vector<std::string> {
+    return instance_buffers_.names();
+  }
+
+  [[nodiscard]] auto listStorageBufferNames() const
+      -> std::vector<std::string> {
+    return listResourceNames(storage_buffers_);
   }
 
   [[nodiscard]] auto listTextureNames() const -> std::vector<std::string> {
-    return listResourceNames(textures_);
+    return textures_.names();
   }
 
   [[nodiscard]] auto listTextureImageNames() const -> std::vector<std::string> {
@@ -182,48 +403,34 @@ public:
   }
 
   [[nodiscard]] auto listCubemapNames() const -> std::vector<std::string> {
-    return listResourceNames(cubemaps_);
+    return cubemaps_.names();
   }
 
   [[nodiscard]] auto listMeshNames() const -> std::vector<std::string> {
-    return listResourceNames(meshes_);
+    return meshes_.names();
   }
 
   // Lists
   [[nodiscard]] auto listUniformBuffers() const
       -> std::vector<std::shared_ptr<IFrameUniformBufferSet>> {
-    return listResources(uniform_buffers_);
+    return uniform_buffers_.resources();
   }
 
   [[nodiscard]] auto listTextures() const
       -> std::vector<std::shared_ptr<Texture>> {
-    return listResources(textures_);
+    return textures_.resources();
   }
 
   [[nodiscard]] auto listCubemaps() const
       -> std::vector<std::shared_ptr<Cubemap>> {
-    return listResources(cubemaps_);
+    return cubemaps_.resources();
   }
 
   [[nodiscard]] auto listMeshes() const -> std::vector<std::shared_ptr<IMesh>> {
-    return listResources(meshes_);
+    return meshes_.resources();
   }
 
 private:
-  template <typename ResourceType>
-  [[nodiscard]] static auto listResources(
-      const std::unordered_map<std::string, std::shared_ptr<ResourceType>>
-          &resourceMap) -> std::vector<std::shared_ptr<ResourceType>> {
-    std::vector<std::shared_ptr<ResourceType>> resources;
-    resources.reserve(resourceMap.size());
-
-    for (const auto &[_, resource] : resourceMap) {
-      resources.push_back(resource);
-    }
-
-    return resources;
-  }
-
   template <typename ResourceType>
   [[nodiscard]] static auto listResourceNames(
       const std::unordered_map<std::string, ResourceType> &resourceMap)
@@ -238,6 +445,56 @@ private:
     return names;
   }
 
+  using IndexMap = std::unordered_map<std::string, uint32_t>;
+
+  [[nodiscard]] static auto findIndex(const IndexMap &indices,
+                                      const std::string &name) -> uint32_t {
+    auto it = indices.find(name);
+    return it == indices.end() ? BindlessTable::kInvalidIndex : it->second;
+  }
+
+  void releaseIndex(IndexMap &indices, const std::string &name,
+                    void (BindlessTable::*release)(uint32_t)) {
+    auto it = indices.find(name);
+    if (it == indices.end()) {
+      return;
+    }
+
+    if (bindless_) {
+      ((*bindless_).*release)(it->second);
+    }
+    indices.erase(it);
+  }
+
+  // a replaced resource gets a new slot; the old one may still be sampled
+  void registerTexture(const std::string &name) {
+    if (!bindless_) {
+      return;
+    }
+
+    releaseIndex(texture_indices_, name, &BindlessTable::releaseTexture);
+    const auto *texture = textures_.get(textures_.find(name));
+    if (!texture->hasSampler()) {
+      VKR_RES_WARN("Texture '{}' has no sampler; not added to the bindless "
+                   "table",
+                   name);
+      return;
+    }
+
+    texture_indices_[name] = bindless_->addTexture(texture->descriptorInfo());
+  }
+
+  void registerStorageBuffer(const std::string &name) {
+    if (!bindless_) {
+      return;
+    }
+
+    releaseIndex(buffer_indices_, name, &BindlessTable::releaseBuffer);
+    const auto &buffer = storage_buffers_.at(name);
+    buffer_indices_[name] = bindless_->addBuffer(
+        VkDescriptorBufferInfo{buffer->buffer(), 0, buffer->size()});
+  }
+
 private:
   // dependencies
   const core::Device &device_;
@@ -245,12 +502,23 @@ private:
   const core::CommandBuffers &command_buffers_;
 
   // components
-  std::unordered_map<std::string, std::shared_ptr<IFrameUniformBufferSet>>
+  ResourceRegistry<IFrameUniformBufferSet, UniformBufferHandle>
       uniform_buffers_{};
-  std::unordered_map<std::string, std::shared_ptr<Texture>> textures_{};
-  std::unordered_map<std::string, std::shared_ptr<Cubemap>> cubemaps_{};
-  std::unordered_map<std::string, std::shared_ptr<IMesh>> meshes_{};
+  ResourceRegistry<IInstanceBuffer, InstanceBufferHandle> instance_buffers_{};
+  std::unordered_map<std::string, std::shared_ptr<resource::Buffer>>
+      storage_buffers_{};
+  std::unordered_map<std::string, std::shared_ptr<DrawDataStream>>
+      draw_data_{};
+  ResourceRegistry<Texture, TextureHandle> textures_{};
+  ResourceRegistry<Cubemap, CubemapHandle> cubemaps_{};
+  ResourceRegistry<IMesh, MeshHandle> meshes_{};
+  std::unique_ptr<BindlessTable> bindless_{};
+
+  // states
   std::string selected_mesh_name_{};
+  MeshHandle selected_mesh_{};
+  IndexMap texture_indices_{};
+  IndexMap buffer_indices_{};
 };
 
 } // namespace vkr::scene
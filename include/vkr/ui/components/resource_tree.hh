@@ -2,6 +2,7 @@
 
 #include "vkr/scene/scene.hh"
 #include "vkr/ui/components/ui_component.hh"
+#include <cstdint>
 #include <imgui.h>
 #include <string>
 #include <vector>
@@ -22,7 +23,15 @@ private:
   std::string selected_name_;
   bool show_empty_groups_{true};
 
-  void renderCategory(const char *type, std::vector<std::string> names,
+  // sorted name lists, rebuilt only when scene resources change
+  uint64_t scene_version_{UINT64_MAX};
+  std::vector<std::string> mesh_names_{};
+  std::vector<std::string> uniform_buffer_names_{};
+  std::vector<std::string> texture_names_{};
+  std::vector<std::string> cubemap_names_{};
+
+  void refreshNames();
+  void renderCategory(const char *type, const std::vector<std::string> &names,
                       size_t count);
   void renderSelectedResource();
 };
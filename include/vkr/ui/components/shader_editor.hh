@@ -4,6 +4,7 @@
 #include "vkr/exec/render/graph.hh"
 #include "vkr/pipeline/graphics_pipeline.hh"
 #include "vkr/ui/components/ui_component.hh"
+#include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <optional>
@@ -45,6 +46,19 @@ private:
     }
   };
 
+  // a rebuild handed to the pipeline's worker; resolved once the pipeline
+  // reports the request as committed or failed
+  struct PendingApply {
+    uint64_t request{0};
+    bool hotReload{false};
+    bool saveVert{false};
+    bool saveFrag{false};
+    std::string oldVertSource{};
+    std::string oldFragSource{};
+    std::string nextVertSource{};
+    std::string nextFragSource{};
+  };
+
   // dependencies
   exec::RenderGraph &graph_;
 
@@ -62,6 +76,7 @@ private:
   ShaderEditorFileState vert_file_{};
   ShaderEditorFileState frag_file_{};
   std::unordered_map<std::string, ShaderEditorPipelineState> pipeline_files_{};
+  std::unordered_map<std::string, PendingApply> pending_applies_{};
 
   // pipeline control
   [[nodiscard]] auto collectTargets() -> std::vector<PipelineTarget>;
@@ -75,6 +90,7 @@ private:
   void reloadFromPipelineIfChanged();
   void refreshFileBackedShaders(const std::vector<PipelineTarget> &targets);
   [[nodiscard]] auto applyToPipeline(bool saveFiles = true) -> bool;
+  void finishPendingApplies(const std::vector<PipelineTarget> &targets);
   void renderTargetSelector(const std::vector<PipelineTarget> &targets);
 
   // editor state
@@ -133,7 +133,7 @@ private:
   scene::Scene &scene_;
   const util::AssetSystem &asset_system_;
   scene::CameraDesc &camera_;
-  exec::OffscreenTarget &offscreen_target_;
+  exec::OffscreenTarget *offscreen_target_;
   const pipeline::RenderPass &render_pass_;
   const pipeline::DescriptorPool &descriptor_pool_;
   exec::RenderGraph &graph_;
@@ -168,6 +168,7 @@ private:
   void renderMainMenu();
   void renderWorkspacePanels();
   void renderThemeControls();
+  [[nodiscard]] auto viewportWrite() const -> pipeline::DescriptorSetWriteDesc;
 };
 
 } // namespace vkr::ui
@@ -113,6 +113,9 @@ public:
   [[nodiscard]] static auto compileSlang(const SlangCompileDesc &desc)
       -> ShaderCompileResult;
 
+  [[nodiscard]] static auto glslCompilerVersion() -> std::string;
+  [[nodiscard]] static auto slangCompilerVersion() -> std::string;
+
 private:
   [[nodiscard]] static auto loadSource(const GlslCompileDesc &desc)
       -> std::string;
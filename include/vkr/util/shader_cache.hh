@@ -0,0 +1,106 @@
+#pragma once
+
+#include "vkr/util/compiler.hh"
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vkr::util {
+
+struct ShaderCacheDesc {
+  bool enabled{true};
+  std::string directory{"shader_cache"};
+  uint32_t memoryEntries{64};
+
+  [[nodiscard]] auto isValid() const noexcept -> bool {
+    return !enabled || (!directory.empty() && memoryEntries > 0);
+  }
+
+  template <typename Archive> auto serialize(Archive &ar) -> void {
+    ar("enabled", enabled);
+    ar("directory", directory);
+    ar("memoryEntries", memoryEntries);
+  }
+};
+
+struct ShaderCacheStats {
+  uint64_t memoryHits{0};
+  uint64_t diskHits{0};
+  uint64_t misses{0};
+  double compileMilliseconds{0.0};
+  double loadMilliseconds{0.0};
+
+  [[nodiscard]] auto lookups() const noexcept -> uint64_t {
+    return memoryHits + diskHits + misses;
+  }
+
+  [[nodiscard]] auto hitRate() const noexcept -> double {
+    const uint64_t total = lookups();
+    return total == 0 ? 0.0
+                      : static_cast<double>(memoryHits + diskHits) / total;
+  }
+};
+
+class ShaderCache {
+public:
+  [[nodiscard]] static auto instance() -> ShaderCache &;
+
+  ShaderCache(const ShaderCache &) = delete;
+  auto operator=(const ShaderCache &) -> ShaderCache & = delete;
+
+  void configure(const ShaderCacheDesc &desc);
+  void clear();
+
+  [[nodiscard]] auto compileGlsl(const GlslCompileDesc &desc)
+      -> ShaderCompileResult;
+  [[nodiscard]] auto compileSlang(const SlangCompileDesc &desc)
+      -> ShaderCompileResult;
+
+  [[nodiscard]] auto stats() const -> ShaderCacheStats;
+  void logStats() const;
+
+private:
+  struct Entry {
+    uint64_t key{0};
+    std::vector<uint32_t> spv{};
+  };
+
+  ShaderCache() = default;
+
+  // components
+  ShaderCacheDesc desc_{};
+
+  // states
+  mutable std::mutex mutex_{};
+  std::list<Entry> lru_{};
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> entries_{};
+  // keys being loaded or compiled; concurrent requests wait on the first
+  std::unordered_map<uint64_t, std::shared_future<ShaderCompileResult>>
+      pending_{};
+  ShaderCacheStats stats_{};
+
+  // helpers
+  [[nodiscard]] auto settings() const -> ShaderCacheDesc;
+  [[nodiscard]] auto
+  fetch(uint64_t key, const std::string &label, const std::string &directory,
+        const std::function<ShaderCompileResult()> &compile)
+      -> ShaderCompileResult;
+  [[nodiscard]] auto lookupMemory(uint64_t key, std::vector<uint32_t> &spv)
+      -> bool;
+  [[nodiscard]] static auto lookupDisk(const std::string &directory,
+                                       uint64_t key,
+                                       std::vector<uint32_t> &spv) -> bool;
+  static void storeDisk(const std::string &directory, uint64_t key,
+                        const std::vector<uint32_t> &spv);
+  void insert(uint64_t key, const std::vector<uint32_t> &spv);
+  [[nodiscard]] static auto blobPath(const std::string &directory,
+                                     uint64_t key) -> std::filesystem::path;
+};
+
+} // namespace vkr::util
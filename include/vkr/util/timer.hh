@@ -21,6 +21,10 @@ public:
 
   void maxFPS(float maxFPS) noexcept { max_fps_ = maxFPS; }
 
+  // advance time by a constant step per frame instead of the wall clock so
+  // animated content is reproducible across runs; zero restores real time
+  void fixedStep(float seconds) noexcept { fixed_step_ = seconds; }
+
   [[nodiscard]] auto deltaTime() const noexcept -> float { return delta_time_; }
 
   [[nodiscard]] auto rawDeltaTime() const noexcept -> float {
@@ -45,6 +49,10 @@ public:
 
   [[nodiscard]] auto maxFPS() const noexcept -> float { return max_fps_; }
 
+  [[nodiscard]] auto fixedStep() const noexcept -> float {
+    return fixed_step_;
+  }
+
 private:
   using Clock = std::chrono::steady_clock;
   using TimePoint = std::chrono::time_point<Clock>;
@@ -60,6 +68,7 @@ private:
 
   float elapsed_time_{0.0f};
   float max_fps_{0.0f};
+  float fixed_step_{0.0f};
 
   uint64_t frame_count_{0};
 
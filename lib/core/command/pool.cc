@@ -18,10 +18,15 @@ CommandPool::CommandPool(const Device &device, CommandPoolDesc &desc)
     VKR_CORE_ERROR("Failed to create command pool!");
   }
 
+  uploader_ = std::make_unique<UploadContext>(device_, queue_family_, queue_,
+                                              desc_.upload);
+
   VKR_CORE_INFO("Command pool created successfully.");
 }
 
 CommandPool::~CommandPool() {
+  uploader_.reset();
+
   if (vk_command_pool_ != VK_NULL_HANDLE) {
     vkDestroyCommandPool(device_.device(), vk_command_pool_, nullptr);
     vk_command_pool_ = VK_NULL_HANDLE;
@@ -0,0 +1,440 @@
+#include "vkr/core/command/upload.hh"
+#include "vkr/logger.hh"
+#include <cstddef>
+#include <cstring>
+
+namespace vkr::core {
+namespace {
+
+auto alignUp(uint64_t value, uint64_t alignment) noexcept -> uint64_t {
+  if (alignment <= 1) {
+    return value;
+  }
+
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+UploadContext::UploadContext(const Device &device, uint32_t queueFamily,
+                             VkQueue queue, const UploadContextDesc &desc)
+    : device_(device), desc_(desc), queue_(queue) {
+  if (!desc_.isValid()) {
+    VKR_CORE_ERROR("UploadContextDesc is invalid");
+  }
+
+  if (device_.timelineSemaphores()) {
+    timeline_ = &device_.timeline(queue_);
+  }
+
+  VkCommandPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                   VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+  poolInfo.queueFamilyIndex = queueFamily;
+
+  if (vkCreateCommandPool(device_.device(), &poolInfo, nullptr,
+                          &vk_command_pool_) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to create upload command pool");
+  }
+
+  std::vector<VkCommandBuffer> commandBuffers(desc_.maxBatchesInFlight);
+
+  VkCommandBufferAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  allocInfo.commandPool = vk_command_pool_;
+  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocInfo.commandBufferCount = desc_.maxBatchesInFlight;
+
+  if (vkAllocateCommandBuffers(device_.device(), &allocInfo,
+                               commandBuffers.data()) != VK_SUCCESS) {
+    destroy();
+    VKR_CORE_ERROR("Failed to allocate upload command buffers");
+  }
+
+  batches_.resize(desc_.maxBatchesInFlight);
+  for (uint32_t i = 0; i < desc_.maxBatchesInFlight; ++i) {
+    batches_[i].commandBuffer = commandBuffers[i];
+    free_batches_.push_back(desc_.maxBatchesInFlight - 1 - i);
+
+    if (timeline_ != nullptr) {
+      continue;
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    if (vkCreateFence(device_.device(), &fenceInfo, nullptr,
+                      &batches_[i].fence) != VK_SUCCESS) {
+      destroy();
+      VKR_CORE_ERROR("Failed to create upload fence");
+    }
+  }
+
+  try {
+    vk_staging_buffer_ = createBuffer(desc_.stagingSize, staging_allocation_);
+  } catch (...) {
+    destroy();
+    throw;
+  }
+}
+
+UploadContext::~UploadContext() { destroy(); }
+
+auto UploadContext::stage(const void *data, VkDeviceSize size,
+                          VkDeviceSize alignment) -> StagingRange {
+  if (size == 0) {
+    VKR_CORE_ERROR("Cannot stage an empty upload");
+  }
+
+  stats_.uploads++;
+  stats_.uploadedBytes += size;
+
+  if (size > desc_.stagingSize) {
+    OverflowBuffer overflow{};
+    overflow.buffer = createBuffer(size, overflow.allocation);
+    if (data != nullptr) {
+      std::memcpy(overflow.allocation.mapped, data, static_cast<size_t>(size));
+    }
+
+    const StagingRange range{overflow.buffer, 0, overflow.allocation.mapped};
+    if (recording_ == NO_BATCH) {
+      beginBatch();
+    }
+    batches_[recording_].overflow.push_back(overflow);
+    stats_.overflowBuffers++;
+    return range;
+  }
+
+  const uint64_t ringSize = desc_.stagingSize;
+  uint64_t offset = 0;
+
+  while (true) {
+    retireCompleted();
+
+    if (!busy()) {
+      ring_head_ = 0;
+      ring_tail_ = 0;
+    }
+
+    // align the position inside the buffer rather than the running head: the
+    // ring size need not be a multiple of every alignment, e.g. 12 for RGB
+    const uint64_t head = ring_head_ % ringSize;
+    uint64_t physical = alignUp(head, alignment);
+    if (physical + size > ringSize) {
+      physical = ringSize;
+    }
+    offset = ring_head_ + (physical - head);
+
+    if (offset + size - ring_tail_ <= ringSize) {
+      break;
+    }
+
+    // the staging ring is full: push the recording batch out and wait for
+    // the oldest batch to hand its range back
+    if (in_flight_.empty()) {
+      flush();
+    }
+
+    stats_.stalls++;
+    retireOldest();
+  }
+
+  ring_head_ = offset + size;
+  if (recording_ == NO_BATCH) {
+    beginBatch();
+  }
+
+  const VkDeviceSize physical = offset % ringSize;
+  auto *mapped = static_cast<std::byte *>(staging_allocation_.mapped) + physical;
+  if (data != nullptr) {
+    std::memcpy(mapped, data, static_cast<size_t>(size));
+  }
+
+  return {vk_staging_buffer_, physical, mapped};
+}
+
+auto UploadContext::commandBuffer() -> VkCommandBuffer {
+  if (recording_ == NO_BATCH) {
+    beginBatch();
+  }
+
+  return batches_[recording_].commandBuffer;
+}
+
+void UploadContext::copyBuffer(const void *data, VkDeviceSize size,
+                               VkBuffer dst, VkDeviceSize dstOffset) {
+  if (dst == VK_NULL_HANDLE) {
+    VKR_CORE_ERROR("Cannot upload into a null buffer");
+  }
+
+  const StagingRange range = stage(data, size);
+
+  VkBufferCopy copyRegion{};
+  copyRegion.srcOffset = range.offset;
+  copyRegion.dstOffset = dstOffset;
+  copyRegion.size = size;
+  vkCmdCopyBuffer(commandBuffer(), range.buffer, dst, 1, &copyRegion);
+}
+
+auto UploadContext::flush() -> uint64_t {
+  if (recording_ == NO_BATCH) {
+    return next_value_ - 1;
+  }
+
+  auto &batch = batches_[recording_];
+
+  VkMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+  vkCmdPipelineBarrier(batch.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0,
+                       nullptr, 0, nullptr);
+
+  if (vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to end upload command buffer");
+  }
+
+  SubmitSemaphores semaphores{};
+  if (timeline_ != nullptr) {
+    batch.timelineValue = timeline_->next();
+    semaphores.signal(timeline_->point(batch.timelineValue));
+  }
+
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &batch.commandBuffer;
+  semaphores.apply(submitInfo);
+
+  if (vkQueueSubmit(queue_, 1, &submitInfo, batch.fence) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to submit upload command buffer");
+  }
+
+  batch.ringEnd = ring_head_;
+  in_flight_.push_back(recording_);
+  recording_ = NO_BATCH;
+  stats_.submits++;
+
+  return batch.value;
+}
+
+auto UploadContext::isComplete(uint64_t batch) -> bool {
+  retireCompleted();
+  return batch <= completed_value_;
+}
+
+void UploadContext::wait(uint64_t batch) {
+  if (recording_ != NO_BATCH && batch >= batches_[recording_].value) {
+    flush();
+  }
+
+  while (!in_flight_.empty() && completed_value_ < batch) {
+    retireOldest();
+  }
+}
+
+auto UploadContext::submission(uint64_t batch) const -> TimelinePoint {
+  if (timeline_ == nullptr || batch <= completed_value_) {
+    return {};
+  }
+
+  for (const uint32_t index : in_flight_) {
+    if (batches_[index].value == batch) {
+      return timeline_->point(batches_[index].timelineValue);
+    }
+  }
+
+  return {};
+}
+
+void UploadContext::waitIdle() {
+  flush();
+
+  while (!in_flight_.empty()) {
+    retireOldest();
+  }
+}
+
+void UploadContext::logStats() const {
+  VKR_CORE_INFO("Uploads: {} ({:.2f} MiB) in {} submit(s), {} staging "
+                "stall(s), {} overflow buffer(s)",
+                stats_.uploads,
+                static_cast<double>(stats_.uploadedBytes) / 1048576.0,
+                stats_.submits, stats_.stalls, stats_.overflowBuffers);
+}
+
+void UploadContext::beginBatch() {
+  if (free_batches_.empty()) {
+    stats_.stalls++;
+    retireOldest();
+  }
+
+  recording_ = free_batches_.back();
+  free_batches_.pop_back();
+
+  auto &batch = batches_[recording_];
+  batch.value = next_value_++;
+
+  if (timeline_ == nullptr &&
+      vkResetFences(device_.device(), 1, &batch.fence) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to reset upload fence");
+  }
+
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+  if (vkBeginCommandBuffer(batch.commandBuffer, &beginInfo) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to begin upload command buffer");
+  }
+
+  // copies may overwrite resources that earlier submissions are still reading
+  vkCmdPipelineBarrier(batch.commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                       nullptr, 0, nullptr);
+}
+
+void UploadContext::retireOldest() {
+  if (in_flight_.empty()) {
+    return;
+  }
+
+  const uint32_t index = in_flight_.front();
+  auto &batch = batches_[index];
+
+  waitBatch(batch);
+
+  in_flight_.pop_front();
+  completed_value_ = batch.value;
+  ring_tail_ = batch.ringEnd;
+  releaseOverflow(batch);
+  free_batches_.push_back(index);
+}
+
+void UploadContext::retireCompleted() {
+  while (!in_flight_.empty()) {
+    if (!batchSignaled(batches_[in_flight_.front()])) {
+      return;
+    }
+
+    retireOldest();
+  }
+}
+
+auto UploadContext::batchSignaled(const Batch &batch) const -> bool {
+  if (timeline_ != nullptr) {
+    return timeline_->reached(batch.timelineValue);
+  }
+
+  const VkResult result = vkGetFenceStatus(device_.device(), batch.fence);
+  if (result != VK_SUCCESS && result != VK_NOT_READY) {
+    VKR_CORE_ERROR("Failed to query upload fence status");
+  }
+
+  return result == VK_SUCCESS;
+}
+
+void UploadContext::waitBatch(const Batch &batch) const {
+  if (timeline_ != nullptr) {
+    timeline_->wait(batch.timelineValue);
+    return;
+  }
+
+  if (vkWaitForFences(device_.device(), 1, &batch.fence, VK_TRUE,
+                      UINT64_MAX) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to wait for upload fence");
+  }
+}
+
+void UploadContext::releaseOverflow(Batch &batch) noexcept {
+  for (auto &overflow : batch.overflow) {
+    vkDestroyBuffer(device_.device(), overflow.buffer, nullptr);
+    device_.allocator().free(overflow.allocation);
+  }
+
+  batch.overflow.clear();
+}
+
+auto UploadContext::createBuffer(VkDeviceSize size,
+                                 MemoryAllocation &allocation) -> VkBuffer {
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = size;
+  bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  VkBuffer buffer{VK_NULL_HANDLE};
+  if (vkCreateBuffer(device_.device(), &bufferInfo, nullptr, &buffer) !=
+      VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to create upload staging buffer");
+  }
+
+  VkMemoryRequirements memRequirements{};
+  vkGetBufferMemoryRequirements(device_.device(), buffer, &memRequirements);
+
+  try {
+    allocation = device_.allocator().allocate(
+        memRequirements,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        MemoryResourceKind::Linear);
+  } catch (...) {
+    vkDestroyBuffer(device_.device(), buffer, nullptr);
+    throw;
+  }
+
+  if (vkBindBufferMemory(device_.device(), buffer, allocation.memory,
+                         allocation.offset) != VK_SUCCESS) {
+    vkDestroyBuffer(device_.device(), buffer, nullptr);
+    device_.allocator().free(allocation);
+    VKR_CORE_ERROR("Failed to bind upload staging buffer memory");
+  }
+
+  return buffer;
+}
+
+void UploadContext::destroy() noexcept {
+  if (recording_ != NO_BATCH) {
+    vkEndCommandBuffer(batches_[recording_].commandBuffer);
+    recording_ = NO_BATCH;
+  }
+
+  for (const uint32_t index : in_flight_) {
+    if (timeline_ != nullptr) {
+      (void)device_.waitSemaphore(timeline_->semaphore(),
+                                  batches_[index].timelineValue, UINT64_MAX);
+    } else {
+      vkWaitForFences(device_.device(), 1, &batches_[index].fence, VK_TRUE,
+                      UINT64_MAX);
+    }
+  }
+
+  for (auto &batch : batches_) {
+    if (batch.fence != VK_NULL_HANDLE) {
+      vkDestroyFence(device_.device(), batch.fence, nullptr);
+      batch.fence = VK_NULL_HANDLE;
+    }
+
+    releaseOverflow(batch);
+  }
+
+  in_flight_.clear();
+  free_batches_.clear();
+  batches_.clear();
+
+  if (vk_command_pool_ != VK_NULL_HANDLE) {
+    vkDestroyCommandPool(device_.device(), vk_command_pool_, nullptr);
+    vk_command_pool_ = VK_NULL_HANDLE;
+  }
+
+  if (vk_staging_buffer_ != VK_NULL_HANDLE) {
+    vkDestroyBuffer(device_.device(), vk_staging_buffer_, nullptr);
+    vk_staging_buffer_ = VK_NULL_HANDLE;
+  }
+
+  device_.allocator().free(staging_allocation_);
+}
+
+} // namespace vkr::core
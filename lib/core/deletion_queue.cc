@@ -0,0 +1,140 @@
+#include "vkr/core/deletion_queue.hh"
+#include "vkr/logger.hh"
+#include <algorithm>
+#include <utility>
+
+namespace vkr::core {
+
+DeletionQueue::~DeletionQueue() { flush(); }
+
+void DeletionQueue::push(std::function<void()> deleter) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back({epoch_, std::move(deleter)});
+  stats_.deferred++;
+  stats_.peakPending = std::max(stats_.peakPending, entries_.size());
+}
+
+auto DeletionQueue::addSubmitter() -> uint32_t {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (uint32_t index = 0; index < submitters_.size(); ++index) {
+    if (!submitters_[index].active) {
+      submitters_[index] = {.active = true};
+      return index;
+    }
+  }
+
+  submitters_.push_back({.active = true});
+  return static_cast<uint32_t>(submitters_.size() - 1);
+}
+
+void DeletionQueue::removeSubmitter(uint32_t submitter) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (submitter < submitters_.size()) {
+    submitters_[submitter].active = false;
+  }
+}
+
+auto DeletionQueue::advance() -> uint64_t {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return epoch_++;
+}
+
+void DeletionQueue::collect(uint32_t submitter, uint64_t retiredEpoch) {
+  std::deque<Entry> retired{};
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &current = registered(submitter);
+    current.retired = current.idle ? retiredEpoch
+                                   : std::max(current.retired, retiredEpoch);
+    current.idle = false;
+    collectRetired(retired);
+  }
+
+  run(retired);
+}
+
+void DeletionQueue::idle(uint32_t submitter) {
+  std::deque<Entry> retired{};
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    registered(submitter).idle = true;
+    collectRetired(retired);
+  }
+
+  run(retired);
+}
+
+void DeletionQueue::flush() {
+  std::deque<Entry> retired{};
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired.swap(entries_);
+    stats_.destroyed += retired.size();
+    stats_.flushes++;
+  }
+
+  run(retired);
+}
+
+auto DeletionQueue::epoch() const -> uint64_t {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return epoch_;
+}
+
+auto DeletionQueue::pending() const -> size_t {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+auto DeletionQueue::stats() const -> DeletionQueueStats {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void DeletionQueue::logStats() const {
+  const DeletionQueueStats current = stats();
+  VKR_CORE_INFO("Deferred destruction: {} object(s) released, {} destroyed, "
+                "peak {} pending, {} flush(es)",
+                current.deferred, current.destroyed, current.peakPending,
+                current.flushes);
+}
+
+auto DeletionQueue::registered(uint32_t index) -> Submitter & {
+  if (index >= submitters_.size() || !submitters_[index].active) {
+    VKR_CORE_ERROR("DeletionQueue submitter {} is not registered", index);
+  }
+
+  return submitters_[index];
+}
+
+// called with mutex_ held; the open epoch may still gain references from
+// work being recorded, so only closed epochs are collected
+void DeletionQueue::collectRetired(std::deque<Entry> &retired) {
+  uint64_t retiredByAll = epoch_ - 1;
+  for (const auto &other : submitters_) {
+    if (other.active && !other.idle) {
+      retiredByAll = std::min(retiredByAll, other.retired);
+    }
+  }
+
+  // entries are pushed in epoch order, so the retired ones form a prefix
+  while (!entries_.empty() && entries_.front().epoch <= retiredByAll) {
+    retired.push_back(std::move(entries_.front()));
+    entries_.pop_front();
+  }
+  stats_.destroyed += retired.size();
+}
+
+void DeletionQueue::run(std::deque<Entry> &entries) noexcept {
+  // deleters run outside the lock, they only call vkDestroy* and free memory
+  for (auto &entry : entries) {
+    entry.deleter();
+  }
+
+  entries.clear();
+}
+
+} // namespace vkr::core
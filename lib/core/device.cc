@@ -1,5 +1,6 @@
 #include "vkr/core/device.hh"
 #include "vkr/core/instance.hh"
+#include "vkr/core/sync/timeline.hh"
 #include "vkr/logger.hh"
 #include <algorithm>
 #include <set>
@@ -12,6 +13,10 @@ Device::Device(const Instance &instance, DeviceDesc &deviceDesc)
 
   pickPhysicalDevice();
   createLogicalDevice();
+  createQueueTimelines();
+  allocator_ = std::make_unique<MemoryAllocator>(*this, desc_.memory);
+  pipeline_cache_ = std::make_unique<PipelineCache>(*this, desc_.pipelineCache);
+  deletion_queue_ = std::make_unique<DeletionQueue>();
 
   for (const auto &ext : enabled_extensions_) {
     VKR_CORE_TRACE("Enabled Extension: {}", ext);
@@ -27,6 +32,10 @@ Device::Device(const Instance &instance, const Surface &surface,
 
   pickPhysicalDevice();
   createLogicalDevice();
+  createQueueTimelines();
+  allocator_ = std::make_unique<MemoryAllocator>(*this, desc_.memory);
+  pipeline_cache_ = std::make_unique<PipelineCache>(*this, desc_.pipelineCache);
+  deletion_queue_ = std::make_unique<DeletionQueue>();
 
   for (const auto &ext : enabled_extensions_) {
     VKR_CORE_TRACE("Enabled Extension: {}", ext);
@@ -36,6 +45,20 @@ Device::Device(const Instance &instance, const Surface &surface,
 }
 
 Device::~Device() {
+  if (deletion_queue_) {
+    waitIdle();
+    deletion_queue_->logStats();
+  }
+
+  if (pipeline_cache_) {
+    pipeline_cache_->logStats();
+  }
+
+  deletion_queue_.reset();
+  pipeline_cache_.reset();
+  allocator_.reset();
+  queue_timelines_.clear();
+
   if (vk_logical_device_ != VK_NULL_HANDLE) {
     vkDestroyDevice(vk_logical_device_, nullptr);
   }
@@ -46,6 +69,10 @@ void Device::waitIdle() const {
   if (vk_logical_device_ != VK_NULL_HANDLE) {
     vkDeviceWaitIdle(vk_logical_device_);
   }
+
+  if (deletion_queue_) {
+    deletion_queue_->flush();
+  }
 }
 
 void Device::pickPhysicalDevice() {
@@ -69,6 +96,9 @@ void Device::pickPhysicalDevice() {
     present_family_ = VK_QUEUE_FAMILY_IGNORED;
     compute_family_ = VK_QUEUE_FAMILY_IGNORED;
     transfer_family_ = VK_QUEUE_FAMILY_IGNORED;
+    timeline_semaphores_ = false;
+    descriptor_indexing_ = false;
+    draw_indirect_count_ = false;
 
     VkPhysicalDeviceProperties deviceProperties;
     vkGetPhysicalDeviceProperties(device, &deviceProperties);
@@ -104,6 +134,18 @@ void Device::pickPhysicalDevice() {
       continue;
     }
 
+    if (desc_.timelineSemaphore) {
+      resolveTimelineSemaphore(device);
+    }
+
+    if (desc_.descriptorIndexing) {
+      resolveDescriptorIndexing(device);
+    }
+
+    if (desc_.drawIndirectCount) {
+      resolveDrawIndirectCount();
+    }
+
     vk_physical_device_ = device;
     VKR_CORE_INFO("Selected device: {}", deviceProperties.deviceName);
     break;
@@ -141,8 +183,15 @@ void Device::createLogicalDevice() {
     queueCreateInfos.push_back(queueCreateInfo);
   }
 
+  VkPhysicalDeviceFeatures supportedFeatures{};
+  vkGetPhysicalDeviceFeatures(vk_physical_device_, &supportedFeatures);
+
   VkPhysicalDeviceFeatures deviceFeatures{};
   deviceFeatures.samplerAnisotropy = VK_TRUE;
+  deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+  deviceFeatures.drawIndirectFirstInstance =
+      supportedFeatures.drawIndirectFirstInstance;
+  enabled_features_ = deviceFeatures;
 
   VkDeviceCreateInfo createInfo{};
   createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -153,6 +202,29 @@ void Device::createLogicalDevice() {
 
   createInfo.pEnabledFeatures = &deviceFeatures;
 
+  VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures{};
+  timelineFeatures.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+  timelineFeatures.timelineSemaphore = VK_TRUE;
+  if (timeline_semaphores_) {
+    createInfo.pNext = &timelineFeatures;
+  }
+
+  VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+  indexingFeatures.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+  indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+  indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+  indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+  indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+  indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+  indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+  indexingFeatures.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+  if (descriptor_indexing_) {
+    indexingFeatures.pNext = const_cast<void *>(createInfo.pNext);
+    createInfo.pNext = &indexingFeatures;
+  }
+
   std::vector<const char *> enabledExtensionNames{};
   enabledExtensionNames.reserve(enabled_extensions_.size());
   for (const auto &extension : enabled_extensions_) {
@@ -200,6 +272,52 @@ void Device::createLogicalDevice() {
     vkGetDeviceQueue(vk_logical_device_, transfer_family_, 0,
                      &vk_transfer_queue_);
   }
+
+  if (timeline_semaphores_) {
+    vk_wait_semaphores_ = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(
+        vkGetDeviceProcAddr(vk_logical_device_, "vkWaitSemaphoresKHR"));
+    vk_get_semaphore_counter_value_ =
+        reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(
+            vkGetDeviceProcAddr(vk_logical_device_,
+                                "vkGetSemaphoreCounterValueKHR"));
+
+    if (vk_wait_semaphores_ == nullptr ||
+        vk_get_semaphore_counter_value_ == nullptr) {
+      VKR_CORE_ERROR("Failed to load VK_KHR_timeline_semaphore functions");
+    }
+  }
+
+  if (draw_indirect_count_) {
+    vk_cmd_draw_indexed_indirect_count_ =
+        reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(vk_logical_device_,
+                                "vkCmdDrawIndexedIndirectCountKHR"));
+
+    if (vk_cmd_draw_indexed_indirect_count_ == nullptr) {
+      VKR_CORE_ERROR("Failed to load VK_KHR_draw_indirect_count functions");
+    }
+  }
+}
+
+void Device::createQueueTimelines() {
+  if (!timeline_semaphores_) {
+    return;
+  }
+
+  for (VkQueue queue : {vk_graphics_queue_, vk_present_queue_,
+                        vk_compute_queue_, vk_transfer_queue_}) {
+    if (queue == VK_NULL_HANDLE ||
+        std::find(timeline_queues_.begin(), timeline_queues_.end(), queue) !=
+            timeline_queues_.end()) {
+      continue;
+    }
+
+    timeline_queues_.push_back(queue);
+    queue_timelines_.push_back(std::make_unique<TimelineSemaphore>(*this));
+  }
+
+  VKR_CORE_INFO("Timeline semaphores enabled, {} queue timeline(s)",
+                queue_timelines_.size());
 }
 
 void Device::queryDeviceSupport(VkPhysicalDevice device) {
@@ -286,6 +404,135 @@ auto Device::resolveExtensions() -> bool {
   return true;
 }
 
+void Device::resolveTimelineSemaphore(VkPhysicalDevice device) {
+  const std::string extension{VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME};
+  if (!hasExtension(extension)) {
+    VKR_CORE_WARN("{} is not available; falling back to fences", extension);
+    return;
+  }
+
+  auto getFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+      vkGetInstanceProcAddr(instance_.instance(),
+                            "vkGetPhysicalDeviceFeatures2KHR"));
+  if (getFeatures2 == nullptr) {
+    VKR_CORE_WARN("{} is not enabled on the instance; falling back to fences",
+                  VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    return;
+  }
+
+  VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures{};
+  timelineFeatures.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+
+  VkPhysicalDeviceFeatures2KHR features{};
+  features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+  features.pNext = &timelineFeatures;
+  getFeatures2(device, &features);
+
+  if (timelineFeatures.timelineSemaphore != VK_TRUE) {
+    VKR_CORE_WARN("timelineSemaphore feature is not supported; falling back "
+                  "to fences");
+    return;
+  }
+
+  if (std::find(enabled_extensions_.begin(), enabled_extensions_.end(),
+                extension) == enabled_extensions_.end()) {
+    enabled_extensions_.push_back(extension);
+  }
+  timeline_semaphores_ = true;
+}
+
+void Device::resolveDescriptorIndexing(VkPhysicalDevice device) {
+  const std::vector<std::string> extensions{
+      VK_KHR_MAINTENANCE3_EXTENSION_NAME,
+      VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME};
+  for (const auto &extension : extensions) {
+    if (!hasExtension(extension)) {
+      VKR_CORE_WARN("{} is not available; bindless resources disabled",
+                    extension);
+      return;
+    }
+  }
+
+  auto getFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+      vkGetInstanceProcAddr(instance_.instance(),
+                            "vkGetPhysicalDeviceFeatures2KHR"));
+  if (getFeatures2 == nullptr) {
+    VKR_CORE_WARN("{} is not enabled on the instance; bindless resources "
+                  "disabled",
+                  VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    return;
+  }
+
+  VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+  indexingFeatures.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+  VkPhysicalDeviceFeatures2KHR features{};
+  features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+  features.pNext = &indexingFeatures;
+  getFeatures2(device, &features);
+
+  if (indexingFeatures.runtimeDescriptorArray != VK_TRUE ||
+      indexingFeatures.descriptorBindingPartiallyBound != VK_TRUE ||
+      indexingFeatures.descriptorBindingUpdateUnusedWhilePending != VK_TRUE ||
+      indexingFeatures.descriptorBindingSampledImageUpdateAfterBind !=
+          VK_TRUE ||
+      indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind !=
+          VK_TRUE ||
+      indexingFeatures.shaderSampledImageArrayNonUniformIndexing != VK_TRUE ||
+      indexingFeatures.shaderStorageBufferArrayNonUniformIndexing != VK_TRUE) {
+    VKR_CORE_WARN("descriptor indexing features are incomplete; bindless "
+                  "resources disabled");
+    return;
+  }
+
+  auto getProperties2 =
+      reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+          vkGetInstanceProcAddr(instance_.instance(),
+                                "vkGetPhysicalDeviceProperties2KHR"));
+  if (getProperties2 == nullptr) {
+    VKR_CORE_WARN("descriptor indexing limits are unavailable; bindless "
+                  "resources disabled");
+    return;
+  }
+
+  descriptor_indexing_properties_ = {};
+  descriptor_indexing_properties_.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+  VkPhysicalDeviceProperties2KHR properties{};
+  properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+  properties.pNext = &descriptor_indexing_properties_;
+  getProperties2(device, &properties);
+  descriptor_indexing_properties_.pNext = nullptr;
+
+  for (const auto &extension : extensions) {
+    if (std::find(enabled_extensions_.begin(), enabled_extensions_.end(),
+                  extension) == enabled_extensions_.end()) {
+      enabled_extensions_.push_back(extension);
+    }
+  }
+  descriptor_indexing_ = true;
+}
+
+void Device::resolveDrawIndirectCount() {
+  const std::string extension{VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME};
+  if (!hasExtension(extension)) {
+    VKR_CORE_WARN("{} is not available; indirect draws run their full "
+                  "command range",
+                  extension);
+    return;
+  }
+
+  if (std::find(enabled_extensions_.begin(), enabled_extensions_.end(),
+                extension) == enabled_extensions_.end()) {
+    enabled_extensions_.push_back(extension);
+  }
+
+  draw_indirect_count_ = true;
+}
+
 void Device::resolveQueueFamilies(VkPhysicalDevice device) {
   for (uint32_t i = 0; i < queue_families_.size(); i++) {
     const auto &queueFamily = queue_families_[i];
@@ -323,6 +570,48 @@ void Device::resolveQueueFamilies(VkPhysicalDevice device) {
   }
 }
 
+auto Device::timeline(VkQueue queue) const -> TimelineSemaphore & {
+  for (size_t i = 0; i < timeline_queues_.size(); ++i) {
+    if (timeline_queues_[i] == queue) {
+      return *queue_timelines_[i];
+    }
+  }
+
+  VKR_CORE_ERROR("No timeline semaphore for the requested queue");
+}
+
+auto Device::waitSemaphore(VkSemaphore semaphore, uint64_t value,
+                           uint64_t timeout) const -> VkResult {
+  VkSemaphoreWaitInfoKHR waitInfo{};
+  waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+  waitInfo.semaphoreCount = 1;
+  waitInfo.pSemaphores = &semaphore;
+  waitInfo.pValues = &value;
+
+  return vk_wait_semaphores_(vk_logical_device_, &waitInfo, timeout);
+}
+
+void Device::cmdDrawIndexedIndirectCount(VkCommandBuffer commandBuffer,
+                                         VkBuffer buffer, VkDeviceSize offset,
+                                         VkBuffer countBuffer,
+                                         VkDeviceSize countOffset,
+                                         uint32_t maxDrawCount,
+                                         uint32_t stride) const {
+  vk_cmd_draw_indexed_indirect_count_(commandBuffer, buffer, offset,
+                                      countBuffer, countOffset, maxDrawCount,
+                                      stride);
+}
+
+auto Device::semaphoreCounterValue(VkSemaphore semaphore) const -> uint64_t {
+  uint64_t value = 0;
+  if (vk_get_semaphore_counter_value_(vk_logical_device_, semaphore,
+                                      &value) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to query timeline semaphore value");
+  }
+
+  return value;
+}
+
 auto Device::hasExtension(const std::string &extension) const noexcept -> bool {
   for (const auto &available : available_extensions_) {
     if (extension == available.extensionName) {
@@ -184,6 +184,16 @@ void Instance::resolveExtensions() {
     }
   }
 
+  // the device feature queries behind optional features such as timeline
+  // semaphores go through vkGetPhysicalDeviceFeatures2KHR on a 1.0 instance
+  const std::string properties2{
+      VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME};
+  if (supportsExtension(properties2) &&
+      std::find(enabled_extensions_.begin(), enabled_extensions_.end(),
+                properties2) == enabled_extensions_.end()) {
+    enabled_extensions_.push_back(properties2);
+  }
+
 #ifndef NDEBUG
   if (supportsExtension(VK_EXT_DEBUG_UTILS_EXTENSION_NAME) &&
       std::find(enabled_extensions_.begin(), enabled_extensions_.end(),
@@ -0,0 +1,402 @@
+#include "vkr/core/memory/allocator.hh"
+#include "vkr/core/device.hh"
+#include "vkr/logger.hh"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace vkr::core {
+namespace {
+
+auto alignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+    -> VkDeviceSize {
+  if (alignment <= 1) {
+    return value;
+  }
+
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+MemoryAllocator::MemoryAllocator(const Device &device,
+                                 const MemoryAllocatorDesc &desc)
+    : device_(device), desc_(desc) {
+  if (!desc_.isValid()) {
+    VKR_CORE_ERROR("MemoryAllocatorDesc is invalid");
+  }
+
+  vkGetPhysicalDeviceMemoryProperties(device_.physicalDevice(),
+                                      &memory_properties_);
+
+  VkPhysicalDeviceProperties properties{};
+  vkGetPhysicalDeviceProperties(device_.physicalDevice(), &properties);
+  buffer_image_granularity_ =
+      std::max<VkDeviceSize>(properties.limits.bufferImageGranularity, 1);
+  max_allocation_count_ = properties.limits.maxMemoryAllocationCount;
+
+  VKR_CORE_INFO("Memory allocator created: blockSize={} MiB, "
+                "bufferImageGranularity={}, maxMemoryAllocationCount={}",
+                desc_.blockSize >> 20U, buffer_image_granularity_,
+                max_allocation_count_);
+}
+
+MemoryAllocator::~MemoryAllocator() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (auto &pool : pools_) {
+    for (auto &block : pool.blocks) {
+      if (!block) {
+        continue;
+      }
+
+      if (block->allocationCount != 0) {
+        VKR_CORE_WARN("Memory allocator destroyed with {} live allocation(s) "
+                      "in a {} byte block",
+                      block->allocationCount, block->size);
+      }
+
+      freeDeviceMemory(block->memory, block->size, block->mapped != nullptr);
+    }
+
+    pool.blocks.clear();
+  }
+
+  if (stats_.deviceMemoryCount != 0) {
+    VKR_CORE_WARN("Memory allocator destroyed with {} dedicated allocation(s) "
+                  "still alive",
+                  stats_.deviceMemoryCount);
+  }
+}
+
+auto MemoryAllocator::allocate(const VkMemoryRequirements &requirements,
+                               VkMemoryPropertyFlags properties,
+                               MemoryResourceKind kind) -> MemoryAllocation {
+  if (requirements.size == 0) {
+    VKR_CORE_ERROR("Cannot allocate zero-sized device memory");
+  }
+
+  const uint32_t memoryType =
+      memoryTypeIndex(requirements.memoryTypeBits, properties);
+  const VkDeviceSize blockSize = preferredBlockSize(memoryType);
+  const VkDeviceSize dedicatedThreshold =
+      desc_.dedicatedThreshold != 0 ? desc_.dedicatedThreshold : blockSize / 2;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  MemoryAllocation allocation{};
+  allocation.memoryType = memoryType;
+  allocation.size = requirements.size;
+
+  if (!desc_.subAllocate || requirements.size > dedicatedThreshold) {
+    allocation.memory =
+        allocateDeviceMemory(memoryType, requirements.size, &allocation.mapped);
+    allocation.block = MemoryAllocation::DEDICATED_BLOCK;
+    stats_.dedicatedAllocations++;
+    trackAllocated(requirements.size);
+    return allocation;
+  }
+
+  const uint32_t poolIndexValue = poolIndex(memoryType, kind);
+  auto &pool = pools_[poolIndexValue];
+  const VkDeviceSize alignment =
+      std::max<VkDeviceSize>(requirements.alignment, 1);
+
+  auto place = [&](uint32_t blockIndex) -> bool {
+    auto &block = *pool.blocks[blockIndex];
+    VkDeviceSize offset = 0;
+    if (!takeRange(block, requirements.size, alignment, offset)) {
+      return false;
+    }
+
+    block.allocationCount++;
+    allocation.memory = block.memory;
+    allocation.offset = offset;
+    allocation.pool = poolIndexValue;
+    allocation.block = blockIndex;
+    allocation.mapped =
+        block.mapped != nullptr
+            ? static_cast<void *>(static_cast<std::byte *>(block.mapped) +
+                                  offset)
+            : nullptr;
+    return true;
+  };
+
+  for (uint32_t i = 0; i < pool.blocks.size(); ++i) {
+    if (pool.blocks[i] && place(i)) {
+      trackAllocated(requirements.size);
+      return allocation;
+    }
+  }
+
+  auto block = std::make_unique<Block>();
+  block->size = std::max(blockSize, alignUp(requirements.size, alignment));
+  block->memory = allocateDeviceMemory(memoryType, block->size, &block->mapped);
+  block->freeByOffset.emplace(0, block->size);
+  block->freeBySize.emplace(block->size, 0);
+
+  auto slot = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+  if (slot == pool.blocks.end()) {
+    pool.blocks.push_back(std::move(block));
+    slot = std::prev(pool.blocks.end());
+  } else {
+    *slot = std::move(block);
+  }
+
+  const auto blockIndex =
+      static_cast<uint32_t>(std::distance(pool.blocks.begin(), slot));
+  if (!place(blockIndex)) {
+    VKR_CORE_ERROR("Failed to place {} byte allocation in a fresh {} byte "
+                   "memory block",
+                   requirements.size, (*slot)->size);
+  }
+
+  trackAllocated(requirements.size);
+  return allocation;
+}
+
+void MemoryAllocator::free(MemoryAllocation &allocation) noexcept {
+  if (!allocation.isValid()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  stats_.allocationCount--;
+  stats_.allocatedBytes -= allocation.size;
+
+  if (allocation.dedicated()) {
+    freeDeviceMemory(allocation.memory, allocation.size,
+                     allocation.mapped != nullptr);
+    allocation = {};
+    return;
+  }
+
+  auto &pool = pools_[allocation.pool];
+  auto &block = pool.blocks[allocation.block];
+  releaseRange(*block, allocation.offset, allocation.size);
+  block->allocationCount--;
+
+  // keep one empty block per pool around so alloc/free churn does not hit
+  // vkAllocateMemory every time
+  if (block->allocationCount == 0) {
+    const auto emptyBlocks =
+        std::count_if(pool.blocks.begin(), pool.blocks.end(),
+                      [](const std::unique_ptr<Block> &candidate) -> bool {
+                        return candidate && candidate->allocationCount == 0;
+                      });
+    if (emptyBlocks > 1) {
+      freeDeviceMemory(block->memory, block->size, block->mapped != nullptr);
+      block.reset();
+    }
+  }
+
+  allocation = {};
+}
+
+auto MemoryAllocator::stats() const -> MemoryStats {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void MemoryAllocator::logStats() const {
+  const MemoryStats current = stats();
+
+  VKR_CORE_INFO("Device memory: vkAllocateMemory objects={} (peak {}, limit "
+                "{}), reserved={:.2f} MiB (peak {:.2f} MiB)",
+                current.deviceMemoryCount, current.peakDeviceMemoryCount,
+                max_allocation_count_,
+                static_cast<double>(current.deviceMemoryBytes) / 1048576.0,
+                static_cast<double>(current.peakDeviceMemoryBytes) / 1048576.0);
+  VKR_CORE_INFO("Device memory: allocations={} (peak {}, total {}, dedicated "
+                "{}), used={:.2f} MiB (peak {:.2f} MiB), vkAllocateMemory "
+                "time={:.3f} ms",
+                current.allocationCount, current.peakAllocationCount,
+                current.totalAllocations, current.dedicatedAllocations,
+                static_cast<double>(current.allocatedBytes) / 1048576.0,
+                static_cast<double>(current.peakAllocatedBytes) / 1048576.0,
+                current.vkAllocateMilliseconds);
+}
+
+auto MemoryAllocator::memoryTypeIndex(uint32_t typeFilter,
+                                      VkMemoryPropertyFlags properties) const
+    -> uint32_t {
+  for (uint32_t i = 0; i < memory_properties_.memoryTypeCount; i++) {
+    if ((typeFilter & (1U << i)) &&
+        (memory_properties_.memoryTypes[i].propertyFlags & properties) ==
+            properties) {
+      return i;
+    }
+  }
+
+  VKR_CORE_ERROR("Failed to find suitable memory type");
+}
+
+auto MemoryAllocator::poolIndex(uint32_t memoryType,
+                                MemoryResourceKind kind) const noexcept
+    -> uint32_t {
+  // linear and optimal resources only need separate blocks when the device
+  // requires bufferImageGranularity padding between them
+  const uint32_t kindIndex = buffer_image_granularity_ > 1 &&
+                                     kind == MemoryResourceKind::Optimal
+                                 ? 1U
+                                 : 0U;
+  return memoryType * KIND_COUNT + kindIndex;
+}
+
+auto MemoryAllocator::preferredBlockSize(uint32_t memoryType) const noexcept
+    -> VkDeviceSize {
+  const uint32_t heapIndex = memory_properties_.memoryTypes[memoryType].heapIndex;
+  const VkDeviceSize heapSize = memory_properties_.memoryHeaps[heapIndex].size;
+
+  // small heaps (e.g. host-visible device-local BAR) get proportionally
+  // smaller blocks
+  return std::min(desc_.blockSize, std::max<VkDeviceSize>(heapSize / 8, 1));
+}
+
+auto MemoryAllocator::allocateDeviceMemory(uint32_t memoryType,
+                                           VkDeviceSize size, void **mapped)
+    -> VkDeviceMemory {
+  if (max_allocation_count_ != 0 &&
+      stats_.deviceMemoryCount >= max_allocation_count_) {
+    VKR_CORE_ERROR("maxMemoryAllocationCount ({}) reached",
+                   max_allocation_count_);
+  }
+
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.allocationSize = size;
+  allocInfo.memoryTypeIndex = memoryType;
+
+  VkDeviceMemory memory{VK_NULL_HANDLE};
+
+  const auto start = std::chrono::steady_clock::now();
+  const VkResult result =
+      vkAllocateMemory(device_.device(), &allocInfo, nullptr, &memory);
+  const auto end = std::chrono::steady_clock::now();
+  stats_.vkAllocateMilliseconds +=
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  if (result != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to allocate {} bytes of device memory (type {})",
+                   size, memoryType);
+  }
+
+  *mapped = nullptr;
+  if ((memory_properties_.memoryTypes[memoryType].propertyFlags &
+       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0) {
+    if (vkMapMemory(device_.device(), memory, 0, VK_WHOLE_SIZE, 0, mapped) !=
+        VK_SUCCESS) {
+      vkFreeMemory(device_.device(), memory, nullptr);
+      VKR_CORE_ERROR("Failed to persistently map device memory (type {})",
+                     memoryType);
+    }
+  }
+
+  stats_.deviceMemoryCount++;
+  stats_.deviceMemoryBytes += size;
+  stats_.peakDeviceMemoryCount =
+      std::max(stats_.peakDeviceMemoryCount, stats_.deviceMemoryCount);
+  stats_.peakDeviceMemoryBytes =
+      std::max(stats_.peakDeviceMemoryBytes, stats_.deviceMemoryBytes);
+
+  return memory;
+}
+
+void MemoryAllocator::freeDeviceMemory(VkDeviceMemory memory, VkDeviceSize size,
+                                       bool mapped) noexcept {
+  if (memory == VK_NULL_HANDLE) {
+    return;
+  }
+
+  if (mapped) {
+    vkUnmapMemory(device_.device(), memory);
+  }
+
+  vkFreeMemory(device_.device(), memory, nullptr);
+  stats_.deviceMemoryCount--;
+  stats_.deviceMemoryBytes -= size;
+}
+
+auto MemoryAllocator::takeRange(Block &block, VkDeviceSize size,
+                                VkDeviceSize alignment, VkDeviceSize &offset)
+    -> bool {
+  // best fit: smallest free range that still holds the aligned request
+  for (auto it = block.freeBySize.lower_bound(size);
+       it != block.freeBySize.end(); ++it) {
+    const VkDeviceSize rangeSize = it->first;
+    const VkDeviceSize rangeOffset = it->second;
+    const VkDeviceSize alignedOffset = alignUp(rangeOffset, alignment);
+    const VkDeviceSize padding = alignedOffset - rangeOffset;
+
+    if (padding + size > rangeSize) {
+      continue;
+    }
+
+    block.freeBySize.erase(it);
+    block.freeByOffset.erase(rangeOffset);
+
+    if (padding > 0) {
+      block.freeByOffset.emplace(rangeOffset, padding);
+      block.freeBySize.emplace(padding, rangeOffset);
+    }
+
+    const VkDeviceSize tail = rangeSize - padding - size;
+    if (tail > 0) {
+      block.freeByOffset.emplace(alignedOffset + size, tail);
+      block.freeBySize.emplace(tail, alignedOffset + size);
+    }
+
+    offset = alignedOffset;
+    return true;
+  }
+
+  return false;
+}
+
+void MemoryAllocator::releaseRange(Block &block, VkDeviceSize offset,
+                                   VkDeviceSize size) {
+  auto next = block.freeByOffset.lower_bound(offset);
+
+  if (next != block.freeByOffset.end() && offset + size == next->first) {
+    size += next->second;
+    eraseBySize(block, next->second, next->first);
+    next = block.freeByOffset.erase(next);
+  }
+
+  if (next != block.freeByOffset.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      eraseBySize(block, prev->second, prev->first);
+      block.freeByOffset.erase(prev);
+    }
+  }
+
+  block.freeByOffset.emplace(offset, size);
+  block.freeBySize.emplace(size, offset);
+}
+
+void MemoryAllocator::eraseBySize(Block &block, VkDeviceSize size,
+                                  VkDeviceSize offset) {
+  auto [begin, end] = block.freeBySize.equal_range(size);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second == offset) {
+      block.freeBySize.erase(it);
+      return;
+    }
+  }
+}
+
+void MemoryAllocator::trackAllocated(VkDeviceSize size) noexcept {
+  stats_.allocationCount++;
+  stats_.totalAllocations++;
+  stats_.allocatedBytes += size;
+  stats_.peakAllocationCount =
+      std::max(stats_.peakAllocationCount, stats_.allocationCount);
+  stats_.peakAllocatedBytes =
+      std::max(stats_.peakAllocatedBytes, stats_.allocatedBytes);
+}
+
+} // namespace vkr::core
@@ -0,0 +1,186 @@
+#include "vkr/core/pipeline_cache.hh"
+#include "vkr/core/device.hh"
+#include "vkr/logger.hh"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace vkr::core {
+
+PipelineCache::PipelineCache(const Device &device,
+                             const PipelineCacheDesc &desc)
+    : device_(device), desc_(desc) {
+  if (!desc_.isValid()) {
+    VKR_CORE_ERROR("PipelineCacheDesc is invalid");
+  }
+
+  if (!desc_.enabled) {
+    VKR_CORE_INFO("Pipeline cache disabled by config");
+    return;
+  }
+
+  const std::vector<uint8_t> initialData = loadInitialData();
+
+  VkPipelineCacheCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  createInfo.initialDataSize = initialData.size();
+  createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+  if (vkCreatePipelineCache(device_.device(), &createInfo, nullptr,
+                            &vk_pipeline_cache_) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to create pipeline cache");
+  }
+
+  stats_.warm = !initialData.empty();
+  stats_.loadedBytes = initialData.size();
+
+  VKR_CORE_INFO("Pipeline cache created ({}): {}",
+                stats_.warm ? "warm" : "cold", desc_.path);
+}
+
+PipelineCache::~PipelineCache() {
+  if (vk_pipeline_cache_ == VK_NULL_HANDLE) {
+    return;
+  }
+
+  save();
+  vkDestroyPipelineCache(device_.device(), vk_pipeline_cache_, nullptr);
+  vk_pipeline_cache_ = VK_NULL_HANDLE;
+}
+
+void PipelineCache::merge(const std::vector<VkPipelineCache> &sources) {
+  if (vk_pipeline_cache_ == VK_NULL_HANDLE || sources.empty()) {
+    return;
+  }
+
+  if (vkMergePipelineCaches(device_.device(), vk_pipeline_cache_,
+                            static_cast<uint32_t>(sources.size()),
+                            sources.data()) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to merge pipeline caches");
+  }
+}
+
+void PipelineCache::save() noexcept {
+  if (vk_pipeline_cache_ == VK_NULL_HANDLE) {
+    return;
+  }
+
+  size_t dataSize = 0;
+  if (vkGetPipelineCacheData(device_.device(), vk_pipeline_cache_, &dataSize,
+                             nullptr) != VK_SUCCESS ||
+      dataSize == 0) {
+    VKR_CORE_WARN("Pipeline cache is empty, nothing to save");
+    return;
+  }
+
+  std::vector<uint8_t> data(dataSize);
+  if (vkGetPipelineCacheData(device_.device(), vk_pipeline_cache_, &dataSize,
+                             data.data()) != VK_SUCCESS) {
+    VKR_CORE_WARN("Failed to read pipeline cache data");
+    return;
+  }
+  data.resize(dataSize);
+
+  // write next to the target first so a crash never leaves a torn cache
+  const std::filesystem::path path{desc_.path};
+  std::filesystem::path tmpPath = path;
+  tmpPath += ".tmp";
+
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      VKR_CORE_WARN("Failed to open pipeline cache for writing: {}",
+                    tmpPath.string());
+      return;
+    }
+
+    file.write(reinterpret_cast<const char *>(data.data()),
+               static_cast<std::streamsize>(data.size()));
+    if (!file) {
+      VKR_CORE_WARN("Failed to write pipeline cache: {}", tmpPath.string());
+      return;
+    }
+  }
+
+  std::error_code error{};
+  std::filesystem::rename(tmpPath, path, error);
+  if (error) {
+    VKR_CORE_WARN("Failed to save pipeline cache to {}: {}", path.string(),
+                  error.message());
+    return;
+  }
+
+  VKR_CORE_INFO("Pipeline cache saved: {} ({} bytes)", path.string(),
+                data.size());
+}
+
+void PipelineCache::recordCreation(double milliseconds) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.pipelineCount++;
+  stats_.creationMilliseconds += milliseconds;
+}
+
+auto PipelineCache::stats() const -> PipelineCacheStats {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void PipelineCache::logStats() const {
+  const PipelineCacheStats current = stats();
+  const double average =
+      current.pipelineCount == 0
+          ? 0.0
+          : current.creationMilliseconds / current.pipelineCount;
+
+  VKR_CORE_INFO("Pipeline creation ({} cache, {} bytes loaded): {} "
+                "pipeline(s) in {:.3f} ms, {:.3f} ms average",
+                vk_pipeline_cache_ == VK_NULL_HANDLE
+                    ? "no"
+                    : (current.warm ? "warm" : "cold"),
+                current.loadedBytes, current.pipelineCount,
+                current.creationMilliseconds, average);
+}
+
+auto PipelineCache::loadInitialData() const -> std::vector<uint8_t> {
+  std::ifstream file(desc_.path, std::ios::binary);
+  if (!file) {
+    return {};
+  }
+
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+
+  if (!headerMatches(data)) {
+    VKR_CORE_WARN("Ignoring pipeline cache from another device or driver: {}",
+                  desc_.path);
+    return {};
+  }
+
+  return data;
+}
+
+auto PipelineCache::headerMatches(const std::vector<uint8_t> &data) const
+    -> bool {
+  // VkPipelineCacheHeaderVersionOne: headerSize, headerVersion, vendorID,
+  // deviceID (4 bytes each) followed by pipelineCacheUUID
+  constexpr size_t HeaderSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+  if (data.size() < HeaderSize) {
+    return false;
+  }
+
+  uint32_t header[4]{};
+  std::memcpy(header, data.data(), sizeof(header));
+
+  VkPhysicalDeviceProperties properties{};
+  vkGetPhysicalDeviceProperties(device_.physicalDevice(), &properties);
+
+  return header[0] >= HeaderSize &&
+         header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header[2] == properties.vendorID &&
+         header[3] == properties.deviceID &&
+         std::memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID,
+                     VK_UUID_SIZE) == 0;
+}
+
+} // namespace vkr::core
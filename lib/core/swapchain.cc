@@ -5,7 +5,18 @@ namespace vkr::core {
 
 Swapchain::Swapchain(const Window &window, const Surface &surface,
                      const Device &device, SwapchainDesc &desc)
-    : window_(window), surface_(surface), device_(device), desc_(desc) {
+    : window_(&window), surface_(&surface), device_(device), desc_(desc) {
+  desc_.headless = false;
+  create();
+}
+
+Swapchain::Swapchain(const Device &device, SwapchainDesc &desc)
+    : device_(device), desc_(desc) {
+  desc_.headless = true;
+  if (!desc_.isValid()) {
+    VKR_CORE_ERROR("headless swapchain desc is invalid");
+  }
+
   create();
 }
 
@@ -18,14 +29,19 @@ void Swapchain::recreate() {
 }
 
 void Swapchain::create() {
+  if (desc_.headless) {
+    createHeadless();
+    return;
+  }
+
   VKR_CORE_INFO("Creating swapchain...");
 
-  querySwapchainSupport(device_.physicalDevice(), surface_.surface(), desc_);
+  querySwapchainSupport(device_.physicalDevice(), surface_->surface(), desc_);
 
   desc_.surfaceFormat = chooseSwapSurfaceFormat(desc_.formats);
   desc_.presentMode =
       chooseSwapPresentMode(desc_.presentModes, desc_.presentMode);
-  auto extent = chooseSwapExtent(window_.glfwWindow(), desc_.capabilities);
+  auto extent = chooseSwapExtent(window_->glfwWindow(), desc_.capabilities);
   desc_.width = extent.width;
   desc_.height = extent.height;
 
@@ -40,13 +56,19 @@ void Swapchain::create() {
 
   VkSwapchainCreateInfoKHR createInfo{};
   createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-  createInfo.surface = surface_.surface();
+  createInfo.surface = surface_->surface();
   createInfo.minImageCount = desc_.imageCount;
   createInfo.imageFormat = desc_.surfaceFormat.format;
   createInfo.imageColorSpace = desc_.surfaceFormat.colorSpace;
   createInfo.imageExtent = {desc_.width, desc_.height};
   createInfo.imageArrayLayers = 1;
-  createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+  // transfer dst lets blit passes copy an offscreen target straight in
+  usage_ = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+  if ((desc_.capabilities.supportedUsageFlags &
+       VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0) {
+    usage_ |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+  }
+  createInfo.imageUsage = usage_;
 
   uint32_t queueFamilyIndices[] = {device_.graphicsFamily(),
                                    device_.presentFamily()};
@@ -76,6 +98,9 @@ void Swapchain::create() {
   vkGetSwapchainImagesKHR(device_.device(), vk_swapchain_, &actualImageCount,
                           nullptr);
   desc_.imageCount = actualImageCount;
+  vk_images_.resize(actualImageCount);
+  vkGetSwapchainImagesKHR(device_.device(), vk_swapchain_, &actualImageCount,
+                          vk_images_.data());
 
   VKR_CORE_INFO(
       "Swapchain created: extent={}x{}, images={}, format={}, presentMode={}",
@@ -86,12 +111,89 @@ void Swapchain::create() {
   VKR_CORE_INFO("Swapchain created successfully.");
 }
 
+void Swapchain::createHeadless() {
+  VKR_CORE_INFO("Creating headless swapchain...");
+
+  desc_.surfaceFormat = {desc_.headlessFormat,
+                         VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+  desc_.width = desc_.headlessExtent.width;
+  desc_.height = desc_.headlessExtent.height;
+  desc_.imageCount = desc_.headlessImageCount;
+  usage_ = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+           VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.extent = {desc_.width, desc_.height, 1};
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.format = desc_.headlessFormat;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  imageInfo.usage = usage_;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  vk_images_.reserve(desc_.imageCount);
+  headless_allocations_.reserve(desc_.imageCount);
+
+  for (uint32_t i = 0; i < desc_.imageCount; ++i) {
+    VkImage image = VK_NULL_HANDLE;
+    if (vkCreateImage(device_.device(), &imageInfo, nullptr, &image) !=
+        VK_SUCCESS) {
+      destroy();
+      VKR_CORE_ERROR("failed to create headless swapchain image {}", i);
+    }
+    vk_images_.push_back(image);
+
+    VkMemoryRequirements requirements{};
+    vkGetImageMemoryRequirements(device_.device(), image, &requirements);
+
+    MemoryAllocation allocation{};
+    try {
+      allocation = device_.allocator().allocate(
+          requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+          MemoryResourceKind::Optimal);
+    } catch (...) {
+      destroy();
+      VKR_CORE_ERROR("failed to allocate headless swapchain image {}", i);
+    }
+    headless_allocations_.push_back(allocation);
+
+    if (vkBindImageMemory(device_.device(), image, allocation.memory,
+                          allocation.offset) != VK_SUCCESS) {
+      destroy();
+      VKR_CORE_ERROR("failed to bind headless swapchain image {} memory", i);
+    }
+  }
+
+  VKR_CORE_INFO("Headless swapchain created: extent={}x{}, images={}, "
+                "format={}",
+                desc_.width, desc_.height, desc_.imageCount,
+                static_cast<int>(desc_.headlessFormat));
+}
+
 void Swapchain::destroy() {
   if (vk_swapchain_ != VK_NULL_HANDLE) {
     vkDestroySwapchainKHR(device_.device(), vk_swapchain_, nullptr);
     vk_swapchain_ = VK_NULL_HANDLE;
   }
 
+  if (desc_.headless) {
+    for (VkImage image : vk_images_) {
+      vkDestroyImage(device_.device(), image, nullptr);
+    }
+  }
+
+  for (auto &allocation : headless_allocations_) {
+    device_.allocator().free(allocation);
+  }
+
+  vk_images_.clear();
+  headless_allocations_.clear();
+  usage_ = 0;
+
   desc_.width = 0;
   desc_.height = 0;
   desc_.imageCount = 0;
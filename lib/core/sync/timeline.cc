@@ -0,0 +1,136 @@
+#include "vkr/core/sync/timeline.hh"
+#include "vkr/logger.hh"
+#include <algorithm>
+#include <utility>
+
+namespace vkr::core {
+
+TimelineSemaphore::TimelineSemaphore(const Device &device,
+                                     uint64_t initialValue)
+    : device_(device), pending_value_(initialValue),
+      completed_value_(initialValue) {
+  if (!device_.timelineSemaphores()) {
+    VKR_CORE_ERROR("Timeline semaphores are not enabled on this device");
+  }
+
+  VkSemaphoreTypeCreateInfoKHR typeInfo{};
+  typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+  typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+  typeInfo.initialValue = initialValue;
+
+  VkSemaphoreCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+  createInfo.pNext = &typeInfo;
+
+  if (vkCreateSemaphore(device_.device(), &createInfo, nullptr,
+                        &vk_semaphore_) != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to create timeline semaphore");
+  }
+}
+
+TimelineSemaphore::~TimelineSemaphore() { destroy(); }
+
+TimelineSemaphore::TimelineSemaphore(TimelineSemaphore &&other) noexcept
+    : device_(other.device_),
+      vk_semaphore_(std::exchange(other.vk_semaphore_, VK_NULL_HANDLE)),
+      pending_value_(other.pending_value_),
+      completed_value_(other.completed_value_) {}
+
+auto TimelineSemaphore::completedValue() const -> uint64_t {
+  completed_value_ = std::max(completed_value_,
+                              device_.semaphoreCounterValue(vk_semaphore_));
+  return completed_value_;
+}
+
+auto TimelineSemaphore::reached(uint64_t value) const -> bool {
+  // the cached value answers most retirement checks without a driver call
+  return value <= completed_value_ || value <= completedValue();
+}
+
+void TimelineSemaphore::wait(uint64_t value, uint64_t timeout) const {
+  if (value <= completed_value_) {
+    return;
+  }
+
+  if (value > pending_value_) {
+    VKR_CORE_ERROR("Waiting on timeline value {} that was never submitted, "
+                   "last submitted {}",
+                   value, pending_value_);
+  }
+
+  const VkResult result = device_.waitSemaphore(vk_semaphore_, value, timeout);
+  if (result == VK_TIMEOUT) {
+    return;
+  }
+
+  if (result != VK_SUCCESS) {
+    VKR_CORE_ERROR("Failed to wait for timeline semaphore");
+  }
+
+  completed_value_ = std::max(completed_value_, value);
+}
+
+void TimelineSemaphore::destroy() noexcept {
+  if (vk_semaphore_ != VK_NULL_HANDLE) {
+    vkDestroySemaphore(device_.device(), vk_semaphore_, nullptr);
+    vk_semaphore_ = VK_NULL_HANDLE;
+  }
+}
+
+void SubmitSemaphores::wait(VkSemaphore semaphore,
+                            VkPipelineStageFlags stageMask, uint64_t value) {
+  wait_semaphores_.push_back(semaphore);
+  wait_stages_.push_back(stageMask);
+  wait_values_.push_back(value);
+  timeline_ = timeline_ || value > 0;
+}
+
+void SubmitSemaphores::wait(const TimelinePoint &point,
+                            VkPipelineStageFlags stageMask) {
+  if (point.isValid()) {
+    wait(point.semaphore, stageMask, point.value);
+  }
+}
+
+void SubmitSemaphores::signal(VkSemaphore semaphore, uint64_t value) {
+  signal_semaphores_.push_back(semaphore);
+  signal_values_.push_back(value);
+  timeline_ = timeline_ || value > 0;
+}
+
+void SubmitSemaphores::signal(const TimelinePoint &point) {
+  if (point.isValid()) {
+    signal(point.semaphore, point.value);
+  }
+}
+
+void SubmitSemaphores::apply(VkSubmitInfo &submitInfo) {
+  submitInfo.waitSemaphoreCount =
+      static_cast<uint32_t>(wait_semaphores_.size());
+  submitInfo.pWaitSemaphores =
+      wait_semaphores_.empty() ? nullptr : wait_semaphores_.data();
+  submitInfo.pWaitDstStageMask =
+      wait_stages_.empty() ? nullptr : wait_stages_.data();
+  submitInfo.signalSemaphoreCount =
+      static_cast<uint32_t>(signal_semaphores_.size());
+  submitInfo.pSignalSemaphores =
+      signal_semaphores_.empty() ? nullptr : signal_semaphores_.data();
+
+  if (!timeline_) {
+    return;
+  }
+
+  timeline_info_ = {};
+  timeline_info_.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+  timeline_info_.waitSemaphoreValueCount =
+      static_cast<uint32_t>(wait_values_.size());
+  timeline_info_.pWaitSemaphoreValues =
+      wait_values_.empty() ? nullptr : wait_values_.data();
+  timeline_info_.signalSemaphoreValueCount =
+      static_cast<uint32_t>(signal_values_.size());
+  timeline_info_.pSignalSemaphoreValues =
+      signal_values_.empty() ? nullptr : signal_values_.data();
+  submitInfo.pNext = &timeline_info_;
+}
+
+} // namespace vkr::core
@@ -1,7 +1,6 @@
 #include "vkr/exec/compute/app.hh"
-#include <algorithm>
-#include <numeric>
-#include <unordered_map>
+#include <chrono>
+#include <filesystem>
 #include <vector>
 
 namespace vkr::exec {
@@ -22,6 +21,16 @@ void ComputeApplication::initCompute() {
   }
 
   assetSystem = std::make_unique<util::AssetSystem>(ctx.asset);
+
+  util::ShaderCacheDesc shaderCache = ctx.shaderCache;
+  if (std::filesystem::path(shaderCache.directory).is_relative()) {
+    shaderCache.directory =
+        (std::filesystem::path(ctx.asset.userRoot) / shaderCache.directory)
+            .lexically_normal()
+            .string();
+  }
+  util::ShaderCache::instance().configure(shaderCache);
+
   timer = std::make_unique<util::Timer>();
 
   instance = std::make_unique<core::Instance>(ctx.instance);
@@ -32,30 +41,70 @@ void ComputeApplication::initCompute() {
 
   commandPool = std::make_unique<core::CommandPool>(*device, ctx.commandPool);
   profiler = std::make_unique<Profiler>(*device, *commandPool, ctx.profiler);
-  executor = std::make_unique<ComputeExecutor>(*device, *commandPool);
+  executor =
+      std::make_unique<ComputeExecutor>(*device, *commandPool, ctx.executor);
   executor->setProfiler(profiler.get());
 
   createResources();
+  commandPool->uploader().flush();
+  commandPool->uploader().logStats();
 
   graph = std::make_unique<ComputeGraph>();
   buildGraph();
   graph->compile();
   graph->create();
+
+  device->allocator().logStats();
+  util::ShaderCache::instance().logStats();
 }
 
 void ComputeApplication::execute() {
+  executor->setProfiler(nullptr);
   for (uint32_t i = 0; i < ctx.profiler.warmupFrames; ++i) {
-    executor->setProfiler(nullptr);
     executor->begin();
     graph->record();
-    executor->submitAndWait();
-    executor->end();
+    if (ctx.executor.pipelined) {
+      executor->submit();
+    } else {
+      executor->submitAndWait();
+      executor->end();
+    }
   }
+  executor->waitIdle();
+
+  executor->setProfiler(profiler.get());
+  const auto captureStart = std::chrono::steady_clock::now();
+  std::vector<ProfileReport> captures =
+      ctx.executor.pipelined ? capturePipelined() : captureBlocking();
+  const double captureMs = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - captureStart)
+                               .count();
+
+  const double iterations = ctx.profiler.captureFrames;
+  const double seconds = captureMs / 1000.0;
+  const size_t dispatches = graph->passes().size();
+  VKR_EXEC_INFO("Compute throughput ({}): {} iteration(s) in {:.3f} ms, "
+                "{:.1f} iterations/s, {:.1f} dispatches/s, {} stall(s)",
+                ctx.executor.pipelined ? "pipelined" : "blocking",
+                ctx.profiler.captureFrames, captureMs,
+                seconds > 0.0 ? iterations / seconds : 0.0,
+                seconds > 0.0 ? iterations * dispatches / seconds : 0.0,
+                executor->stats().stalls);
+
+  profileReport = summarizeReports(captures);
+  if (ctx.profiler.logReport) {
+    logProfileSummary(profileReport);
+  }
+
+  device->waitIdle();
+  device->allocator().logStats();
+  afterExecute();
+}
 
+auto ComputeApplication::captureBlocking() -> std::vector<ProfileReport> {
   std::vector<ProfileReport> captures{};
   captures.reserve(ctx.profiler.captureFrames);
 
-  executor->setProfiler(profiler.get());
   for (uint32_t i = 0; i < ctx.profiler.captureFrames; ++i) {
     ProfileReport capture{};
 
@@ -94,108 +143,70 @@ void ComputeApplication::execute() {
     captures.push_back(std::move(capture));
   }
 
-  profileReport = {};
-  std::unordered_map<std::string, std::vector<double>> cpuTimings{};
-  std::unordered_map<std::string, std::vector<double>> gpuTimings{};
-  for (const auto &capture : captures) {
-    profileReport.gpuTimestampsEnabled =
-        profileReport.gpuTimestampsEnabled || capture.gpuTimestampsEnabled;
+  return captures;
+}
 
-    for (const auto &sample : capture.cpuSamples) {
-      cpuTimings[sample.name].push_back(sample.milliseconds);
-    }
-    for (const auto &sample : capture.gpuSamples) {
-      gpuTimings[sample.name].push_back(sample.milliseconds);
-    }
+auto ComputeApplication::capturePipelined() -> std::vector<ProfileReport> {
+  if (profiler && profiler->enabled() &&
+      ctx.profiler.frameSlots <= ctx.executor.framesInFlight) {
+    VKR_EXEC_WARN("profiler frameSlots ({}) should exceed executor "
+                  "framesInFlight ({}) in pipelined mode",
+                  ctx.profiler.frameSlots, ctx.executor.framesInFlight);
   }
 
-  profileReport.cpuSamples.reserve(cpuTimings.size());
-  for (auto &[name, values] : cpuTimings) {
-    if (values.empty()) {
-      continue;
-    }
-
-    std::sort(values.begin(), values.end());
-    const double sum = std::accumulate(values.begin(), values.end(), 0.0);
-    const double mean = sum / static_cast<double>(values.size());
-    double median = values[values.size() / 2];
-    if (values.size() % 2 == 0) {
-      median = (values[(values.size() / 2) - 1] + median) * 0.5;
-    }
+  std::vector<ProfileReport> captures{};
+  captures.reserve(ctx.profiler.captureFrames * 2);
 
-    profileReport.cpuSamples.push_back(ProfileSample{
-        .name = name,
-        .milliseconds = mean,
-        .minMilliseconds = values.front(),
-        .medianMilliseconds = median,
-        .maxMilliseconds = values.back(),
-        .captureCount = static_cast<uint32_t>(values.size()),
-    });
-  }
+  // record iteration N+1 while N is still executing
+  for (uint32_t i = 0; i < ctx.profiler.captureFrames; ++i) {
+    ProfileReport capture{};
 
-  profileReport.gpuSamples.reserve(gpuTimings.size());
-  for (auto &[name, values] : gpuTimings) {
-    if (values.empty()) {
-      continue;
-    }
+    executor->begin();
+    timer->reset();
+    executor->beginProfileScope("compute_graph");
+    graph->record();
+    executor->endProfileScope();
+    timer->update();
+    const double recordMs = timer->elapsedMilliseconds();
 
-    std::sort(values.begin(), values.end());
-    const double sum = std::accumulate(values.begin(), values.end(), 0.0);
-    const double mean = sum / static_cast<double>(values.size());
-    double median = values[values.size() / 2];
-    if (values.size() % 2 == 0) {
-      median = (values[(values.size() / 2) - 1] + median) * 0.5;
-    }
+    timer->reset();
+    executor->submit();
+    timer->update();
+    const double submitMs = timer->elapsedMilliseconds();
 
-    profileReport.gpuSamples.push_back(ProfileSample{
-        .name = name,
-        .milliseconds = mean,
-        .minMilliseconds = values.front(),
-        .medianMilliseconds = median,
-        .maxMilliseconds = values.back(),
-        .captureCount = static_cast<uint32_t>(values.size()),
+    capture.cpuSamples.push_back(ProfileSample{
+        .name = "compute_graph.record",
+        .milliseconds = recordMs,
+        .minMilliseconds = recordMs,
+        .medianMilliseconds = recordMs,
+        .maxMilliseconds = recordMs,
+        .captureCount = 1,
     });
-  }
-
-  std::sort(profileReport.cpuSamples.begin(), profileReport.cpuSamples.end(),
-            [](const ProfileSample &lhs, const ProfileSample &rhs) -> bool {
-              return lhs.name < rhs.name;
-            });
-  std::sort(profileReport.gpuSamples.begin(), profileReport.gpuSamples.end(),
-            [](const ProfileSample &lhs, const ProfileSample &rhs) -> bool {
-              return lhs.name < rhs.name;
-            });
-
-  if (ctx.profiler.logReport) {
-    if (profileReport.empty()) {
-      VKR_EXEC_INFO("profile report: no samples");
-    }
+    capture.cpuSamples.push_back(ProfileSample{
+        .name = "compute_graph.submit",
+        .milliseconds = submitMs,
+        .minMilliseconds = submitMs,
+        .medianMilliseconds = submitMs,
+        .maxMilliseconds = submitMs,
+        .captureCount = 1,
+    });
+    captures.push_back(std::move(capture));
 
-    if (!profileReport.cpuSamples.empty()) {
-      VKR_EXEC_INFO("CPU profile report:");
-      for (const auto &sample : profileReport.cpuSamples) {
-        VKR_EXEC_INFO("  {}: captures={}, min={:.6f} ms, mean={:.6f} ms, "
-                      "median={:.6f} ms, max={:.6f} ms",
-                      sample.name, sample.captureCount, sample.minMilliseconds,
-                      sample.milliseconds, sample.medianMilliseconds,
-                      sample.maxMilliseconds);
+    if (profiler) {
+      for (auto &report : profiler->collectAll()) {
+        captures.push_back(std::move(report));
       }
     }
+  }
 
-    if (!profileReport.gpuSamples.empty()) {
-      VKR_EXEC_INFO("GPU profile report:");
-      for (const auto &sample : profileReport.gpuSamples) {
-        VKR_EXEC_INFO("  {}: captures={}, min={:.6f} ms, mean={:.6f} ms, "
-                      "median={:.6f} ms, max={:.6f} ms",
-                      sample.name, sample.captureCount, sample.minMilliseconds,
-                      sample.milliseconds, sample.medianMilliseconds,
-                      sample.maxMilliseconds);
-      }
+  executor->waitIdle();
+  if (profiler) {
+    for (auto &report : profiler->collectAll()) {
+      captures.push_back(std::move(report));
     }
   }
 
-  device->waitIdle();
-  afterExecute();
+  return captures;
 }
 
 } // namespace vkr::exec
@@ -1,12 +1,18 @@
 #include "vkr/exec/compute/executor.hh"
 #include "vkr/exec/profiler.hh"
 #include "vkr/logger.hh"
+#include <algorithm>
 
 namespace vkr::exec {
 
 ComputeExecutor::ComputeExecutor(const core::Device &device,
-                                 const core::CommandPool &commandPool)
-    : device_(device), command_pool_(commandPool) {
+                                 const core::CommandPool &commandPool,
+                                 const ComputeExecutorDesc &desc)
+    : device_(device), command_pool_(commandPool), desc_(desc) {
+  if (!desc_.isValid()) {
+    VKR_EXEC_ERROR("ComputeExecutorDesc is invalid");
+  }
+
   if (!device_.supportsCompute()) {
     VKR_EXEC_ERROR("ComputeExecutor requires compute queue support");
   }
@@ -17,14 +23,54 @@ ComputeExecutor::ComputeExecutor(const core::Device &device,
                    command_pool_.queueFamily(), device_.computeFamily());
   }
 
-  allocateCommandBuffer();
+  if (device_.timelineSemaphores()) {
+    timeline_ = &device_.timeline(command_pool_.queue());
+  }
+
+  allocateCommandBuffers();
+  deletion_submitter_ = device_.deletionQueue().addSubmitter();
 }
 
-ComputeExecutor::~ComputeExecutor() { freeCommandBuffer(); }
+ComputeExecutor::~ComputeExecutor() {
+  for (auto &frame : frames_) {
+    if (frame.ticket <= completed_ticket_) {
+      continue;
+    }
+
+    if (timeline_ != nullptr) {
+      (void)device_.waitSemaphore(timeline_->semaphore(), frame.timelineValue,
+                                  UINT64_MAX);
+    } else {
+      const VkFence fence = frame.fence->fence();
+      vkWaitForFences(device_.device(), 1, &fence, VK_TRUE, UINT64_MAX);
+    }
+  }
+
+  device_.deletionQueue().removeSubmitter(deletion_submitter_);
+  freeCommandBuffers();
+}
 
 void ComputeExecutor::begin() {
   ensureInactive("begin");
 
+  // the slot is reused only once the submission recorded into it retired
+  auto &frame = frames_[current_frame_];
+  if (frame.ticket > completed_ticket_) {
+    if (!frameSignaled(frame)) {
+      stats_.stalls++;
+      waitFrame(frame);
+    }
+    retire(frame);
+  }
+
+  // nothing in flight: recording from here on only references objects that
+  // are still alive, so every closed epoch is covered
+  if (completed_ticket_ + 1 == next_ticket_) {
+    auto &deletionQueue = device_.deletionQueue();
+    deletionQueue.collect(deletion_submitter_, deletionQueue.epoch() - 1);
+  }
+
+  command_buffer_ = frame.commandBuffer;
   vkResetCommandBuffer(command_buffer_, 0);
 
   VkCommandBufferBeginInfo beginInfo{};
@@ -50,39 +96,110 @@ void ComputeExecutor::submitAndWait() {
     VKR_EXEC_ERROR("ComputeExecutor::submitAndWait called twice");
   }
 
-  if (profiler_ != nullptr) {
-    profiler_->endFrame(command_buffer_);
+  wait(submitCurrent());
+  submitted_ = true;
+}
+
+void ComputeExecutor::end() {
+  ensureActive("end");
+
+  if (!submitted_) {
+    VKR_EXEC_ERROR("ComputeExecutor::end called before submitAndWait");
   }
 
-  if (vkEndCommandBuffer(command_buffer_) != VK_SUCCESS) {
-    VKR_EXEC_ERROR("failed to end compute command buffer");
+  active_ = false;
+  submitted_ = false;
+
+  if (completed_ticket_ + 1 == next_ticket_) {
+    device_.deletionQueue().idle(deletion_submitter_);
   }
+}
 
-  core::Fence fence{device_};
+auto ComputeExecutor::submit() -> uint64_t {
+  ensureActive("submit");
 
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &command_buffer_;
+  if (submitted_) {
+    VKR_EXEC_ERROR("ComputeExecutor::submit called after submitAndWait");
+  }
 
-  if (vkQueueSubmit(command_pool_.queue(), 1, &submitInfo, fence.fence()) !=
-      VK_SUCCESS) {
-    VKR_EXEC_ERROR("failed to submit compute command buffer");
+  const uint64_t ticket = submitCurrent();
+  active_ = false;
+  command_buffer_ = VK_NULL_HANDLE;
+  return ticket;
+}
+
+auto ComputeExecutor::isComplete(uint64_t ticket) -> bool {
+  if (ticket <= completed_ticket_) {
+    return true;
   }
 
-  fence.wait();
-  submitted_ = true;
+  if (ticket >= next_ticket_) {
+    return false;
+  }
+
+  for (auto &frame : frames_) {
+    if (frame.ticket == ticket) {
+      if (!frameSignaled(frame)) {
+        return false;
+      }
+
+      retire(frame);
+      return true;
+    }
+  }
+
+  return true;
 }
 
-void ComputeExecutor::end() {
-  ensureActive("end");
+void ComputeExecutor::wait(uint64_t ticket) {
+  if (ticket >= next_ticket_) {
+    VKR_EXEC_ERROR("ComputeExecutor::wait on unsubmitted ticket {}", ticket);
+  }
 
-  if (!submitted_) {
-    VKR_EXEC_ERROR("ComputeExecutor::end called before submitAndWait");
+  if (ticket <= completed_ticket_) {
+    return;
   }
 
-  active_ = false;
-  submitted_ = false;
+  for (auto &frame : frames_) {
+    if (frame.ticket == ticket) {
+      waitFrame(frame);
+      retire(frame);
+      return;
+    }
+  }
+}
+
+void ComputeExecutor::waitIdle() {
+  for (auto &frame : frames_) {
+    if (frame.ticket > completed_ticket_) {
+      waitFrame(frame);
+      retire(frame);
+    }
+  }
+}
+
+void ComputeExecutor::waitOn(const core::TimelinePoint &point,
+                             VkPipelineStageFlags stageMask) {
+  if (!point.isValid()) {
+    return;
+  }
+
+  pending_waits_.emplace_back(point, stageMask);
+}
+
+auto ComputeExecutor::submission(uint64_t ticket) const
+    -> core::TimelinePoint {
+  if (timeline_ == nullptr || ticket <= completed_ticket_) {
+    return {};
+  }
+
+  for (const auto &frame : frames_) {
+    if (frame.ticket == ticket) {
+      return timeline_->point(frame.timelineValue);
+    }
+  }
+
+  return {};
 }
 
 void ComputeExecutor::setProfiler(Profiler *profiler) noexcept {
@@ -130,6 +247,31 @@ void ComputeExecutor::dispatch(uint32_t groupCountX, uint32_t groupCountY,
   vkCmdDispatch(command_buffer_, groupCountX, groupCountY, groupCountZ);
 }
 
+void ComputeExecutor::barrier(const ComputeBarrier &barrier) {
+  ensureActive("barrier");
+
+  if (barrier.empty()) {
+    return;
+  }
+
+  // execution-only dependencies (write-after-read) need no memory barrier
+  if (barrier.srcAccessMask == 0 && barrier.dstAccessMask == 0) {
+    vkCmdPipelineBarrier(command_buffer_, barrier.srcStageMask,
+                         barrier.dstStageMask, 0, 0, nullptr, 0, nullptr, 0,
+                         nullptr);
+    return;
+  }
+
+  VkMemoryBarrier memoryBarrier{};
+  memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  memoryBarrier.srcAccessMask = barrier.srcAccessMask;
+  memoryBarrier.dstAccessMask = barrier.dstAccessMask;
+
+  vkCmdPipelineBarrier(command_buffer_, barrier.srcStageMask,
+                       barrier.dstStageMask, 0, 1, &memoryBarrier, 0, nullptr,
+                       0, nullptr);
+}
+
 void ComputeExecutor::beginProfileScope(std::string_view name) {
   ensureActive("beginProfileScope");
   if (profiler_ != nullptr) {
@@ -144,25 +286,116 @@ void ComputeExecutor::endProfileScope() {
   }
 }
 
-void ComputeExecutor::allocateCommandBuffer() {
+auto ComputeExecutor::submitCurrent() -> uint64_t {
+  if (profiler_ != nullptr) {
+    profiler_->endFrame(command_buffer_);
+  }
+
+  if (vkEndCommandBuffer(command_buffer_) != VK_SUCCESS) {
+    VKR_EXEC_ERROR("failed to end compute command buffer");
+  }
+
+  command_pool_.uploader().flush();
+
+  auto &frame = frames_[current_frame_];
+
+  core::SubmitSemaphores semaphores{};
+  for (const auto &[point, stageMask] : pending_waits_) {
+    semaphores.wait(point, stageMask);
+  }
+  pending_waits_.clear();
+
+  VkFence fence = VK_NULL_HANDLE;
+  if (timeline_ != nullptr) {
+    frame.timelineValue = timeline_->next();
+    semaphores.signal(timeline_->point(frame.timelineValue));
+  } else {
+    frame.fence->reset();
+    fence = frame.fence->fence();
+  }
+
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &command_buffer_;
+  semaphores.apply(submitInfo);
+
+  if (vkQueueSubmit(command_pool_.queue(), 1, &submitInfo, fence) !=
+      VK_SUCCESS) {
+    VKR_EXEC_ERROR("failed to submit compute command buffer");
+  }
+
+  frame.ticket = next_ticket_++;
+  frame.epoch = device_.deletionQueue().advance();
+  current_frame_ = (current_frame_ + 1) % static_cast<uint32_t>(frames_.size());
+  stats_.submits++;
+  return frame.ticket;
+}
+
+void ComputeExecutor::retire(Frame &frame) noexcept {
+  // one queue completes submissions in order, so releases up to this
+  // submission's epoch are no longer referenced by compute work
+  completed_ticket_ = std::max(completed_ticket_, frame.ticket);
+  if (completed_ticket_ + 1 == next_ticket_ && !active_) {
+    device_.deletionQueue().idle(deletion_submitter_);
+  } else {
+    device_.deletionQueue().collect(deletion_submitter_, frame.epoch);
+  }
+}
+
+auto ComputeExecutor::frameSignaled(const Frame &frame) const -> bool {
+  if (timeline_ != nullptr) {
+    return timeline_->reached(frame.timelineValue);
+  }
+
+  return frame.fence->isSignaled();
+}
+
+void ComputeExecutor::waitFrame(const Frame &frame) const {
+  if (timeline_ != nullptr) {
+    timeline_->wait(frame.timelineValue);
+    return;
+  }
+
+  frame.fence->wait();
+}
+
+void ComputeExecutor::allocateCommandBuffers() {
+  const uint32_t frameCount = desc_.pipelined ? desc_.framesInFlight : 1;
+
+  std::vector<VkCommandBuffer> commandBuffers(frameCount, VK_NULL_HANDLE);
+
   VkCommandBufferAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   allocInfo.commandPool = command_pool_.commandPool();
   allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  allocInfo.commandBufferCount = 1;
+  allocInfo.commandBufferCount = frameCount;
 
   if (vkAllocateCommandBuffers(device_.device(), &allocInfo,
-                               &command_buffer_) != VK_SUCCESS) {
-    VKR_EXEC_ERROR("failed to allocate compute command buffer");
+                               commandBuffers.data()) != VK_SUCCESS) {
+    VKR_EXEC_ERROR("failed to allocate compute command buffers");
+  }
+
+  frames_.resize(frameCount);
+  for (uint32_t i = 0; i < frameCount; ++i) {
+    frames_[i].commandBuffer = commandBuffers[i];
+    if (timeline_ == nullptr) {
+      frames_[i].fence = std::make_unique<core::Fence>(device_);
+    }
   }
 }
 
-void ComputeExecutor::freeCommandBuffer() noexcept {
-  if (command_buffer_ != VK_NULL_HANDLE) {
-    vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                         &command_buffer_);
-    command_buffer_ = VK_NULL_HANDLE;
+void ComputeExecutor::freeCommandBuffers() noexcept {
+  for (auto &frame : frames_) {
+    if (frame.commandBuffer != VK_NULL_HANDLE) {
+      vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
+                           &frame.commandBuffer);
+      frame.commandBuffer = VK_NULL_HANDLE;
+    }
   }
+
+  frames_.clear();
+  command_buffer_ = VK_NULL_HANDLE;
 }
 
 void ComputeExecutor::ensureActive(const char *op) const {
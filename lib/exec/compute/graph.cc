@@ -1,6 +1,8 @@
 #include "vkr/exec/compute/graph.hh"
 #include "vkr/logger.hh"
+#include <algorithm>
 #include <deque>
+#include <limits>
 
 namespace vkr::exec {
 
@@ -101,8 +103,11 @@ void ComputeGraph::compile() {
     VKR_EXEC_ERROR("Compute graph contains a dependency cycle");
   }
 
+  buildBarrierPlan();
+
   dirty_ = false;
-  VKR_EXEC_INFO("Compute graph compiled: passes={}", passes_.size());
+  VKR_EXEC_INFO("Compute graph compiled: passes={}, levels={}, barriers={}",
+                passes_.size(), levelCount(), barrierCount());
 }
 
 void ComputeGraph::create() {
@@ -110,10 +115,15 @@ void ComputeGraph::create() {
     compile();
   }
 
+  std::vector<Pass *> ordered{};
+  ordered.reserve(ordered_passes_.size());
   for (const size_t index : ordered_passes_) {
-    passes_[index]->create();
+    ordered.push_back(passes_[index].get());
   }
 
+  create_stats_ = createPasses(ordered, parallel_create_);
+  logCreateStats("Compute graph", create_stats_);
+
   created_ = true;
 }
 
@@ -134,8 +144,20 @@ void ComputeGraph::record() {
     create();
   }
 
+  size_t level = std::numeric_limits<size_t>::max();
   for (const size_t index : ordered_passes_) {
-    passes_[index]->record();
+    auto &pass = *passes_[index];
+
+    if (level == std::numeric_limits<size_t>::max()) {
+      pass.executor().barrier(entry_barrier_);
+    }
+
+    if (pass_levels_[index] != level) {
+      level = pass_levels_[index];
+      pass.executor().barrier(level_barriers_[level]);
+    }
+
+    pass.record();
   }
 }
 
@@ -175,6 +197,14 @@ auto ComputeGraph::getPass(std::string_view name) const
   return *passes_[index];
 }
 
+auto ComputeGraph::barrierCount() const noexcept -> size_t {
+  return static_cast<size_t>(
+      std::count_if(level_barriers_.begin(), level_barriers_.end(),
+                    [](const ComputeBarrier &barrier) -> bool {
+                      return !barrier.empty();
+                    }));
+}
+
 void ComputeGraph::rebuildNameTable() {
   pass_indices_.clear();
   pass_indices_.reserve(passes_.size());
@@ -242,6 +272,8 @@ void ComputeGraph::addCompiledDependency(size_t producer, size_t consumer) {
 void ComputeGraph::buildResourceDependencies() {
   const size_t passCount = passes_.size();
 
+  // a pass that only reads a resource runs after every writer of it; passes
+  // that also write it are ordered by declaration below
   for (size_t producer = 0; producer < passCount; ++producer) {
     const auto &writes = passes_[producer]->writes();
 
@@ -251,8 +283,9 @@ void ComputeGraph::buildResourceDependencies() {
       }
 
       const auto &reads = passes_[consumer]->reads();
+      const auto &consumerWrites = passes_[consumer]->writes();
       for (const auto &written : writes) {
-        if (contains(reads, written)) {
+        if (contains(reads, written) && !contains(consumerWrites, written)) {
           addCompiledDependency(producer, consumer);
         }
       }
@@ -274,6 +307,99 @@ void ComputeGraph::buildResourceDependencies() {
   }
 }
 
+void ComputeGraph::buildBarrierPlan() {
+  const size_t passCount = passes_.size();
+
+  // ordered_passes_ is topological, so a producer's level is final before
+  // its consumers are visited
+  pass_levels_.assign(passCount, 0);
+  size_t levels = passCount == 0 ? 0 : 1;
+  for (const size_t producer : ordered_passes_) {
+    for (const size_t consumer : compiled_dependencies_[producer]) {
+      pass_levels_[consumer] =
+          std::max(pass_levels_[consumer], pass_levels_[producer] + 1);
+      levels = std::max(levels, pass_levels_[consumer] + 1);
+    }
+  }
+
+  std::stable_sort(ordered_passes_.begin(), ordered_passes_.end(),
+                   [this](size_t lhs, size_t rhs) -> bool {
+                     return pass_levels_[lhs] < pass_levels_[rhs];
+                   });
+
+  // independent passes in one level share the barrier in front of it
+  level_barriers_.assign(levels, ComputeBarrier{});
+  for (size_t producer = 0; producer < passCount; ++producer) {
+    for (const size_t consumer : compiled_dependencies_[producer]) {
+      level_barriers_[pass_levels_[consumer]].merge(
+          hazardBarrier(producer, consumer));
+    }
+  }
+
+  // the previous submission of this graph may still touch what the first
+  // level reads or overwrites
+  entry_barrier_ = {};
+  for (const auto &pass : passes_) {
+    if (pass->writes().empty()) {
+      continue;
+    }
+
+    entry_barrier_.srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    entry_barrier_.dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    entry_barrier_.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    entry_barrier_.dstAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+
+    for (const auto &written : pass->writes()) {
+      for (const auto &reader : passes_) {
+        if (contains(reader->reads(), written)) {
+          entry_barrier_.dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+        }
+      }
+    }
+  }
+}
+
+auto ComputeGraph::hazardBarrier(size_t producer, size_t consumer) const
+    -> ComputeBarrier {
+  const auto &first = *passes_[producer];
+  const auto &second = *passes_[consumer];
+
+  ComputeBarrier barrier{};
+  barrier.srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+  barrier.dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+  bool shared = false;
+  for (const auto &written : first.writes()) {
+    if (contains(second.reads(), written)) {
+      barrier.srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+      barrier.dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+      shared = true;
+    }
+
+    if (contains(second.writes(), written)) {
+      barrier.srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+      barrier.dstAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+      shared = true;
+    }
+  }
+
+  // write-after-read only needs the reads to finish, not a memory barrier
+  for (const auto &read : first.reads()) {
+    if (contains(second.writes(), read)) {
+      shared = true;
+    }
+  }
+
+  // manual dependencies carry no resource, so assume the worst
+  if (!shared) {
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask =
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+  }
+
+  return barrier;
+}
+
 auto ComputeGraph::passIndex(std::string_view name) const -> size_t {
   auto it = pass_indices_.find(std::string(name));
 
@@ -61,7 +61,27 @@ void ComputePass::destroy() {
 
 void ComputePass::update(const ComputePassDesc &desc) { desc_ = desc; }
 
+auto ComputePass::awaitPipelines()
+    -> std::vector<pipeline::PipelineBuildStatus> {
+  if (!pipeline_) {
+    return {};
+  }
+
+  (void)pipeline_->waitPending();
+  if (!pipeline_->valid()) {
+    VKR_EXEC_ERROR("ComputePass '{}' failed to create compute pipeline '{}': "
+                   "{}",
+                   name(), desc_.pipeline.name, pipeline_->lastBuild().error);
+  }
+
+  return {pipeline_->lastBuild()};
+}
+
 void ComputePass::record() {
+  if (pipeline_) {
+    (void)pipeline_->commitPending();
+  }
+
   if (!pipeline_ || !pipeline_->valid()) {
     VKR_EXEC_ERROR("ComputePass '{}' recorded without a valid compute "
                    "pipeline",
@@ -133,12 +153,7 @@ void ComputePass::createPipeline() {
   }
 
   pipeline_ = std::make_unique<pipeline::ComputePipeline>(device_);
-  pipeline_->update(pipelineDesc);
-
-  if (!pipeline_->valid()) {
-    VKR_EXEC_ERROR("ComputePass '{}' failed to create compute pipeline '{}'",
-                   name(), pipelineDesc.name);
-  }
+  (void)pipeline_->updateAsync(pipelineDesc);
 }
 
 auto ComputePass::descriptorSetCount() const -> uint32_t {
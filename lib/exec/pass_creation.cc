@@ -0,0 +1,72 @@
+#include "vkr/exec/pass_creation.hh"
+#include "vkr/logger.hh"
+#include <chrono>
+
+namespace vkr::exec {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+auto elapsed(Clock::time_point start) -> double {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+void collect(Pass &pass, PassCreateTiming &timing) {
+  for (const auto &build : pass.awaitPipelines()) {
+    timing.pipelineMilliseconds += build.milliseconds;
+    ++timing.pipelines;
+  }
+}
+
+} // namespace
+
+auto createPasses(const std::vector<Pass *> &passes, bool parallel)
+    -> GraphCreateStats {
+  const auto start = Clock::now();
+  GraphCreateStats stats{.parallel = parallel};
+  stats.passes.reserve(passes.size());
+
+  for (auto *pass : passes) {
+    const auto passStart = Clock::now();
+    auto &timing = stats.passes.emplace_back();
+    timing.pass = pass->name();
+
+    pass->create();
+    if (!parallel) {
+      collect(*pass, timing);
+    }
+    timing.createMilliseconds = elapsed(passStart);
+  }
+
+  if (parallel) {
+    for (size_t index = 0; index < passes.size(); ++index) {
+      collect(*passes[index], stats.passes[index]);
+    }
+  }
+
+  stats.milliseconds = elapsed(start);
+  return stats;
+}
+
+void logCreateStats(std::string_view graph, const GraphCreateStats &stats) {
+  uint32_t pipelines = 0;
+  for (const auto &pass : stats.passes) {
+    pipelines += pass.pipelines;
+  }
+
+  VKR_EXEC_INFO("{} created in {:.3f} ms: {} passes, {} pipelines, {:.3f} ms "
+                "of pipeline builds ({})",
+                graph, stats.milliseconds, stats.passes.size(), pipelines,
+                stats.pipelineMilliseconds(),
+                stats.parallel ? "parallel" : "serial");
+
+  for (const auto &pass : stats.passes) {
+    VKR_EXEC_INFO("  {}: create {:.3f} ms, {} pipelines {:.3f} ms", pass.pass,
+                  pass.createMilliseconds, pass.pipelines,
+                  pass.pipelineMilliseconds);
+  }
+}
+
+} // namespace vkr::exec
@@ -2,6 +2,9 @@
 #include "vkr/logger.hh"
 #include <algorithm>
 #include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
 
 namespace vkr::exec {
 
@@ -54,25 +57,34 @@ void Profiler::create() {
   queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
   queryPoolInfo.queryCount = queryCount();
 
-  if (vkCreateQueryPool(device_.device(), &queryPoolInfo, nullptr,
-                        &query_pool_) != VK_SUCCESS) {
-    VKR_EXEC_WARN("GPU profiler disabled: failed to create timestamp query "
-                  "pool");
-    query_pool_ = VK_NULL_HANDLE;
-    return;
+  slots_.resize(desc_.frameSlots);
+  for (auto &slot : slots_) {
+    if (vkCreateQueryPool(device_.device(), &queryPoolInfo, nullptr,
+                          &slot.queryPool) != VK_SUCCESS) {
+      VKR_EXEC_WARN("GPU profiler disabled: failed to create timestamp query "
+                    "pool");
+      slot.queryPool = VK_NULL_HANDLE;
+      destroy();
+      return;
+    }
   }
 
   enabled_ = true;
-  VKR_EXEC_INFO("GPU profiler enabled: maxScopes={}, timestampPeriod={} ns",
-                desc_.maxScopes, timestamp_period_);
+  VKR_EXEC_INFO("GPU profiler enabled: maxScopes={}, frameSlots={}, "
+                "timestampPeriod={} ns",
+                desc_.maxScopes, desc_.frameSlots, timestamp_period_);
 }
 
 void Profiler::destroy() noexcept {
-  if (query_pool_ != VK_NULL_HANDLE) {
-    vkDestroyQueryPool(device_.device(), query_pool_, nullptr);
-    query_pool_ = VK_NULL_HANDLE;
+  for (auto &slot : slots_) {
+    if (slot.queryPool != VK_NULL_HANDLE) {
+      vkDestroyQueryPool(device_.device(), slot.queryPool, nullptr);
+      slot.queryPool = VK_NULL_HANDLE;
+    }
   }
 
+  slots_.clear();
+  resolved_.clear();
   enabled_ = false;
   frame_active_ = false;
 }
@@ -86,12 +98,32 @@ void Profiler::beginFrame(VkCommandBuffer commandBuffer) {
     VKR_EXEC_ERROR("Profiler::beginFrame received null command buffer");
   }
 
-  scopes_.clear();
   scope_stack_.clear();
-  next_query_ = 0;
+  current_slot_ = static_cast<uint32_t>(frame_count_ % slots_.size());
+
+  auto &slot = slots_[current_slot_];
+  if (slot.pending) {
+    // last chance to read this slot before its queries are reset
+    ProfileReport report{};
+    if (resolve(slot, report)) {
+      resolved_.push_back(std::move(report));
+    } else {
+      if (dropped_frames_ == 0) {
+        VKR_EXEC_WARN("GPU profiler dropped frame {}: results not available "
+                      "after {} frame(s), consider raising frameSlots",
+                      slot.frame, slots_.size());
+      }
+      slot.pending = false;
+      dropped_frames_++;
+    }
+  }
+
+  slot.scopes.clear();
+  slot.usedQueries = 0;
+  slot.frame = frame_count_++;
   frame_active_ = true;
 
-  vkCmdResetQueryPool(commandBuffer, query_pool_, 0, queryCount());
+  vkCmdResetQueryPool(commandBuffer, slot.queryPool, 0, queryCount());
 }
 
 void Profiler::endFrame(VkCommandBuffer) {
@@ -108,6 +140,8 @@ void Profiler::endFrame(VkCommandBuffer) {
                    scope_stack_.size());
   }
 
+  auto &slot = slots_[current_slot_];
+  slot.pending = !slot.scopes.empty();
   frame_active_ = false;
 }
 
@@ -125,7 +159,8 @@ void Profiler::beginScope(VkCommandBuffer commandBuffer, std::string_view name,
     VKR_EXEC_ERROR("Profiler::beginScope received null command buffer");
   }
 
-  if (next_query_ + 1 >= queryCount()) {
+  auto &slot = slots_[current_slot_];
+  if (slot.usedQueries + 1 >= queryCount()) {
     VKR_EXEC_WARN("GPU profiler scope limit reached, skipping scope '{}'",
                   std::string(name));
     return;
@@ -133,15 +168,15 @@ void Profiler::beginScope(VkCommandBuffer commandBuffer, std::string_view name,
 
   Scope scope{};
   scope.name = name.empty() ? "unnamed" : std::string(name);
-  scope.beginQuery = next_query_++;
-  scope.endQuery = next_query_++;
+  scope.beginQuery = slot.usedQueries++;
+  scope.endQuery = slot.usedQueries++;
 
-  const size_t scopeIndex = scopes_.size();
-  scopes_.push_back(std::move(scope));
+  const size_t scopeIndex = slot.scopes.size();
+  slot.scopes.push_back(std::move(scope));
   scope_stack_.push_back(scopeIndex);
 
-  vkCmdWriteTimestamp(commandBuffer, stage, query_pool_,
-                      scopes_.back().beginQuery);
+  vkCmdWriteTimestamp(commandBuffer, stage, slot.queryPool,
+                      slot.scopes.back().beginQuery);
 }
 
 void Profiler::endScope(VkCommandBuffer commandBuffer,
@@ -166,33 +201,87 @@ void Profiler::endScope(VkCommandBuffer commandBuffer,
   const size_t scopeIndex = scope_stack_.back();
   scope_stack_.pop_back();
 
-  vkCmdWriteTimestamp(commandBuffer, stage, query_pool_,
-                      scopes_[scopeIndex].endQuery);
+  const auto &slot = slots_[current_slot_];
+  vkCmdWriteTimestamp(commandBuffer, stage, slot.queryPool,
+                      slot.scopes[scopeIndex].endQuery);
 }
 
 auto Profiler::collect() -> ProfileReport {
-  ProfileReport report{};
-  report.gpuTimestampsEnabled = enabled_;
-
-  if (!enabled_ || scopes_.empty()) {
+  auto reports = collectAll();
+  if (reports.empty()) {
+    ProfileReport report{};
+    report.gpuTimestampsEnabled = enabled_;
     return report;
   }
 
-  std::vector<uint64_t> timestamps(next_query_, 0);
+  return std::move(reports.back());
+}
+
+auto Profiler::collectAll() -> std::vector<ProfileReport> {
+  std::vector<ProfileReport> reports = std::move(resolved_);
+  resolved_.clear();
+
+  if (!enabled_) {
+    return reports;
+  }
+
+  std::vector<FrameSlot *> pending{};
+  for (auto &slot : slots_) {
+    if (slot.pending) {
+      pending.push_back(&slot);
+    }
+  }
+
+  std::sort(pending.begin(), pending.end(),
+            [](const FrameSlot *lhs, const FrameSlot *rhs) -> bool {
+              return lhs->frame < rhs->frame;
+            });
+
+  for (auto *slot : pending) {
+    ProfileReport report{};
+    if (!resolve(*slot, report)) {
+      // the GPU finishes frames in order, later slots are not ready either
+      break;
+    }
+
+    reports.push_back(std::move(report));
+  }
+
+  return reports;
+}
+
+auto Profiler::resolve(FrameSlot &slot, ProfileReport &report) -> bool {
+  if (slot.usedQueries == 0) {
+    slot.pending = false;
+    return false;
+  }
+
+  // each query returns its timestamp followed by an availability word
+  std::vector<uint64_t> results(static_cast<size_t>(slot.usedQueries) * 2, 0);
   const VkResult result = vkGetQueryPoolResults(
-      device_.device(), query_pool_, 0, next_query_,
-      sizeof(uint64_t) * timestamps.size(), timestamps.data(), sizeof(uint64_t),
-      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+      device_.device(), slot.queryPool, 0, slot.usedQueries,
+      sizeof(uint64_t) * results.size(), results.data(), sizeof(uint64_t) * 2,
+      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
 
-  if (result != VK_SUCCESS) {
+  if (result != VK_SUCCESS && result != VK_NOT_READY) {
     VKR_EXEC_WARN("Failed to collect GPU profiler timestamp results");
-    return report;
+    slot.pending = false;
+    return false;
+  }
+
+  for (uint32_t query = 0; query < slot.usedQueries; ++query) {
+    if (results[static_cast<size_t>(query) * 2 + 1] == 0) {
+      return false;
+    }
   }
 
-  report.gpuSamples.reserve(scopes_.size());
-  for (const auto &scope : scopes_) {
-    const uint64_t delta = timestampDelta(timestamps[scope.beginQuery],
-                                          timestamps[scope.endQuery]);
+  report.gpuTimestampsEnabled = true;
+  report.frame = slot.frame;
+  report.gpuSamples.reserve(slot.scopes.size());
+  for (const auto &scope : slot.scopes) {
+    const uint64_t delta =
+        timestampDelta(results[static_cast<size_t>(scope.beginQuery) * 2],
+                       results[static_cast<size_t>(scope.endQuery) * 2]);
     const double nanoseconds = static_cast<double>(delta) * timestamp_period_;
     const double milliseconds = nanoseconds / 1'000'000.0;
     report.gpuSamples.push_back(ProfileSample{
@@ -205,7 +294,8 @@ auto Profiler::collect() -> ProfileReport {
     });
   }
 
-  return report;
+  slot.pending = false;
+  return true;
 }
 
 auto Profiler::queryCount() const noexcept -> uint32_t {
@@ -228,4 +318,98 @@ auto Profiler::timestampDelta(uint64_t begin, uint64_t end) const -> uint64_t {
   return (mask - begin) + end + 1U;
 }
 
+auto summarizeTimings(std::string name, std::vector<double> milliseconds)
+    -> ProfileSample {
+  ProfileSample sample{.name = std::move(name), .captureCount = 0};
+  if (milliseconds.empty()) {
+    return sample;
+  }
+
+  std::sort(milliseconds.begin(), milliseconds.end());
+  const double sum =
+      std::accumulate(milliseconds.begin(), milliseconds.end(), 0.0);
+  const size_t count = milliseconds.size();
+  double median = milliseconds[count / 2];
+  if (count % 2 == 0) {
+    median = (milliseconds[(count / 2) - 1] + median) * 0.5;
+  }
+
+  sample.milliseconds = sum / static_cast<double>(count);
+  sample.minMilliseconds = milliseconds.front();
+  sample.medianMilliseconds = median;
+  sample.maxMilliseconds = milliseconds.back();
+  sample.captureCount = static_cast<uint32_t>(count);
+  return sample;
+}
+
+auto summarizeReports(const std::vector<ProfileReport> &reports)
+    -> ProfileReport {
+  ProfileReport summary{};
+  std::unordered_map<std::string, std::vector<double>> cpuTimings{};
+  std::unordered_map<std::string, std::vector<double>> gpuTimings{};
+  for (const auto &report : reports) {
+    summary.gpuTimestampsEnabled =
+        summary.gpuTimestampsEnabled || report.gpuTimestampsEnabled;
+    summary.frame = std::max(summary.frame, report.frame);
+
+    for (const auto &sample : report.cpuSamples) {
+      cpuTimings[sample.name].push_back(sample.milliseconds);
+    }
+    for (const auto &sample : report.gpuSamples) {
+      gpuTimings[sample.name].push_back(sample.milliseconds);
+    }
+  }
+
+  const auto byName = [](const ProfileSample &lhs,
+                         const ProfileSample &rhs) -> bool {
+    return lhs.name < rhs.name;
+  };
+
+  summary.cpuSamples.reserve(cpuTimings.size());
+  for (auto &[name, values] : cpuTimings) {
+    if (!values.empty()) {
+      summary.cpuSamples.push_back(summarizeTimings(name, std::move(values)));
+    }
+  }
+  std::sort(summary.cpuSamples.begin(), summary.cpuSamples.end(), byName);
+
+  summary.gpuSamples.reserve(gpuTimings.size());
+  for (auto &[name, values] : gpuTimings) {
+    if (!values.empty()) {
+      summary.gpuSamples.push_back(summarizeTimings(name, std::move(values)));
+    }
+  }
+  std::sort(summary.gpuSamples.begin(), summary.gpuSamples.end(), byName);
+
+  return summary;
+}
+
+void logProfileSummary(const ProfileReport &report) {
+  if (report.empty()) {
+    VKR_EXEC_INFO("profile report: no samples");
+  }
+
+  if (!report.cpuSamples.empty()) {
+    VKR_EXEC_INFO("CPU profile report:");
+    for (const auto &sample : report.cpuSamples) {
+      VKR_EXEC_INFO("  {}: captures={}, min={:.6f} ms, mean={:.6f} ms, "
+                    "median={:.6f} ms, max={:.6f} ms",
+                    sample.name, sample.captureCount, sample.minMilliseconds,
+                    sample.milliseconds, sample.medianMilliseconds,
+                    sample.maxMilliseconds);
+    }
+  }
+
+  if (!report.gpuSamples.empty()) {
+    VKR_EXEC_INFO("GPU profile report:");
+    for (const auto &sample : report.gpuSamples) {
+      VKR_EXEC_INFO("  {}: captures={}, min={:.6f} ms, mean={:.6f} ms, "
+                    "median={:.6f} ms, max={:.6f} ms",
+                    sample.name, sample.captureCount, sample.minMilliseconds,
+                    sample.milliseconds, sample.medianMilliseconds,
+                    sample.maxMilliseconds);
+    }
+  }
+}
+
 } // namespace vkr::exec
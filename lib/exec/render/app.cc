@@ -1,15 +1,25 @@
 #include "vkr/exec/render/app.hh"
 #include "vkr/exec/render/passes/ui.hh"
+#include "vkr/exec/render/readback.hh"
 #include "vkr/logger.hh"
 #include "vkr/util/toml.hh"
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <optional>
+#include <string_view>
 
 namespace vkr::exec {
 
 void RenderApplication::run() {
   initVulkan();
 
+  if (ctx.headless.enabled) {
+    runHeadless();
+    return;
+  }
+
   try {
     mainLoop();
     saveSnapshot();
@@ -19,6 +29,60 @@ void RenderApplication::run() {
   }
 }
 
+void RenderApplication::run(int argc, char **argv) {
+  arguments_.assign(argv + std::min(argc, 1), argv + argc);
+  run();
+}
+
+void RenderApplication::applyArguments() {
+  const auto value = [](const std::string &arg,
+                        std::string_view key) -> std::optional<std::string> {
+    if (arg.size() <= key.size() || arg.compare(0, key.size(), key) != 0 ||
+        arg[key.size()] != '=') {
+      return std::nullopt;
+    }
+    return arg.substr(key.size() + 1);
+  };
+
+  for (const auto &arg : arguments_) {
+    if (arg == "--headless") {
+      ctx.headless.enabled = true;
+    } else if (auto frames = value(arg, "--frames")) {
+      ctx.headless.frames = static_cast<uint32_t>(std::stoul(*frames));
+    } else if (auto warmup = value(arg, "--warmup")) {
+      ctx.headless.warmupFrames = static_cast<uint32_t>(std::stoul(*warmup));
+    } else if (auto capture = value(arg, "--capture")) {
+      ctx.headless.capturePath = *capture;
+    } else if (auto threads = value(arg, "--record-threads")) {
+      ctx.recording.threads = static_cast<uint32_t>(std::stoul(*threads));
+    } else if (auto sync = value(arg, "--sync")) {
+      if (*sync != "timeline" && *sync != "fence") {
+        VKR_UTIL_WARN("unknown --sync value {}, expected timeline or fence",
+                      *sync);
+        continue;
+      }
+      ctx.device.timelineSemaphore = *sync == "timeline";
+    } else if (auto resize = value(arg, "--resize")) {
+      if (*resize != "incremental" && *resize != "full") {
+        VKR_UTIL_WARN("unknown --resize value {}, expected incremental or full",
+                      *resize);
+        continue;
+      }
+      incremental_resize_ = *resize == "incremental";
+    } else if (auto pipelines = value(arg, "--pipelines")) {
+      if (*pipelines != "parallel" && *pipelines != "serial") {
+        VKR_UTIL_WARN("unknown --pipelines value {}, expected parallel or "
+                      "serial",
+                      *pipelines);
+        continue;
+      }
+      parallel_pipelines_ = *pipelines == "parallel";
+    } else {
+      VKR_UTIL_WARN("ignoring unknown argument: {}", arg);
+    }
+  }
+}
+
 void RenderApplication::loadSnapshot() {
   const auto path = snapshotPath();
 
@@ -45,7 +109,22 @@ void RenderApplication::saveSnapshot() {
 void RenderApplication::initVulkan() {
   Logger::init();
   configure();
-  loadSnapshot();
+  applyArguments();
+
+  const bool headless = ctx.headless.enabled;
+  if (headless) {
+    // benchmarks must not pick up state saved by interactive sessions
+    ctx.window.width = ctx.headless.width;
+    ctx.window.height = ctx.headless.height;
+    ctx.camera.aspectRatio = ctx.window.ratio();
+    ctx.instance.surfaceIntegration = core::SurfaceIntegration::None;
+    ctx.swapchain.headless = true;
+    ctx.swapchain.headlessExtent = {ctx.headless.width, ctx.headless.height};
+    ctx.swapchain.headlessImageCount = ctx.headless.imageCount;
+    ctx.swapchain.headlessFormat = ctx.headless.format;
+  } else {
+    loadSnapshot();
+  }
 
   ctx.commandPool.queueRole = core::CommandQueueRole::Graphics;
 
@@ -56,28 +135,50 @@ void RenderApplication::initVulkan() {
   // asset
   assetSystem = std::make_unique<util::AssetSystem>(ctx.asset);
 
-  // window
-  window = std::make_unique<core::Window>(ctx.window);
+  // shader cache
+  util::ShaderCacheDesc shaderCache = ctx.shaderCache;
+  if (std::filesystem::path(shaderCache.directory).is_relative()) {
+    shaderCache.directory =
+        (std::filesystem::path(ctx.asset.userRoot) / shaderCache.directory)
+            .lexically_normal()
+            .string();
+  }
+  util::ShaderCache::instance().configure(shaderCache);
 
-  // input
-  inputTracer = std::make_unique<util::InputTracer>(window->glfwWindow());
-  inputTracer->installCallbacks();
+  if (headless) {
+    inputTracer = std::make_unique<util::InputTracer>(nullptr);
+    instance = std::make_unique<core::Instance>(ctx.instance);
 
-  // instance
-  instance = std::make_unique<core::Instance>(ctx.instance);
+    device = std::make_unique<core::Device>(*instance, ctx.device);
+    if (!device->supportsGraphics()) {
+      VKR_CORE_ERROR("headless rendering requires graphics queue support");
+    }
 
-  // surface
-  surface = std::make_unique<core::Surface>(*instance, *window);
+    swapchain = std::make_unique<core::Swapchain>(*device, ctx.swapchain);
+  } else {
+    // window
+    window = std::make_unique<core::Window>(ctx.window);
 
-  // device
-  device = std::make_unique<core::Device>(*instance, *surface, ctx.device);
-  if (!device->supportsGraphics() || !device->supportsPresent()) {
-    VKR_CORE_ERROR("rendering requires graphics and present queue support");
-  }
+    // input
+    inputTracer = std::make_unique<util::InputTracer>(window->glfwWindow());
+    inputTracer->installCallbacks();
+
+    // instance
+    instance = std::make_unique<core::Instance>(ctx.instance);
 
-  // swapchain
-  swapchain = std::make_unique<core::Swapchain>(*window, *surface, *device,
-                                                ctx.swapchain);
+    // surface
+    surface = std::make_unique<core::Surface>(*instance, *window);
+
+    // device
+    device = std::make_unique<core::Device>(*instance, *surface, ctx.device);
+    if (!device->supportsGraphics() || !device->supportsPresent()) {
+      VKR_CORE_ERROR("rendering requires graphics and present queue support");
+    }
+
+    // swapchain
+    swapchain = std::make_unique<core::Swapchain>(*window, *surface, *device,
+                                                  ctx.swapchain);
+  }
 
   // command pool
   commandPool = std::make_unique<core::CommandPool>(*device, ctx.commandPool);
@@ -96,9 +197,14 @@ void RenderApplication::initVulkan() {
   // scene
   scene = std::make_unique<vkr::scene::Scene>(*device, *commandPool,
                                               *commandBuffers);
+  if (device->descriptorIndexing()) {
+    scene->enableBindless();
+  }
 
   // user resources
   createResources();
+  commandPool->uploader().flush();
+  commandPool->uploader().logStats();
 
   // timer
   timer = std::make_unique<util::Timer>();
@@ -112,11 +218,22 @@ void RenderApplication::initVulkan() {
                                         *frameSync, *scene, *commandBuffers);
   executor->setProfiler(profiler.get());
 
+  // parallel recording
+  if (ctx.recording.threads > 0) {
+    recorder = std::make_unique<ParallelRecorder>(
+        *device, *commandPool, executor->framesInFlight(), ctx.recording);
+    executor->setParallelRecorder(recorder.get());
+  }
+
   // render graph
-  graph = std::make_unique<RenderGraph>();
+  graph = std::make_unique<RenderGraph>(*executor);
+  graph->parallelCreate(parallel_pipelines_);
   buildGraph();
   graph->compile();
   graph->create();
+
+  device->allocator().logStats();
+  util::ShaderCache::instance().logStats();
 }
 
 void RenderApplication::mainLoop() {
@@ -145,6 +262,130 @@ void RenderApplication::mainLoop() {
   }
 
   device->waitIdle();
+  device->allocator().logStats();
+}
+
+void RenderApplication::runHeadless() {
+  using Clock = std::chrono::steady_clock;
+  const auto &headless = ctx.headless;
+  const uint32_t totalFrames = headless.warmupFrames + headless.frames;
+
+  std::vector<double> frameTimes{};
+  std::vector<double> recordTimes{};
+  std::vector<double> cullTimes{};
+  frameTimes.reserve(headless.frames);
+  recordTimes.reserve(headless.frames);
+  cullTimes.reserve(headless.frames);
+  std::vector<ProfileReport> captures{};
+  std::optional<uint64_t> lastReport{};
+
+  timer->fixedStep(headless.fixedStep);
+  timer->start();
+
+  auto benchmarkStart = Clock::now();
+  for (uint32_t i = 0; i < totalFrames; ++i) {
+    const bool measured = i >= headless.warmupFrames;
+    const auto frameStart = Clock::now();
+    if (i == headless.warmupFrames) {
+      benchmarkStart = frameStart;
+    }
+
+    timer->beginFrame();
+    inputTracer->beginFrame();
+    timer->update();
+    drawFrame();
+    timer->endFrame();
+
+    if (!measured) {
+      continue;
+    }
+
+    frameTimes.push_back(std::chrono::duration<double, std::milli>(
+                             Clock::now() - frameStart)
+                             .count());
+    recordTimes.push_back(record_milliseconds_);
+    cullTimes.push_back(executor->drawStats().cullMilliseconds);
+
+    if (!profileReport.empty() && lastReport != profileReport.frame) {
+      lastReport = profileReport.frame;
+      captures.push_back(profileReport);
+    }
+  }
+
+  device->waitIdle();
+  const double totalMs = std::chrono::duration<double, std::milli>(
+                             Clock::now() - benchmarkStart)
+                             .count();
+
+  const auto frameSample = summarizeTimings("frame", frameTimes);
+  std::sort(frameTimes.begin(), frameTimes.end());
+  const size_t p99Index = frameTimes.empty()
+                              ? 0
+                              : ((frameTimes.size() * 99) + 99) / 100 - 1;
+  const double p99 = frameTimes.empty() ? 0.0 : frameTimes[p99Index];
+
+  VKR_EXEC_INFO("Headless benchmark: {} frame(s) at {}x{} in {:.3f} ms, "
+                "{:.1f} fps, {} sync",
+                headless.frames, swapchain->width(), swapchain->height(),
+                totalMs,
+                totalMs > 0.0 ? headless.frames * 1000.0 / totalMs : 0.0,
+                frameSync->timelineEnabled() ? "timeline" : "fence");
+  VKR_EXEC_INFO("  frame: min={:.6f} ms, mean={:.6f} ms, median={:.6f} ms, "
+                "p99={:.6f} ms, max={:.6f} ms",
+                frameSample.minMilliseconds, frameSample.milliseconds,
+                frameSample.medianMilliseconds, p99,
+                frameSample.maxMilliseconds);
+
+  const auto recordSample = summarizeTimings("record", recordTimes);
+  const auto &draws = executor->drawStats();
+  VKR_EXEC_INFO("  record ({} thread(s)): min={:.6f} ms, mean={:.6f} ms, "
+                "median={:.6f} ms, max={:.6f} ms, draws={}, secondary "
+                "buffers={}, binds issued={}, binds skipped={}",
+                recorder ? recorder->threadCount() : 0,
+                recordSample.minMilliseconds, recordSample.milliseconds,
+                recordSample.medianMilliseconds, recordSample.maxMilliseconds,
+                draws.drawCalls, draws.secondaryCommandBuffers,
+                draws.bindsIssued, draws.bindsSkipped);
+
+  if (draws.cullObjects > 0) {
+    const auto cullSample = summarizeTimings("cull", cullTimes);
+    VKR_EXEC_INFO("  culling: visible={}/{} objects, occluded={}, "
+                  "overflowed={}, min={:.6f} ms, mean={:.6f} ms, "
+                  "median={:.6f} ms, max={:.6f} ms",
+                  draws.cullVisible, draws.cullObjects, draws.cullOccluded,
+                  draws.cullOverflowed,
+                  cullSample.minMilliseconds, cullSample.milliseconds,
+                  cullSample.medianMilliseconds, cullSample.maxMilliseconds);
+  }
+
+  const auto &barriers = graph->barrierStats();
+  VKR_EXEC_INFO("  render graph per frame: barriers={}, image barriers={}, "
+                "layout transitions={}, skipped accesses={}",
+                barriers.pipelineBarriers, barriers.imageBarriers,
+                barriers.layoutTransitions, barriers.skippedAccesses);
+
+  profileReport = summarizeReports(captures);
+  if (ctx.profiler.logReport) {
+    logProfileSummary(profileReport);
+  }
+
+  if (!headless.capturePath.empty()) {
+    captureFrame(headless.capturePath);
+  }
+
+  device->allocator().logStats();
+}
+
+void RenderApplication::captureFrame(const std::filesystem::path &path) {
+  const uint32_t imageIndex = executor->lastPresentedImage();
+  const auto image =
+      readbackImage(*device, *commandPool, swapchain->images().at(imageIndex),
+                    swapchain->finalLayout(), swapchain->format(),
+                    {swapchain->width(), swapchain->height()});
+
+  if (!writePng(path, image)) {
+    VKR_EXEC_ERROR("failed to write headless capture: {}", path.string());
+  }
 }
 
 void RenderApplication::drawFrame() {
@@ -156,16 +397,26 @@ void RenderApplication::drawFrame() {
   }
 
   onDraw();
+  const auto recordStart = std::chrono::steady_clock::now();
   executor->beginProfileScope("render_graph");
   graph->record();
   executor->endProfileScope();
+  record_milliseconds_ = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - recordStart)
+                             .count();
 
   executor->submitFrame();
-  profileReport = profiler ? profiler->collect() : ProfileReport{};
-  if (ctx.profiler.logReport && !profileReport.gpuSamples.empty()) {
-    VKR_EXEC_INFO("GPU profile report:");
-    for (const auto &sample : profileReport.gpuSamples) {
-      VKR_EXEC_INFO("  {}: {:.6f} ms", sample.name, sample.milliseconds);
+  // timestamps resolve a few frames late; keep the newest finished report
+  auto report = profiler ? profiler->collect() : ProfileReport{};
+  if (!report.gpuSamples.empty()) {
+    profileReport = std::move(report);
+
+    // headless runs log one aggregated report at the end instead
+    if (ctx.profiler.logReport && !ctx.headless.enabled) {
+      VKR_EXEC_INFO("GPU profile report (frame {}):", profileReport.frame);
+      for (const auto &sample : profileReport.gpuSamples) {
+        VKR_EXEC_INFO("  {}: {:.6f} ms", sample.name, sample.milliseconds);
+      }
     }
   }
 
@@ -226,15 +477,38 @@ void RenderApplication::recreateSwapchain() {
 
   ctx.camera.aspectRatio = ctx.window.ratio();
 
-  graph->destroy();
+  const auto start = std::chrono::steady_clock::now();
+  const VkExtent2D previous{swapchain->width(), swapchain->height()};
+  const VkFormat previousFormat = swapchain->format();
 
   swapchain->recreate();
   frameSync->recreate();
 
-  graph = std::make_unique<RenderGraph>();
-  buildGraph();
-  graph->compile();
-  graph->create();
+  const VkExtent2D extent{swapchain->width(), swapchain->height()};
+  // a new surface format invalidates render passes, so only a pure extent
+  // change can keep the graph
+  const bool incremental =
+      incremental_resize_ && graph && swapchain->format() == previousFormat;
+
+  if (incremental) {
+    graph->resize(previous, extent);
+  } else {
+    if (graph) {
+      graph->destroy();
+    }
+    graph = std::make_unique<RenderGraph>(*executor);
+    graph->parallelCreate(parallel_pipelines_);
+    buildGraph();
+    graph->compile();
+    graph->create();
+  }
+
+  const double milliseconds = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+  VKR_EXEC_INFO("Swapchain resized to {}x{} in {:.3f} ms ({})", extent.width,
+                extent.height, milliseconds,
+                incremental ? "incremental" : "full rebuild");
 }
 
 } // namespace vkr::exec
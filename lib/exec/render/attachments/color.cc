@@ -22,12 +22,7 @@ void ColorAttachment::create() {
                   desc_.height);
   }
 
-  auto imageDesc = resource::ImageDesc::colorAttachment(
-      desc_.width, desc_.height, desc_.format);
-
-  imageDesc.usage = desc_.usage;
-
-  image_->update(imageDesc);
+  image_->update(desc_.imageDesc());
   image_->setLayout(desc_.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED
                         ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
                         : desc_.finalLayout);
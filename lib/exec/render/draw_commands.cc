@@ -0,0 +1,61 @@
+#include "vkr/exec/render/draw_commands.hh"
+#include "vkr/logger.hh"
+
+namespace vkr::exec {
+
+DrawCommandBuffer::DrawCommandBuffer(const core::Device &device,
+                                     uint32_t frameCount)
+    : device_(device) {
+  if (frameCount == 0) {
+    VKR_EXEC_ERROR("DrawCommandBuffer frame count must be greater than zero");
+  }
+
+  buffers_.reserve(frameCount);
+  for (uint32_t i = 0; i < frameCount; ++i) {
+    buffers_.push_back(std::make_unique<resource::Buffer>(device_));
+  }
+  counts_.resize(frameCount, 0);
+}
+
+void DrawCommandBuffer::update(
+    uint32_t frameIndex,
+    const std::vector<VkDrawIndexedIndirectCommand> &commands) {
+  ensureFrame(frameIndex);
+
+  counts_[frameIndex] = static_cast<uint32_t>(commands.size());
+  if (commands.empty()) {
+    return;
+  }
+
+  const auto byteSize =
+      static_cast<VkDeviceSize>(stride()) * commands.size();
+  auto &target = *buffers_[frameIndex];
+
+  if (!target.isValid() || target.size() < byteSize) {
+    target.update(byteSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    (void)target.map();
+  }
+
+  target.write(commands.data(), byteSize);
+}
+
+auto DrawCommandBuffer::buffer(uint32_t frameIndex) const -> VkBuffer {
+  ensureFrame(frameIndex);
+  return buffers_[frameIndex]->buffer();
+}
+
+auto DrawCommandBuffer::commandCount(uint32_t frameIndex) const -> uint32_t {
+  ensureFrame(frameIndex);
+  return counts_[frameIndex];
+}
+
+void DrawCommandBuffer::ensureFrame(uint32_t frameIndex) const {
+  if (frameIndex >= buffers_.size()) {
+    VKR_EXEC_ERROR("DrawCommandBuffer frame {} out of range, count {}",
+                   frameIndex, buffers_.size());
+  }
+}
+
+} // namespace vkr::exec
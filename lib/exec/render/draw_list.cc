@@ -0,0 +1,39 @@
+#include "vkr/exec/render/draw_list.hh"
+#include <algorithm>
+
+namespace vkr::exec {
+namespace {
+
+constexpr auto fieldMask(uint32_t bits) noexcept -> uint64_t {
+  return (uint64_t{1} << bits) - 1;
+}
+
+} // namespace
+
+auto DrawSortKey::encode() const noexcept -> uint64_t {
+  const float clamped = std::clamp(depth, 0.0f, 1.0f);
+  const auto quantized = static_cast<uint64_t>(
+      clamped * static_cast<float>(fieldMask(kDepthBits)));
+
+  uint64_t key = pipeline & fieldMask(kPipelineBits);
+  key = (key << kDescriptorSetBits) |
+        (descriptorSet & fieldMask(kDescriptorSetBits));
+  key = (key << kMeshBits) | (mesh & fieldMask(kMeshBits));
+  key = (key << kDepthBits) | (quantized & fieldMask(kDepthBits));
+  return key;
+}
+
+void DrawList::add(const DrawSortKey &key, uint32_t draw) {
+  entries_.push_back({key.encode(), draw});
+}
+
+// ties keep submission order, so equal keys record deterministically
+void DrawList::sort() {
+  std::sort(entries_.begin(), entries_.end(),
+            [](const DrawListEntry &lhs, const DrawListEntry &rhs) -> bool {
+              return lhs.key != rhs.key ? lhs.key < rhs.key
+                                        : lhs.draw < rhs.draw;
+            });
+}
+
+} // namespace vkr::exec
@@ -2,6 +2,20 @@
 #include "vkr/logger.hh"
 
 namespace vkr::exec {
+namespace {
+
+// set on a worker thread while it records a chunk, so the draw helpers write
+// into that chunk's secondary buffer instead of the frame's primary one
+struct ChunkRecording {
+  const Executor *executor{nullptr};
+  VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
+  ExecutorDrawStats stats{};
+  ExecutorBindState bindState{};
+};
+
+thread_local ChunkRecording *current_chunk = nullptr;
+
+} // namespace
 
 Executor::Executor(const core::Device &device, const core::Swapchain &swapchain,
                    const core::CommandPool &commandPool, FrameSync &frameSync,
@@ -17,12 +31,23 @@ Executor::Executor(const core::Device &device, const core::Swapchain &swapchain,
                    "FrameSync frames in flight {}",
                    command_buffers_.size(), frame_sync_.framesInFlight());
   }
+
+  frame_epochs_.assign(frame_sync_.framesInFlight(), 0);
+  deletion_submitter_ = device_.deletionQueue().addSubmitter();
+}
+
+Executor::~Executor() {
+  device_.deletionQueue().removeSubmitter(deletion_submitter_);
 }
 
 auto Executor::beginFrame() -> bool {
   ensureFrameInactive("beginFrame");
 
   frame_sync_.waitForFrame(current_frame_);
+  // the graphics queue retires in order, so everything released up to this
+  // slot's last submission is no longer referenced
+  device_.deletionQueue().collect(deletion_submitter_,
+                                 frame_epochs_[current_frame_]);
 
   uint32_t imageIndex = 0;
   if (!acquireNextImage(imageIndex)) {
@@ -31,6 +56,10 @@ auto Executor::beginFrame() -> bool {
 
   frame_sync_.resetFrame(current_frame_);
 
+  if (recorder_ != nullptr) {
+    recorder_->beginFrame(current_frame_);
+  }
+
   VkCommandBuffer commandBuffer = command_buffers_.buffer(current_frame_);
   vkResetCommandBuffer(commandBuffer, 0);
 
@@ -48,6 +77,8 @@ auto Executor::beginFrame() -> bool {
   frame_active_ = true;
   frame_submitted_ = false;
   frame_presented_ = false;
+  draw_stats_ = {};
+  bind_state_ = {};
 
   if (profiler_ != nullptr) {
     profiler_->beginFrame(command_buffer_);
@@ -71,6 +102,8 @@ void Executor::submitFrame() {
     VKR_EXEC_ERROR("failed to record command buffer");
   }
 
+  // uploads recorded while building this frame go out first on the same queue
+  command_pool_.uploader().flush();
   submitCommandBuffer();
   frame_submitted_ = true;
 }
@@ -94,6 +127,19 @@ void Executor::setProfiler(Profiler *profiler) noexcept {
   profiler_ = profiler;
 }
 
+void Executor::setParallelRecorder(ParallelRecorder *recorder) noexcept {
+  recorder_ = recorder;
+}
+
+void Executor::waitOn(const core::TimelinePoint &point,
+                      VkPipelineStageFlags stageMask) {
+  if (!point.isValid()) {
+    return;
+  }
+
+  pending_waits_.emplace_back(point, stageMask);
+}
+
 void Executor::endFrame() {
   ensureFrameActive("endFrame");
 
@@ -119,6 +165,7 @@ void Executor::beginPass(const FramebufferSet &framebufferSet,
                          const pipeline::RenderPass &renderPass,
                          const RenderPassBeginDesc &desc) {
   ensureFrameActive("beginPass");
+  ensurePrimary("beginPass");
 
   if (desc.framebufferIndex >= framebufferSet.buffers().size()) {
     VKR_EXEC_ERROR("Framebuffer index {} out of range, framebuffer count {}",
@@ -140,17 +187,160 @@ void Executor::beginPass(const FramebufferSet &framebufferSet,
       desc.clearValues.empty() ? nullptr : desc.clearValues.data();
 
   vkCmdBeginRenderPass(command_buffer_, &info, desc.contents);
+  // commands recorded through commandBuffer() between passes are not
+  // tracked, so every pass starts from a clean cache
+  bind_state_ = {};
+  active_render_pass_ = info.renderPass;
+  active_framebuffer_ = info.framebuffer;
+  active_contents_ = desc.contents;
 }
 
 void Executor::endPass() {
   ensureFrameActive("endPass");
+  ensurePrimary("endPass");
   vkCmdEndRenderPass(command_buffer_);
+  active_render_pass_ = VK_NULL_HANDLE;
+  active_framebuffer_ = VK_NULL_HANDLE;
+  active_contents_ = VK_SUBPASS_CONTENTS_INLINE;
+}
+
+void Executor::barrier(const ImageBarrierBatch &batch) {
+  ensureFrameActive("barrier");
+  ensurePrimary("barrier");
+
+  if (batch.empty()) {
+    return;
+  }
+
+  vkCmdPipelineBarrier(command_buffer_, batch.srcStageMask, batch.dstStageMask,
+                       0, 0, nullptr, 0, nullptr,
+                       static_cast<uint32_t>(batch.images.size()),
+                       batch.images.empty() ? nullptr : batch.images.data());
+}
+
+void Executor::memoryBarrier(VkPipelineStageFlags srcStageMask,
+                             VkAccessFlags srcAccessMask,
+                             VkPipelineStageFlags dstStageMask,
+                             VkAccessFlags dstAccessMask) {
+  ensureFrameActive("memoryBarrier");
+  ensurePrimary("memoryBarrier");
+
+  VkMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = srcAccessMask;
+  barrier.dstAccessMask = dstAccessMask;
+
+  vkCmdPipelineBarrier(command_buffer_, srcStageMask, dstStageMask, 0, 1,
+                       &barrier, 0, nullptr, 0, nullptr);
+}
+
+void Executor::fillBuffer(VkBuffer buffer, VkDeviceSize offset,
+                          VkDeviceSize size, uint32_t data) {
+  ensureFrameActive("fillBuffer");
+  ensurePrimary("fillBuffer");
+
+  if (active_render_pass_ != VK_NULL_HANDLE) {
+    VKR_EXEC_ERROR("Executor::fillBuffer called inside a render pass");
+  }
+
+  vkCmdFillBuffer(command_buffer_, buffer, offset, size, data);
+}
+
+void Executor::bindComputePipeline(VkPipeline pipeline,
+                                   VkPipelineLayout layout,
+                                   VkDescriptorSet descriptorSet) {
+  ensureFrameActive("bindComputePipeline");
+  ensurePrimary("bindComputePipeline");
+
+  if (pipeline == VK_NULL_HANDLE || layout == VK_NULL_HANDLE) {
+    VKR_EXEC_ERROR("bindComputePipeline received null pipeline or layout");
+  }
+
+  vkCmdBindPipeline(command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+  if (descriptorSet != VK_NULL_HANDLE) {
+    vkCmdBindDescriptorSets(command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE,
+                            layout, 0, 1, &descriptorSet, 0, nullptr);
+  }
+}
+
+void Executor::dispatch(uint32_t groupCountX, uint32_t groupCountY,
+                        uint32_t groupCountZ) {
+  ensureFrameActive("dispatch");
+  ensurePrimary("dispatch");
+
+  if (active_render_pass_ != VK_NULL_HANDLE) {
+    VKR_EXEC_ERROR("Executor::dispatch called inside a render pass");
+  }
+
+  vkCmdDispatch(command_buffer_, groupCountX, groupCountY, groupCountZ);
+}
+
+auto Executor::parallelChunks(uint32_t drawCount) const noexcept
+    -> uint32_t {
+  return recorder_ != nullptr ? recorder_->chunkCount(drawCount) : 0;
+}
+
+void Executor::recordParallel(uint32_t chunkCount,
+                              const std::function<void(uint32_t)> &record) {
+  ensureFrameActive("recordParallel");
+  ensurePrimary("recordParallel");
+
+  if (recorder_ == nullptr) {
+    VKR_EXEC_ERROR("Executor::recordParallel called without a recorder");
+  }
+
+  if (active_render_pass_ == VK_NULL_HANDLE ||
+      active_contents_ != VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS) {
+    VKR_EXEC_ERROR("Executor::recordParallel requires a render pass begun "
+                   "with secondary command buffer contents");
+  }
+
+  VkCommandBufferInheritanceInfo inheritance{};
+  inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+  inheritance.renderPass = active_render_pass_;
+  inheritance.subpass = 0;
+  inheritance.framebuffer = active_framebuffer_;
+
+  std::vector<ExecutorDrawStats> chunkStats(chunkCount);
+  const auto buffers = recorder_->record(
+      inheritance, chunkCount,
+      [&](VkCommandBuffer commandBuffer, uint32_t chunk) -> void {
+        ChunkRecording recording{.executor = this,
+                                 .commandBuffer = commandBuffer};
+        current_chunk = &recording;
+        try {
+          record(chunk);
+        } catch (...) {
+          current_chunk = nullptr;
+          throw;
+        }
+        current_chunk = nullptr;
+        chunkStats[chunk] = recording.stats;
+      });
+
+  if (buffers.empty()) {
+    return;
+  }
+
+  vkCmdExecuteCommands(command_buffer_, static_cast<uint32_t>(buffers.size()),
+                       buffers.data());
+
+  for (const auto &stats : chunkStats) {
+    draw_stats_.drawCalls += stats.drawCalls;
+    draw_stats_.indirectDrawCalls += stats.indirectDrawCalls;
+    draw_stats_.indirectCommands += stats.indirectCommands;
+    draw_stats_.instances += stats.instances;
+    draw_stats_.bindsIssued += stats.bindsIssued;
+    draw_stats_.bindsSkipped += stats.bindsSkipped;
+  }
+  draw_stats_.secondaryCommandBuffers += static_cast<uint32_t>(buffers.size());
 }
 
 void Executor::bindPipeline(
     VkPipeline pipeline, VkPipelineLayout pipelineLayout,
     const std::vector<VkDescriptorSet> &descriptorSets) {
   ensureFrameActive("bindPipeline");
+  VkCommandBuffer commandBuffer = activeCommandBuffer();
 
   if (pipeline == VK_NULL_HANDLE) {
     VKR_EXEC_ERROR("bindPipeline received null VkPipeline");
@@ -160,7 +350,16 @@ void Executor::bindPipeline(
     VKR_EXEC_ERROR("bindPipeline received null VkPipelineLayout");
   }
 
-  vkCmdBindPipeline(command_buffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+  auto &state = activeBindState();
+  auto &stats = activeDrawStats();
+  if (state.pipeline == pipeline) {
+    ++stats.bindsSkipped;
+  } else {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                      pipeline);
+    state.pipeline = pipeline;
+    ++stats.bindsIssued;
+  }
 
   if (descriptorSets.empty()) {
     return;
@@ -171,14 +370,92 @@ void Executor::bindPipeline(
                    frame_index_, descriptorSets.size());
   }
 
-  VkDescriptorSet descriptorSet = descriptorSets[frame_index_];
+  bindDescriptorSet(pipelineLayout, 0, descriptorSets[frame_index_]);
+}
+
+void Executor::bindDescriptorSet(
+    VkPipelineLayout pipelineLayout, uint32_t setIndex,
+    VkDescriptorSet descriptorSet,
+    std::initializer_list<uint32_t> dynamicOffsets) {
+  ensureFrameActive("bindDescriptorSet");
+
+  if (pipelineLayout == VK_NULL_HANDLE || descriptorSet == VK_NULL_HANDLE) {
+    VKR_EXEC_ERROR("bindDescriptorSet received null layout or set {}",
+                   setIndex);
+  }
+
+  // only sets with at most one dynamic offset are cached
+  auto &state = activeBindState();
+  auto &stats = activeDrawStats();
+  const auto offsetCount = static_cast<uint32_t>(dynamicOffsets.size());
+  const uint32_t offset = offsetCount == 1 ? *dynamicOffsets.begin() : 0;
+  const bool cached =
+      setIndex < ExecutorBindState::kMaxSets && offsetCount <= 1;
+
+  if (cached) {
+    const auto &bound = state.sets[setIndex];
+    if (bound.layout == pipelineLayout && bound.set == descriptorSet &&
+        bound.dynamicOffsetCount == offsetCount &&
+        bound.dynamicOffset == offset) {
+      ++stats.bindsSkipped;
+      return;
+    }
+  }
+
+  vkCmdBindDescriptorSets(activeCommandBuffer(),
+                          VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+                          setIndex, 1, &descriptorSet, offsetCount,
+                          offsetCount == 0 ? nullptr : dynamicOffsets.begin());
+  ++stats.bindsIssued;
+
+  for (auto &bound : state.sets) {
+    if (bound.layout != pipelineLayout) {
+      bound = {};
+    }
+  }
+
+  if (cached) {
+    state.sets[setIndex] = {.layout = pipelineLayout,
+                            .set = descriptorSet,
+                            .dynamicOffsetCount = offsetCount,
+                            .dynamicOffset = offset};
+  } else if (setIndex < ExecutorBindState::kMaxSets) {
+    state.sets[setIndex] = {};
+  }
+}
+
+void Executor::recordCulling(const scene::CullStats &stats) {
+  ensureFrameActive("recordCulling");
+  ensurePrimary("recordCulling");
+  draw_stats_.cullObjects += stats.objects;
+  draw_stats_.cullVisible += stats.visible;
+  draw_stats_.cullOccluded += stats.occluded;
+  draw_stats_.cullOverflowed += stats.overflowed;
+  draw_stats_.cullMilliseconds += stats.milliseconds;
+}
+
+void Executor::pushConstants(VkPipelineLayout pipelineLayout,
+                             VkShaderStageFlags stageFlags, uint32_t offset,
+                             uint32_t size, const void *data) {
+  ensureFrameActive("pushConstants");
+
+  if (pipelineLayout == VK_NULL_HANDLE || data == nullptr) {
+    VKR_EXEC_ERROR("pushConstants received null layout or data");
+  }
+
+  if (size == 0 || size % 4 != 0 || offset % 4 != 0) {
+    VKR_EXEC_ERROR("pushConstants range offset {} size {} must be non-zero "
+                   "multiples of 4",
+                   offset, size);
+  }
 
-  vkCmdBindDescriptorSets(command_buffer_, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                          pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+  vkCmdPushConstants(activeCommandBuffer(), pipelineLayout, stageFlags, offset,
+                     size, data);
 }
 
 void Executor::setViewportAndScissor(VkExtent2D extent) {
   ensureFrameActive("setViewportAndScissor");
+  VkCommandBuffer commandBuffer = activeCommandBuffer();
 
   VkViewport viewport{};
   viewport.x = 0.0f;
@@ -188,46 +465,144 @@ void Executor::setViewportAndScissor(VkExtent2D extent) {
   viewport.minDepth = 0.0f;
   viewport.maxDepth = 1.0f;
 
-  vkCmdSetViewport(command_buffer_, 0, 1, &viewport);
+  vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
   VkRect2D scissor{};
   scissor.offset = {0, 0};
   scissor.extent = extent;
 
-  vkCmdSetScissor(command_buffer_, 0, 1, &scissor);
+  vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 }
 
 void Executor::drawIndexed(const scene::IVertexBuffer &vertexBuffer,
                            const scene::IndexBuffer &indexBuffer) {
   ensureFrameActive("drawIndexed");
+  VkCommandBuffer commandBuffer = activeCommandBuffer();
+  auto &stats = activeDrawStats();
+
+  const uint32_t indexCount = indexBuffer.indexCount();
+  if (vertexBuffer.vertexCount() == 0 || indexCount == 0) {
+    return;
+  }
+
+  bindGeometry(vertexBuffer, indexBuffer, nullptr);
+  vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
+  ++stats.drawCalls;
+  ++stats.instances;
+}
+
+void Executor::drawIndexedInstanced(const scene::IVertexBuffer &vertexBuffer,
+                                    const scene::IndexBuffer &indexBuffer,
+                                    const InstanceBinding &instances,
+                                    uint32_t instanceCount,
+                                    uint32_t firstInstance) {
+  ensureFrameActive("drawIndexedInstanced");
+  VkCommandBuffer commandBuffer = activeCommandBuffer();
+  auto &stats = activeDrawStats();
+
+  const uint32_t indexCount = indexBuffer.indexCount();
+  if (vertexBuffer.vertexCount() == 0 || indexCount == 0 ||
+      instanceCount == 0) {
+    return;
+  }
+
+  if (instances.buffer == VK_NULL_HANDLE) {
+    VKR_EXEC_ERROR("drawIndexedInstanced received null instance buffer");
+  }
+
+  bindGeometry(vertexBuffer, indexBuffer, &instances);
+  vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, 0, 0,
+                   firstInstance);
+  ++stats.drawCalls;
+  stats.instances += instanceCount;
+}
+
+void Executor::drawIndexedIndirect(const scene::IVertexBuffer &vertexBuffer,
+                                   const scene::IndexBuffer &indexBuffer,
+                                   const InstanceBinding &instances,
+                                   VkBuffer drawBuffer, VkDeviceSize drawOffset,
+                                   uint32_t drawCount) {
+  ensureFrameActive("drawIndexedIndirect");
+  VkCommandBuffer commandBuffer = activeCommandBuffer();
+  auto &stats = activeDrawStats();
+
+  if (vertexBuffer.vertexCount() == 0 || indexBuffer.indexCount() == 0 ||
+      drawCount == 0) {
+    return;
+  }
+
+  if (drawBuffer == VK_NULL_HANDLE) {
+    VKR_EXEC_ERROR("drawIndexedIndirect received null draw buffer");
+  }
+
+  bindGeometry(vertexBuffer, indexBuffer,
+               instances.buffer == VK_NULL_HANDLE ? nullptr : &instances);
+
+  constexpr auto stride =
+      static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+  if (drawCount == 1 || device_.enabledFeatures().multiDrawIndirect) {
+    vkCmdDrawIndexedIndirect(commandBuffer, drawBuffer, drawOffset,
+                             drawCount, stride);
+    ++stats.indirectDrawCalls;
+  } else {
+    // without multiDrawIndirect each command needs its own call
+    for (uint32_t i = 0; i < drawCount; ++i) {
+      const VkDeviceSize offset =
+          drawOffset + static_cast<VkDeviceSize>(i) * stride;
+      vkCmdDrawIndexedIndirect(commandBuffer, drawBuffer, offset, 1, stride);
+    }
+    stats.indirectDrawCalls += drawCount;
+  }
+  stats.indirectCommands += drawCount;
+}
+
+void Executor::drawIndexedIndirectCount(
+    const scene::IVertexBuffer &vertexBuffer,
+    const scene::IndexBuffer &indexBuffer, const InstanceBinding &instances,
+    VkBuffer drawBuffer, VkDeviceSize drawOffset, VkBuffer countBuffer,
+    VkDeviceSize countOffset, uint32_t maxDrawCount) {
+  ensureFrameActive("drawIndexedIndirectCount");
+  VkCommandBuffer commandBuffer = activeCommandBuffer();
+  auto &stats = activeDrawStats();
+
+  if (vertexBuffer.vertexCount() == 0 || indexBuffer.indexCount() == 0 ||
+      maxDrawCount == 0) {
+    return;
+  }
 
-  if (vertexBuffer.vertexCount() == 0 || indexBuffer.indices().empty()) {
+  if (drawBuffer == VK_NULL_HANDLE || countBuffer == VK_NULL_HANDLE) {
+    VKR_EXEC_ERROR("drawIndexedIndirectCount received null draw or count "
+                   "buffer");
+  }
+
+  if (!device_.drawIndirectCount()) {
+    drawIndexedIndirect(vertexBuffer, indexBuffer, instances, drawBuffer,
+                        drawOffset, maxDrawCount);
     return;
   }
 
-  VkDeviceSize offsets[] = {0};
-  VkBuffer vertexBuffers[] = {vertexBuffer.buffer()};
+  bindGeometry(vertexBuffer, indexBuffer,
+               instances.buffer == VK_NULL_HANDLE ? nullptr : &instances);
 
-  vkCmdBindVertexBuffers(command_buffer_, 0, 1, vertexBuffers, offsets);
-  vkCmdBindIndexBuffer(command_buffer_, indexBuffer.buffer(), 0,
-                       VK_INDEX_TYPE_UINT16);
-  vkCmdDrawIndexed(command_buffer_,
-                   static_cast<uint32_t>(indexBuffer.indices().size()), 1, 0, 0,
-                   0);
+  device_.cmdDrawIndexedIndirectCount(
+      commandBuffer, drawBuffer, drawOffset, countBuffer, countOffset,
+      maxDrawCount,
+      static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand)));
+  ++stats.indirectDrawCalls;
+  stats.indirectCommands += maxDrawCount;
 }
 
 void Executor::drawGeometry() {
   ensureFrameActive("drawGeometry");
 
-  auto meshNames = scene_.listMeshNames();
+  const auto &meshes = scene_.meshes();
 
-  if (meshNames.empty()) {
-    vkCmdDraw(command_buffer_, 3, 1, 0, 0);
+  if (meshes.empty()) {
+    vkCmdDraw(activeCommandBuffer(), 3, 1, 0, 0);
     return;
   }
 
-  for (const auto &name : meshNames) {
-    auto mesh = scene_.getMesh(name);
+  for (const auto &mesh : meshes) {
     if (!mesh || !mesh->isValid()) {
       continue;
     }
@@ -244,16 +619,20 @@ void Executor::drawGeometry() {
 
 void Executor::drawFullscreenTriangle() {
   ensureFrameActive("drawFullscreenTriangle");
-  vkCmdDraw(command_buffer_, 3, 1, 0, 0);
+  vkCmdDraw(activeCommandBuffer(), 3, 1, 0, 0);
 }
 
 void Executor::drawUI(ui::UI &ui) {
   ensureFrameActive("drawUI");
+  ensurePrimary("drawUI");
   ui.render(command_buffer_);
+  // the UI binds its own pipeline and buffers
+  bind_state_ = {};
 }
 
 void Executor::beginProfileScope(std::string_view name) {
   ensureFrameActive("beginProfileScope");
+  ensurePrimary("beginProfileScope");
   if (profiler_ != nullptr) {
     profiler_->beginScope(command_buffer_, name);
   }
@@ -261,6 +640,7 @@ void Executor::beginProfileScope(std::string_view name) {
 
 void Executor::endProfileScope() {
   ensureFrameActive("endProfileScope");
+  ensurePrimary("endProfileScope");
   if (profiler_ != nullptr) {
     profiler_->endScope(command_buffer_);
   }
@@ -278,7 +658,94 @@ void Executor::ensureFrameInactive(const char *op) const {
   }
 }
 
+void Executor::ensurePrimary(const char *op) const {
+  if (current_chunk != nullptr && current_chunk->executor == this) {
+    VKR_EXEC_ERROR("Executor::{} called while recording a parallel chunk", op);
+  }
+}
+
+auto Executor::activeCommandBuffer() const -> VkCommandBuffer {
+  if (current_chunk != nullptr && current_chunk->executor == this) {
+    return current_chunk->commandBuffer;
+  }
+
+  return command_buffer_;
+}
+
+auto Executor::activeDrawStats() -> ExecutorDrawStats & {
+  if (current_chunk != nullptr && current_chunk->executor == this) {
+    return current_chunk->stats;
+  }
+
+  return draw_stats_;
+}
+
+auto Executor::activeBindState() -> ExecutorBindState & {
+  if (current_chunk != nullptr && current_chunk->executor == this) {
+    return current_chunk->bindState;
+  }
+
+  return bind_state_;
+}
+
+void Executor::bindGeometry(const scene::IVertexBuffer &vertexBuffer,
+                            const scene::IndexBuffer &indexBuffer,
+                            const InstanceBinding *instances) {
+  VkCommandBuffer commandBuffer = activeCommandBuffer();
+  auto &state = activeBindState();
+  auto &stats = activeDrawStats();
+
+  const VkBuffer vertexBuffers[] = {
+      vertexBuffer.buffer(),
+      instances != nullptr ? instances->buffer : VK_NULL_HANDLE};
+  const VkDeviceSize offsets[] = {
+      0, instances != nullptr ? instances->offset : 0};
+
+  // binding 1 is only compared when the draw reads it
+  const bool bindVertices = state.vertexBuffer != vertexBuffers[0];
+  const bool bindInstances =
+      instances != nullptr && (state.instanceBuffer != vertexBuffers[1] ||
+                               state.instanceOffset != offsets[1]);
+
+  if (bindVertices || bindInstances) {
+    const uint32_t first = bindVertices ? 0 : 1;
+    const uint32_t count = bindVertices && bindInstances ? 2 : 1;
+    vkCmdBindVertexBuffers(commandBuffer, first, count, vertexBuffers + first,
+                           offsets + first);
+    ++stats.bindsIssued;
+  } else {
+    ++stats.bindsSkipped;
+  }
+
+  state.vertexBuffer = vertexBuffers[0];
+  if (instances != nullptr) {
+    state.instanceBuffer = vertexBuffers[1];
+    state.instanceOffset = offsets[1];
+  }
+
+  if (state.indexBuffer == indexBuffer.buffer() &&
+      state.indexType == indexBuffer.indexType()) {
+    ++stats.bindsSkipped;
+    return;
+  }
+
+  vkCmdBindIndexBuffer(commandBuffer, indexBuffer.buffer(), 0,
+                       indexBuffer.indexType());
+  state.indexBuffer = indexBuffer.buffer();
+  state.indexType = indexBuffer.indexType();
+  ++stats.bindsIssued;
+}
+
 auto Executor::acquireNextImage(uint32_t &imageIndex) -> bool {
+  if (swapchain_.headless()) {
+    // round-robin over the offscreen ring; the per-frame waits already keep
+    // an image from being reused while the GPU still writes it
+    const auto imageCount = static_cast<uint32_t>(swapchain_.imageCount());
+    imageIndex = headless_image_cursor_ % imageCount;
+    headless_image_cursor_ = (headless_image_cursor_ + 1) % imageCount;
+    return true;
+  }
+
   VkResult result = vkAcquireNextImageKHR(
       device_.device(), swapchain_.swapchain(), UINT64_MAX,
       frame_sync_.imageAvailableSemaphore(current_frame_), VK_NULL_HANDLE,
@@ -297,34 +764,45 @@ auto Executor::acquireNextImage(uint32_t &imageIndex) -> bool {
 }
 
 void Executor::submitCommandBuffer() {
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  core::SubmitSemaphores semaphores{};
 
-  VkSemaphore waitSemaphores[] = {
-      frame_sync_.imageAvailableSemaphore(frame_index_)};
+  if (!swapchain_.headless()) {
+    semaphores.wait(frame_sync_.imageAvailableSemaphore(frame_index_),
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    semaphores.signal(frame_sync_.renderFinishedSemaphore(image_index_));
+  }
+
+  for (const auto &[point, stageMask] : pending_waits_) {
+    semaphores.wait(point, stageMask);
+  }
+  pending_waits_.clear();
 
-  VkPipelineStageFlags waitStages[] = {
-      VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+  // the timeline value replaces the in-flight fence; binary semaphores still
+  // pair the submit with acquire and present
+  last_submission_ = frame_sync_.signalFrame(frame_index_);
+  semaphores.signal(last_submission_);
 
-  submitInfo.waitSemaphoreCount = 1;
-  submitInfo.pWaitSemaphores = waitSemaphores;
-  submitInfo.pWaitDstStageMask = waitStages;
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
   submitInfo.commandBufferCount = 1;
   submitInfo.pCommandBuffers = &command_buffer_;
-
-  VkSemaphore signalSemaphores[] = {
-      frame_sync_.renderFinishedSemaphore(image_index_)};
-
-  submitInfo.signalSemaphoreCount = 1;
-  submitInfo.pSignalSemaphores = signalSemaphores;
+  semaphores.apply(submitInfo);
 
   if (vkQueueSubmit(command_pool_.queue(), 1, &submitInfo,
                     frame_sync_.inFlightFence(frame_index_)) != VK_SUCCESS) {
     VKR_EXEC_ERROR("failed to submit draw command buffer");
   }
+
+  frame_epochs_[frame_index_] = device_.deletionQueue().advance();
 }
 
 void Executor::present(uint32_t imageIndex) {
+  last_presented_image_ = imageIndex;
+
+  if (swapchain_.headless()) {
+    return;
+  }
+
   VkPresentInfoKHR presentInfo{};
   presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
@@ -1,5 +1,6 @@
 #include "vkr/exec/render/frame_buffer_set.hh"
 #include "vkr/logger.hh"
+#include <utility>
 
 namespace vkr::exec {
 
@@ -32,10 +33,15 @@ void FramebufferSet::create() {
 }
 
 void FramebufferSet::destroy() {
-  for (auto framebuffer : vk_framebuffers_) {
-    if (framebuffer != VK_NULL_HANDLE) {
-      vkDestroyFramebuffer(device_.device(), framebuffer, nullptr);
-    }
+  if (!vk_framebuffers_.empty()) {
+    device_.deletionQueue().push([device = device_.device(),
+                                  framebuffers = std::move(vk_framebuffers_)] {
+      for (auto framebuffer : framebuffers) {
+        if (framebuffer != VK_NULL_HANDLE) {
+          vkDestroyFramebuffer(device, framebuffer, nullptr);
+        }
+      }
+    });
   }
 
   vk_framebuffers_.clear();
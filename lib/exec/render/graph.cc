@@ -1,6 +1,9 @@
 #include "vkr/exec/render/graph.hh"
+#include "vkr/exec/render/executor.hh"
 #include "vkr/exec/render/passes/ui.hh"
 #include "vkr/logger.hh"
+#include <algorithm>
+#include <cstdint>
 #include <deque>
 #include <string_view>
 
@@ -109,10 +112,23 @@ auto RenderGraph::create() -> void {
     compile();
   }
 
+  if (created_) {
+    destroy();
+  }
+
+  planTransientAttachments();
+
+  std::vector<Pass *> ordered{};
+  ordered.reserve(ordered_passes_.size());
   for (const size_t index : ordered_passes_) {
-    passes_[index]->create();
+    ordered.push_back(passes_[index].get());
   }
 
+  create_stats_ = createPasses(ordered, parallel_create_);
+  logCreateStats("Render graph", create_stats_);
+
+  bindTransientImages();
+  resetImageStates();
   created_ = true;
 }
 
@@ -121,9 +137,39 @@ auto RenderGraph::destroy() -> void {
     passes_[*it]->destroy();
   }
 
+  releaseTransientAttachments();
   created_ = false;
 }
 
+auto RenderGraph::resize(VkExtent2D previous, VkExtent2D extent) -> void {
+  for (const size_t index : ordered_passes_) {
+    passes_[index]->rescale(previous, extent);
+  }
+
+  if (!created_) {
+    return;
+  }
+
+  // the old slots stay bound until every pass has moved off them
+  auto retired = std::move(transient_slots_);
+  transient_slots_.clear();
+  releaseTransientAttachments();
+  planTransientAttachments();
+
+  for (const size_t index : ordered_passes_) {
+    passes_[index]->resize();
+  }
+
+  // passes that fell back to create() may still be building pipelines
+  for (const size_t index : ordered_passes_) {
+    (void)passes_[index]->awaitPipelines();
+  }
+
+  retireTransientSlots(std::move(retired));
+  bindTransientImages();
+  resetImageStates();
+}
+
 auto RenderGraph::record() -> void {
   if (dirty_) {
     compile();
@@ -133,9 +179,22 @@ auto RenderGraph::record() -> void {
     create();
   }
 
+  // background pipeline rebuilds are swapped in here, before any pass of this
+  // frame records against them
   for (const size_t index : ordered_passes_) {
+    if (auto pipeline = passes_[index]->editablePipeline()) {
+      (void)pipeline->get().commitPending();
+    }
+  }
+
+  pending_barrier_stats_ = {};
+
+  for (const size_t index : ordered_passes_) {
+    recordBarriers(*passes_[index]);
     passes_[index]->record();
   }
+
+  barrier_stats_ = pending_barrier_stats_;
 }
 
 auto RenderGraph::present() -> void {
@@ -344,6 +403,310 @@ auto RenderGraph::buildResourceDependencies() -> void {
   }
 }
 
+auto RenderGraph::planTransientAttachments() -> void {
+  struct Candidate {
+    size_t pass{0};
+    size_t attachment{0};
+    size_t first{0};
+    size_t last{0};
+    VkMemoryRequirements requirements{};
+  };
+
+  struct Slot {
+    VkMemoryRequirements requirements{};
+    size_t last{0};
+  };
+
+  const size_t passCount = passes_.size();
+  std::vector<size_t> position(passCount, 0);
+  std::unordered_map<const Pass *, size_t> indices{};
+
+  for (size_t order = 0; order < ordered_passes_.size(); ++order) {
+    const size_t index = ordered_passes_[order];
+    position[index] = order;
+    indices.emplace(passes_[index].get(), index);
+  }
+
+  // an attachment lives from its pass to its last reader in the same frame;
+  // one sampled at or before its own pass carries data across frames
+  std::vector<size_t> lastUse = position;
+  std::vector<bool> persistent(passCount, false);
+
+  for (size_t consumer = 0; consumer < passCount; ++consumer) {
+    for (const Pass *source : passes_[consumer]->sampledPasses()) {
+      auto it = indices.find(source);
+      if (it == indices.end()) {
+        continue;
+      }
+
+      const size_t producer = it->second;
+      if (position[consumer] <= position[producer]) {
+        persistent[producer] = true;
+      } else {
+        lastUse[producer] = std::max(lastUse[producer], position[consumer]);
+      }
+    }
+  }
+
+  const auto &device = executor_.device();
+  std::vector<Candidate> candidates{};
+  std::vector<Slot> slots{};
+
+  pass_transient_slots_.assign(passCount, {});
+
+  for (const size_t index : ordered_passes_) {
+    const auto descs = passes_[index]->transientAttachments();
+    pass_transient_slots_[index].assign(descs.size(), SIZE_MAX);
+
+    if (persistent[index]) {
+      continue;
+    }
+
+    for (size_t attachment = 0; attachment < descs.size(); ++attachment) {
+      const auto &desc = descs[attachment];
+      if (desc.tiling != VK_IMAGE_TILING_OPTIMAL ||
+          desc.memoryProperties != VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+        continue;
+      }
+
+      Candidate candidate{
+          .pass = index,
+          .attachment = attachment,
+          .first = position[index],
+          .last = lastUse[index],
+          .requirements = resource::Image::memoryRequirements(device, desc)};
+
+      // reuse the slot that grows least among those free before this pass
+      size_t best = SIZE_MAX;
+      VkDeviceSize bestGrowth = 0;
+      for (size_t slot = 0; slot < slots.size(); ++slot) {
+        const auto &requirements = slots[slot].requirements;
+        if (slots[slot].last >= candidate.first ||
+            (requirements.memoryTypeBits &
+             candidate.requirements.memoryTypeBits) == 0) {
+          continue;
+        }
+
+        const VkDeviceSize growth =
+            candidate.requirements.size > requirements.size
+                ? candidate.requirements.size - requirements.size
+                : 0;
+        if (best == SIZE_MAX || growth < bestGrowth ||
+            (growth == bestGrowth &&
+             requirements.size < slots[best].requirements.size)) {
+          best = slot;
+          bestGrowth = growth;
+        }
+      }
+
+      if (best == SIZE_MAX) {
+        best = slots.size();
+        slots.push_back(Slot{.requirements = candidate.requirements,
+                             .last = candidate.last});
+      } else {
+        auto &slot = slots[best];
+        slot.requirements.size =
+            std::max(slot.requirements.size, candidate.requirements.size);
+        slot.requirements.alignment = std::max(
+            slot.requirements.alignment, candidate.requirements.alignment);
+        slot.requirements.memoryTypeBits &=
+            candidate.requirements.memoryTypeBits;
+        slot.last = candidate.last;
+      }
+
+      pass_transient_slots_[index][attachment] = best;
+      candidates.push_back(candidate);
+    }
+  }
+
+  attachment_stats_ = {};
+  transient_slots_.reserve(slots.size());
+
+  for (const auto &slot : slots) {
+    transient_slots_.push_back(device.allocator().allocate(
+        slot.requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        core::MemoryResourceKind::Optimal));
+    attachment_stats_.aliasedBytes += slot.requirements.size;
+  }
+
+  for (const auto &candidate : candidates) {
+    attachment_stats_.unaliasedBytes += candidate.requirements.size;
+  }
+
+  for (size_t index = 0; index < passCount; ++index) {
+    std::vector<core::MemoryAllocation> memory(
+        pass_transient_slots_[index].size());
+
+    for (size_t attachment = 0; attachment < memory.size(); ++attachment) {
+      const size_t slot = pass_transient_slots_[index][attachment];
+      if (slot != SIZE_MAX) {
+        memory[attachment] = transient_slots_[slot];
+      }
+    }
+
+    passes_[index]->setTransientMemory(std::move(memory));
+  }
+
+  attachment_stats_.attachments = static_cast<uint32_t>(candidates.size());
+  attachment_stats_.slots = static_cast<uint32_t>(slots.size());
+
+  if (!candidates.empty()) {
+    constexpr double MiB = 1024.0 * 1024.0;
+    VKR_EXEC_INFO("Render graph transient attachments: {} image(s) in {} "
+                  "slot(s), {:.2f} MiB -> {:.2f} MiB",
+                  attachment_stats_.attachments, attachment_stats_.slots,
+                  static_cast<double>(attachment_stats_.unaliasedBytes) / MiB,
+                  static_cast<double>(attachment_stats_.aliasedBytes) / MiB);
+  }
+}
+
+auto RenderGraph::bindTransientImages() -> void {
+  image_slots_.clear();
+
+  for (size_t index = 0; index < passes_.size(); ++index) {
+    const auto &slots = pass_transient_slots_[index];
+    if (slots.empty()) {
+      continue;
+    }
+
+    const auto images = passes_[index]->transientImages();
+    for (size_t attachment = 0;
+         attachment < std::min(images.size(), slots.size()); ++attachment) {
+      if (slots[attachment] != SIZE_MAX) {
+        image_slots_[images[attachment]] = slots[attachment];
+      }
+    }
+  }
+}
+
+auto RenderGraph::releaseTransientAttachments() -> void {
+  retireTransientSlots(std::move(transient_slots_));
+
+  for (auto &pass : passes_) {
+    pass->setTransientMemory({});
+  }
+
+  transient_slots_.clear();
+  pass_transient_slots_.clear();
+  image_slots_.clear();
+  slot_owners_.clear();
+  attachment_stats_ = {};
+}
+
+auto RenderGraph::retireTransientSlots(
+    std::vector<core::MemoryAllocation> slots) -> void {
+  // the images placed in the slots went through the deletion queue first, so
+  // their memory is freed after them
+  const auto &device = executor_.device();
+  for (auto &slot : slots) {
+    device.deletionQueue().push([&device, slot]() mutable {
+      device.allocator().free(slot);
+    });
+  }
+}
+
+auto RenderGraph::resetImageStates() -> void {
+  image_states_.clear();
+  slot_owners_.assign(transient_slots_.size(), VK_NULL_HANDLE);
+
+  // a freshly acquired swapchain image is only usable once the acquire
+  // semaphore, waited on at color output, has signalled
+  for (VkImage image : executor_.swapchain().images()) {
+    image_states_[image] = ImageState{
+        .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .stageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        .accessMask = 0};
+  }
+}
+
+auto RenderGraph::recordBarriers(const Pass &pass) -> void {
+  ImageBarrierBatch batch{};
+
+  for (const auto &access : pass.imageAccesses()) {
+    if (access.image == VK_NULL_HANDLE) {
+      continue;
+    }
+
+    auto [it, _] = image_states_.try_emplace(
+        access.image,
+        ImageState{.layout = VK_IMAGE_LAYOUT_UNDEFINED,
+                   .stageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                   .accessMask = 0});
+    auto &state = it->second;
+    ImageState previous = state;
+
+    // taking over aliased memory waits on the image that used it last, and
+    // whatever layout this image had is gone
+    bool aliased = false;
+    if (auto slot = image_slots_.find(access.image);
+        slot != image_slots_.end()) {
+      VkImage &owner = slot_owners_[slot->second];
+      if (owner != access.image) {
+        if (auto other = image_states_.find(owner);
+            other != image_states_.end()) {
+          previous.stageMask |= other->second.stageMask;
+          previous.accessMask |= other->second.accessMask;
+        }
+
+        owner = access.image;
+        aliased = true;
+      }
+    }
+
+    const bool transition = aliased || previous.layout != access.state.layout;
+    const bool lastWrote = (previous.accessMask & kWriteAccessMask) != 0;
+
+    if (!transition && !lastWrote) {
+      if (!access.writes()) {
+        // read after read in the same layout; later writers wait on both
+        state.stageMask |= access.state.stageMask;
+        state.accessMask |= access.state.accessMask;
+        pending_barrier_stats_.skippedAccesses++;
+        continue;
+      }
+
+      // write after read only has to wait for the readers to finish
+      batch.srcStageMask |= previous.stageMask;
+      batch.dstStageMask |= access.state.stageMask;
+      state = access.state;
+      continue;
+    }
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = aliased || (transition && access.discard)
+                            ? VK_IMAGE_LAYOUT_UNDEFINED
+                            : previous.layout;
+    barrier.newLayout = access.state.layout;
+    barrier.srcAccessMask = previous.accessMask & kWriteAccessMask;
+    barrier.dstAccessMask = access.state.accessMask;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = access.image;
+    barrier.subresourceRange = {access.aspectMask, 0, VK_REMAINING_MIP_LEVELS,
+                                0, VK_REMAINING_ARRAY_LAYERS};
+
+    batch.images.push_back(barrier);
+    batch.srcStageMask |= previous.stageMask;
+    batch.dstStageMask |= access.state.stageMask;
+
+    if (transition) {
+      pending_barrier_stats_.layoutTransitions++;
+    }
+
+    state = access.state;
+  }
+
+  if (batch.empty()) {
+    return;
+  }
+
+  executor_.barrier(batch);
+  pending_barrier_stats_.pipelineBarriers++;
+  pending_barrier_stats_.imageBarriers +=
+      static_cast<uint32_t>(batch.images.size());
+}
+
 auto RenderGraph::passIndex(std::string_view name) const -> size_t {
   auto it = pass_indices_.find(std::string(name));
 
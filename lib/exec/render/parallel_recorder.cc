@@ -0,0 +1,213 @@
+#include "vkr/exec/render/parallel_recorder.hh"
+#include "vkr/logger.hh"
+#include <algorithm>
+#include <utility>
+
+namespace vkr::exec {
+
+ParallelRecorder::ParallelRecorder(const core::Device &device,
+                                   const core::CommandPool &commandPool,
+                                   uint32_t framesInFlight,
+                                   const ParallelRecorderDesc &desc)
+    : device_(device), desc_(desc) {
+  if (!desc_.isValid()) {
+    VKR_EXEC_ERROR("ParallelRecorderDesc is invalid");
+  }
+
+  if (framesInFlight == 0) {
+    VKR_EXEC_ERROR("ParallelRecorder requires at least one frame in flight");
+  }
+
+  // command pools are externally synchronized, so every worker records from
+  // its own pool, one per frame in flight to recycle without waiting
+  VkCommandPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+  poolInfo.queueFamilyIndex = commandPool.queueFamily();
+
+  pools_.resize(framesInFlight);
+  for (auto &framePools : pools_) {
+    framePools.resize(desc_.threads);
+    for (auto &threadPool : framePools) {
+      if (vkCreateCommandPool(device_.device(), &poolInfo, nullptr,
+                              &threadPool.pool) != VK_SUCCESS) {
+        VKR_EXEC_ERROR("Failed to create parallel recording command pool");
+      }
+    }
+  }
+
+  workers_.reserve(desc_.threads);
+  for (uint32_t thread = 0; thread < desc_.threads; ++thread) {
+    workers_.emplace_back([this, thread] { workerLoop(thread); });
+  }
+
+  if (desc_.threads > 0) {
+    VKR_EXEC_INFO("Parallel command recording: {} thread(s), {} draw(s) "
+                  "per chunk minimum",
+                  desc_.threads, desc_.minDrawsPerChunk);
+  }
+}
+
+ParallelRecorder::~ParallelRecorder() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_ready_.notify_all();
+
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+
+  for (auto &framePools : pools_) {
+    for (auto &threadPool : framePools) {
+      if (threadPool.pool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device_.device(), threadPool.pool, nullptr);
+      }
+    }
+  }
+}
+
+void ParallelRecorder::beginFrame(uint32_t frameIndex) {
+  if (frameIndex >= pools_.size()) {
+    VKR_EXEC_ERROR("ParallelRecorder frame index {} out of range, count {}",
+                   frameIndex, pools_.size());
+  }
+
+  frame_index_ = frameIndex;
+  for (auto &threadPool : pools_[frameIndex]) {
+    if (threadPool.used == 0) {
+      continue;
+    }
+
+    vkResetCommandPool(device_.device(), threadPool.pool, 0);
+    threadPool.used = 0;
+  }
+}
+
+auto ParallelRecorder::record(const VkCommandBufferInheritanceInfo &inheritance,
+                              uint32_t taskCount,
+                              const ParallelRecordTask &task)
+    -> std::vector<VkCommandBuffer> {
+  if (taskCount == 0) {
+    return {};
+  }
+
+  if (workers_.empty()) {
+    VKR_EXEC_ERROR("ParallelRecorder::record called without worker threads");
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_ = &task;
+  inheritance_ = &inheritance;
+  results_.assign(taskCount, VK_NULL_HANDLE);
+  error_ = nullptr;
+  task_count_ = taskCount;
+  next_task_ = 0;
+  finished_tasks_ = 0;
+  ++generation_;
+  work_ready_.notify_all();
+
+  work_done_.wait(lock, [this] { return finished_tasks_ == task_count_; });
+
+  task_ = nullptr;
+  inheritance_ = nullptr;
+  task_count_ = 0;
+
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+
+  return std::move(results_);
+}
+
+auto ParallelRecorder::chunkCount(uint32_t drawCount) const noexcept
+    -> uint32_t {
+  if (workers_.empty() || drawCount < desc_.minDrawsPerChunk) {
+    return 0;
+  }
+
+  return std::clamp(drawCount / desc_.minDrawsPerChunk, 1U, threadCount());
+}
+
+void ParallelRecorder::workerLoop(uint32_t thread) {
+  uint64_t generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    work_ready_.wait(
+        lock, [&] { return stopping_ || generation_ != generation; });
+    if (stopping_) {
+      return;
+    }
+
+    generation = generation_;
+    while (next_task_ < task_count_) {
+      const uint32_t task = next_task_++;
+
+      lock.unlock();
+      std::exception_ptr error{};
+      try {
+        recordTask(thread, task);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+
+      if (error && !error_) {
+        error_ = error;
+      }
+
+      if (++finished_tasks_ == task_count_) {
+        work_done_.notify_one();
+      }
+    }
+  }
+}
+
+void ParallelRecorder::recordTask(uint32_t thread, uint32_t task) {
+  VkCommandBuffer commandBuffer = acquireBuffer(thread);
+
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                    VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  beginInfo.pInheritanceInfo = inheritance_;
+
+  if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+    VKR_EXEC_ERROR("failed to begin recording secondary command buffer");
+  }
+
+  (*task_)(commandBuffer, task);
+
+  if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+    VKR_EXEC_ERROR("failed to record secondary command buffer");
+  }
+
+  // each task owns its slot, so no lock is needed to publish it
+  results_[task] = commandBuffer;
+}
+
+auto ParallelRecorder::acquireBuffer(uint32_t thread) -> VkCommandBuffer {
+  auto &threadPool = pools_[frame_index_][thread];
+
+  if (threadPool.used == threadPool.buffers.size()) {
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = threadPool.pool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    if (vkAllocateCommandBuffers(device_.device(), &allocInfo,
+                                 &commandBuffer) != VK_SUCCESS) {
+      VKR_EXEC_ERROR("Failed to allocate secondary command buffer");
+    }
+
+    threadPool.buffers.push_back(commandBuffer);
+  }
+
+  return threadPool.buffers[threadPool.used++];
+}
+
+} // namespace vkr::exec
@@ -0,0 +1,62 @@
+#include "vkr/exec/render/passes/blit.hh"
+#include "vkr/logger.hh"
+
+namespace vkr::exec {
+
+BlitPass::BlitPass(Executor &executor, const core::Swapchain &swapchain,
+                   RenderPassSource source, VkFilter filter)
+    : executor_(executor), swapchain_(swapchain), source_(source),
+      filter_(filter) {}
+
+void BlitPass::record() {
+  const auto &target = source_.target(executor_.frameIndex());
+  if (!target.hasColor()) {
+    VKR_EXEC_ERROR("BlitPass '{}' source has no color attachment", name());
+  }
+
+  const auto &color = target.color();
+  if ((color.desc().usage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) == 0) {
+    VKR_EXEC_ERROR("BlitPass '{}' source color lacks TRANSFER_SRC usage",
+                   name());
+  }
+
+  if ((swapchain_.usage() & VK_IMAGE_USAGE_TRANSFER_DST_BIT) == 0) {
+    VKR_EXEC_ERROR("BlitPass '{}' swapchain images lack TRANSFER_DST usage",
+                   name());
+  }
+
+  executor_.beginProfileScope(name());
+
+  VkImageBlit region{};
+  region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  region.srcOffsets[1] = {static_cast<int32_t>(color.desc().width),
+                          static_cast<int32_t>(color.desc().height), 1};
+  region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  region.dstOffsets[1] = {static_cast<int32_t>(swapchain_.width()),
+                          static_cast<int32_t>(swapchain_.height()), 1};
+
+  // the render graph has already moved both images into transfer layouts
+  vkCmdBlitImage(executor_.commandBuffer(), color.image(),
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 swapchain_.images().at(executor_.imageIndex()),
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region, filter_);
+
+  executor_.endProfileScope();
+}
+
+auto BlitPass::imageAccesses() const -> std::vector<ImageAccess> {
+  const auto &target = source_.target(executor_.frameIndex());
+  if (!target.hasColor()) {
+    return {};
+  }
+
+  return {ImageAccess::transferSource(target.color().image()),
+          ImageAccess::transferDestination(
+              swapchain_.images().at(executor_.imageIndex()))};
+}
+
+auto BlitPass::sampledPasses() const -> std::vector<const Pass *> {
+  return {&source_.pass()};
+}
+
+} // namespace vkr::exec
@@ -208,6 +208,47 @@ void FeedbackFullscreenPass::update(const FeedbackFullscreenPassDesc &desc) {
   desc_ = desc;
 }
 
+void FeedbackFullscreenPass::rescale(VkExtent2D previous, VkExtent2D extent) {
+  desc_.target.target.rescale(previous, extent);
+}
+
+void FeedbackFullscreenPass::resize() {
+  if (!target_ || !render_pass_) {
+    create();
+    return;
+  }
+
+  // history contents do not survive a resize; the next frame reads a freshly
+  // created target just like the first frame after create()
+  auto targetDesc = desc_.target;
+  targetDesc.frameCount = executor_.framesInFlight();
+
+  framebuffers_.clear();
+  target_->update(targetDesc);
+  createFramebuffers();
+
+  if (descriptor_sets_) {
+    descriptor_sets_->rewrite(createDescriptorWrites(resolvedInputs()));
+  }
+}
+
+auto FeedbackFullscreenPass::awaitPipelines()
+    -> std::vector<pipeline::PipelineBuildStatus> {
+  if (!pipeline_) {
+    return {};
+  }
+
+  (void)pipeline_->waitPending();
+  if (!pipeline_->valid()) {
+    VKR_EXEC_ERROR("FeedbackFullscreenPass '{}' failed to create graphics "
+                   "pipeline '{}': {}",
+                   name(), desc_.graphicsPipeline.name,
+                   pipeline_->lastBuild().error);
+  }
+
+  return {pipeline_->lastBuild()};
+}
+
 void FeedbackFullscreenPass::record() {
   if (!target_ || !render_pass_) {
     VKR_EXEC_ERROR("FeedbackFullscreenPass '{}' recorded before create",
@@ -247,6 +288,45 @@ void FeedbackFullscreenPass::record() {
   executor_.endProfileScope();
 }
 
+auto FeedbackFullscreenPass::imageAccesses() const
+    -> std::vector<ImageAccess> {
+  if (!target_) {
+    return {};
+  }
+
+  std::vector<ImageAccess> accesses{};
+  const uint32_t frameIndex = executor_.frameIndex();
+  if (desc_.historyInput) {
+    accesses.push_back(
+        historyTarget(frameIndex).sampledAccess(desc_.historyInput->kind));
+  }
+
+  const auto inputs = resolvedInputs();
+  for (size_t index = 0; index < sources_.size(); ++index) {
+    accesses.push_back(sources_[index].target(frameIndex).sampledAccess(
+        inputs[index].kind));
+  }
+
+  for (const auto &access :
+       target_->writeForFrame(frameIndex).attachmentAccesses()) {
+    accesses.push_back(access);
+  }
+
+  return accesses;
+}
+
+auto FeedbackFullscreenPass::sampledPasses() const
+    -> std::vector<const Pass *> {
+  std::vector<const Pass *> passes{};
+  passes.reserve(sources_.size());
+
+  for (const auto &source : sources_) {
+    passes.push_back(&source.pass());
+  }
+
+  return passes;
+}
+
 auto FeedbackFullscreenPass::addSource(RenderPassSource source)
     -> FeedbackFullscreenPass & {
   sources_.push_back(source);
@@ -360,15 +440,6 @@ void FeedbackFullscreenPass::createRenderPass() {
         writeTarget.color().desc().format,
         writeTarget.depth() ? writeTarget.depth()->desc().format
                             : VK_FORMAT_UNDEFINED);
-
-    const auto &colorDesc = writeTarget.color().desc();
-    if (colorDesc.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
-      renderPassDesc.colors[0].finalLayout = colorDesc.finalLayout;
-    } else if ((colorDesc.usage & (VK_IMAGE_USAGE_SAMPLED_BIT |
-                                   VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT)) == 0) {
-      renderPassDesc.colors[0].finalLayout =
-          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    }
   } else if (writeTarget.depth()) {
     renderPassDesc = pipeline::RenderPassDesc::makeDepthOnly(
         writeTarget.depth()->desc().format);
@@ -379,15 +450,12 @@ void FeedbackFullscreenPass::createRenderPass() {
 
   if (writeTarget.depth()) {
     const auto &depthDesc = writeTarget.depth()->desc();
-    if (depthDesc.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
-      renderPassDesc.depth.finalLayout = depthDesc.finalLayout;
-    }
-
     if ((depthDesc.usage & VK_IMAGE_USAGE_SAMPLED_BIT) != 0) {
       renderPassDesc.depth.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     }
   }
 
+  renderPassDesc.externalLayouts();
   render_pass_->update(renderPassDesc);
 }
 
@@ -469,13 +537,7 @@ void FeedbackFullscreenPass::createPipeline() {
 
   pipeline_ =
       std::make_unique<pipeline::GraphicsPipeline>(device_, *render_pass_);
-  pipeline_->update(pipelineDesc);
-
-  if (!pipeline_->valid()) {
-    VKR_EXEC_ERROR("FeedbackFullscreenPass '{}' failed to create graphics "
-                   "pipeline '{}'",
-                   name(), pipelineDesc.name);
-  }
+  (void)pipeline_->updateAsync(pipelineDesc);
 }
 
 auto FeedbackFullscreenPass::resolvedInputs() const
@@ -202,6 +202,45 @@ void FullscreenPass::destroy() {
 
 void FullscreenPass::update(const FullscreenPassDesc &desc) { desc_ = desc; }
 
+void FullscreenPass::rescale(VkExtent2D previous, VkExtent2D extent) {
+  desc_.target.rescale(previous, extent);
+}
+
+void FullscreenPass::resize() {
+  if (!target_ || !render_pass_) {
+    create();
+    return;
+  }
+
+  // the render pass and pipeline only depend on attachment formats
+  auto targetDesc = desc_.target;
+  targetDesc.aliasMemory(transientMemory());
+
+  framebuffers_.reset();
+  target_->update(targetDesc);
+  createFramebuffers();
+
+  if (descriptor_sets_) {
+    descriptor_sets_->rewrite(createDescriptorWrites(resolvedInputs()));
+  }
+}
+
+auto FullscreenPass::awaitPipelines()
+    -> std::vector<pipeline::PipelineBuildStatus> {
+  if (!pipeline_) {
+    return {};
+  }
+
+  (void)pipeline_->waitPending();
+  if (!pipeline_->valid()) {
+    VKR_EXEC_ERROR(
+        "FullscreenPass '{}' failed to create graphics pipeline '{}': {}",
+        name(), desc_.graphicsPipeline.name, pipeline_->lastBuild().error);
+  }
+
+  return {pipeline_->lastBuild()};
+}
+
 void FullscreenPass::record() {
   if (!target_ || !render_pass_ || !framebuffers_) {
     VKR_EXEC_ERROR("FullscreenPass '{}' recorded before create", name());
@@ -229,6 +268,26 @@ void FullscreenPass::record() {
   executor_.endProfileScope();
 }
 
+auto FullscreenPass::imageAccesses() const -> std::vector<ImageAccess> {
+  if (!target_) {
+    return {};
+  }
+
+  std::vector<ImageAccess> accesses{};
+  const uint32_t frameIndex = executor_.frameIndex();
+  const auto inputs = resolvedInputs();
+  for (size_t index = 0; index < sources_.size(); ++index) {
+    accesses.push_back(sources_[index].target(frameIndex).sampledAccess(
+        inputs[index].kind));
+  }
+
+  for (const auto &access : target_->attachmentAccesses()) {
+    accesses.push_back(access);
+  }
+
+  return accesses;
+}
+
 auto FullscreenPass::addSource(RenderPassSource source) -> FullscreenPass & {
   sources_.push_back(source);
   return *this;
@@ -240,6 +299,26 @@ auto FullscreenPass::setSources(std::vector<RenderPassSource> sources)
   return *this;
 }
 
+auto FullscreenPass::transientAttachments() const
+    -> std::vector<resource::ImageDesc> {
+  return desc_.target.imageDescs();
+}
+
+auto FullscreenPass::transientImages() const -> std::vector<VkImage> {
+  return target_ ? target_->images() : std::vector<VkImage>{};
+}
+
+auto FullscreenPass::sampledPasses() const -> std::vector<const Pass *> {
+  std::vector<const Pass *> passes{};
+  passes.reserve(sources_.size());
+
+  for (const auto &source : sources_) {
+    passes.push_back(&source.pass());
+  }
+
+  return passes;
+}
+
 auto FullscreenPass::target() -> OffscreenTarget & {
   if (!target_) {
     VKR_EXEC_ERROR("FullscreenPass '{}' target requested before create",
@@ -259,8 +338,11 @@ auto FullscreenPass::target() const -> const OffscreenTarget & {
 }
 
 void FullscreenPass::createTarget() {
+  auto targetDesc = desc_.target;
+  targetDesc.aliasMemory(transientMemory());
+
   target_ = std::make_unique<OffscreenTarget>(device_, command_pool_);
-  target_->update(desc_.target);
+  target_->update(targetDesc);
 }
 
 void FullscreenPass::createRenderPass() {
@@ -272,15 +354,6 @@ void FullscreenPass::createRenderPass() {
         target_->color().desc().format, target_->depth()
                                             ? target_->depth()->desc().format
                                             : VK_FORMAT_UNDEFINED);
-
-    const auto &colorDesc = target_->color().desc();
-    if (colorDesc.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
-      renderPassDesc.colors[0].finalLayout = colorDesc.finalLayout;
-    } else if ((colorDesc.usage & (VK_IMAGE_USAGE_SAMPLED_BIT |
-                                   VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT)) == 0) {
-      renderPassDesc.colors[0].finalLayout =
-          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    }
   } else if (target_->depth()) {
     renderPassDesc = pipeline::RenderPassDesc::makeDepthOnly(
         target_->depth()->desc().format);
@@ -290,15 +363,12 @@ void FullscreenPass::createRenderPass() {
 
   if (target_->depth()) {
     const auto &depthDesc = target_->depth()->desc();
-    if (depthDesc.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
-      renderPassDesc.depth.finalLayout = depthDesc.finalLayout;
-    }
-
     if ((depthDesc.usage & VK_IMAGE_USAGE_SAMPLED_BIT) != 0) {
       renderPassDesc.depth.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     }
   }
 
+  renderPassDesc.externalLayouts();
   render_pass_->update(renderPassDesc);
 }
 
@@ -362,13 +432,7 @@ void FullscreenPass::createPipeline() {
 
   pipeline_ =
       std::make_unique<pipeline::GraphicsPipeline>(device_, *render_pass_);
-  pipeline_->update(pipelineDesc);
-
-  if (!pipeline_->valid()) {
-    VKR_EXEC_ERROR(
-        "FullscreenPass '{}' failed to create graphics pipeline '{}'", name(),
-        pipelineDesc.name);
-  }
+  (void)pipeline_->updateAsync(pipelineDesc);
 }
 
 auto FullscreenPass::resolvedInputs() const
@@ -0,0 +1,564 @@
+#include "vkr/exec/render/passes/gpu_cull.hh"
+#include "vkr/logger.hh"
+#include <algorithm>
+#include <cstring>
+
+namespace vkr::exec {
+namespace {
+
+constexpr uint32_t kLocalSize = 64;
+
+// a negative radius marks meshes without bounds, which are never culled;
+// emitted commands start at their object, so firstInstance doubles as the
+// object index in the vertex shader. The occlusion test projects the box
+// around the bounding sphere with the pyramid's view-projection and picks the
+// level where that rectangle spans at most 2x2 texels; the object is hidden
+// when its nearest depth lies behind the farthest depth stored there.
+constexpr const char *kCullShader = R"(#version 450
+layout(local_size_x = 64) in;
+
+struct Object {
+  mat4 model;
+  uint batch;
+  uint pad0;
+  uint pad1;
+  uint pad2;
+};
+
+struct Batch {
+  vec4 sphere;
+  uint indexCount;
+  uint firstIndex;
+  int vertexOffset;
+  uint firstCommand;
+  uint maxCommands;
+  uint pad0;
+  uint pad1;
+  uint pad2;
+};
+
+struct Command {
+  uint indexCount;
+  uint instanceCount;
+  uint firstIndex;
+  int vertexOffset;
+  uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+  Object objects[];
+};
+layout(std430, set = 0, binding = 1) readonly buffer Batches {
+  Batch batches[];
+};
+layout(std430, set = 0, binding = 2) writeonly buffer Commands {
+  Command commands[];
+};
+layout(std430, set = 0, binding = 3) buffer Counts {
+  uint counts[];
+};
+layout(std430, set = 0, binding = 4) readonly buffer Pyramid {
+  float pyramid[];
+};
+layout(std430, set = 0, binding = 5) readonly buffer Occlusion {
+  mat4 viewProjection;
+  uint levelCount;
+  uint pad0;
+  uint pad1;
+  uint pad2;
+  uvec4 levels[16];
+} occlusion;
+layout(std430, set = 0, binding = 6) buffer Stats {
+  uint visible;
+  uint frustumCulled;
+  uint occluded;
+  uint overflowed;
+} stats;
+
+layout(push_constant) uniform Cull {
+  vec4 planes[6];
+  uint objectCount;
+  uint batchCount;
+  float margin;
+} cull;
+
+bool occluded(vec3 center, float radius) {
+  vec2 uvMin = vec2(1.0);
+  vec2 uvMax = vec2(0.0);
+  float nearest = 1.0;
+  for (int corner = 0; corner < 8; ++corner) {
+    vec3 offset = vec3((corner & 1) != 0 ? radius : -radius,
+                       (corner & 2) != 0 ? radius : -radius,
+                       (corner & 4) != 0 ? radius : -radius);
+    vec4 clip = occlusion.viewProjection * vec4(center + offset, 1.0);
+    if (clip.w <= 0.0) {
+      return false;
+    }
+
+    vec3 ndc = clip.xyz / clip.w;
+    uvMin = min(uvMin, ndc.xy * 0.5 + 0.5);
+    uvMax = max(uvMax, ndc.xy * 0.5 + 0.5);
+    nearest = min(nearest, ndc.z);
+  }
+
+  if (nearest <= 0.0) {
+    return false;
+  }
+
+  uvMin = clamp(uvMin, 0.0, 1.0);
+  uvMax = clamp(uvMax, 0.0, 1.0);
+  vec2 extent = (uvMax - uvMin) * vec2(occlusion.levels[0].xy);
+  uint level = uint(clamp(ceil(log2(max(max(extent.x, extent.y), 1.0))), 0.0,
+                          float(occlusion.levelCount - 1u)));
+
+  uvec4 info;
+  uvec2 lo;
+  uvec2 hi;
+  for (;;) {
+    info = occlusion.levels[level];
+    lo = min(uvec2(uvMin * vec2(info.xy)), info.xy - 1u);
+    hi = min(uvec2(uvMax * vec2(info.xy)), info.xy - 1u);
+    if ((hi.x - lo.x <= 1u && hi.y - lo.y <= 1u) ||
+        level + 1u >= occlusion.levelCount) {
+      break;
+    }
+    ++level;
+  }
+
+  float farthest = 0.0;
+  for (uint y = lo.y; y <= hi.y; ++y) {
+    for (uint x = lo.x; x <= hi.x; ++x) {
+      farthest = max(farthest, pyramid[info.z + y * info.x + x]);
+    }
+  }
+
+  return nearest > farthest;
+}
+
+void main() {
+  uint index = gl_GlobalInvocationID.x;
+  if (index >= cull.objectCount) {
+    return;
+  }
+
+  mat4 model = objects[index].model;
+  uint batchIndex = objects[index].batch;
+  if (batchIndex >= cull.batchCount) {
+    return;
+  }
+
+  Batch batch = batches[batchIndex];
+  if (batch.sphere.w >= 0.0) {
+    vec3 center = (model * vec4(batch.sphere.xyz, 1.0)).xyz;
+    float scale = max(max(length(model[0].xyz), length(model[1].xyz)),
+                      length(model[2].xyz));
+    float radius = batch.sphere.w * scale + cull.margin;
+    for (int plane = 0; plane < 6; ++plane) {
+      if (dot(cull.planes[plane].xyz, center) + cull.planes[plane].w <
+          -radius) {
+        atomicAdd(stats.frustumCulled, 1u);
+        return;
+      }
+    }
+
+    if (occlusion.levelCount > 0u && occluded(center, radius)) {
+      atomicAdd(stats.occluded, 1u);
+      return;
+    }
+  }
+
+  uint slot = atomicAdd(counts[batchIndex], 1u);
+  if (slot >= batch.maxCommands) {
+    atomicAdd(stats.overflowed, 1u);
+    return;
+  }
+
+  atomicAdd(stats.visible, 1u);
+
+  commands[batch.firstCommand + slot] =
+      Command(batch.indexCount, 1u, batch.firstIndex, batch.vertexOffset,
+              index);
+}
+)";
+
+constexpr VkDeviceSize kCountStride = sizeof(uint32_t);
+
+} // namespace
+
+GpuCullPass::GpuCullPass(Executor &executor, const core::Device &device,
+                         scene::Scene &scene)
+    : executor_(executor), device_(device), scene_(scene) {}
+
+GpuCullPass::~GpuCullPass() { destroy(); }
+
+void GpuCullPass::create() {
+  destroy();
+
+  if (desc_.camera == nullptr) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' has no camera", name());
+  }
+
+  if (desc_.batches.empty()) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' has no batches", name());
+  }
+
+  objects_ = scene_.getStorageBuffer(desc_.objects);
+  if (!objects_) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' object buffer not found: {}", name(),
+                   desc_.objects);
+  }
+
+  object_count_ =
+      static_cast<uint32_t>(objects_->size() / sizeof(GpuCullObject));
+  if (object_count_ == 0) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' object buffer '{}' holds no objects",
+                   name(), desc_.objects);
+  }
+
+  first_commands_.clear();
+  command_count_ = 0;
+  for (const auto &batch : desc_.batches) {
+    if (batch.maxObjects == 0) {
+      VKR_EXEC_ERROR("GpuCullPass '{}' batch '{}' has no object capacity",
+                     name(), batch.meshName);
+    }
+
+    first_commands_.push_back(command_count_);
+    command_count_ += batch.maxObjects;
+  }
+
+  mesh_handles_.clear();
+  for (const auto &batch : desc_.batches) {
+    mesh_handles_.push_back(scene_.meshHandle(batch.meshName));
+  }
+  meshes_.assign(desc_.batches.size(), nullptr);
+  batch_data_.assign(desc_.batches.size(), BatchData{});
+
+  createBuffers();
+  createDescriptors();
+  createPipeline();
+}
+
+void GpuCullPass::destroy() {
+  pipeline_.reset();
+  descriptor_sets_.reset();
+  descriptor_layout_.reset();
+  descriptor_pool_.reset();
+  frames_.clear();
+  objects_.reset();
+  object_count_ = 0;
+  command_count_ = 0;
+  first_commands_.clear();
+  mesh_handles_.clear();
+  meshes_.clear();
+  batch_data_.clear();
+}
+
+void GpuCullPass::update(const GpuCullPassDesc &desc) { desc_ = desc; }
+
+auto GpuCullPass::awaitPipelines()
+    -> std::vector<pipeline::PipelineBuildStatus> {
+  if (!pipeline_) {
+    return {};
+  }
+
+  (void)pipeline_->waitPending();
+  if (!pipeline_->valid()) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' failed to create compute pipeline: {}",
+                   name(), pipeline_->lastBuild().error);
+  }
+
+  return {pipeline_->lastBuild()};
+}
+
+void GpuCullPass::record() {
+  if (!pipeline_ || !descriptor_sets_) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' recorded before create", name());
+  }
+
+  (void)pipeline_->commitPending();
+  if (!pipeline_->valid()) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' recorded without a valid compute "
+                   "pipeline",
+                   name());
+  }
+
+  const uint32_t frameIndex = executor_.frameIndex();
+  auto &frame = frames_[frameIndex];
+  resolveMeshes();
+  writeBatches(frame);
+  readStats(frame);
+  writeOcclusion(frameIndex);
+
+  PushConstants constants{};
+  const auto frustum = desc_.camera->frustum();
+  std::copy(frustum.planes.begin(), frustum.planes.end(), constants.planes);
+  constants.objectCount = object_count_;
+  constants.batchCount = batchCount();
+  constants.margin = desc_.margin;
+
+  executor_.beginProfileScope(name());
+
+  // the previous use of this slot's buffers finished with its fence; commands
+  // no object claims stay zero, which draws nothing without a count buffer
+  executor_.fillBuffer(frame.commands->buffer(), 0, VK_WHOLE_SIZE, 0);
+  executor_.fillBuffer(frame.counts->buffer(), 0, VK_WHOLE_SIZE, 0);
+  executor_.memoryBarrier(
+      VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+  executor_.bindComputePipeline(pipeline_->pipeline(), pipeline_->layout(),
+                                descriptor_sets_->set(frameIndex));
+  executor_.pushConstants(pipeline_->layout(), VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                          sizeof(constants), &constants);
+  executor_.dispatch((object_count_ + kLocalSize - 1) / kLocalSize);
+
+  executor_.memoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          VK_ACCESS_SHADER_WRITE_BIT,
+                          VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                              VK_PIPELINE_STAGE_HOST_BIT,
+                          VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+                              VK_ACCESS_HOST_READ_BIT);
+
+  executor_.endProfileScope();
+  frame.recorded = true;
+}
+
+auto GpuCullPass::batchMesh(uint32_t batch) const -> scene::IMesh & {
+  if (batch >= meshes_.size() || meshes_[batch] == nullptr) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' batch {} has no resolved mesh", name(),
+                   batch);
+  }
+
+  return *meshes_[batch];
+}
+
+auto GpuCullPass::commandBuffer(uint32_t frameIndex) const -> VkBuffer {
+  if (frameIndex >= frames_.size()) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' frame index {} out of range", name(),
+                   frameIndex);
+  }
+
+  return frames_[frameIndex].commands->buffer();
+}
+
+auto GpuCullPass::commandOffset(uint32_t batch) const -> VkDeviceSize {
+  return static_cast<VkDeviceSize>(first_commands_.at(batch)) *
+         sizeof(VkDrawIndexedIndirectCommand);
+}
+
+auto GpuCullPass::countBuffer(uint32_t frameIndex) const -> VkBuffer {
+  if (frameIndex >= frames_.size()) {
+    VKR_EXEC_ERROR("GpuCullPass '{}' frame index {} out of range", name(),
+                   frameIndex);
+  }
+
+  return frames_[frameIndex].counts->buffer();
+}
+
+auto GpuCullPass::countOffset(uint32_t batch) const -> VkDeviceSize {
+  return static_cast<VkDeviceSize>(batch) * kCountStride;
+}
+
+void GpuCullPass::createBuffers() {
+  frames_.resize(executor_.framesInFlight());
+  for (auto &frame : frames_) {
+    frame.batches = std::make_unique<resource::Buffer>(device_);
+    frame.batches->update(sizeof(BatchData) * desc_.batches.size(),
+                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    (void)frame.batches->map();
+
+    frame.commands = std::make_unique<resource::Buffer>(device_);
+    frame.commands->update(
+        sizeof(VkDrawIndexedIndirectCommand) * command_count_,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    frame.counts = std::make_unique<resource::Buffer>(device_);
+    frame.counts->update(kCountStride * desc_.batches.size(),
+                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                             VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                             VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    frame.occlusion = std::make_unique<resource::Buffer>(device_);
+    frame.occlusion->update(sizeof(OcclusionData),
+                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    (void)frame.occlusion->map();
+
+    frame.stats = std::make_unique<resource::Buffer>(device_);
+    frame.stats->update(sizeof(StatsData), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    (void)frame.stats->map();
+
+    // nothing reads the pyramid binding until the Hi-Z pass has recorded
+    frame.pyramid = objects_->buffer();
+  }
+}
+
+void GpuCullPass::createDescriptors() {
+  std::vector<pipeline::DescriptorBinding> bindings{};
+  for (uint32_t binding = 0; binding < 7; ++binding) {
+    bindings.push_back(pipeline::DescriptorBinding{
+        .layout = {binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1,
+                   VK_SHADER_STAGE_COMPUTE_BIT}});
+  }
+
+  const uint32_t frameCount = executor_.framesInFlight();
+  descriptor_pool_ = std::make_unique<pipeline::DescriptorPool>(device_);
+  descriptor_pool_->update(pipeline::DescriptorPoolDesc{
+      .poolSizes = {{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 7 * frameCount}},
+      .maxSets = frameCount,
+  });
+
+  descriptor_layout_ = std::make_unique<pipeline::DescriptorSetLayout>(device_);
+  descriptor_layout_->update(
+      pipeline::DescriptorSetLayoutDesc{.bindings = bindings});
+
+  std::vector<pipeline::DescriptorSetWriteDesc> writes{};
+  for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+    const auto &frame = frames_[frameIndex];
+    auto write = pipeline::DescriptorSetWriteDesc::forSet(frameIndex);
+    write.buffers = {
+        pipeline::DescriptorBufferWriteDesc::storage(
+            0, {objects_->buffer(), 0, VK_WHOLE_SIZE}),
+        pipeline::DescriptorBufferWriteDesc::storage(
+            1, {frame.batches->buffer(), 0, VK_WHOLE_SIZE}),
+        pipeline::DescriptorBufferWriteDesc::storage(
+            2, {frame.commands->buffer(), 0, VK_WHOLE_SIZE}),
+        pipeline::DescriptorBufferWriteDesc::storage(
+            3, {frame.counts->buffer(), 0, VK_WHOLE_SIZE}),
+        pipeline::DescriptorBufferWriteDesc::storage(
+            4, {frame.pyramid, 0, VK_WHOLE_SIZE}),
+        pipeline::DescriptorBufferWriteDesc::storage(
+            5, {frame.occlusion->buffer(), 0, VK_WHOLE_SIZE}),
+        pipeline::DescriptorBufferWriteDesc::storage(
+            6, {frame.stats->buffer(), 0, VK_WHOLE_SIZE}),
+    };
+    writes.push_back(std::move(write));
+  }
+
+  descriptor_sets_ = std::make_unique<pipeline::DescriptorSets>(device_);
+  descriptor_sets_->update(pipeline::DescriptorSetsDesc{
+      .pool = descriptor_pool_->pool(),
+      .layout = descriptor_layout_->layout(),
+      .setCount = frameCount,
+      .writes = std::move(writes),
+  });
+}
+
+void GpuCullPass::createPipeline() {
+  pipeline_ = std::make_unique<pipeline::ComputePipeline>(device_);
+  (void)pipeline_->updateAsync(pipeline::ComputePipelineDesc{
+      .name = name().empty() ? "gpu-cull" : name(),
+      .shader = resource::ShaderModuleDesc::computeGlslSource(kCullShader,
+                                                              "gpu-cull"),
+      .layout = {.setLayouts = {descriptor_layout_->layout()},
+                 .pushConstants = {{VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                                    sizeof(PushConstants)}}},
+  });
+}
+
+// batch meshes go through the scene's handles like RasterPass mesh lists; the
+// table only changes with the scene version
+void GpuCullPass::resolveMeshes() {
+  for (size_t index = 0; index < desc_.batches.size(); ++index) {
+    auto *mesh = scene_.mesh(mesh_handles_[index]);
+    if (mesh == nullptr) {
+      mesh_handles_[index] = scene_.meshHandle(desc_.batches[index].meshName);
+      mesh = scene_.mesh(mesh_handles_[index]);
+    }
+
+    if (mesh == nullptr || !mesh->isValid() || !mesh->indexBuffer()) {
+      VKR_EXEC_ERROR("GpuCullPass '{}' mesh resource not found: {}", name(),
+                     desc_.batches[index].meshName);
+    }
+
+    meshes_[index] = mesh;
+  }
+}
+
+// in-place mesh edits move bounds and index counts without bumping the scene
+// version, so each slot also tracks the meshes' revisions
+void GpuCullPass::writeBatches(FrameBuffers &frame) {
+  uint64_t revision = 0;
+  for (const auto *mesh : meshes_) {
+    revision += mesh->revision();
+  }
+
+  if (frame.batchVersion == scene_.version() &&
+      frame.batchRevision == revision) {
+    return;
+  }
+
+  for (size_t index = 0; index < desc_.batches.size(); ++index) {
+    const auto bounds = meshes_[index]->bounds();
+    batch_data_[index] = BatchData{
+        .sphere = bounds.isValid() ? glm::vec4(bounds.center, bounds.radius)
+                                   : glm::vec4(0.0f, 0.0f, 0.0f, -1.0f),
+        .indexCount = meshes_[index]->indexBuffer()->get().indexCount(),
+        .firstCommand = first_commands_[index],
+        .maxCommands = desc_.batches[index].maxObjects,
+    };
+  }
+
+  frame.batches->write(batch_data_.data(),
+                       sizeof(BatchData) * batch_data_.size());
+  frame.batchVersion = scene_.version();
+  frame.batchRevision = revision;
+}
+
+// the previous use of this slot has finished, so its counters are complete
+// and the slot's set can point at a new pyramid, e.g. after a resize
+void GpuCullPass::readStats(FrameBuffers &frame) {
+  if (frame.recorded) {
+    StatsData counted{};
+    std::memcpy(&counted, frame.stats->mapped(), sizeof(counted));
+    stats_ = {.objects = object_count_,
+              .visible = counted.visible,
+              .occluded = counted.occluded,
+              .overflowed = counted.overflowed};
+    executor_.recordCulling(stats_);
+  }
+
+  const StatsData cleared{};
+  frame.stats->write(&cleared, sizeof(cleared));
+}
+
+void GpuCullPass::writeOcclusion(uint32_t frameIndex) {
+  auto &frame = frames_[frameIndex];
+  OcclusionData data{};
+
+  const auto *hiz = desc_.hiz;
+  const bool active = occlusionEnabled() && hiz->ready();
+  const VkBuffer pyramid = active ? hiz->pyramid() : objects_->buffer();
+  if (frame.pyramid != pyramid) {
+    frame.pyramid = pyramid;
+    auto write = pipeline::DescriptorSetWriteDesc::forSet(frameIndex);
+    write.buffers.push_back(pipeline::DescriptorBufferWriteDesc::storage(
+        4, {pyramid, 0, VK_WHOLE_SIZE}));
+    descriptor_sets_->write({write});
+  }
+
+  if (active) {
+    const auto &levels = hiz->levels();
+    data.viewProjection = hiz->viewProjection();
+    data.levelCount = static_cast<uint32_t>(levels.size());
+    for (size_t index = 0; index < levels.size(); ++index) {
+      data.levels[index] = {levels[index].width, levels[index].height,
+                            levels[index].offset, 0};
+    }
+  }
+
+  frame.occlusion->write(&data, sizeof(data));
+}
+
+} // namespace vkr::exec
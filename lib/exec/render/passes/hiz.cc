@@ -0,0 +1,264 @@
+#include "vkr/exec/render/passes/hiz.hh"
+#include "vkr/logger.hh"
+#include <algorithm>
+
+namespace vkr::exec {
+namespace {
+
+constexpr uint32_t kLocalSize = 8;
+
+// each destination texel takes the farthest of the source texels it covers;
+// rounding the range outwards keeps odd sizes conservative, at most 3x3
+constexpr const char *kReduceShader = R"(#version 450
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(set = 0, binding = 0) uniform sampler2D depth;
+layout(std430, set = 0, binding = 1) buffer Pyramid {
+  float texels[];
+};
+
+layout(push_constant) uniform Level {
+  uint srcWidth;
+  uint srcHeight;
+  uint srcOffset;
+  uint dstWidth;
+  uint dstHeight;
+  uint dstOffset;
+  uint fromDepth;
+} level;
+
+float source(uint x, uint y) {
+  if (level.fromDepth != 0u) {
+    return texelFetch(depth, ivec2(x, y), 0).r;
+  }
+  return texels[level.srcOffset + y * level.srcWidth + x];
+}
+
+void main() {
+  uvec2 texel = gl_GlobalInvocationID.xy;
+  uvec2 dst = uvec2(level.dstWidth, level.dstHeight);
+  if (texel.x >= dst.x || texel.y >= dst.y) {
+    return;
+  }
+
+  uvec2 src = uvec2(level.srcWidth, level.srcHeight);
+  uvec2 begin = texel * src / dst;
+  uvec2 end = min(((texel + 1u) * src + dst - 1u) / dst, src);
+
+  float farthest = 0.0;
+  for (uint y = begin.y; y < end.y; ++y) {
+    for (uint x = begin.x; x < end.x; ++x) {
+      farthest = max(farthest, source(x, y));
+    }
+  }
+
+  texels[level.dstOffset + texel.y * dst.x + texel.x] = farthest;
+}
+)";
+
+} // namespace
+
+HiZPass::HiZPass(Executor &executor, const core::Device &device,
+                 RenderPassSource source, const scene::Camera &camera)
+    : executor_(executor), device_(device), source_(source), camera_(camera) {}
+
+HiZPass::~HiZPass() { destroy(); }
+
+void HiZPass::create() {
+  destroy();
+
+  const auto *depth = source_.target().depth();
+  if (depth == nullptr || !depth->hasSampler()) {
+    VKR_EXEC_ERROR("HiZPass '{}' source needs a sampled depth attachment",
+                   name());
+  }
+
+  createLevels();
+  createDescriptors();
+  createPipeline();
+}
+
+void HiZPass::destroy() {
+  pipeline_.reset();
+  descriptor_sets_.reset();
+  descriptor_layout_.reset();
+  descriptor_pool_.reset();
+  pyramid_.reset();
+  levels_.clear();
+  ready_ = false;
+}
+
+auto HiZPass::awaitPipelines() -> std::vector<pipeline::PipelineBuildStatus> {
+  if (!pipeline_) {
+    return {};
+  }
+
+  (void)pipeline_->waitPending();
+  if (!pipeline_->valid()) {
+    VKR_EXEC_ERROR("HiZPass '{}' failed to create compute pipeline: {}",
+                   name(), pipeline_->lastBuild().error);
+  }
+
+  return {pipeline_->lastBuild()};
+}
+
+void HiZPass::record() {
+  if (!pipeline_ || !descriptor_sets_) {
+    VKR_EXEC_ERROR("HiZPass '{}' recorded before create", name());
+  }
+
+  (void)pipeline_->commitPending();
+  if (!pipeline_->valid()) {
+    VKR_EXEC_ERROR("HiZPass '{}' recorded without a valid compute pipeline",
+                   name());
+  }
+
+  const uint32_t frameIndex = executor_.frameIndex();
+  const auto &target = source_.target(frameIndex);
+
+  executor_.beginProfileScope(name());
+
+  // culling earlier in this frame still reads the previous pyramid
+  executor_.memoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          VK_ACCESS_SHADER_WRITE_BIT);
+  executor_.bindComputePipeline(pipeline_->pipeline(), pipeline_->layout(),
+                                descriptor_sets_->set(frameIndex));
+
+  PushConstants constants{.srcWidth = target.width(),
+                          .srcHeight = target.height(),
+                          .fromDepth = 1};
+  for (size_t index = 0; index < levels_.size(); ++index) {
+    const auto &level = levels_[index];
+    if (index > 0) {
+      const auto &previous = levels_[index - 1];
+      constants = {.srcWidth = previous.width,
+                   .srcHeight = previous.height,
+                   .srcOffset = previous.offset};
+      executor_.memoryBarrier(
+          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    constants.dstWidth = level.width;
+    constants.dstHeight = level.height;
+    constants.dstOffset = level.offset;
+    executor_.pushConstants(pipeline_->layout(), VK_SHADER_STAGE_COMPUTE_BIT,
+                            0, sizeof(constants), &constants);
+    executor_.dispatch((level.width + kLocalSize - 1) / kLocalSize,
+                       (level.height + kLocalSize - 1) / kLocalSize);
+  }
+
+  // also orders the next frame's culling, which comes later in submission
+  // order on the same queue
+  executor_.memoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          VK_ACCESS_SHADER_WRITE_BIT,
+                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          VK_ACCESS_SHADER_READ_BIT);
+
+  executor_.endProfileScope();
+
+  view_projection_ = camera_.getProjection() * camera_.getView();
+  ready_ = true;
+}
+
+auto HiZPass::imageAccesses() const -> std::vector<ImageAccess> {
+  auto access = source_.target(executor_.frameIndex())
+                    .sampledAccess(RenderPassInputKind::Depth);
+  access.state.stageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+  return {access};
+}
+
+auto HiZPass::sampledPasses() const -> std::vector<const Pass *> {
+  return {&source_.pass()};
+}
+
+auto HiZPass::pyramid() const -> VkBuffer {
+  if (!pyramid_) {
+    VKR_EXEC_ERROR("HiZPass '{}' pyramid requested before create", name());
+  }
+
+  return pyramid_->buffer();
+}
+
+void HiZPass::createLevels() {
+  const auto &target = source_.target();
+  uint32_t width = target.width();
+  uint32_t height = target.height();
+  uint32_t offset = 0;
+
+  while (levels_.size() < kMaxLevels && (width > 1 || height > 1)) {
+    width = std::max(1U, (width + 1) / 2);
+    height = std::max(1U, (height + 1) / 2);
+    levels_.push_back({.width = width, .height = height, .offset = offset});
+    offset += width * height;
+  }
+
+  if (levels_.empty()) {
+    levels_.push_back({.width = 1, .height = 1, .offset = 0});
+    offset = 1;
+  }
+
+  pyramid_ = std::make_unique<resource::Buffer>(device_);
+  pyramid_->update(sizeof(float) * offset, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
+void HiZPass::createDescriptors() {
+  const std::vector<pipeline::DescriptorBinding> bindings{
+      {.layout = {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
+                  VK_SHADER_STAGE_COMPUTE_BIT}},
+      {.layout = {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1,
+                  VK_SHADER_STAGE_COMPUTE_BIT}},
+  };
+
+  const uint32_t frameCount = executor_.framesInFlight();
+  descriptor_pool_ = std::make_unique<pipeline::DescriptorPool>(device_);
+  descriptor_pool_->update(pipeline::DescriptorPoolDesc{
+      .poolSizes = {{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount},
+                    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frameCount}},
+      .maxSets = frameCount,
+  });
+
+  descriptor_layout_ = std::make_unique<pipeline::DescriptorSetLayout>(device_);
+  descriptor_layout_->update(
+      pipeline::DescriptorSetLayoutDesc{.bindings = bindings});
+
+  std::vector<pipeline::DescriptorSetWriteDesc> writes{};
+  for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+    const auto &target = source_.target(frameIndex);
+    const auto layout =
+        target.sampledAccess(RenderPassInputKind::Depth).state.layout;
+    const VkDescriptorImageInfo imageInfo{target.depth()->sampler(),
+                                          target.depth()->imageView(), layout};
+
+    auto write = pipeline::DescriptorSetWriteDesc::forSet(frameIndex);
+    write.images.push_back(
+        pipeline::DescriptorImageWriteDesc::combinedImageSampler(0, imageInfo));
+    write.buffers.push_back(pipeline::DescriptorBufferWriteDesc::storage(
+        1, {pyramid_->buffer(), 0, VK_WHOLE_SIZE}));
+    writes.push_back(std::move(write));
+  }
+
+  descriptor_sets_ = std::make_unique<pipeline::DescriptorSets>(device_);
+  descriptor_sets_->update(pipeline::DescriptorSetsDesc{
+      .pool = descriptor_pool_->pool(),
+      .layout = descriptor_layout_->layout(),
+      .setCount = frameCount,
+      .writes = std::move(writes),
+  });
+}
+
+void HiZPass::createPipeline() {
+  pipeline_ = std::make_unique<pipeline::ComputePipeline>(device_);
+  (void)pipeline_->updateAsync(pipeline::ComputePipelineDesc{
+      .name = name().empty() ? "hiz" : name(),
+      .shader =
+          resource::ShaderModuleDesc::computeGlslSource(kReduceShader, "hiz"),
+      .layout = {.setLayouts = {descriptor_layout_->layout()},
+                 .pushConstants = {{VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                                    sizeof(PushConstants)}}},
+  });
+}
+
+} // namespace vkr::exec
@@ -9,7 +9,14 @@ PresentPass::PresentPass(Executor &executor) : executor_(executor) {
 void PresentPass::record() {
   // Queue presentation happens after the command buffer has been submitted.
   // This pass is still part of the graph so dependency ordering remains
-  // explicit, but it records no commands.
+  // explicit, but it records no commands; the graph moves the swapchain image
+  // into its present layout right before this pass.
+}
+
+auto PresentPass::imageAccesses() const -> std::vector<ImageAccess> {
+  const auto &swapchain = executor_.swapchain();
+  return {ImageAccess::present(swapchain.images().at(executor_.imageIndex()),
+                               swapchain.finalLayout())};
 }
 
 void PresentPass::present() { executor_.presentFrame(); }
@@ -94,15 +94,40 @@ void RasterPass::create() {
   createTarget();
   createRenderPass();
   createFramebuffers();
+  resolveSceneHandles();
+  createDrawData();
   createDescriptors();
   createPipeline();
+
+  if (desc_.gpuCull != nullptr &&
+      device_.enabledFeatures().drawIndirectFirstInstance != VK_TRUE) {
+    VKR_EXEC_ERROR("RasterPass '{}' draws GPU culled batches, which need "
+                   "drawIndirectFirstInstance",
+                   name());
+  }
+
+  if (!desc_.instanceBatches.empty() && desc_.indirect) {
+    draw_commands_ = std::make_unique<DrawCommandBuffer>(
+        device_, executor_.framesInFlight());
+  }
 }
 
 void RasterPass::destroy() {
+  draw_commands_.reset();
+  draw_data_buffer_.reset();
+  draw_data_.reset();
+  draw_data_slice_ = 0;
   mesh_grid_pipeline_.reset();
   mesh_grid_index_buffer_.reset();
-  mesh_grid_name_.clear();
+  mesh_grid_mesh_ = {};
+  mesh_grid_draw_ = 0;
+  draw_list_.clear();
+  draw_list_version_ = UINT64_MAX;
+  bounds_revision_ = UINT64_MAX;
+  culler_.clear();
+  visible_draws_.clear();
   pipeline_.reset();
+  empty_layout_.reset();
   descriptor_sets_.reset();
   descriptor_layout_.reset();
   descriptor_pool_.reset();
@@ -113,6 +138,28 @@ void RasterPass::destroy() {
 
 void RasterPass::update(const RasterPassDesc &desc) { desc_ = desc; }
 
+void RasterPass::rescale(VkExtent2D previous, VkExtent2D extent) {
+  desc_.target.rescale(previous, extent);
+}
+
+void RasterPass::resize() {
+  if (!target_ || !render_pass_) {
+    create();
+    return;
+  }
+
+  auto targetDesc = desc_.target;
+  targetDesc.aliasMemory(transientMemory());
+
+  framebuffers_.reset();
+  target_->update(targetDesc);
+  createFramebuffers();
+
+  if (descriptor_sets_) {
+    descriptor_sets_->rewrite(createDescriptorWrites());
+  }
+}
+
 auto RasterPass::addSource(RenderPassSource source) -> RasterPass & {
   sources_.push_back(source);
   return *this;
@@ -124,12 +171,34 @@ auto RasterPass::setSources(std::vector<RenderPassSource> sources)
   return *this;
 }
 
+auto RasterPass::awaitPipelines()
+    -> std::vector<pipeline::PipelineBuildStatus> {
+  std::vector<pipeline::PipelineBuildStatus> builds{};
+
+  for (auto *pipeline : {pipeline_.get(), mesh_grid_pipeline_.get()}) {
+    if (!pipeline) {
+      continue;
+    }
+
+    (void)pipeline->waitPending();
+    if (!pipeline->valid()) {
+      VKR_EXEC_ERROR("RasterPass '{}' failed to create graphics pipeline: {}",
+                     name(), pipeline->lastBuild().error);
+    }
+
+    builds.push_back(pipeline->lastBuild());
+  }
+
+  return builds;
+}
+
 void RasterPass::record() {
   if (!target_ || !render_pass_ || !framebuffers_) {
     VKR_EXEC_ERROR("RasterPass '{}' recorded before create", name());
   }
 
   syncSelectedMeshGrid();
+  sortDraws();
 
   RenderPassBeginDesc beginDesc{
       .framebufferIndex = 0,
@@ -137,42 +206,105 @@ void RasterPass::record() {
                      .extent = {target_->width(), target_->height()}},
       .clearValues = desc_.clearValues};
 
+  const bool drawable = pipeline_ && pipeline_->valid();
+  const uint32_t chunks =
+      drawable
+          ? executor_.parallelChunks(static_cast<uint32_t>(draw_list_.size()))
+          : 0;
+  if (chunks > 0) {
+    beginDesc.contents = VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+  }
+
   executor_.beginProfileScope(name());
   executor_.beginPass(*framebuffers_, *render_pass_, beginDesc);
-  executor_.setViewportAndScissor({target_->width(), target_->height()});
-
-  if (pipeline_ && pipeline_->valid()) {
-    const std::vector<VkDescriptorSet> emptySets{};
-    const auto &sets = descriptor_sets_ ? descriptor_sets_->sets() : emptySets;
 
-    executor_.bindPipeline(pipeline_->pipeline(), pipeline_->layout(), sets);
-    if (desc_.meshNames.empty()) {
-      executor_.drawGeometry();
-    } else {
-      for (const auto &meshName : desc_.meshNames) {
-        auto mesh = scene_.getMesh(meshName);
-        if (!mesh || !mesh->isValid()) {
-          VKR_EXEC_ERROR("RasterPass '{}' mesh resource not found: {}", name(),
-                         meshName);
-        }
-
-        const auto vertexBuffer = mesh->vertexBufferBase();
-        const auto indexBuffer = mesh->indexBuffer();
-        if (!vertexBuffer || !indexBuffer) {
-          VKR_EXEC_ERROR("RasterPass '{}' mesh '{}' has invalid buffers",
-                         name(), meshName);
-        }
-
-        executor_.drawIndexed(vertexBuffer->get(), indexBuffer->get());
+  // with a dynamic draw data slice set 0 is bound per draw instead
+  const std::vector<VkDescriptorSet> emptySets{};
+  const auto &sets = descriptor_sets_ && !dynamicDrawData()
+                         ? descriptor_sets_->sets()
+                         : emptySets;
+
+  if (chunks > 0) {
+    // secondary buffers inherit no state, so every chunk binds its own; the
+    // last one also carries the instanced batches and the mesh grid
+    const size_t meshCount = draw_list_.size();
+    executor_.recordParallel(chunks, [&](uint32_t chunk) -> void {
+      executor_.setViewportAndScissor({target_->width(), target_->height()});
+      executor_.bindPipeline(pipeline_->pipeline(), pipeline_->layout(),
+                             sets);
+      bindBindlessTable(pipeline_->layout());
+      bindDrawData(pipeline_->layout(), 0);
+      recordMeshes(meshCount * chunk / chunks,
+                   meshCount * (chunk + 1) / chunks);
+
+      if (chunk + 1 == chunks) {
+        recordInstanceBatches();
+        recordGpuCulledBatches();
+        recordSelectedMeshGrid(sets);
       }
+    });
+  } else {
+    executor_.setViewportAndScissor({target_->width(), target_->height()});
+
+    if (drawable) {
+      executor_.bindPipeline(pipeline_->pipeline(), pipeline_->layout(), sets);
+      bindBindlessTable(pipeline_->layout());
+      bindDrawData(pipeline_->layout(), 0);
+      if (desc_.meshNames.empty() && desc_.instanceBatches.empty() &&
+          desc_.gpuCull == nullptr) {
+        executor_.drawGeometry();
+      } else {
+        recordMeshes(0, draw_list_.size());
+        recordInstanceBatches();
+        recordGpuCulledBatches();
+      }
+      recordSelectedMeshGrid(sets);
     }
-    recordSelectedMeshGrid(sets);
   }
 
   executor_.endPass();
   executor_.endProfileScope();
 }
 
+auto RasterPass::imageAccesses() const -> std::vector<ImageAccess> {
+  if (!target_) {
+    return {};
+  }
+
+  std::vector<ImageAccess> accesses{};
+  const size_t inputCount = std::min(sources_.size(), desc_.inputs.size());
+  for (size_t index = 0; index < inputCount; ++index) {
+    accesses.push_back(
+        sources_[index].target().sampledAccess(desc_.inputs[index].kind));
+  }
+
+  for (const auto &access : target_->attachmentAccesses()) {
+    accesses.push_back(access);
+  }
+
+  return accesses;
+}
+
+auto RasterPass::transientAttachments() const
+    -> std::vector<resource::ImageDesc> {
+  return desc_.target.imageDescs();
+}
+
+auto RasterPass::transientImages() const -> std::vector<VkImage> {
+  return target_ ? target_->images() : std::vector<VkImage>{};
+}
+
+auto RasterPass::sampledPasses() const -> std::vector<const Pass *> {
+  std::vector<const Pass *> passes{};
+  passes.reserve(sources_.size());
+
+  for (const auto &source : sources_) {
+    passes.push_back(&source.pass());
+  }
+
+  return passes;
+}
+
 auto RasterPass::target() -> OffscreenTarget & {
   if (!target_) {
     VKR_EXEC_ERROR("RasterPass '{}' target requested before create", name());
@@ -190,8 +322,11 @@ auto RasterPass::target() const -> const OffscreenTarget & {
 }
 
 void RasterPass::createTarget() {
+  auto targetDesc = desc_.target;
+  targetDesc.aliasMemory(transientMemory());
+
   target_ = std::make_unique<OffscreenTarget>(device_, command_pool_);
-  target_->update(desc_.target);
+  target_->update(targetDesc);
 }
 
 void RasterPass::createRenderPass() {
@@ -203,16 +338,6 @@ void RasterPass::createRenderPass() {
         target_->color().desc().format, target_->depth()
                                             ? target_->depth()->desc().format
                                             : VK_FORMAT_UNDEFINED);
-
-    const auto &colorDesc = target_->color().desc();
-    const auto colorFinalLayout = colorDesc.finalLayout;
-    if (colorFinalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
-      renderPassDesc.colors[0].finalLayout = colorFinalLayout;
-    } else if ((colorDesc.usage & (VK_IMAGE_USAGE_SAMPLED_BIT |
-                                   VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT)) == 0) {
-      renderPassDesc.colors[0].finalLayout =
-          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    }
   } else if (target_->depth()) {
     renderPassDesc = pipeline::RenderPassDesc::makeDepthOnly(
         target_->depth()->desc().format);
@@ -222,15 +347,12 @@ void RasterPass::createRenderPass() {
 
   if (target_->depth()) {
     const auto &depthDesc = target_->depth()->desc();
-    if (depthDesc.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
-      renderPassDesc.depth.finalLayout = depthDesc.finalLayout;
-    }
-
     if ((depthDesc.usage & VK_IMAGE_USAGE_SAMPLED_BIT) != 0) {
       renderPassDesc.depth.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     }
   }
 
+  renderPassDesc.externalLayouts();
   render_pass_->update(renderPassDesc);
 }
 
@@ -243,7 +365,8 @@ void RasterPass::createFramebuffers() {
 }
 
 void RasterPass::createDescriptors() {
-  if (desc_.descriptorBindings.empty() && desc_.inputs.empty()) {
+  if (desc_.descriptorBindings.empty() && desc_.inputs.empty() &&
+      !dynamicDrawData()) {
     return;
   }
 
@@ -263,6 +386,10 @@ void RasterPass::createDescriptors() {
                    input.stageFlags}});
   }
 
+  if (dynamicDrawData()) {
+    bindings.push_back(drawDataBinding());
+  }
+
   descriptor_pool_ = std::make_unique<pipeline::DescriptorPool>(device_);
   descriptor_pool_->update(descriptorPoolDesc());
 
@@ -290,6 +417,15 @@ void RasterPass::createPipeline() {
     pipelineDesc.layout.setLayouts = {descriptorSetLayout};
   }
 
+  if (desc_.bindless) {
+    pipelineDesc.layout.setLayouts = bindlessSetLayouts();
+  }
+
+  if (draw_data_ && !dynamicDrawData()) {
+    pipelineDesc.layout.pushConstant(desc_.drawData.stageFlags, 0,
+                                     draw_data_->stride());
+  }
+
   if (!pipelineDesc.isValid()) {
     VKR_EXEC_WARN("RasterPass '{}' has no valid graphics pipeline desc",
                   name());
@@ -298,12 +434,7 @@ void RasterPass::createPipeline() {
 
   pipeline_ =
       std::make_unique<pipeline::GraphicsPipeline>(device_, *render_pass_);
-  pipeline_->update(pipelineDesc);
-
-  if (!pipeline_->valid()) {
-    VKR_EXEC_ERROR("RasterPass '{}' failed to create graphics pipeline '{}'",
-                   name(), pipelineDesc.name);
-  }
+  (void)pipeline_->updateAsync(pipelineDesc);
 
   auto gridPipelineDesc = pipelineDesc;
   gridPipelineDesc.name = pipelineDesc.name + "-mesh-grid";
@@ -315,13 +446,120 @@ void RasterPass::createPipeline() {
 
   mesh_grid_pipeline_ =
       std::make_unique<pipeline::GraphicsPipeline>(device_, *render_pass_);
-  mesh_grid_pipeline_->update(gridPipelineDesc);
+  (void)mesh_grid_pipeline_->updateAsync(gridPipelineDesc);
+}
+
+void RasterPass::createDrawData() {
+  if (!desc_.drawData.enabled()) {
+    return;
+  }
+
+  draw_data_ = scene_.getDrawDataStream(desc_.drawData.stream);
+  if (!draw_data_) {
+    VKR_EXEC_ERROR("RasterPass '{}' draw data stream not found: {}", name(),
+                   desc_.drawData.stream);
+  }
+
+  if (draw_data_->drawCount() == 0 ||
+      draw_data_->drawCount() < desc_.meshNames.size()) {
+    VKR_EXEC_ERROR("RasterPass '{}' draw data stream '{}' has {} elements "
+                   "for {} meshes",
+                   name(), desc_.drawData.stream, draw_data_->drawCount(),
+                   desc_.meshNames.size());
+  }
+
+  VkPhysicalDeviceProperties properties{};
+  vkGetPhysicalDeviceProperties(device_.physicalDevice(), &properties);
 
-  if (!mesh_grid_pipeline_->valid()) {
-    VKR_EXEC_ERROR(
-        "RasterPass '{}' failed to create mesh grid graphics pipeline '{}'",
-        name(), gridPipelineDesc.name);
+  if (!dynamicDrawData()) {
+    if (draw_data_->stride() > properties.limits.maxPushConstantsSize) {
+      VKR_EXEC_ERROR("RasterPass '{}' draw data stride {} exceeds the {} "
+                     "byte push constant limit",
+                     name(), draw_data_->stride(),
+                     properties.limits.maxPushConstantsSize);
+    }
+    return;
   }
+
+  const VkDeviceSize alignment = std::max<VkDeviceSize>(
+      properties.limits.minUniformBufferOffsetAlignment, 1);
+  draw_data_slice_ =
+      (draw_data_->stride() + alignment - 1) / alignment * alignment;
+
+  draw_data_buffer_ = std::make_unique<resource::Buffer>(device_);
+  draw_data_buffer_->update(draw_data_slice_ * draw_data_->drawCount() *
+                                executor_.framesInFlight(),
+                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+  (void)draw_data_buffer_->map();
+}
+
+auto RasterPass::dynamicDrawData() const noexcept -> bool {
+  return desc_.drawData.enabled() &&
+         desc_.drawData.mode == DrawDataMode::DynamicUniform;
+}
+
+auto RasterPass::drawDataBinding() const -> pipeline::DescriptorBinding {
+  return pipeline::DescriptorBinding{
+      .name = desc_.drawData.stream,
+      .layout = {desc_.drawData.binding,
+                 VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
+                 desc_.drawData.stageFlags}};
+}
+
+// push constants are recorded by value; a dynamic slice is copied into the
+// frame's region, which the GPU no longer reads once the frame is recording
+void RasterPass::bindDrawData(VkPipelineLayout layout, size_t drawIndex) {
+  if (!draw_data_) {
+    return;
+  }
+
+  const auto index = static_cast<uint32_t>(drawIndex);
+  if (!dynamicDrawData()) {
+    executor_.pushConstants(layout, desc_.drawData.stageFlags, 0,
+                            draw_data_->stride(), draw_data_->element(index));
+    return;
+  }
+
+  const uint32_t frameIndex = executor_.frameIndex();
+  const VkDeviceSize offset =
+      draw_data_slice_ *
+      (static_cast<VkDeviceSize>(frameIndex) * draw_data_->drawCount() + index);
+  draw_data_buffer_->write(draw_data_->element(index), draw_data_->stride(),
+                           offset);
+  executor_.bindDescriptorSet(layout, 0, descriptor_sets_->set(frameIndex),
+                              {static_cast<uint32_t>(offset)});
+}
+
+auto RasterPass::bindlessSetLayouts() -> std::vector<VkDescriptorSetLayout> {
+  const auto *table = scene_.bindless();
+  if (table == nullptr) {
+    VKR_EXEC_ERROR("RasterPass '{}' uses bindless resources but the scene "
+                   "has no bindless table",
+                   name());
+  }
+
+  // set 0 stays the pass's own set; passes without one get an empty layout
+  // so the table still lands at BindlessTable::kSet
+  if (!descriptor_layout_) {
+    empty_layout_ = std::make_unique<pipeline::DescriptorSetLayout>(device_);
+    empty_layout_->update(pipeline::DescriptorSetLayoutDesc{});
+  }
+
+  const VkDescriptorSetLayout passLayout = descriptor_layout_
+                                               ? descriptor_layout_->layout()
+                                               : empty_layout_->layout();
+  return {passLayout, table->layout()};
+}
+
+void RasterPass::bindBindlessTable(VkPipelineLayout layout) {
+  if (!desc_.bindless) {
+    return;
+  }
+
+  executor_.bindDescriptorSet(layout, scene::BindlessTable::kSet,
+                              scene_.bindless()->set());
 }
 
 auto RasterPass::createDescriptorWrites() const
@@ -364,6 +602,23 @@ auto RasterPass::createDescriptorWrites() const
       break;
     }
 
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: {
+      auto storageBuffer = scene_.getStorageBuffer(binding.name);
+
+      if (!storageBuffer) {
+        VKR_EXEC_ERROR("Storage buffer resource not found: {}", binding.name);
+      }
+
+      const VkDescriptorBufferInfo bufferInfo{storageBuffer->buffer(), 0,
+                                              VK_WHOLE_SIZE};
+      for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        writes[frameIndex].buffers.push_back(
+            pipeline::DescriptorBufferWriteDesc::storage(
+                binding.layout.binding, bufferInfo));
+      }
+      break;
+    }
+
     case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: {
       auto texture = scene_.getTexture(binding.name);
       auto cubemap = texture ? nullptr : scene_.getCubemap(binding.name);
@@ -419,6 +674,17 @@ auto RasterPass::createDescriptorWrites() const
     }
   }
 
+  if (dynamicDrawData()) {
+    const VkDescriptorBufferInfo bufferInfo{draw_data_buffer_->buffer(), 0,
+                                            draw_data_->stride()};
+    for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+      writes[frameIndex].buffers.push_back(
+          pipeline::DescriptorBufferWriteDesc::one(
+              desc_.drawData.binding,
+              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, bufferInfo));
+    }
+  }
+
   return writes;
 }
 
@@ -466,49 +732,306 @@ auto RasterPass::descriptorPoolDesc() const -> pipeline::DescriptorPoolDesc {
     }
   }
 
+  if (dynamicDrawData()) {
+    poolDesc.poolSizes.push_back(
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, frameCount});
+  }
+
   poolDesc.maxSets = frameCount;
   return poolDesc;
 }
 
+void RasterPass::resolveSceneHandles() {
+  mesh_handles_.clear();
+  mesh_handles_.reserve(desc_.meshNames.size());
+  for (const auto &meshName : desc_.meshNames) {
+    mesh_handles_.push_back(scene_.meshHandle(meshName));
+  }
+
+  batch_meshes_.clear();
+  batch_instances_.clear();
+  for (const auto &batchDesc : desc_.instanceBatches) {
+    batch_meshes_.push_back(scene_.meshHandle(batchDesc.meshName));
+    batch_instances_.push_back(
+        scene_.instanceBufferHandle(batchDesc.instanceBufferName));
+  }
+
+  batches_.reserve(desc_.instanceBatches.size());
+  batch_commands_.reserve(desc_.instanceBatches.size());
+}
+
+// a mesh destroyed and created again under its name gets a new handle; only
+// that miss goes back to the name lookup
+auto RasterPass::resolveMesh(size_t index) -> scene::IMesh & {
+  auto *mesh = scene_.mesh(mesh_handles_[index]);
+  if (mesh == nullptr) {
+    mesh_handles_[index] = scene_.meshHandle(desc_.meshNames[index]);
+    mesh = scene_.mesh(mesh_handles_[index]);
+  }
+
+  if (mesh == nullptr || !mesh->isValid()) {
+    VKR_EXEC_ERROR("RasterPass '{}' mesh resource not found: {}", name(),
+                   desc_.meshNames[index]);
+  }
+
+  return *mesh;
+}
+
+// the pass binds one pipeline and one set 0, so the keys only differ by mesh
+// and depth and draws of the same mesh end up adjacent; per-draw data still
+// follows the desc's mesh order through the entry's draw index
+void RasterPass::sortDraws() {
+  const bool culling = desc_.culling.enabled();
+  const bool boundsChanged =
+      culling && draw_list_version_ == scene_.version() &&
+      bounds_revision_ != boundsRevision();
+  if (draw_list_version_ != scene_.version() || boundsChanged) {
+    draw_list_.clear();
+    draw_list_.reserve(desc_.meshNames.size());
+    culler_.clear();
+    if (culling) {
+      culler_.reserve(desc_.meshNames.size());
+    }
+
+    for (size_t index = 0; index < desc_.meshNames.size(); ++index) {
+      auto *mesh = scene_.mesh(mesh_handles_[index]);
+      if (mesh == nullptr) {
+        mesh_handles_[index] = scene_.meshHandle(desc_.meshNames[index]);
+        mesh = scene_.mesh(mesh_handles_[index]);
+      }
+
+      if (culling) {
+        const auto bounds =
+            mesh != nullptr ? mesh->bounds() : scene::MeshBounds{};
+        culler_.add(bounds, desc_.culling.margin);
+      } else {
+        draw_list_.add(DrawSortKey{.mesh = mesh_handles_[index].index},
+                       static_cast<uint32_t>(index));
+      }
+    }
+
+    draw_list_.sort();
+    draw_list_version_ = scene_.version();
+    bounds_revision_ = culling ? boundsRevision() : UINT64_MAX;
+  }
+
+  if (culling) {
+    cullDraws();
+  }
+}
+
+// revisions only grow while the scene version holds the meshes in place, so
+// an unchanged sum means unchanged bounds
+auto RasterPass::boundsRevision() const -> uint64_t {
+  uint64_t revision = 0;
+  for (const auto handle : mesh_handles_) {
+    const auto *mesh = scene_.mesh(handle);
+    revision += mesh != nullptr ? mesh->revision() : 0;
+  }
+
+  return revision;
+}
+
+// meshes carry no transform, so object-space bounds are tested as they are
+void RasterPass::cullDraws() {
+  const auto &camera = *desc_.culling.camera;
+  culler_.cull(camera.frustum(), visible_draws_);
+
+  const auto &view = camera.desc();
+  const float depthRange = view.farPlane - view.nearPlane;
+  draw_list_.clear();
+  for (const uint32_t index : visible_draws_) {
+    const float depth =
+        glm::dot(culler_.center(index) - view.pos, view.front);
+    draw_list_.add(DrawSortKey{.mesh = mesh_handles_[index].index,
+                               .depth = (depth - view.nearPlane) / depthRange},
+                   index);
+  }
+
+  draw_list_.sort();
+  executor_.recordCulling(culler_.stats());
+}
+
+void RasterPass::recordMeshes(size_t begin, size_t end) {
+  for (size_t position = begin; position < end; ++position) {
+    const size_t index = draw_list_.draw(position);
+    const auto &mesh = resolveMesh(index);
+    const auto vertexBuffer = mesh.vertexBufferBase();
+    const auto indexBuffer = mesh.indexBuffer();
+    if (!vertexBuffer || !indexBuffer) {
+      VKR_EXEC_ERROR("RasterPass '{}' mesh '{}' has invalid buffers", name(),
+                     desc_.meshNames[index]);
+    }
+
+    bindDrawData(pipeline_->layout(), index);
+    executor_.drawIndexed(vertexBuffer->get(), indexBuffer->get());
+  }
+}
+
+void RasterPass::recordInstanceBatches() {
+  if (desc_.instanceBatches.empty()) {
+    return;
+  }
+
+  // without drawIndirectFirstInstance the range start moves into the vertex
+  // binding offset, which also prevents merging ranges into one multi-draw
+  const uint32_t frameIndex = executor_.frameIndex();
+  const bool offsetBinding =
+      !desc_.indirect ||
+      device_.enabledFeatures().drawIndirectFirstInstance != VK_TRUE;
+
+  auto &batches = batches_;
+  auto &commands = batch_commands_;
+  batches.clear();
+  commands.clear();
+
+  for (size_t index = 0; index < desc_.instanceBatches.size(); ++index) {
+    const auto &batchDesc = desc_.instanceBatches[index];
+    auto *mesh = scene_.mesh(batch_meshes_[index]);
+    if (mesh == nullptr) {
+      batch_meshes_[index] = scene_.meshHandle(batchDesc.meshName);
+      mesh = scene_.mesh(batch_meshes_[index]);
+    }
+
+    if (mesh == nullptr || !mesh->isValid()) {
+      VKR_EXEC_ERROR("RasterPass '{}' mesh resource not found: {}", name(),
+                     batchDesc.meshName);
+    }
+
+    auto *instances = scene_.instanceBuffer(batch_instances_[index]);
+    if (instances == nullptr) {
+      batch_instances_[index] =
+          scene_.instanceBufferHandle(batchDesc.instanceBufferName);
+      instances = scene_.instanceBuffer(batch_instances_[index]);
+    }
+
+    if (instances == nullptr) {
+      VKR_EXEC_ERROR("RasterPass '{}' instance buffer not found: {}", name(),
+                     batchDesc.instanceBufferName);
+    }
+
+    const uint32_t available = instances->instanceCount(frameIndex);
+    if (batchDesc.firstInstance >= available) {
+      continue;
+    }
+
+    const uint32_t remaining = available - batchDesc.firstInstance;
+    const uint32_t instanceCount =
+        batchDesc.instanceCount == 0
+            ? remaining
+            : std::min(batchDesc.instanceCount, remaining);
+
+    const InstanceBinding binding{
+        .buffer = instances->buffer(frameIndex),
+        .offset = offsetBinding ? instances->stride() * batchDesc.firstInstance
+                                : 0,
+    };
+
+    commands.push_back(VkDrawIndexedIndirectCommand{
+        .indexCount = mesh->indexBuffer()->get().indexCount(),
+        .instanceCount = instanceCount,
+        .firstIndex = 0,
+        .vertexOffset = 0,
+        .firstInstance = offsetBinding ? 0 : batchDesc.firstInstance,
+    });
+
+    const auto commandIndex = static_cast<uint32_t>(commands.size() - 1);
+    if (!batches.empty() && batches.back().mesh == mesh &&
+        batches.back().instances == instances && !offsetBinding) {
+      ++batches.back().commandCount;
+      continue;
+    }
+
+    batches.push_back(InstanceBatch{.mesh = mesh,
+                                    .instances = instances,
+                                    .binding = binding,
+                                    .firstCommand = commandIndex,
+                                    .commandCount = 1});
+  }
+
+  if (!desc_.indirect) {
+    for (const auto &batch : batches) {
+      const auto &command = commands[batch.firstCommand];
+      executor_.drawIndexedInstanced(
+          batch.mesh->vertexBufferBase()->get(),
+          batch.mesh->indexBuffer()->get(), batch.binding,
+          command.instanceCount, command.firstInstance);
+    }
+    return;
+  }
+
+  // one host write per frame; recording is then one call per batch
+  draw_commands_->update(frameIndex, commands);
+  for (const auto &batch : batches) {
+    executor_.drawIndexedIndirect(
+        batch.mesh->vertexBufferBase()->get(), batch.mesh->indexBuffer()->get(),
+        batch.binding, draw_commands_->buffer(frameIndex),
+        static_cast<VkDeviceSize>(batch.firstCommand) *
+            DrawCommandBuffer::stride(),
+        batch.commandCount);
+  }
+}
+
+// the cull pass recorded earlier in the frame resolved the batch meshes and
+// wrote this frame slot's commands and counts
+void RasterPass::recordGpuCulledBatches() {
+  if (desc_.gpuCull == nullptr) {
+    return;
+  }
+
+  const auto &cull = *desc_.gpuCull;
+  const uint32_t frameIndex = executor_.frameIndex();
+  for (uint32_t batch = 0; batch < cull.batchCount(); ++batch) {
+    const auto &mesh = cull.batchMesh(batch);
+    executor_.drawIndexedIndirectCount(
+        mesh.vertexBufferBase()->get(), mesh.indexBuffer()->get(),
+        InstanceBinding{}, cull.commandBuffer(frameIndex),
+        cull.commandOffset(batch), cull.countBuffer(frameIndex),
+        cull.countOffset(batch), cull.desc().batches[batch].maxObjects);
+  }
+}
+
 void RasterPass::syncSelectedMeshGrid() {
-  const std::string &selectedMesh = scene_.selectedMeshName();
+  const scene::MeshHandle selectedMesh = scene_.selectedMesh();
 
-  if (selectedMesh == mesh_grid_name_) {
+  if (selectedMesh == mesh_grid_mesh_) {
     return;
   }
 
-  device_.waitIdle();
-  mesh_grid_name_ = selectedMesh;
+  mesh_grid_mesh_ = selectedMesh;
+  mesh_grid_draw_ = static_cast<size_t>(std::distance(
+      mesh_handles_.begin(),
+      std::find(mesh_handles_.begin(), mesh_handles_.end(), selectedMesh)));
   mesh_grid_index_buffer_.reset();
 
-  if (selectedMesh.empty()) {
+  if (!selectedMesh.isValid()) {
     return;
   }
 
-  auto mesh = scene_.getMesh(selectedMesh);
-  if (!mesh || !mesh->isValid()) {
-    mesh_grid_name_.clear();
+  const auto *mesh = scene_.mesh(selectedMesh);
+  if (mesh == nullptr || !mesh->isValid()) {
+    mesh_grid_mesh_ = {};
     return;
   }
 
   const auto indexBuffer = mesh->indexBuffer();
   if (!indexBuffer) {
-    mesh_grid_name_.clear();
+    mesh_grid_mesh_ = {};
     return;
   }
 
   const auto indices = indexBuffer->get().indices();
-  std::vector<uint16_t> lineIndices;
+  std::vector<uint32_t> lineIndices;
   lineIndices.reserve(indices.size() * 2);
 
-  std::unordered_set<uint32_t> edges;
+  std::unordered_set<uint64_t> edges;
   edges.reserve(indices.size());
 
-  auto addEdge = [&](uint16_t a, uint16_t b) -> void {
-    const uint16_t lo = std::min(a, b);
-    const uint16_t hi = std::max(a, b);
-    const uint32_t key =
-        (static_cast<uint32_t>(lo) << 16) | static_cast<uint32_t>(hi);
+  auto addEdge = [&](uint32_t a, uint32_t b) -> void {
+    const uint32_t lo = std::min(a, b);
+    const uint32_t hi = std::max(a, b);
+    const uint64_t key =
+        (static_cast<uint64_t>(lo) << 32) | static_cast<uint64_t>(hi);
 
     if (!edges.insert(key).second) {
       return;
@@ -525,7 +1048,7 @@ void RasterPass::syncSelectedMeshGrid() {
   }
 
   if (lineIndices.empty()) {
-    mesh_grid_name_.clear();
+    mesh_grid_mesh_ = {};
     return;
   }
 
@@ -537,18 +1060,21 @@ void RasterPass::syncSelectedMeshGrid() {
 void RasterPass::recordSelectedMeshGrid(
     const std::vector<VkDescriptorSet> &sets) {
   if (!mesh_grid_pipeline_ || !mesh_grid_pipeline_->valid() ||
-      !mesh_grid_index_buffer_ || mesh_grid_name_.empty()) {
+      !mesh_grid_index_buffer_ || !mesh_grid_mesh_.isValid()) {
+    return;
+  }
+
+  // instanced pipelines expect vertex binding 1, which the grid does not bind
+  if (!desc_.instanceBatches.empty()) {
     return;
   }
 
-  if (!desc_.meshNames.empty() &&
-      std::find(desc_.meshNames.begin(), desc_.meshNames.end(),
-                mesh_grid_name_) == desc_.meshNames.end()) {
+  if (!mesh_handles_.empty() && mesh_grid_draw_ >= mesh_handles_.size()) {
     return;
   }
 
-  auto mesh = scene_.getMesh(mesh_grid_name_);
-  if (!mesh || !mesh->isValid()) {
+  const auto *mesh = scene_.mesh(mesh_grid_mesh_);
+  if (mesh == nullptr || !mesh->isValid()) {
     return;
   }
 
@@ -559,6 +1085,9 @@ void RasterPass::recordSelectedMeshGrid(
 
   executor_.bindPipeline(mesh_grid_pipeline_->pipeline(),
                          mesh_grid_pipeline_->layout(), sets);
+  bindBindlessTable(mesh_grid_pipeline_->layout());
+  bindDrawData(mesh_grid_pipeline_->layout(),
+               mesh_grid_draw_ < mesh_handles_.size() ? mesh_grid_draw_ : 0);
   executor_.drawIndexed(vertexBuffer->get(), *mesh_grid_index_buffer_);
 }
 
@@ -14,6 +14,11 @@ RenderPassSource::RenderPassSource(FullscreenPass &source)
 RenderPassSource::RenderPassSource(FeedbackFullscreenPass &source)
     : source_(std::ref(source)) {}
 
+auto RenderPassSource::pass() const -> const Pass & {
+  return std::visit(
+      [](auto source) -> const Pass & { return source.get(); }, source_);
+}
+
 auto RenderPassSource::target() -> OffscreenTarget & { return target(0); }
 
 auto RenderPassSource::target() const -> const OffscreenTarget & {
@@ -28,17 +28,12 @@ void UiPass::create() {
   target_->update(SwapchainTargetDesc{});
 
   render_pass_ = std::make_unique<pipeline::RenderPass>(device_);
-  render_pass_->update(pipeline::RenderPassDesc::makeSwapchain(
+  auto renderPassDesc = pipeline::RenderPassDesc::makeSwapchain(
       target_->format(), target_->depth() ? target_->depth()->desc().format
-                                          : VK_FORMAT_UNDEFINED));
+                                          : VK_FORMAT_UNDEFINED);
+  render_pass_->update(renderPassDesc.externalLayouts());
 
-  FramebufferDesc framebufferDesc{.width = target_->width(),
-                                  .height = target_->height(),
-                                  .layers = 1,
-                                  .attachments = target_->attachmentViews()};
-
-  framebuffers_ = std::make_unique<FramebufferSet>(device_, *render_pass_);
-  framebuffers_->update(framebufferDesc);
+  createFramebuffers();
 
   descriptor_pool_ = std::make_unique<pipeline::DescriptorPool>(device_);
   descriptor_pool_->update({
@@ -60,6 +55,20 @@ void UiPass::destroy() {
   target_.reset();
 }
 
+void UiPass::resize() {
+  if (!target_ || !render_pass_ || !ui_) {
+    create();
+    return;
+  }
+
+  // imgui keeps its pipeline and fonts; only the swapchain images and the
+  // viewport texture moved
+  framebuffers_.reset();
+  target_->create();
+  createFramebuffers();
+  ui_->rebindViewport(source_.target());
+}
+
 void UiPass::record() {
   if (!target_ || !render_pass_ || !framebuffers_ || !ui_) {
     VKR_EXEC_ERROR("UiPass '{}' recorded before create", name());
@@ -79,4 +88,35 @@ void UiPass::record() {
   executor_.endProfileScope();
 }
 
+auto UiPass::imageAccesses() const -> std::vector<ImageAccess> {
+  if (!target_) {
+    return {};
+  }
+
+  std::vector<ImageAccess> accesses{
+      source_.target().sampledAccess(RenderPassInputKind::Color),
+      ImageAccess::colorAttachment(target_->image(executor_.imageIndex()))};
+
+  if (const auto *depth = target_->depth()) {
+    accesses.push_back(
+        ImageAccess::depthAttachment(depth->image(), depth->desc().format));
+  }
+
+  return accesses;
+}
+
+auto UiPass::sampledPasses() const -> std::vector<const Pass *> {
+  return {&source_.pass()};
+}
+
+void UiPass::createFramebuffers() {
+  FramebufferDesc framebufferDesc{.width = target_->width(),
+                                  .height = target_->height(),
+                                  .layers = 1,
+                                  .attachments = target_->attachmentViews()};
+
+  framebuffers_ = std::make_unique<FramebufferSet>(device_, *render_pass_);
+  framebuffers_->update(framebufferDesc);
+}
+
 } // namespace vkr::exec
@@ -0,0 +1,134 @@
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "vkr/exec/render/readback.hh"
+#include "vkr/logger.hh"
+#include "vkr/resource/buffer/buffer.hh"
+#include <cstring>
+#include <stb_image_write.h>
+#include <utility>
+
+namespace vkr::exec {
+namespace {
+
+auto isBgra(VkFormat format) noexcept -> bool {
+  return format == VK_FORMAT_B8G8R8A8_UNORM ||
+         format == VK_FORMAT_B8G8R8A8_SRGB;
+}
+
+auto isRgba(VkFormat format) noexcept -> bool {
+  return format == VK_FORMAT_R8G8B8A8_UNORM ||
+         format == VK_FORMAT_R8G8B8A8_SRGB;
+}
+
+auto layoutBarrier(VkImage image, VkImageLayout oldLayout,
+                   VkImageLayout newLayout, VkAccessFlags srcAccess,
+                   VkAccessFlags dstAccess) -> VkImageMemoryBarrier {
+  VkImageMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = image;
+  barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+  barrier.srcAccessMask = srcAccess;
+  barrier.dstAccessMask = dstAccess;
+  return barrier;
+}
+
+} // namespace
+
+auto readbackImage(const core::Device &device,
+                   const core::CommandPool &commandPool, VkImage image,
+                   VkImageLayout layout, VkFormat format, VkExtent2D extent)
+    -> ImageReadback {
+  if (image == VK_NULL_HANDLE || extent.width == 0 || extent.height == 0) {
+    VKR_EXEC_ERROR("Cannot read back an invalid image");
+  }
+
+  if (!isRgba(format) && !isBgra(format)) {
+    VKR_EXEC_ERROR("Image readback does not support format {}",
+                   static_cast<int>(format));
+  }
+
+  const VkDeviceSize byteSize =
+      static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+  resource::Buffer staging(device);
+  staging.update(byteSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+  auto &uploader = commandPool.uploader();
+  VkCommandBuffer commandBuffer = uploader.commandBuffer();
+
+  const bool transition = layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  if (transition) {
+    const auto barrier =
+        layoutBarrier(image, layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                      VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                         nullptr, 1, &barrier);
+  }
+
+  VkBufferImageCopy region{};
+  region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  region.imageExtent = {extent.width, extent.height, 1};
+  vkCmdCopyImageToBuffer(commandBuffer, image,
+                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                         staging.buffer(), 1, &region);
+
+  if (transition) {
+    const auto barrier =
+        layoutBarrier(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, layout,
+                      VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_MEMORY_READ_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0,
+                         nullptr, 1, &barrier);
+  }
+
+  uploader.wait(uploader.flush());
+
+  ImageReadback readback{};
+  readback.width = extent.width;
+  readback.height = extent.height;
+  readback.format = format;
+  readback.pixels.resize(static_cast<size_t>(byteSize));
+  std::memcpy(readback.pixels.data(), staging.map(),
+              readback.pixels.size());
+
+  if (isBgra(format)) {
+    for (size_t i = 0; i < readback.pixels.size(); i += 4) {
+      std::swap(readback.pixels[i], readback.pixels[i + 2]);
+    }
+  }
+
+  return readback;
+}
+
+auto writePng(const std::filesystem::path &path, const ImageReadback &image)
+    -> bool {
+  if (!image.isValid()) {
+    VKR_EXEC_WARN("Cannot write invalid readback to {}", path.string());
+    return false;
+  }
+
+  if (path.has_parent_path()) {
+    std::error_code ec{};
+    std::filesystem::create_directories(path.parent_path(), ec);
+  }
+
+  const int stride = static_cast<int>(image.width) * 4;
+  if (stbi_write_png(path.string().c_str(), static_cast<int>(image.width),
+                     static_cast<int>(image.height), 4, image.pixels.data(),
+                     stride) == 0) {
+    VKR_EXEC_WARN("Failed to write PNG {}", path.string());
+    return false;
+  }
+
+  VKR_EXEC_INFO("Wrote {}x{} capture to {}", image.width, image.height,
+                path.string());
+  return true;
+}
+
+} // namespace vkr::exec
@@ -11,6 +11,11 @@ FrameSync::FrameSync(const core::Device &device,
     VKR_EXEC_ERROR("FrameSync requires initialized command buffers");
   }
 
+  if (device_.timelineSemaphores()) {
+    timeline_ = &device_.timeline(device_.graphicsQueue());
+    frame_values_.assign(framesInFlight(), 0);
+  }
+
   create();
 }
 
@@ -22,12 +27,7 @@ void FrameSync::recreate() {
 }
 
 void FrameSync::create() {
-  uint32_t imageCount = 0;
-
-  if (vkGetSwapchainImagesKHR(device_.device(), swapchain_.swapchain(),
-                              &imageCount, nullptr) != VK_SUCCESS) {
-    VKR_EXEC_ERROR("failed to query swapchain image count for sync objects");
-  }
+  const auto imageCount = static_cast<uint32_t>(swapchain_.images().size());
 
   if (imageCount == 0) {
     VKR_EXEC_ERROR("swapchain has no images for sync objects");
@@ -36,7 +36,7 @@ void FrameSync::create() {
   const uint32_t frameCount = framesInFlight();
   vk_image_available_semaphores_.resize(frameCount);
   vk_render_finished_semaphores_.resize(imageCount);
-  vk_in_flight_fences_.resize(frameCount);
+  vk_in_flight_fences_.resize(timelineEnabled() ? 0 : frameCount);
 
   VkSemaphoreCreateInfo semaphoreInfo{};
   semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -51,6 +51,10 @@ void FrameSync::create() {
       VKR_EXEC_ERROR("failed to create image available semaphore {}", i);
     }
 
+    if (timelineEnabled()) {
+      continue;
+    }
+
     if (vkCreateFence(device_.device(), &fenceInfo, nullptr,
                       &vk_in_flight_fences_[i]) != VK_SUCCESS) {
       VKR_EXEC_ERROR("failed to create in-flight fence {}", i);
@@ -112,6 +116,10 @@ auto FrameSync::renderFinishedSemaphore(uint32_t imageIndex) const
 }
 
 auto FrameSync::inFlightFence(uint32_t frameIndex) const -> VkFence {
+  if (timelineEnabled()) {
+    return VK_NULL_HANDLE;
+  }
+
   if (frameIndex >= vk_in_flight_fences_.size()) {
     VKR_EXEC_ERROR("in-flight fence frame index {} out of range, count {}",
                    frameIndex, vk_in_flight_fences_.size());
@@ -120,13 +128,54 @@ auto FrameSync::inFlightFence(uint32_t frameIndex) const -> VkFence {
   return vk_in_flight_fences_[frameIndex];
 }
 
+auto FrameSync::timeline() const -> core::TimelineSemaphore & {
+  if (!timelineEnabled()) {
+    VKR_EXEC_ERROR("FrameSync is not using a timeline semaphore");
+  }
+
+  return *timeline_;
+}
+
+auto FrameSync::signalFrame(uint32_t frameIndex) -> core::TimelinePoint {
+  if (!timelineEnabled()) {
+    return {};
+  }
+
+  if (frameIndex >= frame_values_.size()) {
+    VKR_EXEC_ERROR("timeline frame index {} out of range, count {}",
+                   frameIndex, frame_values_.size());
+  }
+
+  frame_values_[frameIndex] = timeline_->next();
+  return timeline_->point(frame_values_[frameIndex]);
+}
+
+auto FrameSync::isFrameComplete(uint32_t frameIndex) const -> bool {
+  if (timelineEnabled()) {
+    return timeline_->reached(frame_values_.at(frameIndex));
+  }
+
+  return vkGetFenceStatus(device_.device(), inFlightFence(frameIndex)) ==
+         VK_SUCCESS;
+}
+
 void FrameSync::waitForFrame(uint32_t frameIndex) const {
+  if (timelineEnabled()) {
+    timeline_->wait(frame_values_.at(frameIndex));
+    return;
+  }
+
   VkFence fence = inFlightFence(frameIndex);
 
   vkWaitForFences(device_.device(), 1, &fence, VK_TRUE, UINT64_MAX);
 }
 
 void FrameSync::resetFrame(uint32_t frameIndex) const {
+  // timeline values only grow, there is nothing to reset
+  if (timelineEnabled()) {
+    return;
+  }
+
   VkFence fence = inFlightFence(frameIndex);
 
   vkResetFences(device_.device(), 1, &fence);
@@ -121,4 +121,65 @@ auto OffscreenTarget::attachmentViews() const -> std::vector<VkImageView> {
   return views;
 }
 
+auto OffscreenTarget::images() const -> std::vector<VkImage> {
+  std::vector<VkImage> images{};
+  images.reserve((color_ ? 1U : 0U) + (depth_ ? 1U : 0U));
+
+  if (color_) {
+    images.push_back(color_->image());
+  }
+
+  if (depth_) {
+    images.push_back(depth_->image());
+  }
+
+  return images;
+}
+
+auto OffscreenTarget::attachmentAccesses() const -> std::vector<ImageAccess> {
+  std::vector<ImageAccess> accesses{};
+  accesses.reserve((color_ ? 1U : 0U) + (depth_ ? 1U : 0U));
+
+  if (color_) {
+    accesses.push_back(ImageAccess::colorAttachment(color_->image()));
+  }
+
+  if (depth_) {
+    accesses.push_back(
+        ImageAccess::depthAttachment(depth_->image(), depth_->desc().format));
+  }
+
+  return accesses;
+}
+
+auto OffscreenTarget::sampledAccess(RenderPassInputKind kind) const
+    -> ImageAccess {
+  switch (kind) {
+  case RenderPassInputKind::Color:
+    if (!color_) {
+      VKR_EXEC_ERROR("Offscreen target has no color attachment to sample");
+    }
+
+    return ImageAccess::sampled(
+        color_->image(),
+        color_->desc().finalLayout == VK_IMAGE_LAYOUT_UNDEFINED
+            ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            : color_->desc().finalLayout);
+
+  case RenderPassInputKind::Depth:
+    if (!depth_) {
+      VKR_EXEC_ERROR("Offscreen target has no depth attachment to sample");
+    }
+
+    return ImageAccess::sampled(
+        depth_->image(),
+        depth_->desc().finalLayout == VK_IMAGE_LAYOUT_UNDEFINED
+            ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+            : depth_->desc().finalLayout,
+        depthAspectMask(depth_->desc().format));
+  }
+
+  VKR_EXEC_ERROR("Offscreen target sampled with unknown input kind");
+}
+
 } // namespace vkr::exec
@@ -13,22 +13,15 @@ SwapchainTarget::~SwapchainTarget() { destory(); }
 void SwapchainTarget::create() {
   destory();
 
-  if (swapchain_.swapchain() == VK_NULL_HANDLE) {
+  if (!swapchain_.headless() && swapchain_.swapchain() == VK_NULL_HANDLE) {
     VKR_RES_ERROR("SwapchainTarget has null swapchain");
   }
 
-  uint32_t imageCount = 0;
-  vkGetSwapchainImagesKHR(device_.device(), swapchain_.swapchain(), &imageCount,
-                          nullptr);
-
-  if (imageCount == 0) {
+  if (swapchain_.images().empty()) {
     VKR_RES_ERROR("SwapchainTarget has no swapchain images");
   }
 
-  vk_color_images_.resize(imageCount);
-
-  vkGetSwapchainImagesKHR(device_.device(), swapchain_.swapchain(), &imageCount,
-                          vk_color_images_.data());
+  vk_color_images_ = swapchain_.images();
 
   color_image_views_.reserve(vk_color_images_.size());
 
@@ -1,5 +1,7 @@
 #include "vkr/pipeline/compute_pipeline.hh"
 #include "vkr/logger.hh"
+#include <chrono>
+#include <exception>
 
 namespace vkr::pipeline {
 
@@ -9,109 +11,225 @@ ComputePipeline::ComputePipeline(const core::Device &device)
 ComputePipeline::~ComputePipeline() { destroy(); }
 
 void ComputePipeline::destroy() {
-  if (vk_compute_pipeline_ != VK_NULL_HANDLE ||
-      vk_pipeline_layout_ != VK_NULL_HANDLE || !retired_pipelines_.empty()) {
-    vkDeviceWaitIdle(device_.device());
+  if (pending_build_.valid()) {
+    auto stale = pending_build_.get();
+    discard(stale);
   }
+  queued_build_.reset();
 
-  if (vk_compute_pipeline_ != VK_NULL_HANDLE) {
-    vkDestroyPipeline(device_.device(), vk_compute_pipeline_, nullptr);
-    vk_compute_pipeline_ = VK_NULL_HANDLE;
+  retire(vk_compute_pipeline_, vk_pipeline_layout_);
+  vk_compute_pipeline_ = VK_NULL_HANDLE;
+  vk_pipeline_layout_ = VK_NULL_HANDLE;
+  shader_module_.reset();
+}
+
+auto ComputePipeline::update(const ComputePipelineDesc &desc) -> bool {
+  auto next = build(desc);
+  next.request = ++next_request_;
+  commit(std::move(next));
+  return true;
+}
+
+auto ComputePipeline::updateAsync(const ComputePipelineDesc &desc)
+    -> uint64_t {
+  QueuedBuild request{.request = ++next_request_, .desc = desc};
+
+  if (pending_build_.valid()) {
+    queued_build_ = std::move(request);
+  } else {
+    launch(std::move(request));
   }
 
-  if (vk_pipeline_layout_ != VK_NULL_HANDLE) {
-    vkDestroyPipelineLayout(device_.device(), vk_pipeline_layout_, nullptr);
-    vk_pipeline_layout_ = VK_NULL_HANDLE;
+  return next_request_;
+}
+
+auto ComputePipeline::commitPending() -> bool {
+  if (!pending_build_.valid() ||
+      pending_build_.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    return false;
   }
 
-  for (const auto &retired : retired_pipelines_) {
-    if (retired.pipeline != VK_NULL_HANDLE) {
-      vkDestroyPipeline(device_.device(), retired.pipeline, nullptr);
-    }
+  auto next = pending_build_.get();
 
-    if (retired.layout != VK_NULL_HANDLE) {
-      vkDestroyPipelineLayout(device_.device(), retired.layout, nullptr);
+  if (queued_build_ || next.request < last_build_.request) {
+    discard(next);
+
+    if (queued_build_) {
+      auto request = std::move(*queued_build_);
+      queued_build_.reset();
+      launch(std::move(request));
     }
+
+    return false;
   }
 
-  retired_pipelines_.clear();
-  shader_module_.reset();
+  if (!next.error.empty()) {
+    last_build_ = PipelineBuildStatus{
+        .request = next.request,
+        .ok = false,
+        .error = next.error,
+        .milliseconds = next.milliseconds,
+    };
+    VKR_PIPE_WARN("Compute pipeline '{}' rebuild failed; keeping revision "
+                  "{}: {}",
+                  next.desc.name, revision_, next.error);
+    discard(next);
+    return false;
+  }
+
+  commit(std::move(next));
+  return true;
 }
 
-auto ComputePipeline::update(const ComputePipelineDesc &desc) -> bool {
-  desc_ = desc;
+auto ComputePipeline::waitPending() -> bool {
+  bool committed = false;
+
+  while (pending_build_.valid()) {
+    pending_build_.wait();
+    committed = commitPending() || committed;
+  }
+
+  return committed;
+}
 
-  if (!desc_.isValid()) {
+auto ComputePipeline::build(const ComputePipelineDesc &desc) const -> Build {
+  Build next{.desc = desc};
+
+  if (!next.desc.isValid()) {
     VKR_PIPE_ERROR("Invalid compute pipeline descriptor");
   }
 
-  auto shaderDesc = desc_.shader;
-  shaderDesc.setEntryPoint(desc_.entryPoint);
+  auto shaderDesc = next.desc.shader;
+  shaderDesc.setEntryPoint(next.desc.entryPoint);
 
-  auto nextShaderModule = std::make_unique<resource::ShaderModule>(device_);
-  nextShaderModule->update(shaderDesc);
+  next.shaderModule = std::make_unique<resource::ShaderModule>(device_);
+  next.shaderModule->update(shaderDesc);
 
-  if (!nextShaderModule->valid()) {
+  if (!next.shaderModule->valid()) {
     VKR_PIPE_ERROR("Failed to create compute shader module for pipeline '{}'",
-                   desc_.name);
+                   next.desc.name);
   }
 
   VkPipelineShaderStageCreateInfo shaderStage{};
   shaderStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
   shaderStage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-  shaderStage.module = nextShaderModule->module();
-  shaderStage.pName = desc_.entryPoint.c_str();
+  shaderStage.module = next.shaderModule->module();
+  shaderStage.pName = next.desc.entryPoint.c_str();
 
   VkPipelineLayoutCreateInfo layoutInfo{};
   layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
   layoutInfo.setLayoutCount =
-      static_cast<uint32_t>(desc_.layout.setLayouts.size());
-  layoutInfo.pSetLayouts = desc_.layout.setLayouts.empty()
+      static_cast<uint32_t>(next.desc.layout.setLayouts.size());
+  layoutInfo.pSetLayouts = next.desc.layout.setLayouts.empty()
                                ? nullptr
-                               : desc_.layout.setLayouts.data();
+                               : next.desc.layout.setLayouts.data();
   layoutInfo.pushConstantRangeCount =
-      static_cast<uint32_t>(desc_.layout.pushConstants.size());
-  layoutInfo.pPushConstantRanges = desc_.layout.pushConstants.empty()
-                                       ? nullptr
-                                       : desc_.layout.pushConstants.data();
+      static_cast<uint32_t>(next.desc.layout.pushConstants.size());
+  layoutInfo.pPushConstantRanges =
+      next.desc.layout.pushConstants.empty()
+          ? nullptr
+          : next.desc.layout.pushConstants.data();
 
-  VkPipelineLayout nextLayout{VK_NULL_HANDLE};
   if (vkCreatePipelineLayout(device_.device(), &layoutInfo, nullptr,
-                             &nextLayout) != VK_SUCCESS) {
+                             &next.layout) != VK_SUCCESS) {
     VKR_PIPE_ERROR("Failed to create compute pipeline layout for '{}'",
-                   desc_.name);
+                   next.desc.name);
   }
 
   VkComputePipelineCreateInfo pipelineInfo{};
   pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
   pipelineInfo.stage = shaderStage;
-  pipelineInfo.layout = nextLayout;
+  pipelineInfo.layout = next.layout;
   pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
   pipelineInfo.basePipelineIndex = -1;
 
-  VkPipeline nextPipeline{VK_NULL_HANDLE};
-  if (vkCreateComputePipelines(device_.device(), VK_NULL_HANDLE, 1,
+  const auto start = std::chrono::steady_clock::now();
+  if (vkCreateComputePipelines(device_.device(),
+                               device_.pipelineCache().cache(), 1,
                                &pipelineInfo, nullptr,
-                               &nextPipeline) != VK_SUCCESS) {
-    vkDestroyPipelineLayout(device_.device(), nextLayout, nullptr);
-    VKR_PIPE_ERROR("Failed to create compute pipeline '{}'", desc_.name);
+                               &next.pipeline) != VK_SUCCESS) {
+    vkDestroyPipelineLayout(device_.device(), next.layout, nullptr);
+    VKR_PIPE_ERROR("Failed to create compute pipeline '{}'", next.desc.name);
   }
+  const auto end = std::chrono::steady_clock::now();
+  next.milliseconds =
+      std::chrono::duration<double, std::milli>(end - start).count();
+  device_.pipelineCache().recordCreation(next.milliseconds);
 
-  if (vk_compute_pipeline_ != VK_NULL_HANDLE ||
-      vk_pipeline_layout_ != VK_NULL_HANDLE) {
-    RetiredPipeline retired{};
-    retired.pipeline = vk_compute_pipeline_;
-    retired.layout = vk_pipeline_layout_;
-    retired_pipelines_.push_back(retired);
-  }
+  return next;
+}
+
+void ComputePipeline::launch(QueuedBuild request) {
+  pending_build_ = std::async(
+      std::launch::async, [this, request = std::move(request)]() -> Build {
+        const auto start = std::chrono::steady_clock::now();
+        Build next{};
+
+        try {
+          next = build(request.desc);
+        } catch (const std::exception &e) {
+          next.desc = request.desc;
+          next.error = e.what();
+        }
+
+        next.request = request.request;
+        next.milliseconds = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+        return next;
+      });
+}
+
+void ComputePipeline::commit(Build &&next) {
+  retire(vk_compute_pipeline_, vk_pipeline_layout_);
 
-  shader_module_ = std::move(nextShaderModule);
-  vk_pipeline_layout_ = nextLayout;
-  vk_compute_pipeline_ = nextPipeline;
+  desc_ = std::move(next.desc);
+  shader_module_ = std::move(next.shaderModule);
+  vk_pipeline_layout_ = next.layout;
+  vk_compute_pipeline_ = next.pipeline;
   ++revision_;
 
+  last_build_ = PipelineBuildStatus{
+      .request = next.request,
+      .ok = true,
+      .error = {},
+      .milliseconds = next.milliseconds,
+  };
+
   VKR_PIPE_INFO("Compute pipeline '{}' created", desc_.name);
-  return true;
+}
+
+void ComputePipeline::discard(Build &next) const {
+  if (next.pipeline != VK_NULL_HANDLE) {
+    vkDestroyPipeline(device_.device(), next.pipeline, nullptr);
+    next.pipeline = VK_NULL_HANDLE;
+  }
+
+  if (next.layout != VK_NULL_HANDLE) {
+    vkDestroyPipelineLayout(device_.device(), next.layout, nullptr);
+    next.layout = VK_NULL_HANDLE;
+  }
+
+  next.shaderModule.reset();
+}
+
+void ComputePipeline::retire(VkPipeline pipeline,
+                             VkPipelineLayout layout) const {
+  if (pipeline == VK_NULL_HANDLE && layout == VK_NULL_HANDLE) {
+    return;
+  }
+
+  // frames still in flight may have recorded the old pipeline
+  device_.deletionQueue().push([device = device_.device(), pipeline, layout] {
+    if (pipeline != VK_NULL_HANDLE) {
+      vkDestroyPipeline(device, pipeline, nullptr);
+    }
+
+    if (layout != VK_NULL_HANDLE) {
+      vkDestroyPipelineLayout(device, layout, nullptr);
+    }
+  });
 }
 
 } // namespace vkr::pipeline
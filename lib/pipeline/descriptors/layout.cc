@@ -24,9 +24,26 @@ void DescriptorSetLayout::create() {
 
   VkDescriptorSetLayoutCreateInfo layoutInfo{};
   layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.flags = desc_.flags;
   layoutInfo.bindingCount = static_cast<uint32_t>(vkBindings.size());
   layoutInfo.pBindings = vkBindings.empty() ? nullptr : vkBindings.data();
 
+  VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo{};
+  bindingFlagsInfo.sType =
+      VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+  if (!desc_.bindingFlags.empty()) {
+    if (desc_.bindingFlags.size() != vkBindings.size()) {
+      VKR_PIPE_ERROR("Descriptor set layout has {} binding flags for {} "
+                     "bindings",
+                     desc_.bindingFlags.size(), vkBindings.size());
+    }
+
+    bindingFlagsInfo.bindingCount =
+        static_cast<uint32_t>(desc_.bindingFlags.size());
+    bindingFlagsInfo.pBindingFlags = desc_.bindingFlags.data();
+    layoutInfo.pNext = &bindingFlagsInfo;
+  }
+
   if (vkCreateDescriptorSetLayout(device_.device(), &layoutInfo, nullptr,
                                   &layout_) != VK_SUCCESS) {
     VKR_PIPE_ERROR("Failed to create descriptor set layout.");
@@ -53,7 +53,10 @@ void DescriptorPool::create() {
 
 void DescriptorPool::destroy() {
   if (pool_ != VK_NULL_HANDLE) {
-    vkDestroyDescriptorPool(device_.device(), pool_, nullptr);
+    // sets allocated from the pool may still be bound by frames in flight
+    device_.deletionQueue().push([device = device_.device(), pool = pool_] {
+      vkDestroyDescriptorPool(device, pool, nullptr);
+    });
     pool_ = VK_NULL_HANDLE;
   }
 
@@ -1,5 +1,6 @@
 #include "vkr/pipeline/descriptors/set.hh"
 #include "vkr/logger.hh"
+#include <utility>
 
 namespace vkr::pipeline {
 
@@ -40,6 +41,17 @@ void DescriptorSets::update(const DescriptorSetsDesc &desc) {
   create();
 }
 
+void DescriptorSets::rewrite(std::vector<DescriptorSetWriteDesc> writes) {
+  desc_.writes = std::move(writes);
+
+  if (sets_.empty()) {
+    create();
+    return;
+  }
+
+  updateDescriptors();
+}
+
 void DescriptorSets::allocateSets() {
   std::vector<VkDescriptorSetLayout> layouts(desc_.setCount, desc_.layout);
 
@@ -62,14 +74,25 @@ void DescriptorSets::allocateSets() {
   VKR_PIPE_INFO("Allocated {} descriptor sets", sets_.size());
 }
 
-void DescriptorSets::updateDescriptors() {
-  if (desc_.writes.empty()) {
+void DescriptorSets::write(const std::vector<DescriptorSetWriteDesc> &writes) {
+  if (sets_.empty()) {
+    VKR_PIPE_ERROR("Descriptor sets written before allocation");
+  }
+
+  updateDescriptors(writes);
+}
+
+void DescriptorSets::updateDescriptors() { updateDescriptors(desc_.writes); }
+
+void DescriptorSets::updateDescriptors(
+    const std::vector<DescriptorSetWriteDesc> &setWrites) {
+  if (setWrites.empty()) {
     return;
   }
 
   std::vector<VkWriteDescriptorSet> writes{};
 
-  for (const auto &setWrite : desc_.writes) {
+  for (const auto &setWrite : setWrites) {
     if (setWrite.setIndex >= sets_.size()) {
       VKR_PIPE_ERROR("Descriptor set write index {} out of range, count {}",
                      setWrite.setIndex, sets_.size());
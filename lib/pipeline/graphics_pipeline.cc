@@ -1,6 +1,8 @@
 #include "vkr/pipeline/graphics_pipeline.hh"
 #include "vkr/logger.hh"
 #include "vkr/pipeline/render_pass.hh"
+#include <chrono>
+#include <exception>
 
 namespace vkr::pipeline {
 
@@ -11,56 +13,111 @@ GraphicsPipeline::GraphicsPipeline(const core::Device &device,
 GraphicsPipeline::~GraphicsPipeline() { destroy(); }
 
 void GraphicsPipeline::destroy() {
-  if (vk_graphics_pipeline_ != VK_NULL_HANDLE ||
-      vk_pipeline_layout_ != VK_NULL_HANDLE || !retired_pipelines_.empty()) {
-    vkDeviceWaitIdle(device_.device());
+  if (pending_build_.valid()) {
+    auto stale = pending_build_.get();
+    discard(stale);
   }
+  queued_build_.reset();
 
-  if (vk_graphics_pipeline_ != VK_NULL_HANDLE) {
-    vkDestroyPipeline(device_.device(), vk_graphics_pipeline_, nullptr);
-    vk_graphics_pipeline_ = VK_NULL_HANDLE;
+  retire(vk_graphics_pipeline_, vk_pipeline_layout_);
+  vk_graphics_pipeline_ = VK_NULL_HANDLE;
+  vk_pipeline_layout_ = VK_NULL_HANDLE;
+  shader_modules_.clear();
+}
+
+auto GraphicsPipeline::update(const GraphicsPipelineDesc &desc) -> bool {
+  auto next = build(desc);
+  next.request = ++next_request_;
+  commit(std::move(next));
+  return true;
+}
+
+auto GraphicsPipeline::updateAsync(const GraphicsPipelineDesc &desc)
+    -> uint64_t {
+  QueuedBuild request{.request = ++next_request_, .desc = desc};
+
+  if (pending_build_.valid()) {
+    queued_build_ = std::move(request);
+  } else {
+    launch(std::move(request));
   }
 
-  if (vk_pipeline_layout_ != VK_NULL_HANDLE) {
-    vkDestroyPipelineLayout(device_.device(), vk_pipeline_layout_, nullptr);
-    vk_pipeline_layout_ = VK_NULL_HANDLE;
+  return next_request_;
+}
+
+auto GraphicsPipeline::commitPending() -> bool {
+  if (!pending_build_.valid() ||
+      pending_build_.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    return false;
   }
 
-  for (const auto &retired : retired_pipelines_) {
-    if (retired.pipeline != VK_NULL_HANDLE) {
-      vkDestroyPipeline(device_.device(), retired.pipeline, nullptr);
-    }
+  auto next = pending_build_.get();
+
+  // a newer request arrived while this one was building, or a synchronous
+  // update() already replaced the pipeline
+  if (queued_build_ || next.request < last_build_.request) {
+    discard(next);
 
-    if (retired.layout != VK_NULL_HANDLE) {
-      vkDestroyPipelineLayout(device_.device(), retired.layout, nullptr);
+    if (queued_build_) {
+      auto request = std::move(*queued_build_);
+      queued_build_.reset();
+      launch(std::move(request));
     }
+
+    return false;
   }
 
-  retired_pipelines_.clear();
-  shader_modules_.clear();
+  if (!next.error.empty()) {
+    last_build_ = PipelineBuildStatus{
+        .request = next.request,
+        .ok = false,
+        .error = next.error,
+        .milliseconds = next.milliseconds,
+    };
+    VKR_PIPE_WARN("Graphics pipeline '{}' rebuild failed; keeping revision "
+                  "{}: {}",
+                  next.desc.name, revision_, next.error);
+    discard(next);
+    return false;
+  }
+
+  commit(std::move(next));
+  return true;
 }
 
-auto GraphicsPipeline::update(const GraphicsPipelineDesc &desc) -> bool {
-  desc_ = desc;
+auto GraphicsPipeline::waitPending() -> bool {
+  bool committed = false;
+
+  while (pending_build_.valid()) {
+    pending_build_.wait();
+    committed = commitPending() || committed;
+  }
+
+  return committed;
+}
+
+auto GraphicsPipeline::build(const GraphicsPipelineDesc &desc) const
+    -> Build {
+  Build next{.desc = desc};
 
   if (render_pass_.renderPass() == VK_NULL_HANDLE) {
     VKR_PIPE_ERROR("Graphics pipeline '{}' requires a valid render pass",
-                   desc_.name);
+                   next.desc.name);
   }
 
-  std::vector<std::unique_ptr<resource::ShaderModule>> nextShaderModules{};
   std::vector<VkPipelineShaderStageCreateInfo> shaderStages{};
 
-  nextShaderModules.reserve(desc_.shaders.size());
-  shaderStages.reserve(desc_.shaders.size());
+  next.shaderModules.reserve(next.desc.shaders.size());
+  shaderStages.reserve(next.desc.shaders.size());
 
-  for (const auto &shader : desc_.shaders) {
+  for (const auto &shader : next.desc.shaders) {
     auto module = std::make_unique<resource::ShaderModule>(device_);
     module->update(shader.module);
 
     if (!module->valid()) {
       VKR_PIPE_ERROR("Failed to create shader module for pipeline '{}'",
-                     desc_.name);
+                     next.desc.name);
     }
 
     VkPipelineShaderStageCreateInfo stage{};
@@ -70,83 +127,148 @@ auto GraphicsPipeline::update(const GraphicsPipelineDesc &desc) -> bool {
     stage.pName = shader.entryPoint.c_str();
 
     shaderStages.push_back(stage);
-    nextShaderModules.push_back(std::move(module));
+    next.shaderModules.push_back(std::move(module));
   }
 
-  auto vertexInput = desc_.vertexInput.createInfo();
-  auto inputAssembly = desc_.inputAssembly.createInfo();
-  auto tessellation = desc_.tessellation.createInfo();
-  auto viewport = desc_.viewport.createInfo();
-  auto rasterization = desc_.rasterization.createInfo();
-  auto multisample = desc_.multisample.createInfo();
-  auto depthStencil = desc_.depthStencil.createInfo();
-  auto colorBlend = desc_.colorBlend.createInfo();
-  auto dynamicState = desc_.dynamicState.createInfo();
+  auto vertexInput = next.desc.vertexInput.createInfo();
+  auto inputAssembly = next.desc.inputAssembly.createInfo();
+  auto tessellation = next.desc.tessellation.createInfo();
+  auto viewport = next.desc.viewport.createInfo();
+  auto rasterization = next.desc.rasterization.createInfo();
+  auto multisample = next.desc.multisample.createInfo();
+  auto depthStencil = next.desc.depthStencil.createInfo();
+  auto colorBlend = next.desc.colorBlend.createInfo();
+  auto dynamicState = next.desc.dynamicState.createInfo();
 
   VkPipelineLayoutCreateInfo layoutInfo{};
   layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
   layoutInfo.setLayoutCount =
-      static_cast<uint32_t>(desc_.layout.setLayouts.size());
-  layoutInfo.pSetLayouts = desc_.layout.setLayouts.empty()
+      static_cast<uint32_t>(next.desc.layout.setLayouts.size());
+  layoutInfo.pSetLayouts = next.desc.layout.setLayouts.empty()
                                ? nullptr
-                               : desc_.layout.setLayouts.data();
+                               : next.desc.layout.setLayouts.data();
   layoutInfo.pushConstantRangeCount =
-      static_cast<uint32_t>(desc_.layout.pushConstants.size());
-  layoutInfo.pPushConstantRanges = desc_.layout.pushConstants.empty()
-                                       ? nullptr
-                                       : desc_.layout.pushConstants.data();
+      static_cast<uint32_t>(next.desc.layout.pushConstants.size());
+  layoutInfo.pPushConstantRanges =
+      next.desc.layout.pushConstants.empty()
+          ? nullptr
+          : next.desc.layout.pushConstants.data();
 
-  VkPipelineLayout nextLayout = VK_NULL_HANDLE;
   if (vkCreatePipelineLayout(device_.device(), &layoutInfo, nullptr,
-                             &nextLayout) != VK_SUCCESS) {
+                             &next.layout) != VK_SUCCESS) {
     VKR_PIPE_ERROR("Failed to create graphics pipeline layout for '{}'",
-                   desc.name);
+                   next.desc.name);
   }
 
   VkGraphicsPipelineCreateInfo pipelineInfo{};
   pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-  pipelineInfo.flags = desc_.flags;
+  pipelineInfo.flags = next.desc.flags;
   pipelineInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
   pipelineInfo.pStages = shaderStages.data();
   pipelineInfo.pVertexInputState = &vertexInput;
   pipelineInfo.pInputAssemblyState = &inputAssembly;
   pipelineInfo.pTessellationState =
-      desc_.tessellation.enabled() ? &tessellation : nullptr;
+      next.desc.tessellation.enabled() ? &tessellation : nullptr;
   pipelineInfo.pViewportState = &viewport;
   pipelineInfo.pRasterizationState = &rasterization;
   pipelineInfo.pMultisampleState = &multisample;
   pipelineInfo.pDepthStencilState = &depthStencil;
   pipelineInfo.pColorBlendState = &colorBlend;
   pipelineInfo.pDynamicState = &dynamicState;
-  pipelineInfo.layout = nextLayout;
+  pipelineInfo.layout = next.layout;
   pipelineInfo.renderPass = render_pass_.renderPass();
-  pipelineInfo.subpass = desc_.subpass;
-  pipelineInfo.basePipelineHandle = desc_.basePipeline;
-  pipelineInfo.basePipelineIndex = desc_.basePipelineIndex;
+  pipelineInfo.subpass = next.desc.subpass;
+  pipelineInfo.basePipelineHandle = next.desc.basePipeline;
+  pipelineInfo.basePipelineIndex = next.desc.basePipelineIndex;
 
-  VkPipeline nextPipeline = VK_NULL_HANDLE;
-  if (vkCreateGraphicsPipelines(device_.device(), VK_NULL_HANDLE, 1,
+  const auto start = std::chrono::steady_clock::now();
+  if (vkCreateGraphicsPipelines(device_.device(),
+                                device_.pipelineCache().cache(), 1,
                                 &pipelineInfo, nullptr,
-                                &nextPipeline) != VK_SUCCESS) {
-    vkDestroyPipelineLayout(device_.device(), nextLayout, nullptr);
-    VKR_PIPE_ERROR("Failed to create graphics pipeline '{}'", desc.name);
+                                &next.pipeline) != VK_SUCCESS) {
+    vkDestroyPipelineLayout(device_.device(), next.layout, nullptr);
+    VKR_PIPE_ERROR("Failed to create graphics pipeline '{}'", next.desc.name);
   }
+  const auto end = std::chrono::steady_clock::now();
+  next.milliseconds =
+      std::chrono::duration<double, std::milli>(end - start).count();
+  device_.pipelineCache().recordCreation(next.milliseconds);
 
-  if (vk_graphics_pipeline_ != VK_NULL_HANDLE ||
-      vk_pipeline_layout_ != VK_NULL_HANDLE) {
-    RetiredPipeline retired{};
-    retired.pipeline = vk_graphics_pipeline_;
-    retired.layout = vk_pipeline_layout_;
-    retired_pipelines_.push_back(retired);
-  }
+  return next;
+}
+
+void GraphicsPipeline::launch(QueuedBuild request) {
+  pending_build_ = std::async(
+      std::launch::async, [this, request = std::move(request)]() -> Build {
+        const auto start = std::chrono::steady_clock::now();
+        Build next{};
+
+        try {
+          next = build(request.desc);
+        } catch (const std::exception &e) {
+          next.desc = request.desc;
+          next.error = e.what();
+        }
+
+        next.request = request.request;
+        next.milliseconds = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+        return next;
+      });
+}
 
-  shader_modules_ = std::move(nextShaderModules);
-  vk_pipeline_layout_ = nextLayout;
-  vk_graphics_pipeline_ = nextPipeline;
+void GraphicsPipeline::commit(Build &&next) {
+  retire(vk_graphics_pipeline_, vk_pipeline_layout_);
+
+  desc_ = std::move(next.desc);
+  shader_modules_ = std::move(next.shaderModules);
+  vk_pipeline_layout_ = next.layout;
+  vk_graphics_pipeline_ = next.pipeline;
   ++revision_;
 
-  VKR_PIPE_INFO("Graphics pipeline '{}' created", desc_.name);
-  return true;
+  last_build_ = PipelineBuildStatus{
+      .request = next.request,
+      .ok = true,
+      .error = {},
+      .milliseconds = next.milliseconds,
+  };
+
+  VKR_PIPE_INFO("Graphics pipeline '{}' created in {:.3f} ms", desc_.name,
+                next.milliseconds);
+}
+
+void GraphicsPipeline::discard(Build &next) const {
+  // never recorded, so nothing in flight can reference it
+  if (next.pipeline != VK_NULL_HANDLE) {
+    vkDestroyPipeline(device_.device(), next.pipeline, nullptr);
+    next.pipeline = VK_NULL_HANDLE;
+  }
+
+  if (next.layout != VK_NULL_HANDLE) {
+    vkDestroyPipelineLayout(device_.device(), next.layout, nullptr);
+    next.layout = VK_NULL_HANDLE;
+  }
+
+  next.shaderModules.clear();
+}
+
+void GraphicsPipeline::retire(VkPipeline pipeline,
+                              VkPipelineLayout layout) const {
+  if (pipeline == VK_NULL_HANDLE && layout == VK_NULL_HANDLE) {
+    return;
+  }
+
+  // frames still in flight may have recorded the old pipeline
+  device_.deletionQueue().push([device = device_.device(), pipeline, layout] {
+    if (pipeline != VK_NULL_HANDLE) {
+      vkDestroyPipeline(device, pipeline, nullptr);
+    }
+
+    if (layout != VK_NULL_HANDLE) {
+      vkDestroyPipelineLayout(device, layout, nullptr);
+    }
+  });
 }
 
 } // namespace vkr::pipeline
@@ -17,10 +17,10 @@ Buffer::~Buffer() { destroy(); }
 
 Buffer::Buffer(Buffer &&other) noexcept
     : device_(other.device_), vk_buffer_(other.vk_buffer_),
-      vk_memory_(other.vk_memory_), size_(other.size_), usage_(other.usage_),
+      allocation_(other.allocation_), size_(other.size_), usage_(other.usage_),
       memory_properties_(other.memory_properties_), mapped_(other.mapped_) {
   other.vk_buffer_ = VK_NULL_HANDLE;
-  other.vk_memory_ = VK_NULL_HANDLE;
+  other.allocation_ = {};
   other.size_ = 0;
   other.usage_ = 0;
   other.memory_properties_ = 0;
@@ -51,21 +51,17 @@ void Buffer::create(VkDeviceSize size, VkBufferUsageFlags usage,
   VkMemoryRequirements memRequirements{};
   vkGetBufferMemoryRequirements(device_.device(), vk_buffer_, &memRequirements);
 
-  VkMemoryAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  allocInfo.allocationSize = memRequirements.size;
-  allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-                                             memory_properties_, device_);
-
-  if (vkAllocateMemory(device_.device(), &allocInfo, nullptr, &vk_memory_) !=
-      VK_SUCCESS) {
+  try {
+    allocation_ = device_.allocator().allocate(
+        memRequirements, memory_properties_, core::MemoryResourceKind::Linear);
+  } catch (...) {
     vkDestroyBuffer(device_.device(), vk_buffer_, nullptr);
     vk_buffer_ = VK_NULL_HANDLE;
     VKR_RES_ERROR("Failed to allocate buffer memory");
   }
 
-  if (vkBindBufferMemory(device_.device(), vk_buffer_, vk_memory_, 0) !=
-      VK_SUCCESS) {
+  if (vkBindBufferMemory(device_.device(), vk_buffer_, allocation_.memory,
+                         allocation_.offset) != VK_SUCCESS) {
     destroy();
     VKR_RES_ERROR("Failed to bind buffer memory");
   }
@@ -80,15 +76,20 @@ void Buffer::update(VkDeviceSize size, VkBufferUsageFlags usage,
 void Buffer::destroy() noexcept {
   unmap();
 
-  if (vk_buffer_ != VK_NULL_HANDLE) {
-    vkDestroyBuffer(device_.device(), vk_buffer_, nullptr);
-    vk_buffer_ = VK_NULL_HANDLE;
+  if (vk_buffer_ != VK_NULL_HANDLE || allocation_.isValid()) {
+    // frames still in flight may read the buffer or its memory
+    device_.deletionQueue().push(
+        [&device = device_, buffer = vk_buffer_,
+         allocation = allocation_]() mutable {
+          if (buffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device.device(), buffer, nullptr);
+          }
+          device.allocator().free(allocation);
+        });
   }
 
-  if (vk_memory_ != VK_NULL_HANDLE) {
-    vkFreeMemory(device_.device(), vk_memory_, nullptr);
-    vk_memory_ = VK_NULL_HANDLE;
-  }
+  vk_buffer_ = VK_NULL_HANDLE;
+  allocation_ = {};
 
   size_ = 0;
   usage_ = 0;
@@ -108,20 +109,21 @@ auto Buffer::map(VkDeviceSize size, VkDeviceSize offset) -> void * {
     return mapped_;
   }
 
-  if (vkMapMemory(device_.device(), vk_memory_, offset, size, 0, &mapped_) !=
-      VK_SUCCESS) {
+  // host-visible blocks stay persistently mapped by the allocator, so mapping
+  // a sub-allocated buffer is just pointer arithmetic
+  if (allocation_.mapped == nullptr) {
     VKR_RES_ERROR("Failed to map buffer memory");
   }
 
+  if (size != VK_WHOLE_SIZE && offset + size > size_) {
+    VKR_RES_ERROR("Buffer map range exceeds buffer size");
+  }
+
+  mapped_ = static_cast<std::byte *>(allocation_.mapped) + offset;
   return mapped_;
 }
 
-void Buffer::unmap() noexcept {
-  if (mapped_ != nullptr) {
-    vkUnmapMemory(device_.device(), vk_memory_);
-    mapped_ = nullptr;
-  }
-}
+void Buffer::unmap() noexcept { mapped_ = nullptr; }
 
 void Buffer::write(const void *data, VkDeviceSize size, VkDeviceSize offset) {
   if (data == nullptr || size == 0) {
@@ -140,17 +142,7 @@ void Buffer::write(const void *data, VkDeviceSize size, VkDeviceSize offset) {
 auto Buffer::findMemoryType(uint32_t typeFilter,
                             VkMemoryPropertyFlags properties,
                             const core::Device &device) -> uint32_t {
-  VkPhysicalDeviceMemoryProperties memProperties{};
-  vkGetPhysicalDeviceMemoryProperties(device.physicalDevice(), &memProperties);
-
-  for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-    if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags &
-                                    properties) == properties) {
-      return i;
-    }
-  }
-
-  VKR_RES_ERROR("Failed to find suitable memory type");
+  return device.allocator().memoryTypeIndex(typeFilter, properties);
 }
 
 } // namespace vkr::resource
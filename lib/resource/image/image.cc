@@ -1,8 +1,29 @@
 #include "vkr/resource/image/image.hh"
 #include "vkr/logger.hh"
-#include "vkr/resource/buffer/buffer.hh"
 
 namespace vkr::resource {
+namespace {
+
+auto imageCreateInfo(const ImageDesc &desc) -> VkImageCreateInfo {
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.flags = desc.flags;
+  imageInfo.imageType = desc.type;
+  imageInfo.extent.width = desc.width;
+  imageInfo.extent.height = desc.height;
+  imageInfo.extent.depth = desc.depth;
+  imageInfo.mipLevels = desc.mipLevels;
+  imageInfo.arrayLayers = desc.arrayLayers;
+  imageInfo.format = desc.format;
+  imageInfo.tiling = desc.tiling;
+  imageInfo.initialLayout = desc.layout;
+  imageInfo.usage = desc.usage;
+  imageInfo.samples = desc.samples;
+  imageInfo.sharingMode = desc.sharingMode;
+  return imageInfo;
+}
+
+} // namespace
 
 Image::Image(const core::Device &device) : device_(device) {}
 
@@ -19,26 +40,33 @@ void Image::update(const ImageDesc &desc) {
   create();
 }
 
+auto Image::memoryRequirements(const core::Device &device,
+                               const ImageDesc &desc) -> VkMemoryRequirements {
+  if (!desc.isValid()) {
+    VKR_RES_ERROR("ImageDesc is invalid");
+  }
+
+  const VkImageCreateInfo imageInfo = imageCreateInfo(desc);
+
+  VkImage image = VK_NULL_HANDLE;
+  if (vkCreateImage(device.device(), &imageInfo, nullptr, &image) !=
+      VK_SUCCESS) {
+    VKR_RES_ERROR("Failed to create image");
+  }
+
+  VkMemoryRequirements requirements{};
+  vkGetImageMemoryRequirements(device.device(), image, &requirements);
+  vkDestroyImage(device.device(), image, nullptr);
+
+  return requirements;
+}
+
 void Image::create() {
   if (!desc_.isValid()) {
     VKR_RES_ERROR("ImageDesc is invalid");
   }
 
-  VkImageCreateInfo imageInfo{};
-  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-  imageInfo.flags = desc_.flags;
-  imageInfo.imageType = desc_.type;
-  imageInfo.extent.width = desc_.width;
-  imageInfo.extent.height = desc_.height;
-  imageInfo.extent.depth = desc_.depth;
-  imageInfo.mipLevels = desc_.mipLevels;
-  imageInfo.arrayLayers = desc_.arrayLayers;
-  imageInfo.format = desc_.format;
-  imageInfo.tiling = desc_.tiling;
-  imageInfo.initialLayout = desc_.layout;
-  imageInfo.usage = desc_.usage;
-  imageInfo.samples = desc_.samples;
-  imageInfo.sharingMode = desc_.sharingMode;
+  const VkImageCreateInfo imageInfo = imageCreateInfo(desc_);
 
   if (vkCreateImage(device_.device(), &imageInfo, nullptr, &vk_image_) !=
       VK_SUCCESS) {
@@ -48,21 +76,35 @@ void Image::create() {
   VkMemoryRequirements memRequirements{};
   vkGetImageMemoryRequirements(device_.device(), vk_image_, &memRequirements);
 
-  VkMemoryAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  allocInfo.allocationSize = memRequirements.size;
-  allocInfo.memoryTypeIndex = Buffer::findMemoryType(
-      memRequirements.memoryTypeBits, desc_.memoryProperties, device_);
-
-  if (vkAllocateMemory(device_.device(), &allocInfo, nullptr, &vk_memory_) !=
-      VK_SUCCESS) {
-    vkDestroyImage(device_.device(), vk_image_, nullptr);
-    vk_image_ = VK_NULL_HANDLE;
-    VKR_RES_ERROR("Failed to allocate image memory");
+  const auto kind = desc_.tiling == VK_IMAGE_TILING_LINEAR
+                        ? core::MemoryResourceKind::Linear
+                        : core::MemoryResourceKind::Optimal;
+
+  if (desc_.memory) {
+    const auto &memory = *desc_.memory;
+    if (!memory.isValid() || memRequirements.size > memory.size ||
+        memory.offset % memRequirements.alignment != 0 ||
+        (memRequirements.memoryTypeBits & (1U << memory.memoryType)) == 0) {
+      vkDestroyImage(device_.device(), vk_image_, nullptr);
+      vk_image_ = VK_NULL_HANDLE;
+      VKR_RES_ERROR("Aliased memory cannot hold a {}x{} image", desc_.width,
+                    desc_.height);
+    }
+
+    allocation_ = memory;
+  } else {
+    try {
+      allocation_ = device_.allocator().allocate(
+          memRequirements, desc_.memoryProperties, kind);
+    } catch (...) {
+      vkDestroyImage(device_.device(), vk_image_, nullptr);
+      vk_image_ = VK_NULL_HANDLE;
+      VKR_RES_ERROR("Failed to allocate image memory");
+    }
   }
 
-  if (vkBindImageMemory(device_.device(), vk_image_, vk_memory_, 0) !=
-      VK_SUCCESS) {
+  if (vkBindImageMemory(device_.device(), vk_image_, allocation_.memory,
+                        allocation_.offset) != VK_SUCCESS) {
     destroy();
     VKR_RES_ERROR("Failed to bind image memory");
   }
@@ -71,16 +113,26 @@ void Image::create() {
 }
 
 void Image::destroy() {
-  if (vk_image_ != VK_NULL_HANDLE) {
-    vkDestroyImage(device_.device(), vk_image_, nullptr);
-    vk_image_ = VK_NULL_HANDLE;
+  // aliased memory belongs to whoever handed it out
+  core::MemoryAllocation owned{};
+  if (!desc_.memory) {
+    owned = allocation_;
   }
 
-  if (vk_memory_ != VK_NULL_HANDLE) {
-    vkFreeMemory(device_.device(), vk_memory_, nullptr);
-    vk_memory_ = VK_NULL_HANDLE;
+  if (vk_image_ != VK_NULL_HANDLE || owned.isValid()) {
+    // frames still in flight may access the image or its memory
+    device_.deletionQueue().push(
+        [&device = device_, image = vk_image_, allocation = owned]() mutable {
+          if (image != VK_NULL_HANDLE) {
+            vkDestroyImage(device.device(), image, nullptr);
+          }
+          device.allocator().free(allocation);
+        });
   }
 
+  vk_image_ = VK_NULL_HANDLE;
+  allocation_ = {};
+
   layout_ = VK_IMAGE_LAYOUT_UNDEFINED;
 }
 
@@ -50,7 +50,10 @@ void ImageView::create() {
 
 void ImageView::destroy() {
   if (vk_imageview_ != VK_NULL_HANDLE) {
-    vkDestroyImageView(device_.device(), vk_imageview_, nullptr);
+    device_.deletionQueue().push(
+        [device = device_.device(), imageView = vk_imageview_] {
+          vkDestroyImageView(device, imageView, nullptr);
+        });
     vk_imageview_ = VK_NULL_HANDLE;
   }
 }
@@ -59,7 +59,10 @@ void Sampler::create() {
 
 void Sampler::destroy() {
   if (vk_sampler_ != VK_NULL_HANDLE) {
-    vkDestroySampler(device_.device(), vk_sampler_, nullptr);
+    device_.deletionQueue().push(
+        [device = device_.device(), sampler = vk_sampler_] {
+          vkDestroySampler(device, sampler, nullptr);
+        });
     vk_sampler_ = VK_NULL_HANDLE;
   }
 }
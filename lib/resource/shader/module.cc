@@ -1,6 +1,7 @@
 #include "vkr/resource/shader/module.hh"
 #include "vkr/logger.hh"
 #include "vkr/util/io.hh"
+#include "vkr/util/shader_cache.hh"
 #include <exception>
 #include <utility>
 
@@ -66,7 +67,7 @@ auto ShaderModule::loadSpirv() const -> std::vector<uint32_t> {
     }
 
   case ShaderModuleSourceKind::Glsl: {
-    auto result = util::ShaderCompiler::compileGlsl(desc_.glslCompile);
+    auto result = util::ShaderCache::instance().compileGlsl(desc_.glslCompile);
 
     if (!result) {
       VKR_RES_ERROR("Shader compilation failed '{}': {}",
@@ -78,7 +79,8 @@ auto ShaderModule::loadSpirv() const -> std::vector<uint32_t> {
   }
 
   case ShaderModuleSourceKind::Slang: {
-    auto result = util::ShaderCompiler::compileSlang(desc_.slangCompile);
+    auto result =
+        util::ShaderCache::instance().compileSlang(desc_.slangCompile);
 
     if (!result) {
       VKR_RES_ERROR("Slang compilation failed '{}': {}",
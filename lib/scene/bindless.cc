@@ -0,0 +1,165 @@
+#include "vkr/scene/bindless.hh"
+#include "vkr/logger.hh"
+#include <algorithm>
+
+namespace vkr::scene {
+namespace {
+
+auto clampCapacity(uint32_t requested, uint32_t limit, const char *kind)
+    -> uint32_t {
+  if (requested <= limit) {
+    return requested;
+  }
+
+  VKR_RES_WARN("Bindless {} capacity {} exceeds the device limit, clamped "
+               "to {}",
+               kind, requested, limit);
+  return limit;
+}
+
+} // namespace
+
+BindlessTable::BindlessTable(const core::Device &device,
+                             const BindlessDesc &desc)
+    : device_(device), desc_(desc) {
+  if (!device_.descriptorIndexing()) {
+    VKR_RES_ERROR("BindlessTable requires descriptor indexing on the device");
+  }
+
+  if (!desc_.isValid()) {
+    VKR_RES_ERROR("BindlessTable requires non-zero capacities and stages");
+  }
+
+  // a combined image sampler counts as both a sampler and a sampled image
+  const auto &limits = device_.descriptorIndexingProperties();
+  desc_.textureCapacity = clampCapacity(
+      desc_.textureCapacity,
+      std::min({limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+                limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                limits.maxDescriptorSetUpdateAfterBindSamplers,
+                limits.maxDescriptorSetUpdateAfterBindSampledImages}),
+      "texture");
+  desc_.bufferCapacity = clampCapacity(
+      desc_.bufferCapacity,
+      std::min(limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+               limits.maxDescriptorSetUpdateAfterBindStorageBuffers),
+      "storage buffer");
+
+  const uint32_t resources = limits.maxPerStageUpdateAfterBindResources;
+  if (desc_.bufferCapacity < resources) {
+    desc_.textureCapacity =
+        clampCapacity(desc_.textureCapacity,
+                      resources - desc_.bufferCapacity, "texture");
+  }
+
+  if (!desc_.isValid() || desc_.bufferCapacity >= resources) {
+    VKR_RES_ERROR("BindlessTable does not fit the device's update-after-bind "
+                  "descriptor limits");
+  }
+
+  pool_ = std::make_unique<pipeline::DescriptorPool>(device_);
+  pool_->update({
+      .poolSizes = {{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                     desc_.textureCapacity},
+                    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, desc_.bufferCapacity}},
+      .maxSets = 1,
+      .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT |
+               VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+  });
+
+  constexpr VkDescriptorBindingFlagsEXT bindingFlags =
+      VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+      VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+      VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+  layout_ = std::make_unique<pipeline::DescriptorSetLayout>(device_);
+  layout_->update({
+      .bindings = {{.name = "bindless-textures",
+                    .layout = {kTextureBinding,
+                               VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                               desc_.textureCapacity, desc_.stageFlags}},
+                   {.name = "bindless-buffers",
+                    .layout = {kBufferBinding,
+                               VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                               desc_.bufferCapacity, desc_.stageFlags}}},
+      .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+      .bindingFlags = {bindingFlags, bindingFlags},
+  });
+
+  sets_ = std::make_unique<pipeline::DescriptorSets>(device_);
+  sets_->update({
+      .pool = pool_->pool(),
+      .layout = layout_->layout(),
+      .setCount = 1,
+  });
+
+  VKR_RES_INFO("Bindless table created: {} textures, {} storage buffers",
+               desc_.textureCapacity, desc_.bufferCapacity);
+}
+
+auto BindlessTable::addTexture(VkDescriptorImageInfo image) -> uint32_t {
+  const uint32_t index = allocate(&FreeSlots::textures, next_texture_,
+                                  desc_.textureCapacity, "texture");
+
+  auto write = pipeline::DescriptorSetWriteDesc::forSet(0);
+  write.images.push_back(pipeline::DescriptorImageWriteDesc::one(
+      kTextureBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, image,
+      index));
+  sets_->write({write});
+  return index;
+}
+
+auto BindlessTable::addBuffer(VkDescriptorBufferInfo buffer) -> uint32_t {
+  const uint32_t index = allocate(&FreeSlots::buffers, next_buffer_,
+                                  desc_.bufferCapacity, "storage buffer");
+
+  auto write = pipeline::DescriptorSetWriteDesc::forSet(0);
+  write.buffers.push_back(pipeline::DescriptorBufferWriteDesc::one(
+      kBufferBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, buffer, index));
+  sets_->write({write});
+  return index;
+}
+
+void BindlessTable::releaseTexture(uint32_t index) {
+  release(&FreeSlots::textures, index);
+}
+
+void BindlessTable::releaseBuffer(uint32_t index) {
+  release(&FreeSlots::buffers, index);
+}
+
+auto BindlessTable::allocate(std::vector<uint32_t> FreeSlots::*list,
+                             uint32_t &next, uint32_t capacity,
+                             const char *kind) -> uint32_t {
+  {
+    std::lock_guard lock(free_slots_->mutex);
+    auto &slots = (*free_slots_).*list;
+    if (!slots.empty()) {
+      const uint32_t index = slots.back();
+      slots.pop_back();
+      return index;
+    }
+  }
+
+  if (next >= capacity) {
+    VKR_RES_ERROR("Bindless table is out of {} slots (capacity {})", kind,
+                  capacity);
+  }
+
+  return next++;
+}
+
+void BindlessTable::release(std::vector<uint32_t> FreeSlots::*list,
+                            uint32_t index) {
+  if (index == kInvalidIndex) {
+    return;
+  }
+
+  // frames in flight may still index the old descriptor
+  device_.deletionQueue().push([slots = free_slots_, list, index] {
+    std::lock_guard lock(slots->mutex);
+    ((*slots).*list).push_back(index);
+  });
+}
+
+} // namespace vkr::scene
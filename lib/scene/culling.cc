@@ -0,0 +1,93 @@
+#include "vkr/scene/culling.hh"
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace vkr::scene {
+
+void FrustumCuller::clear() noexcept {
+  center_x_.clear();
+  center_y_.clear();
+  center_z_.clear();
+  radius_.clear();
+  extent_x_.clear();
+  extent_y_.clear();
+  extent_z_.clear();
+}
+
+void FrustumCuller::reserve(size_t count) {
+  center_x_.reserve(count);
+  center_y_.reserve(count);
+  center_z_.reserve(count);
+  radius_.reserve(count);
+  extent_x_.reserve(count);
+  extent_y_.reserve(count);
+  extent_z_.reserve(count);
+}
+
+auto FrustumCuller::add(const MeshBounds &bounds, float margin) -> uint32_t {
+  const auto index = static_cast<uint32_t>(radius_.size());
+
+  // finite so that a zero plane component times the extent stays zero
+  const float unbounded = std::numeric_limits<float>::max();
+  const bool valid = bounds.isValid();
+  const glm::vec3 extent = bounds.extent() + margin;
+
+  center_x_.push_back(valid ? bounds.center.x : 0.0f);
+  center_y_.push_back(valid ? bounds.center.y : 0.0f);
+  center_z_.push_back(valid ? bounds.center.z : 0.0f);
+  radius_.push_back(valid ? bounds.radius + margin : unbounded);
+  extent_x_.push_back(valid ? extent.x : unbounded);
+  extent_y_.push_back(valid ? extent.y : unbounded);
+  extent_z_.push_back(valid ? extent.z : unbounded);
+  return index;
+}
+
+void FrustumCuller::cull(const Frustum &frustum,
+                         std::vector<uint32_t> &visible) {
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  const size_t count = radius_.size();
+
+  inside_.assign(count, 1);
+  const float *centerX = center_x_.data();
+  const float *centerY = center_y_.data();
+  const float *centerZ = center_z_.data();
+  const float *radius = radius_.data();
+  const float *extentX = extent_x_.data();
+  const float *extentY = extent_y_.data();
+  const float *extentZ = extent_z_.data();
+  uint8_t *inside = inside_.data();
+
+  for (const auto &plane : frustum.planes) {
+    const float nx = plane.x;
+    const float ny = plane.y;
+    const float nz = plane.z;
+    const float ax = std::abs(nx);
+    const float ay = std::abs(ny);
+    const float az = std::abs(nz);
+
+    for (size_t i = 0; i < count; ++i) {
+      const float distance =
+          nx * centerX[i] + ny * centerY[i] + nz * centerZ[i] + plane.w;
+      const float boxRadius =
+          ax * extentX[i] + ay * extentY[i] + az * extentZ[i];
+      const float reach = radius[i] < boxRadius ? radius[i] : boxRadius;
+      inside[i] &= static_cast<uint8_t>(distance + reach >= 0.0f);
+    }
+  }
+
+  visible.clear();
+  for (size_t i = 0; i < count; ++i) {
+    if (inside[i] != 0) {
+      visible.push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  stats_.objects = static_cast<uint32_t>(count);
+  stats_.visible = static_cast<uint32_t>(visible.size());
+  stats_.milliseconds =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace vkr::scene
@@ -1,5 +1,7 @@
 #include "vkr/scene/geometry/index_buffer.hh"
 #include "vkr/logger.hh"
+#include <algorithm>
+#include <limits>
 
 namespace vkr::scene {
 
@@ -11,81 +13,61 @@ IndexBuffer::IndexBuffer(const core::Device &device,
 IndexBuffer::~IndexBuffer() = default;
 
 void IndexBuffer::create() {
-  if (indices_.empty()) {
+  const IndexSpan span = indices();
+  if (span.empty()) {
     VKR_RES_ERROR("Cannot create index buffer with no indices");
   }
 
-  VkDeviceSize bufferSize = sizeof(indices_[0]) * indices_.size();
+  const VkDeviceSize size = bufferSize();
 
-  resource::Buffer staging{device_, bufferSize,
-                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                               VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-  staging.write(indices_.data(), bufferSize);
-
-  target_->update(bufferSize,
+  target_->update(size,
                   VK_BUFFER_USAGE_TRANSFER_DST_BIT |
                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-  VkCommandBufferAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  allocInfo.commandPool = command_pool_.commandPool();
-  allocInfo.commandBufferCount = 1;
-
-  VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
-  if (vkAllocateCommandBuffers(device_.device(), &allocInfo, &commandBuffer) !=
-      VK_SUCCESS) {
-    VKR_RES_ERROR("Failed to allocate index upload command buffer");
-  }
-
-  VkCommandBufferBeginInfo beginInfo{};
-  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-  if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
-    vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                         &commandBuffer);
-    VKR_RES_ERROR("Failed to begin index upload command buffer");
-  }
-
-  VkBufferCopy copyRegion{};
-  copyRegion.size = bufferSize;
-  vkCmdCopyBuffer(commandBuffer, staging.buffer(), target_->buffer(), 1,
-                  &copyRegion);
-
-  if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-    vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                         &commandBuffer);
-    VKR_RES_ERROR("Failed to end index upload command buffer");
-  }
-
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &commandBuffer;
+  command_pool_.uploader().copyBuffer(span.data(), size, target_->buffer());
 
-  if (vkQueueSubmit(command_pool_.queue(), 1, &submitInfo, VK_NULL_HANDLE) !=
-      VK_SUCCESS) {
-    vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                         &commandBuffer);
-    VKR_RES_ERROR("Failed to submit index upload command buffer");
+  if (index_type_ == VK_INDEX_TYPE_UINT16) {
+    VKR_RES_DEBUG("Index buffer: {} uint16 indices, {} bytes ({} bytes "
+                  "saved over uint32)",
+                  span.size(), size, size);
+  } else {
+    VKR_RES_DEBUG("Index buffer: {} uint32 indices, {} bytes", span.size(),
+                  size);
   }
-
-  vkQueueWaitIdle(command_pool_.queue());
-  vkFreeCommandBuffers(device_.device(), command_pool_.commandPool(), 1,
-                       &commandBuffer);
 }
 
 void IndexBuffer::destroy() {
   target_->destroy();
-  indices_.clear();
+  indices16_.clear();
+  indices32_.clear();
 }
 
 void IndexBuffer::update(const std::vector<uint16_t> &indices) {
   destroy();
-  indices_ = indices;
+  index_type_ = VK_INDEX_TYPE_UINT16;
+  indices16_ = indices;
+  create();
+}
+
+void IndexBuffer::update(const std::vector<uint32_t> &indices) {
+  destroy();
+
+  // narrow whenever every index fits, halving index memory and bandwidth
+  const uint32_t maxIndex =
+      indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end());
+  if (maxIndex <= std::numeric_limits<uint16_t>::max()) {
+    index_type_ = VK_INDEX_TYPE_UINT16;
+    indices16_.resize(indices.size());
+    std::transform(indices.begin(), indices.end(), indices16_.begin(),
+                   [](uint32_t index) -> uint16_t {
+                     return static_cast<uint16_t>(index);
+                   });
+  } else {
+    index_type_ = VK_INDEX_TYPE_UINT32;
+    indices32_ = indices;
+  }
+
   create();
 }
 
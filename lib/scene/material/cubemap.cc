@@ -1,6 +1,5 @@
 #include "vkr/scene/material/cubemap.hh"
 #include "vkr/logger.hh"
-#include "vkr/resource/buffer/buffer.hh"
 #include <cstddef>
 #include <cstring>
 #include <memory>
@@ -34,69 +33,20 @@ auto shaderStageFor(const core::CommandPool &commandPool)
   VKR_RES_ERROR("Unsupported command pool role for cubemap shader access");
 }
 
-auto beginSingleTimeCommands(const core::Device &device,
-                             const core::CommandPool &commandPool)
-    -> VkCommandBuffer {
-  VkCommandBufferAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  allocInfo.commandPool = commandPool.commandPool();
-  allocInfo.commandBufferCount = 1;
-
-  VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
-  if (vkAllocateCommandBuffers(device.device(), &allocInfo, &commandBuffer) !=
-      VK_SUCCESS) {
-    VKR_RES_ERROR("Failed to allocate cubemap upload command buffer");
-  }
-
-  VkCommandBufferBeginInfo beginInfo{};
-  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-  if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
-    vkFreeCommandBuffers(device.device(), commandPool.commandPool(), 1,
-                         &commandBuffer);
-    VKR_RES_ERROR("Failed to begin cubemap upload command buffer");
-  }
-
-  return commandBuffer;
+auto stagingAlignment(uint32_t channels) noexcept -> VkDeviceSize {
+  // buffer offsets of image copies must be a multiple of both 4 and the
+  // texel size
+  return channels == 3 ? 12 : 16;
 }
 
-void endSingleTimeCommands(const core::Device &device,
-                           const core::CommandPool &commandPool,
-                           VkCommandBuffer commandBuffer) {
-  if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-    vkFreeCommandBuffers(device.device(), commandPool.commandPool(), 1,
-                         &commandBuffer);
-    VKR_RES_ERROR("Failed to end cubemap upload command buffer");
-  }
-
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &commandBuffer;
-
-  if (vkQueueSubmit(commandPool.queue(), 1, &submitInfo, VK_NULL_HANDLE) !=
-      VK_SUCCESS) {
-    vkFreeCommandBuffers(device.device(), commandPool.commandPool(), 1,
-                         &commandBuffer);
-    VKR_RES_ERROR("Failed to submit cubemap upload command buffer");
-  }
-
-  vkQueueWaitIdle(commandPool.queue());
-  vkFreeCommandBuffers(device.device(), commandPool.commandPool(), 1,
-                       &commandBuffer);
-}
-
-void transitionImageLayout(const core::Device &device,
-                           const core::CommandPool &commandPool,
+void transitionImageLayout(const core::CommandPool &commandPool,
                            resource::Image &image, VkImageLayout oldLayout,
                            VkImageLayout newLayout) {
   if (oldLayout == newLayout) {
     return;
   }
 
-  VkCommandBuffer commandBuffer = beginSingleTimeCommands(device, commandPool);
+  VkCommandBuffer commandBuffer = commandPool.uploader().commandBuffer();
 
   VkImageMemoryBarrier barrier{};
   barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -134,15 +84,14 @@ void transitionImageLayout(const core::Device &device,
   vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0,
                        nullptr, 0, nullptr, 1, &barrier);
 
-  endSingleTimeCommands(device, commandPool, commandBuffer);
   image.setLayout(newLayout);
 }
 
-void copyBufferToImage(const core::Device &device,
-                       const core::CommandPool &commandPool,
-                       const resource::Buffer &buffer, resource::Image &image,
-                       uint32_t layers, uint32_t channels) {
-  VkCommandBuffer commandBuffer = beginSingleTimeCommands(device, commandPool);
+void copyBufferToImage(const core::CommandPool &commandPool,
+                       const core::StagingRange &staging,
+                       resource::Image &image, uint32_t layers,
+                       uint32_t channels) {
+  VkCommandBuffer commandBuffer = commandPool.uploader().commandBuffer();
 
   const VkDeviceSize layerSize = static_cast<VkDeviceSize>(image.width()) *
                                  static_cast<VkDeviceSize>(image.height()) *
@@ -152,7 +101,7 @@ void copyBufferToImage(const core::Device &device,
 
   for (uint32_t layer = 0; layer < layers; ++layer) {
     VkBufferImageCopy region{};
-    region.bufferOffset = layerSize * layer;
+    region.bufferOffset = staging.offset + layerSize * layer;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
     region.imageSubresource.aspectMask = image.desc().aspectMask;
@@ -164,11 +113,9 @@ void copyBufferToImage(const core::Device &device,
     regions.push_back(region);
   }
 
-  vkCmdCopyBufferToImage(commandBuffer, buffer.buffer(), image.image(),
+  vkCmdCopyBufferToImage(commandBuffer, staging.buffer, image.image(),
                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                          static_cast<uint32_t>(regions.size()), regions.data());
-
-  endSingleTimeCommands(device, commandPool, commandBuffer);
 }
 
 } // namespace
@@ -250,16 +197,14 @@ void Cubemap::create() {
                                 static_cast<VkDeviceSize>(channels);
   const VkDeviceSize imageSize = faceSize * FaceCount;
 
-  resource::Buffer staging{device_, imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                               VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+  const auto staging = command_pool_.uploader().stage(
+      nullptr, imageSize, stagingAlignment(channels));
 
-  auto *data = static_cast<std::byte *>(staging.map(imageSize));
+  auto *data = static_cast<std::byte *>(staging.mapped);
   for (uint32_t face = 0; face < FaceCount; ++face) {
     std::memcpy(data + faceSize * face, facePixels[face].get(),
                 static_cast<size_t>(faceSize));
   }
-  staging.unmap();
 
   resource::ImageDesc imageDesc =
       resource::ImageDesc::sampled2D(width, height, desc_.format);
@@ -270,15 +215,14 @@ void Cubemap::create() {
 
   image_->update(imageDesc);
 
-  transitionImageLayout(device_, command_pool_, *image_,
+  transitionImageLayout(command_pool_, *image_,
                         VK_IMAGE_LAYOUT_UNDEFINED,
                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-  copyBufferToImage(device_, command_pool_, staging, *image_, FaceCount,
-                    channels);
+  copyBufferToImage(command_pool_, staging, *image_, FaceCount, channels);
 
   if (desc_.layout != VK_IMAGE_LAYOUT_UNDEFINED &&
       desc_.layout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-    transitionImageLayout(device_, command_pool_, *image_,
+    transitionImageLayout(command_pool_, *image_,
                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, desc_.layout);
   }
 
@@ -8,6 +8,26 @@ ExecGraphPanel::ExecGraphPanel(exec::RenderGraph &graph)
 
 void ExecGraphPanel::render() {
   const auto passes = graph_.passes();
+  const auto &barriers = graph_.barrierStats();
+
+  ImGui::SeparatorText("Barriers");
+  ImGui::Text("Pipeline barriers: %u", barriers.pipelineBarriers);
+  ImGui::Text("Image barriers: %u", barriers.imageBarriers);
+  ImGui::Text("Layout transitions: %u", barriers.layoutTransitions);
+  ImGui::TextDisabled("%u access(es) needed no barrier",
+                      barriers.skippedAccesses);
+  ImGui::Spacing();
+
+  const auto &attachments = graph_.attachmentStats();
+  constexpr double MiB = 1024.0 * 1024.0;
+
+  ImGui::SeparatorText("Transient Attachments");
+  ImGui::Text("Images: %u in %u slot(s)", attachments.attachments,
+              attachments.slots);
+  ImGui::Text("Memory: %.2f MiB (%.2f MiB unaliased)",
+              static_cast<double>(attachments.aliasedBytes) / MiB,
+              static_cast<double>(attachments.unaliasedBytes) / MiB);
+  ImGui::Spacing();
 
   ImGui::SeparatorText("Passes");
   ImGui::TextDisabled("%zu total", passes.size());
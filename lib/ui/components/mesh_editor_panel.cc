@@ -7,7 +7,7 @@ MeshEditorPanel::MeshEditorPanel(scene::Scene &scene)
     : UiComponent("Mesh Editor"), scene_(scene) {}
 
 void MeshEditorPanel::render() {
-  const auto meshNames = scene_.listMeshNames();
+  const auto &meshNames = scene_.meshNames();
   const auto selectedMesh = scene_.selectedMeshName();
 
   ImGui::SeparatorText("Target");
@@ -49,8 +49,8 @@ void MeshEditorPanel::render() {
 
   ImGui::Text("Name: %s", currentMesh.c_str());
 
-  auto mesh = scene_.getMesh(currentMesh);
-  if (!mesh || !mesh->isValid()) {
+  const auto *mesh = scene_.mesh(scene_.selectedMesh());
+  if (mesh == nullptr || !mesh->isValid()) {
     ImGui::TextDisabled("State: unavailable");
     return;
   }
@@ -65,7 +65,10 @@ void MeshEditorPanel::render() {
   const auto vertexInput = vertexBuffer->get().vertexInputDesc();
 
   ImGui::Text("Vertices: %zu", vertexBuffer->get().vertexCount());
-  ImGui::Text("Indices: %zu", indexBuffer->get().indices().size());
+  ImGui::Text("Indices: %zu (%s)", indexBuffer->get().indices().size(),
+              indexBuffer->get().indexType() == VK_INDEX_TYPE_UINT32
+                  ? "uint32"
+                  : "uint16");
   ImGui::Text("Bindings: %zu", vertexInput.bindings.size());
   ImGui::Text("Attributes: %zu", vertexInput.attributes.size());
 }
@@ -2,6 +2,20 @@
 #include <algorithm>
 
 namespace vkr::ui {
+namespace {
+
+auto sortedNames(std::vector<std::string> names) -> std::vector<std::string> {
+  names.erase(std::remove_if(
+                  names.begin(), names.end(),
+                  [](const std::string &name) -> bool { return name.empty(); }),
+              names.end());
+
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+  return names;
+}
+
+} // namespace
 
 ResourceTree::ResourceTree(scene::Scene &scene)
     : UiComponent("Resources"), scene_(scene) {}
@@ -13,20 +27,20 @@ void ResourceTree::render() {
   ImGui::Checkbox("Show empty groups", &show_empty_groups_);
   ImGui::Spacing();
 
+  refreshNames();
+
   const float detailsHeight = ImGui::GetTextLineHeightWithSpacing() * 11.0f;
   if (ImGui::BeginChild("ResourceTreeScrollRegion",
                         ImVec2(0.0f, -detailsHeight), true,
                         ImGuiWindowFlags_HorizontalScrollbar)) {
-    renderCategory("Meshes", scene_.listMeshNames(), scene_.meshCount());
+    renderCategory("Meshes", mesh_names_, scene_.meshCount());
 
-    renderCategory("Uniform Buffers", scene_.listUniformBufferNames(),
+    renderCategory("Uniform Buffers", uniform_buffer_names_,
                    scene_.uniformBufferCount());
 
-    renderCategory("Textures", scene_.listTextureImageNames(),
-                   scene_.textureImageCount());
+    renderCategory("Textures", texture_names_, scene_.textureImageCount());
 
-    renderCategory("Cubemaps", scene_.listCubemapNames(),
-                   scene_.cubemapCount());
+    renderCategory("Cubemaps", cubemap_names_, scene_.cubemapCount());
   }
 
   ImGui::EndChild();
@@ -34,17 +48,21 @@ void ResourceTree::render() {
   renderSelectedResource();
 }
 
-void ResourceTree::renderCategory(const char *type,
-                                  std::vector<std::string> names,
-                                  size_t count) {
-  names.erase(std::remove_if(
-                  names.begin(), names.end(),
-                  [](const std::string &name) -> bool { return name.empty(); }),
-              names.end());
+void ResourceTree::refreshNames() {
+  if (scene_version_ == scene_.version()) {
+    return;
+  }
 
-  std::sort(names.begin(), names.end());
-  names.erase(std::unique(names.begin(), names.end()), names.end());
+  scene_version_ = scene_.version();
+  mesh_names_ = sortedNames(scene_.listMeshNames());
+  uniform_buffer_names_ = sortedNames(scene_.listUniformBufferNames());
+  texture_names_ = sortedNames(scene_.listTextureImageNames());
+  cubemap_names_ = sortedNames(scene_.listCubemapNames());
+}
 
+void ResourceTree::renderCategory(const char *type,
+                                  const std::vector<std::string> &names,
+                                  size_t count) {
   if (!show_empty_groups_ && names.empty()) {
     return;
   }
@@ -136,7 +154,10 @@ void ResourceTree::renderSelectedResource() {
 
     ImGui::Text("State: valid");
     ImGui::Text("Vertices: %zu", vertexBuffer->get().vertexCount());
-    ImGui::Text("Indices: %zu", indexBuffer->get().indices().size());
+    ImGui::Text("Indices: %zu (%s)", indexBuffer->get().indices().size(),
+                indexBuffer->get().indexType() == VK_INDEX_TYPE_UINT32
+                    ? "uint32"
+                    : "uint16");
     ImGui::Text("Vertex bindings: %zu", vertexInput.bindings.size());
     ImGui::Text("Vertex attributes: %zu", vertexInput.attributes.size());
     return;
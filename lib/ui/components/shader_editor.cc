@@ -983,11 +983,9 @@ void ShaderEditor::refreshFileBackedShaders(
   };
 
   auto applyFileBackedState = [&](const PipelineTarget &target,
-                                  ShaderEditorPipelineState &state,
-                                  bool active) -> bool {
+                                  const ShaderEditorPipelineState &state) {
     auto &pipeline = target.pipeline.get();
-    const auto oldDesc = pipeline.desc();
-    auto nextDesc = oldDesc;
+    auto nextDesc = pipeline.desc();
 
     if (auto vert = findShader(nextDesc, VK_SHADER_STAGE_VERTEX_BIT)) {
       auto &shader = vert->get();
@@ -1007,65 +1005,19 @@ void ShaderEditor::refreshFileBackedShaders(
       }
     }
 
-    try {
-      if (pipeline.update(nextDesc)) {
-        state.vert.valid_text = state.vert.synced_text;
-        state.frag.valid_text = state.frag.synced_text;
-        state.vert.conflict = false;
-        state.frag.conflict = false;
-
-        if (active) {
-          vert_file_ = state.vert;
-          frag_file_ = state.frag;
-        }
-
-        setStatus("Hot reloaded: " + target.label(), false);
-        return true;
-      }
-    } catch (const std::exception &e) {
-      setStatus("Failed to hot reload: " + target.label() + ": " + e.what(),
-                true);
-    } catch (...) {
-      setStatus("Failed to hot reload: " + target.label(), true);
-    }
-
-    auto restoreDesc = oldDesc;
-
-    if (auto vert = findShader(restoreDesc, VK_SHADER_STAGE_VERTEX_BIT)) {
-      auto &shader = vert->get();
-      if (state.vert.file_backed && !state.vert.valid_text.empty()) {
-        shader.module =
-            makeShaderModule(VK_SHADER_STAGE_VERTEX_BIT, state.vert.valid_text,
-                             shaderLabel(shader, restoreDesc.name + ".vert"),
-                             shader.entryPoint, false);
-      }
-    }
-
-    if (auto frag = findShader(restoreDesc, VK_SHADER_STAGE_FRAGMENT_BIT)) {
-      auto &shader = frag->get();
-      if (state.frag.file_backed && !state.frag.valid_text.empty()) {
-        shader.module = makeShaderModule(
-            VK_SHADER_STAGE_FRAGMENT_BIT, state.frag.valid_text,
-            shaderLabel(shader, restoreDesc.name + ".frag"), shader.entryPoint,
-            false);
-      }
-    }
-
-    try {
-      pipeline.update(restoreDesc);
-    } catch (...) {
-    }
-
-    if (active) {
-      vert_file_ = state.vert;
-      frag_file_ = state.frag;
-    }
-
-    return false;
+    pending_applies_[target.label()] = PendingApply{
+        .request = pipeline.updateAsync(nextDesc),
+        .hotReload = true,
+    };
+    setStatus("Hot reloading: " + target.label(), false);
   };
 
   for (const auto &target : targets) {
     const std::string key = target.label();
+    if (pending_applies_.count(key) != 0) {
+      continue;
+    }
+
     const bool active = key == loaded_target_key_;
     auto &state = pipeline_files_[key];
 
@@ -1127,7 +1079,7 @@ void ShaderEditor::refreshFileBackedShaders(
       state.frag.conflict = false;
     }
 
-    (void)applyFileBackedState(target, state, active);
+    applyFileBackedState(target, state);
   }
 }
 
@@ -1191,6 +1143,24 @@ auto ShaderEditor::applyToPipeline(bool saveFiles) -> bool {
     return false;
   }
 
+  // record the write now so the file watcher does not reload it while the
+  // pipeline is still compiling
+  auto recordWrite = [](ShaderEditorFileState &file,
+                        const std::string &source) {
+    file.disk_text = source;
+    if (const auto time = fileWriteTime(file.path)) {
+      file.write_time = *time;
+    }
+  };
+
+  if (saveVertFile) {
+    recordWrite(vert_file_, nextVertSource);
+  }
+
+  if (saveFragFile) {
+    recordWrite(frag_file_, nextFragSource);
+  }
+
   vertShader.module = makeShaderModule(
       VK_SHADER_STAGE_VERTEX_BIT, nextVertSource,
       vertFileBacked ? vert_file_.path
@@ -1203,116 +1173,105 @@ auto ShaderEditor::applyToPipeline(bool saveFiles) -> bool {
                      : shaderLabel(fragShader, nextDesc.name + ".frag"),
       fragShader.entryPoint, fragFileBacked);
 
-  try {
-    if (pipeline->get().update(nextDesc)) {
-      loaded_target_key_ = activeTargetKey();
-      vert_file_.synced_text = nextVertSource;
-      frag_file_.synced_text = nextFragSource;
-      vert_file_.valid_text = nextVertSource;
-      frag_file_.valid_text = nextFragSource;
-      if (saveVertFile) {
-        vert_file_.disk_text = nextVertSource;
-      }
-
-      if (saveFragFile) {
-        frag_file_.disk_text = nextFragSource;
-      }
+  const std::string key = activeTargetKey();
+  pending_applies_[key] = PendingApply{
+      .request = pipeline->get().updateAsync(nextDesc),
+      .saveVert = saveVertFile,
+      .saveFrag = saveFragFile,
+      .oldVertSource = oldVertSource,
+      .oldFragSource = oldFragSource,
+      .nextVertSource = nextVertSource,
+      .nextFragSource = nextFragSource,
+  };
 
-      vert_file_.conflict = false;
-      frag_file_.conflict = false;
+  setStatus("Compiling: " + key, false);
+  return true;
+}
 
-      if (const auto time = fileWriteTime(vert_file_.path)) {
-        vert_file_.write_time = *time;
-      }
+void ShaderEditor::finishPendingApplies(
+    const std::vector<PipelineTarget> &targets) {
+  for (auto it = pending_applies_.begin(); it != pending_applies_.end();) {
+    const std::string key = it->first;
+    const PendingApply apply = it->second;
+
+    const auto target =
+        std::find_if(targets.begin(), targets.end(),
+                     [&](const auto &entry) { return entry.label() == key; });
+    if (target == targets.end()) {
+      it = pending_applies_.erase(it);
+      continue;
+    }
 
-      if (const auto time = fileWriteTime(frag_file_.path)) {
-        frag_file_.write_time = *time;
-      }
+    const auto &build = target->pipeline.get().lastBuild();
+    if (!build.covers(apply.request)) {
+      ++it;
+      continue;
+    }
 
-      if (!loaded_target_key_.empty()) {
-        pipeline_files_[loaded_target_key_] = ShaderEditorPipelineState{
-            .vert = vert_file_,
-            .frag = frag_file_,
-        };
-      }
+    it = pending_applies_.erase(it);
 
-      setStatus((saveVertFile || saveFragFile ? "Saved and applied: "
-                                              : "Compiled and applied: ") +
-                    loaded_target_key_,
-                false);
-      return true;
+    // superseded by an update made outside the editor
+    if (build.request != apply.request) {
+      continue;
     }
-  } catch (const std::exception &e) {
-    setStatus("Failed to compile pipeline. Restored previous pipeline: " +
-                  std::string(e.what()),
-              true);
-  } catch (...) {
-    setStatus("Failed to compile pipeline. Restored previous pipeline.", true);
-  }
 
-  auto restoreDesc = oldDesc;
-
-  if (auto restoreVert = findShader(restoreDesc, VK_SHADER_STAGE_VERTEX_BIT)) {
-    auto &shader = restoreVert->get();
-    const std::string source =
-        vert_file_.valid_text.empty() ? oldVertSource : vert_file_.valid_text;
-    if (!source.empty()) {
-      shader.module =
-          makeShaderModule(VK_SHADER_STAGE_VERTEX_BIT, source,
-                           shaderLabel(shader, restoreDesc.name + ".vert"),
-                           shader.entryPoint, false);
+    const bool active = key == loaded_target_key_;
+    auto &state = pipeline_files_[key];
+    if (active) {
+      state.vert = vert_file_;
+      state.frag = frag_file_;
     }
-  }
 
-  if (auto restoreFrag =
-          findShader(restoreDesc, VK_SHADER_STAGE_FRAGMENT_BIT)) {
-    auto &shader = restoreFrag->get();
-    const std::string source =
-        frag_file_.valid_text.empty() ? oldFragSource : frag_file_.valid_text;
-    if (!source.empty()) {
-      shader.module =
-          makeShaderModule(VK_SHADER_STAGE_FRAGMENT_BIT, source,
-                           shaderLabel(shader, restoreDesc.name + ".frag"),
-                           shader.entryPoint, false);
-    }
-  }
+    if (build.ok) {
+      if (!apply.hotReload) {
+        state.vert.synced_text = apply.nextVertSource;
+        state.frag.synced_text = apply.nextFragSource;
+      }
 
-  try {
-    pipeline->get().update(restoreDesc);
-  } catch (...) {
-  }
+      state.vert.valid_text = state.vert.synced_text;
+      state.frag.valid_text = state.frag.synced_text;
+      state.vert.conflict = false;
+      state.frag.conflict = false;
 
-  if (saveVertFile) {
-    (void)writeTextFile(vert_file_.path, oldVertSource);
-    vert_file_.disk_text = oldVertSource;
-    if (const auto time = fileWriteTime(vert_file_.path)) {
-      vert_file_.write_time = *time;
-    }
-  }
+      const std::string action =
+          apply.hotReload ? "Hot reloaded"
+          : apply.saveVert || apply.saveFrag ? "Saved and applied"
+                                             : "Compiled and applied";
+      std::array<char, 32> elapsed{};
+      std::snprintf(elapsed.data(), elapsed.size(), " (%.1f ms)",
+                    build.milliseconds);
+      setStatus(action + ": " + key + elapsed.data(), false);
+    } else if (apply.hotReload) {
+      setStatus("Failed to hot reload: " + key + ": " + build.error, true);
+    } else {
+      // the live pipeline was never touched; only the saved files go back
+      auto revert = [](ShaderEditorFileState &file,
+                       const std::string &source) {
+        (void)writeTextFile(file.path, source);
+        file.disk_text = source;
+        if (const auto time = fileWriteTime(file.path)) {
+          file.write_time = *time;
+        }
+      };
 
-  if (saveFragFile) {
-    (void)writeTextFile(frag_file_.path, oldFragSource);
-    frag_file_.disk_text = oldFragSource;
-    if (const auto time = fileWriteTime(frag_file_.path)) {
-      frag_file_.write_time = *time;
-    }
-  }
+      if (apply.saveVert) {
+        revert(state.vert, apply.oldVertSource);
+      }
 
-  loaded_target_key_ = activeTargetKey();
+      if (apply.saveFrag) {
+        revert(state.frag, apply.oldFragSource);
+      }
 
-  if (status_message_.empty() || !status_is_error_) {
-    setStatus("Failed to compile pipeline. Previous pipeline was restored.",
-              true);
-  }
+      setStatus("Failed to compile pipeline. Kept previous pipeline: " +
+                    build.error,
+                true);
+    }
 
-  if (!loaded_target_key_.empty()) {
-    pipeline_files_[loaded_target_key_] = ShaderEditorPipelineState{
-        .vert = vert_file_,
-        .frag = frag_file_,
-    };
+    if (active) {
+      vert_file_ = state.vert;
+      frag_file_ = state.frag;
+    }
   }
-
-  return false;
 }
 
 void ShaderEditor::renderTargetSelector(
@@ -1373,6 +1332,7 @@ auto ShaderEditor::parseErrors(const std::string &log)
 auto ShaderEditor::render() -> void {
   reloadFromPipelineIfChanged();
   const auto targets = collectTargets();
+  finishPendingApplies(targets);
   refreshFileBackedShaders(targets);
 
   const ImGuiStyle &style = ImGui::GetStyle();
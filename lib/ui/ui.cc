@@ -35,7 +35,7 @@ UI::UI(const core::Window &window, const core::Instance &instance,
        const core::CommandBuffers &commandBuffers)
     : window_(window), instance_(instance), surface_(surface), device_(device),
       command_pool_(commandPool), scene_(scene), asset_system_(assetSystem),
-      camera_(camera), offscreen_target_(offscreenTarget),
+      camera_(camera), offscreen_target_(&offscreenTarget),
       render_pass_(renderPass), descriptor_pool_(descriptorPool), graph_(graph),
       timer_(timer), command_buffers_(commandBuffers), desc_(desc) {
   if (command_buffers_.empty()) {
@@ -71,7 +71,7 @@ UI::UI(const core::Window &window, const core::Instance &instance,
   initInfo.Device = device_.device();
   initInfo.QueueFamily = device_.graphicsFamily();
   initInfo.Queue = device_.graphicsQueue();
-  initInfo.PipelineCache = VK_NULL_HANDLE;
+  initInfo.PipelineCache = device_.pipelineCache().cache();
   initInfo.DescriptorPool = descriptor_pool_.pool();
   initInfo.Allocator = nullptr;
   initInfo.MinImageCount = command_buffers_.size();
@@ -94,22 +94,13 @@ UI::UI(const core::Window &window, const core::Instance &instance,
       std::make_unique<pipeline::DescriptorSetLayout>(device_);
   offscreen_descriptor_layout_->update({.bindings = offscreenBindings});
 
-  VkDescriptorImageInfo offscreenImageInfo{};
-  offscreenImageInfo.sampler = offscreen_target_.color().sampler();
-  offscreenImageInfo.imageView = offscreen_target_.color().imageView();
-  offscreenImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-  auto offscreenWrite = pipeline::DescriptorSetWriteDesc::forSet(0);
-  offscreenWrite.images.push_back(pipeline::DescriptorImageWriteDesc::one(
-      0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, offscreenImageInfo));
-
   offscreen_descriptor_sets_ =
       std::make_unique<pipeline::DescriptorSets>(device_);
   offscreen_descriptor_sets_->update(pipeline::DescriptorSetsDesc{
       .pool = descriptor_pool_.pool(),
       .layout = offscreen_descriptor_layout_->layout(),
       .setCount = 1,
-      .writes = {offscreenWrite},
+      .writes = {viewportWrite()},
   });
 
   viewport_panel_ = std::make_unique<ViewportPanel>(
@@ -185,6 +176,13 @@ void UI::render(VkCommandBuffer commandBuffer) {
   ImGui_ImplVulkan_RenderDrawData(drawData, commandBuffer);
 }
 
+void UI::rebindViewport(exec::OffscreenTarget &offscreenTarget) {
+  offscreen_target_ = &offscreenTarget;
+  if (offscreen_descriptor_sets_) {
+    offscreen_descriptor_sets_->rewrite({viewportWrite()});
+  }
+}
+
 void UI::renderFullScreen() {
   const ImGuiViewport *viewport = ImGui::GetMainViewport();
   ImGui::SetNextWindowPos(viewport->WorkPos);
@@ -423,4 +421,16 @@ void UI::renderThemeControls() {
   }
 }
 
+auto UI::viewportWrite() const -> pipeline::DescriptorSetWriteDesc {
+  VkDescriptorImageInfo offscreenImageInfo{};
+  offscreenImageInfo.sampler = offscreen_target_->color().sampler();
+  offscreenImageInfo.imageView = offscreen_target_->color().imageView();
+  offscreenImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+  auto offscreenWrite = pipeline::DescriptorSetWriteDesc::forSet(0);
+  offscreenWrite.images.push_back(pipeline::DescriptorImageWriteDesc::one(
+      0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, offscreenImageInfo));
+  return offscreenWrite;
+}
+
 } // namespace vkr::ui
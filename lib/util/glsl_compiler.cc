@@ -1,9 +1,24 @@
 #include "vkr/logger.hh"
 #include "vkr/util/compiler.hh"
 #include "vkr/util/io.hh"
+#include <string>
+
+#if __has_include(<glslang/build_info.h>)
+#include <glslang/build_info.h>
+#endif
 
 namespace vkr::util {
 
+namespace {
+
+// shaderc compilers are safe to share across threads and costly to build
+auto sharedCompiler() -> const shaderc::Compiler & {
+  static const shaderc::Compiler compiler;
+  return compiler;
+}
+
+} // namespace
+
 auto ShaderCompiler::compileGlsl(const GlslCompileDesc &desc)
     -> ShaderCompileResult {
   ShaderCompileResult result{};
@@ -19,7 +34,7 @@ auto ShaderCompiler::compileGlsl(const GlslCompileDesc &desc)
     return result;
   }
 
-  shaderc::Compiler compiler;
+  const shaderc::Compiler &compiler = sharedCompiler();
   shaderc::CompileOptions options;
   options.SetSourceLanguage(shaderc_source_language_glsl);
   options.SetOptimizationLevel(desc.optimization);
@@ -51,6 +66,22 @@ auto ShaderCompiler::compileGlsl(const GlslCompileDesc &desc)
   return result;
 }
 
+auto ShaderCompiler::glslCompilerVersion() -> std::string {
+  // shaderc has no version query of its own (shaderc_get_spv_version reports
+  // the SPIR-V version it emits), so identify the build through the SDK it
+  // came from and the glslang it was compiled against
+  std::string version = "shaderc";
+#ifdef VKR_SHADERC_VERSION
+  version += "-" VKR_SHADERC_VERSION;
+#endif
+#ifdef GLSLANG_VERSION_MAJOR
+  version += "-glslang-" + std::to_string(GLSLANG_VERSION_MAJOR) + "." +
+             std::to_string(GLSLANG_VERSION_MINOR) + "." +
+             std::to_string(GLSLANG_VERSION_PATCH) + GLSLANG_VERSION_FLAVOR;
+#endif
+  return version;
+}
+
 auto ShaderCompiler::loadSource(const GlslCompileDesc &desc) -> std::string {
   if (!desc.source.empty()) {
     return desc.source;
@@ -0,0 +1,531 @@
+#include "vkr/util/shader_cache.hh"
+#include "vkr/logger.hh"
+#include "vkr/util/io.hh"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+namespace vkr::util {
+
+namespace {
+
+// bump when the key layout or the blob format changes
+constexpr uint32_t CACHE_FORMAT_VERSION = 1;
+constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+constexpr size_t SPIRV_HEADER_WORDS = 5;
+constexpr uint32_t MAX_INCLUDE_DEPTH = 32;
+
+class KeyHasher {
+public:
+  void add(std::string_view value) noexcept {
+    add(static_cast<uint64_t>(value.size()));
+    addBytes(value.data(), value.size());
+  }
+
+  void add(uint64_t value) noexcept { addBytes(&value, sizeof(value)); }
+
+  [[nodiscard]] auto value() const noexcept -> uint64_t { return hash_; }
+
+private:
+  uint64_t hash_{0xcbf29ce484222325ULL};
+
+  void addBytes(const void *data, size_t size) noexcept {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash_ ^= bytes[i];
+      hash_ *= 0x100000001b3ULL;
+    }
+  }
+};
+
+auto trimLeft(std::string_view line) -> std::string_view {
+  while (!line.empty() && std::isspace(static_cast<unsigned char>(line[0]))) {
+    line.remove_prefix(1);
+  }
+  return line;
+}
+
+auto startsWith(std::string_view value, std::string_view prefix) -> bool {
+  return value.substr(0, prefix.size()) == prefix;
+}
+
+// `#include "a.glsl"`, `#include <a.glsl>`, `__include a;`, `import a.b;` and
+// `import "a.slang";` all name a dependency whose content must be in the key
+auto includeCandidates(std::string_view line) -> std::vector<std::string> {
+  line = trimLeft(line);
+
+  bool moduleName = false;
+  if (startsWith(line, "#include")) {
+    line.remove_prefix(8);
+  } else if (startsWith(line, "__include")) {
+    line.remove_prefix(9);
+    moduleName = true;
+  } else if (startsWith(line, "import ")) {
+    line.remove_prefix(7);
+    moduleName = true;
+  } else {
+    return {};
+  }
+
+  line = trimLeft(line);
+  if (line.empty()) {
+    return {};
+  }
+
+  if (line[0] == '"' || line[0] == '<') {
+    const char close = line[0] == '"' ? '"' : '>';
+    const auto end = line.find(close, 1);
+    if (end == std::string_view::npos) {
+      return {};
+    }
+    return {std::string(line.substr(1, end - 1))};
+  }
+
+  if (!moduleName) {
+    return {};
+  }
+
+  std::string name{};
+  for (const char c : line) {
+    if (c == ';' || std::isspace(static_cast<unsigned char>(c))) {
+      break;
+    }
+    name.push_back(c == '.' ? '/' : c);
+  }
+
+  if (name.empty()) {
+    return {};
+  }
+
+  // Slang maps `_` in module names to `-` in file names
+  std::string dashed = name;
+  for (auto &c : dashed) {
+    if (c == '_') {
+      c = '-';
+    }
+  }
+
+  std::vector<std::string> candidates{name + ".slang"};
+  if (dashed != name) {
+    candidates.push_back(dashed + ".slang");
+  }
+  return candidates;
+}
+
+auto resolveInclude(const std::vector<std::string> &candidates,
+                    const std::filesystem::path &currentDir,
+                    const std::vector<std::string> &searchPaths)
+    -> std::filesystem::path {
+  std::error_code error{};
+
+  for (const auto &candidate : candidates) {
+    if (!currentDir.empty()) {
+      auto path = currentDir / candidate;
+      if (std::filesystem::is_regular_file(path, error)) {
+        return path;
+      }
+    }
+
+    for (const auto &searchPath : searchPaths) {
+      auto path = std::filesystem::path(searchPath) / candidate;
+      if (std::filesystem::is_regular_file(path, error)) {
+        return path;
+      }
+    }
+  }
+
+  return {};
+}
+
+void hashIncludes(KeyHasher &hasher, const std::string &source,
+                  const std::filesystem::path &currentDir,
+                  const std::vector<std::string> &searchPaths,
+                  std::set<std::filesystem::path> &visited, uint32_t depth) {
+  if (depth > MAX_INCLUDE_DEPTH) {
+    return;
+  }
+
+  std::istringstream stream(source);
+  std::string line{};
+  while (std::getline(stream, line)) {
+    const auto candidates = includeCandidates(line);
+    if (candidates.empty()) {
+      continue;
+    }
+
+    const auto path = resolveInclude(candidates, currentDir, searchPaths);
+    if (path.empty()) {
+      // builtin modules or a file that does not exist yet
+      hasher.add(candidates.front());
+      continue;
+    }
+
+    std::error_code error{};
+    auto canonical = std::filesystem::weakly_canonical(path, error);
+    if (error) {
+      canonical = path.lexically_normal();
+    }
+
+    if (!visited.insert(canonical).second) {
+      continue;
+    }
+
+    std::ifstream file(canonical, std::ios::binary);
+    const std::string content{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+
+    hasher.add(canonical.generic_string());
+    hasher.add(content);
+    hashIncludes(hasher, content, canonical.parent_path(), searchPaths, visited,
+                 depth + 1);
+  }
+}
+
+auto sourceDir(const std::string &path) -> std::filesystem::path {
+  return path.empty() ? std::filesystem::path{}
+                      : std::filesystem::path(path).parent_path();
+}
+
+auto elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+    -> double {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+auto ShaderCache::instance() -> ShaderCache & {
+  static ShaderCache cache;
+  return cache;
+}
+
+void ShaderCache::configure(const ShaderCacheDesc &desc) {
+  if (!desc.isValid()) {
+    VKR_UTIL_ERROR("Invalid shader cache descriptor");
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  desc_ = desc;
+
+  while (lru_.size() > desc_.memoryEntries) {
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+
+  if (desc_.enabled) {
+    VKR_UTIL_INFO("Shader cache directory: {}", desc_.directory);
+  } else {
+    VKR_UTIL_INFO("Shader cache disabled by config");
+  }
+}
+
+void ShaderCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  entries_.clear();
+  stats_ = {};
+}
+
+auto ShaderCache::compileGlsl(const GlslCompileDesc &desc)
+    -> ShaderCompileResult {
+  const ShaderCacheDesc cache = settings();
+  if (!cache.enabled || !desc.isValid()) {
+    return ShaderCompiler::compileGlsl(desc);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  GlslCompileDesc resolved = desc;
+  if (resolved.source.empty()) {
+    resolved.source = fread_string(resolved.path);
+  }
+
+  KeyHasher hasher{};
+  hasher.add(CACHE_FORMAT_VERSION);
+  hasher.add("glsl");
+  hasher.add(ShaderCompiler::glslCompilerVersion());
+  hasher.add(static_cast<uint64_t>(resolved.stage));
+  hasher.add(resolved.entryPoint);
+  hasher.add(static_cast<uint64_t>(resolved.optimization));
+  hasher.add(static_cast<uint64_t>(resolved.generateDebugInfo));
+  // debug info records the source name; otherwise the label only names logs
+  if (resolved.generateDebugInfo) {
+    hasher.add(resolved.label);
+  }
+  hasher.add(static_cast<uint64_t>(resolved.warningsAsErrors));
+  hasher.add(static_cast<uint64_t>(resolved.targetEnvVersion));
+  hasher.add(resolved.source);
+
+  std::set<std::filesystem::path> visited{};
+  hashIncludes(hasher, resolved.source, sourceDir(resolved.path), {}, visited,
+               0);
+
+  auto result =
+      fetch(hasher.value(), resolved.label, cache.directory,
+            [&resolved]() { return ShaderCompiler::compileGlsl(resolved); });
+
+  VKR_UTIL_DEBUG("Shader '{}' resolved in {:.3f} ms", resolved.label,
+                 elapsedMilliseconds(start));
+  return result;
+}
+
+auto ShaderCache::compileSlang(const SlangCompileDesc &desc)
+    -> ShaderCompileResult {
+  const ShaderCacheDesc cache = settings();
+  if (!cache.enabled || !desc.isValid()) {
+    return ShaderCompiler::compileSlang(desc);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  SlangCompileDesc resolved = desc;
+  if (resolved.source.empty()) {
+    resolved.source = fread_string(resolved.path);
+  }
+
+  KeyHasher hasher{};
+  hasher.add(CACHE_FORMAT_VERSION);
+  hasher.add("slang");
+  hasher.add(ShaderCompiler::slangCompilerVersion());
+  hasher.add(static_cast<uint64_t>(resolved.stage));
+  hasher.add(resolved.moduleName);
+  hasher.add(resolved.entryPoint);
+  hasher.add(static_cast<uint64_t>(resolved.generateDebugInfo));
+  if (resolved.generateDebugInfo) {
+    hasher.add(resolved.label);
+  }
+  hasher.add(static_cast<uint64_t>(resolved.warningsAsErrors));
+  hasher.add(static_cast<uint64_t>(resolved.skipSpirvValidation));
+  for (const auto &path : resolved.searchPaths) {
+    hasher.add(path);
+  }
+  for (const auto &macro : resolved.macros) {
+    hasher.add(macro.first);
+    hasher.add(macro.second);
+  }
+  hasher.add(resolved.source);
+
+  std::set<std::filesystem::path> visited{};
+  hashIncludes(hasher, resolved.source, sourceDir(resolved.path),
+               resolved.searchPaths, visited, 0);
+
+  auto result =
+      fetch(hasher.value(), resolved.label, cache.directory,
+            [&resolved]() { return ShaderCompiler::compileSlang(resolved); });
+
+  VKR_UTIL_DEBUG("Slang shader '{}' resolved in {:.3f} ms", resolved.label,
+                 elapsedMilliseconds(start));
+  return result;
+}
+
+auto ShaderCache::stats() const -> ShaderCacheStats {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void ShaderCache::logStats() const {
+  const ShaderCacheStats current = stats();
+
+  VKR_UTIL_INFO("Shader cache: {} lookup(s), {} memory hit(s), {} disk "
+                "hit(s), {} miss(es), {:.1f}% hit rate",
+                current.lookups(), current.memoryHits, current.diskHits,
+                current.misses, current.hitRate() * 100.0);
+  VKR_UTIL_INFO("Shader cache: {:.3f} ms compiling, {:.3f} ms loading",
+                current.compileMilliseconds, current.loadMilliseconds);
+}
+
+auto ShaderCache::settings() const -> ShaderCacheDesc {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return desc_;
+}
+
+auto ShaderCache::fetch(uint64_t key, const std::string &label,
+                        const std::string &directory,
+                        const std::function<ShaderCompileResult()> &compile)
+    -> ShaderCompileResult {
+  const auto start = std::chrono::steady_clock::now();
+
+  std::promise<ShaderCompileResult> promise{};
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    ShaderCompileResult result{};
+    if (lookupMemory(key, result.spv)) {
+      result.success = true;
+      stats_.memoryHits++;
+      stats_.loadMilliseconds += elapsedMilliseconds(start);
+      return result;
+    }
+
+    // pipelines built concurrently from the same shader wait for the first
+    // request instead of compiling and writing the same blob again
+    auto pending = pending_.find(key);
+    if (pending != pending_.end()) {
+      const auto future = pending->second;
+      lock.unlock();
+      result = future.get();
+      lock.lock();
+      stats_.memoryHits++;
+      stats_.loadMilliseconds += elapsedMilliseconds(start);
+      return result;
+    }
+
+    pending_.emplace(key, promise.get_future().share());
+  }
+
+  ShaderCompileResult result{};
+  bool diskHit = false;
+  try {
+    diskHit = lookupDisk(directory, key, result.spv);
+    if (diskHit) {
+      result.success = true;
+      VKR_UTIL_INFO("Loaded cached SPIR-V: {}", label);
+    } else {
+      result = compile();
+      if (result) {
+        storeDisk(directory, key, result.spv);
+      }
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(key);
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  const double milliseconds = elapsedMilliseconds(start);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (result) {
+    insert(key, result.spv);
+  }
+  pending_.erase(key);
+  promise.set_value(result);
+
+  if (diskHit) {
+    stats_.diskHits++;
+    stats_.loadMilliseconds += milliseconds;
+  } else {
+    stats_.misses++;
+    stats_.compileMilliseconds += milliseconds;
+  }
+  return result;
+}
+
+// called with mutex_ held
+auto ShaderCache::lookupMemory(uint64_t key, std::vector<uint32_t> &spv)
+    -> bool {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, it->second);
+  spv = it->second->spv;
+  return true;
+}
+
+auto ShaderCache::lookupDisk(const std::string &directory, uint64_t key,
+                             std::vector<uint32_t> &spv) -> bool {
+  const auto path = blobPath(directory, key);
+  std::ifstream file(path, std::ios::ate | std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  const auto size = static_cast<size_t>(file.tellg());
+  if (size < SPIRV_HEADER_WORDS * sizeof(uint32_t) ||
+      size % sizeof(uint32_t) != 0) {
+    VKR_UTIL_WARN("Ignoring truncated cached SPIR-V: {}", path.string());
+    return false;
+  }
+
+  std::vector<uint32_t> words(size / sizeof(uint32_t));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(words.data()),
+            static_cast<std::streamsize>(size));
+  if (!file || words[0] != SPIRV_MAGIC) {
+    VKR_UTIL_WARN("Ignoring corrupt cached SPIR-V: {}", path.string());
+    return false;
+  }
+
+  spv = std::move(words);
+  return true;
+}
+
+void ShaderCache::storeDisk(const std::string &directory, uint64_t key,
+                            const std::vector<uint32_t> &spv) {
+  std::error_code error{};
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    VKR_UTIL_WARN("Failed to create shader cache directory {}: {}", directory,
+                  error.message());
+    return;
+  }
+
+  // other processes may store the same key; each writer renames its own
+  // complete file into place, so readers never see a partial blob
+  static std::atomic<uint64_t> writes{0};
+  const auto thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+  const auto path = blobPath(directory, key);
+  auto tmpPath = path;
+  tmpPath += ".tmp" + std::to_string(thread) + "-" + std::to_string(now) +
+             "-" + std::to_string(writes++);
+
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(spv.data()),
+               static_cast<std::streamsize>(spv.size() * sizeof(uint32_t)));
+    if (!file) {
+      VKR_UTIL_WARN("Failed to write cached SPIR-V: {}", tmpPath.string());
+      file.close();
+      std::filesystem::remove(tmpPath, error);
+      return;
+    }
+  }
+
+  std::filesystem::rename(tmpPath, path, error);
+  if (error) {
+    VKR_UTIL_WARN("Failed to store cached SPIR-V {}: {}", path.string(),
+                  error.message());
+    std::filesystem::remove(tmpPath, error);
+  }
+}
+
+// called with mutex_ held
+void ShaderCache::insert(uint64_t key, const std::vector<uint32_t> &spv) {
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second->spv = spv;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+
+  lru_.push_front(Entry{key, spv});
+  entries_[key] = lru_.begin();
+
+  while (lru_.size() > desc_.memoryEntries) {
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+}
+
+auto ShaderCache::blobPath(const std::string &directory, uint64_t key)
+    -> std::filesystem::path {
+  char name[17]{};
+  std::snprintf(name, sizeof(name), "%016llx",
+                static_cast<unsigned long long>(key));
+  return std::filesystem::path(directory) / (std::string(name) + ".spv");
+}
+
+} // namespace vkr::util
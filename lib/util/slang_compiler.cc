@@ -8,6 +8,7 @@
 #endif
 
 #include <cstring>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -48,6 +49,22 @@ auto toSlangStage(SlangShaderStage stage) -> SlangStage {
   return SLANG_STAGE_NONE;
 }
 
+// global sessions are expensive and not thread-safe; share one under a lock
+auto slangMutex() -> std::mutex & {
+  static std::mutex mutex;
+  return mutex;
+}
+
+auto sharedGlobalSession() -> slang::IGlobalSession * {
+  static Slang::ComPtr<slang::IGlobalSession> globalSession;
+  if (globalSession.get() == nullptr &&
+      SLANG_FAILED(slang::createGlobalSession(globalSession.writeRef()))) {
+    return nullptr;
+  }
+
+  return globalSession.get();
+}
+
 #endif
 
 } // namespace
@@ -73,8 +90,9 @@ auto ShaderCompiler::compileSlang(const SlangCompileDesc &desc)
 #else
   VKR_UTIL_INFO("Compiling Slang shader: {}", desc.label);
 
-  Slang::ComPtr<slang::IGlobalSession> globalSession;
-  if (SLANG_FAILED(slang::createGlobalSession(globalSession.writeRef()))) {
+  std::lock_guard<std::mutex> lock(slangMutex());
+  slang::IGlobalSession *globalSession = sharedGlobalSession();
+  if (globalSession == nullptr) {
     result.error = "failed to create Slang global session";
     return result;
   }
@@ -212,4 +230,13 @@ auto ShaderCompiler::compileSlang(const SlangCompileDesc &desc)
 #endif
 }
 
+auto ShaderCompiler::slangCompilerVersion() -> std::string {
+#ifdef VKR_HAS_SLANG
+  const char *tag = spGetBuildTagString();
+  return tag != nullptr ? std::string("slang-") + tag : "slang";
+#else
+  return "slang-unavailable";
+#endif
+}
+
 } // namespace vkr::util
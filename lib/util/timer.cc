@@ -29,6 +29,11 @@ void Timer::start() {
 void Timer::beginFrame() { frame_start_time_ = Clock::now(); }
 
 void Timer::update() {
+  if (fixed_step_ > 0.0f) {
+    elapsed_time_ = fixed_step_ * static_cast<float>(frame_count_);
+    return;
+  }
+
   auto now = Clock::now();
   std::chrono::duration<float> elapsed = now - start_time_;
   elapsed_time_ = elapsed.count();
@@ -61,6 +66,16 @@ void Timer::endFrame() {
     }
   }
 
+  if (fixed_step_ > 0.0f) {
+    raw_delta_time_ = fixed_step_;
+    delta_time_ = fixed_step_;
+    raw_fps_ = 1.0f / fixed_step_;
+    fps_ = raw_fps_;
+    frame_count_++;
+    elapsed_time_ = fixed_step_ * static_cast<float>(frame_count_);
+    return;
+  }
+
   auto frame_end_time = Clock::now();
 
   std::chrono::duration<float> frameDuration =